@@ -0,0 +1,398 @@
+/**
+ * @file FuzzTarget.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Editor.h"
+#include "Fuzz.h"
+#include "History.h"
+
+// Input bytes of one step, the xorshift state the step is drawn from
+#define FUZZ_STEP_BYTES 4
+
+#ifndef HOST_LIBFUZZER
+// Seed and number of the generated input run by the thread, reported
+// on a violation to run the input again alone
+unsigned fuzzInputSeed = 0;
+thread_local uint64_t fuzzInputNumber = UINT64_MAX;
+#endif
+
+/**
+ * @brief Apply the steps decoded from the input on the fresh fuzz
+ * editor and history, every 4 bytes seed one random step, and check
+ * the editor invariants and text area after each. A violation is
+ * reported and aborts, so libFuzzer stores the input.
+ * 
+ * @param data 
+ * @param size 
+ * @return int always 0
+ */
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  size_t steps = size / FUZZ_STEP_BYTES;
+  if (steps > FUZZ_MAX_STEPS) {
+    steps = FUZZ_MAX_STEPS;
+  }
+
+  initHistory();
+  Editor *editor = resetFuzzEditor();
+
+  for (size_t step = 0; step < steps; ++step) {
+    const uint8_t *bytes = data + step * FUZZ_STEP_BYTES;
+    uint32_t state = bytes[0] | (bytes[1] << 8) | (bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+    if (state == 0) {
+      state = 1;
+    }
+
+    Key key;
+    FuzzAction action;
+    runFuzzStep(editor, &state, &key, &action);
+
+    EditorCheck check = checkEditor(editor);
+    if (check == CHECK_OK) {
+      check = checkFrame(editor);
+    }
+
+    if (check != CHECK_OK) {
+      fprintf(stderr, "step %zu of %zu: check %d after key %d action %d, message '%s'\n",
+              step, steps, check, key, action, editor->buffer);
+#ifndef HOST_LIBFUZZER
+      if (fuzzInputNumber != UINT64_MAX) {
+        fprintf(stderr, "run again with --seed %u --input %llu\n", fuzzInputSeed,
+                (unsigned long long)fuzzInputNumber);
+      }
+#endif
+      abort();
+    }
+  }
+
+  return 0;
+}
+
+#ifndef HOST_LIBFUZZER
+
+/**
+ * @brief Structure for the inputs left to one worker, other workers
+ * steal the back half when they run out.
+ * 
+ */
+typedef struct {
+  std::mutex lock;
+  uint64_t next;
+  uint64_t end;
+} FuzzQueue;
+
+/**
+ * @brief Structure for the standalone run options.
+ * 
+ */
+typedef struct {
+  unsigned threads;
+  uint64_t execs;
+  unsigned maxLen;
+  unsigned seed;
+} FuzzOptions;
+
+/**
+ * @brief Structure for the result of one worker.
+ * 
+ */
+typedef struct {
+  uint64_t execs;
+  uint64_t stolen;
+  double seconds;
+} FuzzWorkerResult;
+
+// Inputs taken from the own queue at once
+#define FUZZ_BATCH 16
+
+/**
+ * @brief Get the next splitmix value, inputs are generated from their
+ * number so every input can be run again alone.
+ * 
+ * @param state 
+ * @return uint64_t 
+ */
+uint64_t nextFuzzInputRandom(uint64_t *state) {
+  uint64_t value = (*state += 0x9E3779B97F4A7C15ull);
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+/**
+ * @brief Generate the input of the number, random bytes of a random
+ * length up to the maximal length.
+ * 
+ * @param options 
+ * @param number 
+ * @param input 
+ */
+void makeFuzzInput(const FuzzOptions *options, uint64_t number, std::vector<uint8_t> *input) {
+  uint64_t state = ((uint64_t)options->seed << 32) ^ number;
+  input->resize(nextFuzzInputRandom(&state) % (options->maxLen + 1));
+
+  for (size_t idx = 0; idx < input->size(); idx += 8) {
+    uint64_t value = nextFuzzInputRandom(&state);
+    for (size_t byte = idx; byte < idx + 8 && byte < input->size(); ++byte) {
+      (*input)[byte] = value >> (8 * (byte - idx));
+    }
+  }
+}
+
+/**
+ * @brief Take the next batch of inputs from the own queue, an empty
+ * queue steals the back half of the fullest other queue.
+ * 
+ * @param queues 
+ * @param count 
+ * @param worker 
+ * @param first 
+ * @param last 
+ * @param stolen 
+ * @return true 
+ * @return false when all queues are empty
+ */
+bool takeFuzzInputs(FuzzQueue *queues, unsigned count, unsigned worker, uint64_t *first, uint64_t *last,
+                    uint64_t *stolen) {
+  FuzzQueue *own = &queues[worker];
+
+  for (;;) {
+    {
+      std::lock_guard<std::mutex> guard(own->lock);
+      if (own->next < own->end) {
+        *first = own->next;
+        own->next += own->end - own->next < FUZZ_BATCH ? own->end - own->next : FUZZ_BATCH;
+        *last = own->next;
+        return true;
+      }
+    }
+
+    unsigned victim = count;
+    uint64_t most = 0;
+    for (unsigned idx = 0; idx < count; ++idx) {
+      std::lock_guard<std::mutex> guard(queues[idx].lock);
+      if (idx != worker && queues[idx].end - queues[idx].next > most) {
+        most = queues[idx].end - queues[idx].next;
+        victim = idx;
+      }
+    }
+
+    if (victim == count) {
+      return false;
+    }
+
+    // Both queues are locked at once, two thieves can not deadlock
+    std::scoped_lock guard(own->lock, queues[victim].lock);
+    uint64_t left = queues[victim].end - queues[victim].next;
+    if (left > 0) {
+      uint64_t half = (left + 1) / 2;
+      own->next = queues[victim].end - half;
+      own->end = queues[victim].end;
+      queues[victim].end = own->next;
+      *stolen += half;
+    }
+  }
+}
+
+/**
+ * @brief Run the inputs of the own queue and the stolen ones.
+ * 
+ * @param options 
+ * @param queues 
+ * @param worker 
+ * @param result 
+ */
+void runFuzzWorker(const FuzzOptions *options, FuzzQueue *queues, unsigned worker, FuzzWorkerResult *result) {
+  std::vector<uint8_t> input;
+  uint64_t first;
+  uint64_t last;
+
+  result->execs = 0;
+  result->stolen = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  while (takeFuzzInputs(queues, options->threads, worker, &first, &last, &result->stolen)) {
+    for (uint64_t number = first; number < last; ++number) {
+      makeFuzzInput(options, number, &input);
+      fuzzInputNumber = number;
+      LLVMFuzzerTestOneInput(input.data(), input.size());
+      result->execs++;
+    }
+  }
+
+  result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Run the input file.
+ * 
+ * @param path 
+ * @return true 
+ * @return false if the file can not be read
+ */
+bool runFuzzFile(const char *path) {
+  FILE *file = fopen(path, "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  std::vector<uint8_t> input;
+  uint8_t chunk[4096];
+  size_t len;
+  while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    input.insert(input.end(), chunk, chunk + len);
+  }
+  fclose(file);
+
+  LLVMFuzzerTestOneInput(input.data(), input.size());
+  return true;
+}
+
+/**
+ * @brief Parse the option value.
+ * 
+ * @param arg 
+ * @param value 
+ * @return true 
+ * @return false if the value is not a number
+ */
+bool parseFuzzValue(const char *arg, uint64_t *value) {
+  char *end;
+  *value = strtoull(arg, &end, 0);
+  return *arg != '\0' && *end == '\0';
+}
+
+/**
+ * @brief Standalone driver without libFuzzer, runs the generated
+ * inputs spread over the worker threads with work stealing and reports
+ * exec/s of every worker, the whole run and per core, or runs the
+ * input files given.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on a bad option or file, a violation aborts
+ */
+int main(int argc, char **argv) {
+  FuzzOptions options = {std::thread::hardware_concurrency(), 100000, 1024, 1};
+  std::vector<const char *> files;
+  uint64_t single = UINT64_MAX;
+
+  if (options.threads == 0) {
+    options.threads = 1;
+  }
+
+  for (int idx = 1; idx < argc; ++idx) {
+    uint64_t value = 0;
+    bool valid = true;
+
+    if (argv[idx][0] != '-') {
+      files.push_back(argv[idx]);
+      continue;
+    }
+
+    valid = idx + 1 < argc && parseFuzzValue(argv[idx + 1], &value);
+    if (valid && strcmp(argv[idx], "--threads") == 0 && value > 0 && value <= 1024) {
+      options.threads = value;
+    }
+    else if (valid && strcmp(argv[idx], "--execs") == 0) {
+      options.execs = value;
+    }
+    else if (valid && strcmp(argv[idx], "--max-len") == 0 && value <= FUZZ_MAX_STEPS * FUZZ_STEP_BYTES) {
+      options.maxLen = value;
+    }
+    else if (valid && strcmp(argv[idx], "--seed") == 0 && value <= UINT32_MAX) {
+      options.seed = value;
+    }
+    else if (valid && strcmp(argv[idx], "--input") == 0) {
+      single = value;
+    }
+    else {
+      fprintf(stderr, "usage: %s [--threads N] [--execs N] [--max-len N] [--seed N] [--input N] [FILE ...]\n",
+              argv[0]);
+      return 1;
+    }
+    ++idx;
+  }
+
+  fuzzInputSeed = options.seed;
+
+  if (!files.empty()) {
+    for (const char *path : files) {
+      if (!runFuzzFile(path)) {
+        fprintf(stderr, "%s: can not read\n", path);
+        return 1;
+      }
+    }
+    printf("%zu inputs passed\n", files.size());
+    return 0;
+  }
+
+  if (single != UINT64_MAX) {
+    std::vector<uint8_t> input;
+    makeFuzzInput(&options, single, &input);
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+    printf("input %llu of %zu bytes passed\n", (unsigned long long)single, input.size());
+    return 0;
+  }
+
+  // Every worker starts with an equal slice, the longer inputs are
+  // balanced by stealing
+  std::vector<FuzzQueue> queues(options.threads);
+  for (unsigned worker = 0; worker < options.threads; ++worker) {
+    queues[worker].next = options.execs * worker / options.threads;
+    queues[worker].end = options.execs * (worker + 1) / options.threads;
+  }
+
+  std::vector<FuzzWorkerResult> results(options.threads);
+  std::vector<std::thread> workers;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned worker = 0; worker < options.threads; ++worker) {
+    workers.emplace_back(runFuzzWorker, &options, queues.data(), worker, &results[worker]);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // Threads beyond the cores share them
+  unsigned cores = std::thread::hardware_concurrency();
+  if (cores == 0 || cores > options.threads) {
+    cores = options.threads;
+  }
+
+  printf("%llu inputs up to %u bytes on %u threads, seed %u\n", (unsigned long long)options.execs,
+         options.maxLen, options.threads, options.seed);
+  for (unsigned worker = 0; worker < options.threads; ++worker) {
+    const FuzzWorkerResult &result = results[worker];
+    printf("thread %2u: %10llu execs %8llu stolen %8.3f s %10.0f exec/s\n", worker,
+           (unsigned long long)result.execs, (unsigned long long)result.stolen, result.seconds,
+           result.execs / result.seconds);
+  }
+  printf("total: %.0f exec/s, %.0f exec/s per core in %.3f s\n", options.execs / wall,
+         options.execs / wall / cores, wall);
+
+  return 0;
+}
+
+#endif
@@ -0,0 +1,264 @@
+/**
+ * @file HistoryBench.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+
+#include "Display.h"
+#include "Editor.h"
+#include "History.h"
+#include "Index.h"
+#include "Keypad.h"
+
+// Most history sizes given by --sizes
+#define HISTORY_BENCH_MAX_SIZES 16
+
+// Words of the stored messages, same as history-bench of tools/link.py
+const char *const HistoryBenchWords[] = {
+  "ok", "see", "you", "at", "noon", "the", "meeting", "moved", "call", "me", "back", "soon", "home", "late",
+};
+
+/**
+ * @brief Structure for the bench options, named like the history-bench
+ * command of tools/link.py.
+ * 
+ */
+typedef struct {
+  unsigned sizes[HISTORY_BENCH_MAX_SIZES];
+  unsigned sizeCount;
+  unsigned scrolls;
+  unsigned deletes;
+  unsigned seed;
+} HistoryBenchOptions;
+
+/**
+ * @brief Structure for the times of one operation in us, the sum and
+ * the worst one.
+ * 
+ */
+typedef struct {
+  double sum;
+  double max;
+  unsigned count;
+} HistoryBenchTime;
+
+// Editor of the list operations, its flush draws to the host panel
+Editor HistoryBenchEditor;
+DisplayPanel HistoryBenchPanel;
+
+/**
+ * @brief Flush hook of the bench editor, the flush runs in the key
+ * handling like the device without the render task.
+ * 
+ * @param editor 
+ */
+void flushHistoryBench(Editor *editor) {
+  editor->display->display();
+}
+
+/**
+ * @brief Get the time since the start in us.
+ * 
+ * @param start 
+ * @return double 
+ */
+double getHistoryBenchTime(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Add the time of one operation.
+ * 
+ * @param time 
+ * @param us 
+ */
+void addHistoryBenchTime(HistoryBenchTime *time, double us) {
+  time->sum += us;
+  time->max = std::max(time->max, us);
+  time->count++;
+}
+
+/**
+ * @brief Get the average time of the operations.
+ * 
+ * @param time 
+ * @return double 0 without operations
+ */
+double getHistoryBenchMean(const HistoryBenchTime *time) {
+  return time->count > 0 ? time->sum / time->count : 0;
+}
+
+/**
+ * @brief Time one key action on the bench editor like the K command
+ * of the link.
+ * 
+ * @param key 
+ * @param hold hold instead of press
+ * @return double time in us
+ */
+double timeHistoryBenchKey(Key key, bool hold) {
+  auto start = std::chrono::steady_clock::now();
+
+  if (hold) {
+    handleLongPress(&HistoryBenchEditor, key, HistoryBenchEditor.now);
+  }
+  else {
+    handlePress(&HistoryBenchEditor, key);
+  }
+
+  double us = getHistoryBenchTime(start);
+  if (hold) {
+    handleLongRelease(&HistoryBenchEditor, key, HistoryBenchEditor.now);
+  }
+  return us;
+}
+
+/**
+ * @brief Store messages until the history keeps the size and time the
+ * list open, scrolls, message open and deletes at every size, the same
+ * steps as history-bench of tools/link.py, and print its table. The
+ * stores stop early once the slabs run out and a store drops a message.
+ * 
+ * @param options 
+ */
+void runHistoryBench(const HistoryBenchOptions *options) {
+  std::mt19937 rng(options->seed);
+  unsigned stored = 0;
+
+  initEditor(&HistoryBenchEditor, &HistoryBenchPanel, flushHistoryBench);
+  initDisplay(&HistoryBenchEditor);
+  initHistory();
+
+  printf("%8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "stored", "kept", "free", "dropped", "store", "max",
+         "list", "scroll", "open", "delete", "max");
+
+  for (unsigned idx = 0; idx < options->sizeCount; ++idx) {
+    HistoryBenchTime store = {0, 0, 0};
+    HistoryBenchTime scroll = {0, 0, 0};
+    HistoryBenchTime remove = {0, 0, 0};
+
+    for (bool full = false; !full && getHistoryStats().count < options->sizes[idx];) {
+      uint16_t kept = getHistoryStats().count;
+      std::string text;
+      for (unsigned word = 0, words = 2 + rng() % 11; word < words; ++word) {
+        text += (word > 0 ? " " : "") + std::string(HistoryBenchWords[rng() % 14]);
+      }
+      char peer[HISTORY_PEER_SIZE];
+      uint8_t peerLen = snprintf(peer, sizeof(peer), "+420%09u", (unsigned)(rng() % 1000000000));
+      uint8_t flags = rng() % 2 ? HISTORY_SENT : HISTORY_UNREAD;
+
+      auto start = std::chrono::steady_clock::now();
+      addHistory(flags, peer, peerLen, text.c_str(), text.size());
+      addHistoryBenchTime(&store, getHistoryBenchTime(start));
+      stored++;
+      full = getHistoryStats().count <= kept;
+    }
+
+    HistoryStats history = getHistoryStats();
+    double list = timeHistoryBenchKey(KEY_9, true);
+    for (unsigned move = 0; move < options->scrolls && move + 1 < history.count; ++move) {
+      addHistoryBenchTime(&scroll, timeHistoryBenchKey(KEY_8, false));
+    }
+    double open = timeHistoryBenchKey(KEY_5, false);
+    timeHistoryBenchKey(KEY_H, false);
+
+    // The delete repeats after the delete delay only
+    for (unsigned count = 0; count < options->deletes && getHistoryStats().count > 0; ++count) {
+      setEditorTime(&HistoryBenchEditor, HistoryBenchEditor.now + DELETE_SPEED_DELAY + 2);
+      addHistoryBenchTime(&remove, timeHistoryBenchKey(KEY_0, true));
+    }
+    timeHistoryBenchKey(KEY_H, false);
+
+    printf("%8u %8u %8u %8u %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f %8.1f\n", stored, history.count,
+           history.freeSlabs, history.evictions, getHistoryBenchMean(&store), store.max, list,
+           getHistoryBenchMean(&scroll), open, getHistoryBenchMean(&remove), remove.max);
+  }
+
+  IndexStats index = getIndexStats();
+  printf("times in us, scroll is the average of %u moves, delete of %u deletes\n", options->scrolls,
+         options->deletes);
+  printf("index: %u words, %u postings, %u dead, %u sweeps, %u free blocks\n", index.terms, index.postings,
+         index.dead, index.sweeps, index.freeBlocks);
+}
+
+/**
+ * @brief Parse the comma separated history sizes.
+ * 
+ * @param arg 
+ * @param options 
+ * @return true 
+ * @return false if a size is not a number up to the history entries
+ */
+bool parseHistoryBenchSizes(const char *arg, HistoryBenchOptions *options) {
+  options->sizeCount = 0;
+
+  while (*arg != '\0' && options->sizeCount < HISTORY_BENCH_MAX_SIZES) {
+    char *end;
+    unsigned long size = strtoul(arg, &end, 10);
+    if (end == arg || size > HISTORY_ENTRIES || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+
+    options->sizes[options->sizeCount++] = size;
+    arg = *end == ',' ? end + 1 : end;
+  }
+
+  return *arg == '\0' && options->sizeCount > 0;
+}
+
+/**
+ * @brief Run the history bench of tools/link.py on the host, by
+ * default at the sizes the history holds.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on a bad option
+ */
+int main(int argc, char **argv) {
+  HistoryBenchOptions options = {{10, 100, HISTORY_ENTRIES}, 3, 50, 10, 1};
+
+  for (int idx = 1; idx < argc; ++idx) {
+    bool valid = idx + 1 < argc;
+
+    if (valid && strcmp(argv[idx], "--sizes") == 0) {
+      valid = parseHistoryBenchSizes(argv[++idx], &options);
+    }
+    else if (valid && strcmp(argv[idx], "--scrolls") == 0) {
+      options.scrolls = strtoul(argv[++idx], NULL, 10);
+    }
+    else if (valid && strcmp(argv[idx], "--deletes") == 0) {
+      options.deletes = strtoul(argv[++idx], NULL, 10);
+    }
+    else if (valid && strcmp(argv[idx], "--seed") == 0) {
+      options.seed = strtoul(argv[++idx], NULL, 10);
+    }
+    else {
+      valid = false;
+    }
+
+    if (!valid) {
+      fprintf(stderr, "usage: %s [--sizes N,...] [--scrolls N] [--deletes N] [--seed N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  runHistoryBench(&options);
+  return 0;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file Load.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Editor.h"
+#include "Display.h"
+#include "Fuzz.h"
+#include "History.h"
+#include "Latency.h"
+
+/**
+ * @brief Structure for the load run options, the editors are split
+ * over the threads and every editor takes the steps.
+ * 
+ */
+typedef struct {
+  unsigned threads;
+  unsigned editors;
+  unsigned steps;
+  unsigned seed;
+  bool frames;
+  unsigned maxP99;
+  unsigned maxViolations;
+} LoadOptions;
+
+/**
+ * @brief Structure for the result of one worker thread.
+ * 
+ */
+typedef struct {
+  unsigned editors;
+  uint64_t steps;
+  uint64_t violations;
+  double seconds;
+  LoopStats loop;
+} LoadResult;
+
+// Names of the step parts, LoopPhase of Latency.h
+const char *const LoadPhases[LOOP_PHASES] = {"scan", "edit", "render", "flush", "link"};
+
+// Gate not set
+#define LOAD_NO_LIMIT UINT32_MAX
+
+// Workers waiting for the common start
+std::atomic<unsigned> loadReady(0);
+
+/**
+ * @brief Flush hook of the load editors, the frame stays in the panel.
+ * 
+ * @param editor 
+ */
+void skipLoadFlush(Editor * /*editor*/) {
+}
+
+/**
+ * @brief Run the editors of one worker thread round robin, one fuzz
+ * step each, every editor has its own panel and seed. The history,
+ * index and flow pools and the step time report are the shared state
+ * of the thread, every fuzz step is timed as one input step.
+ * 
+ * @param options 
+ * @param worker 
+ * @param result 
+ */
+void runLoadWorker(const LoadOptions *options, unsigned worker, LoadResult *result) {
+  unsigned count = options->editors / options->threads + (worker < options->editors % options->threads);
+  std::unique_ptr<Editor[]> editors(new Editor[count]);
+  std::unique_ptr<DisplayPanel[]> panels(new DisplayPanel[count]);
+  std::vector<uint32_t> states(count);
+
+  initHistory();
+  for (unsigned idx = 0; idx < count; ++idx) {
+    Editor *editor = &editors[idx];
+    initEditor(editor, &panels[idx], skipLoadFlush);
+    resetDisplay(editor);
+    drawHeader(editor);
+    states[idx] = (options->seed + worker * 0x9E3779B9u + idx * 0x85EBCA6Bu) | 1;
+  }
+
+  result->editors = count;
+  result->steps = 0;
+  result->violations = 0;
+  resetLoopStats();
+
+  loadReady++;
+  while (loadReady < options->threads) {
+    std::this_thread::yield();
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  for (unsigned step = 0; step < options->steps; ++step) {
+    for (unsigned idx = 0; idx < count; ++idx) {
+      Key key;
+      FuzzAction action;
+      startLoopStep();
+      runFuzzStep(&editors[idx], &states[idx], &key, &action);
+      endLoopStep();
+
+      EditorCheck check = checkEditor(&editors[idx]);
+      if (check == CHECK_OK && options->frames) {
+        check = checkFrame(&editors[idx]);
+      }
+      if (check != CHECK_OK) {
+        result->violations++;
+      }
+    }
+    result->steps += count;
+  }
+
+  result->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  result->loop = *getLoopStats();
+}
+
+/**
+ * @brief Print the step time histogram, percentiles and violations of
+ * all workers like the latency command of tools/link.py.
+ * 
+ * @param stats 
+ */
+void printLoadLatency(const LoopStats *stats) {
+  int first = -1;
+  int last = 0;
+  uint32_t most = 1;
+
+  for (int bucket = 0; bucket < LOOP_BUCKETS; ++bucket) {
+    if (stats->buckets[bucket] > 0) {
+      first = first < 0 ? bucket : first;
+      last = bucket;
+      most = stats->buckets[bucket] > most ? stats->buckets[bucket] : most;
+    }
+  }
+
+  printf("steps %u, budget %.2f ms\n", stats->steps, LOOP_BUDGET / 1e3);
+  for (int bucket = first < 0 ? 0 : first; bucket <= last; ++bucket) {
+    char bar[41];
+    int len = (uint64_t)stats->buckets[bucket] * 40 / most;
+    memset(bar, '#', len);
+    bar[len] = '\0';
+    printf("%8lu us %10u %s\n", bucket > 0 ? 1UL << (bucket - 1) : 0UL, stats->buckets[bucket], bar);
+  }
+
+  printf("p50 < %u us, p99 < %u us, max %u us\n", getLoopPercentile(stats, 50), getLoopPercentile(stats, 99),
+         stats->maxTime);
+  printf("budget violations %u (", stats->violations);
+  const char *separator = "";
+  for (int phase = 0; phase < LOOP_PHASES; ++phase) {
+    if (stats->causes[phase] > 0) {
+      printf("%s%s %u", separator, LoadPhases[phase], stats->causes[phase]);
+      separator = ", ";
+    }
+  }
+  printf(")\n");
+}
+
+/**
+ * @brief Parse the unsigned option value.
+ * 
+ * @param arg 
+ * @param value 
+ * @param least 
+ * @return true 
+ * @return false if the value is not a number of at least the least
+ */
+bool parseLoadValue(const char *arg, unsigned *value, unsigned least) {
+  char *end;
+  unsigned long parsed = strtoul(arg, &end, 0);
+
+  if (*arg == '\0' || *end != '\0' || parsed < least || parsed >= UINT32_MAX) {
+    return false;
+  }
+
+  *value = parsed;
+  return true;
+}
+
+/**
+ * @brief Run thousands of editors across the worker threads and report
+ * the editor steps per second of the whole run and per core and the
+ * step time histogram, the p99 and budget violations gate the run.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on an editor invariant violation, a bad option or a
+ * step time over the gate
+ */
+int main(int argc, char **argv) {
+  LoadOptions options = {std::thread::hardware_concurrency(), 4096, 256, 1, false, LOAD_NO_LIMIT, LOAD_NO_LIMIT};
+  if (options.threads == 0) {
+    options.threads = 1;
+  }
+
+  for (int idx = 1; idx < argc; ++idx) {
+    bool valid = idx + 1 < argc;
+
+    if (strcmp(argv[idx], "--frames") == 0) {
+      options.frames = true;
+      continue;
+    }
+    else if (valid && strcmp(argv[idx], "--threads") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.threads, 1);
+    }
+    else if (valid && strcmp(argv[idx], "--editors") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.editors, 1);
+    }
+    else if (valid && strcmp(argv[idx], "--steps") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.steps, 1);
+    }
+    else if (valid && strcmp(argv[idx], "--seed") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.seed, 1);
+    }
+    else if (valid && strcmp(argv[idx], "--max-p99-us") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.maxP99, 0);
+    }
+    else if (valid && strcmp(argv[idx], "--max-violations") == 0) {
+      valid = parseLoadValue(argv[++idx], &options.maxViolations, 0);
+    }
+    else {
+      valid = false;
+    }
+
+    if (!valid) {
+      fprintf(stderr, "usage: %s [--threads N] [--editors N] [--steps N] [--seed N] [--frames] "
+                      "[--max-p99-us N] [--max-violations N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  if (options.threads > options.editors) {
+    options.threads = options.editors;
+  }
+
+  std::vector<LoadResult> results(options.threads);
+  std::vector<std::thread> workers;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned worker = 0; worker < options.threads; ++worker) {
+    workers.emplace_back(runLoadWorker, &options, worker, &results[worker]);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+  double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  uint64_t steps = 0;
+  uint64_t violations = 0;
+  double slowest = 0;
+  LoopStats loop = {};
+
+  printf("%u editors on %u threads, %u steps each, %u hardware threads\n",
+         options.editors, options.threads, options.steps, std::thread::hardware_concurrency());
+
+  for (unsigned worker = 0; worker < options.threads; ++worker) {
+    const LoadResult &result = results[worker];
+    printf("thread %2u: %5u editors %10llu steps %8.3f s %12.0f instances/s\n", worker, result.editors,
+           (unsigned long long)result.steps, result.seconds, result.steps / result.seconds);
+
+    steps += result.steps;
+    violations += result.violations;
+    addLoopStats(&loop, &result.loop);
+    slowest = result.seconds > slowest ? result.seconds : slowest;
+  }
+
+  // Threads beyond the cores share them
+  unsigned cores = std::thread::hardware_concurrency();
+  if (cores == 0 || cores > options.threads) {
+    cores = options.threads;
+  }
+
+  printf("total: %llu steps in %.3f s (%.3f s with setup), %.0f instances/s, %.0f instances/s per core\n",
+         (unsigned long long)steps, slowest, wall, steps / slowest, steps / slowest / cores);
+  printf("violations: %llu\n", (unsigned long long)violations);
+  printLoadLatency(&loop);
+
+  bool failed = violations > 0;
+  if (options.maxP99 != LOAD_NO_LIMIT && getLoopPercentile(&loop, 99) > options.maxP99) {
+    printf("FAIL p99 over %u us\n", options.maxP99);
+    failed = true;
+  }
+  if (options.maxViolations != LOAD_NO_LIMIT && loop.violations > options.maxViolations) {
+    printf("FAIL over %u budget violations\n", options.maxViolations);
+    failed = true;
+  }
+
+  return failed ? 1 : 0;
+}
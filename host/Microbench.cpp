@@ -0,0 +1,313 @@
+/**
+ * @file Microbench.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <regex.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Bench.h"
+#include "Buffer.h"
+#include "History.h"
+
+// Maximal message lengths given by --lengths
+#define MICROBENCH_MAX_LENGTHS 16
+
+/**
+ * @brief Structure for the benchmark name of every case, the cursor
+ * index is part of the name of the indexed ones. Same names as the
+ * microbench command of tools/link.py, so device and host reports
+ * compare by name.
+ * 
+ */
+typedef struct {
+  const char *name;
+  bool indexed;
+} MicrobenchCase;
+
+const MicrobenchCase MicrobenchCases[BENCHES] = {
+  {"setBufferChar", true},
+  {"removeBufferCharOnIndex", true},
+  {"getBufferLen", false},
+  {"getKeyChar", true},
+  {"isSentenceStart", true},
+  {"getTargetCursorPos", true},
+  {"drawMessage", true},
+  {"drawHeader", false},
+};
+
+/**
+ * @brief Structure for the run options, named after the Google
+ * Benchmark flags.
+ * 
+ */
+typedef struct {
+  const char *filter;
+  double minTime;
+  unsigned repetitions;
+  const char *out;
+  uint8_t lengths[MICROBENCH_MAX_LENGTHS];
+  unsigned lengthCount;
+} MicrobenchOptions;
+
+/**
+ * @brief Structure for one benchmark of the sweep.
+ * 
+ */
+typedef struct {
+  std::string label;
+  BenchCase bench;
+  uint8_t len;
+  uint8_t index;
+  uint64_t iterations;
+  double time;
+} Microbench;
+
+/**
+ * @brief Add the benchmarks of every case over the message lengths,
+ * the cursor at the start, middle and end of the message, the written
+ * and removed char is the last one of a full message.
+ * 
+ * @param options 
+ * @param filter compiled filter or NULL
+ * @param benches 
+ */
+void addMicrobenches(const MicrobenchOptions *options, const regex_t *filter, std::vector<Microbench> *benches) {
+  for (int bench = 0; bench < BENCHES; ++bench) {
+    const MicrobenchCase *info = &MicrobenchCases[bench];
+
+    for (unsigned idx = 0; idx < options->lengthCount; ++idx) {
+      uint8_t len = options->lengths[idx];
+      std::vector<uint8_t> indexes;
+
+      if (!info->indexed) {
+        indexes = {0};
+      }
+      else if (bench == BENCH_REMOVE_CHAR) {
+        if (len > 0) {
+          indexes = {0, (uint8_t)(len / 2), (uint8_t)(len - 1)};
+        }
+      }
+      else if (bench == BENCH_SET_CHAR && len == MESSAGE_SIZE) {
+        indexes = {0, (uint8_t)(len / 2), (uint8_t)(len - 1)};
+      }
+      else {
+        indexes = {0, (uint8_t)(len / 2), len};
+      }
+
+      std::sort(indexes.begin(), indexes.end());
+      indexes.erase(std::unique(indexes.begin(), indexes.end()), indexes.end());
+
+      for (uint8_t index : indexes) {
+        char label[64];
+        if (info->indexed) {
+          snprintf(label, sizeof(label), "%s/%u/%u", info->name, len, index);
+        }
+        else {
+          snprintf(label, sizeof(label), "%s/%u", info->name, len);
+        }
+
+        if (filter == NULL || regexec(filter, label, 0, NULL, 0) == 0) {
+          benches->push_back({label, (BenchCase)bench, len, index, 0, 0});
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Run the benchmark until the runs take the minimal time, every
+ * run times the most calls runBench takes at once.
+ * 
+ * @param bench 
+ * @param minTime in s
+ * @param iterations calls done
+ * @return double time per call in ns, 0 if the case is not valid
+ */
+double runMicrobench(const Microbench *bench, double minTime, uint64_t *iterations) {
+  uint64_t time = 0;
+  *iterations = 0;
+
+  do {
+    BenchResult result = runBench(bench->bench, bench->len, bench->index, BENCH_MAX_ITERATIONS);
+    if (result.iterations == 0) {
+      return 0;
+    }
+    time += result.time;
+    *iterations += result.iterations;
+  } while (time < minTime * 1e6);
+
+  return time * 1000.0 / *iterations;
+}
+
+/**
+ * @brief Write the report in the Google Benchmark JSON format.
+ * 
+ * @param path 
+ * @param options 
+ * @param benches 
+ * @return true 
+ * @return false if the file can not be written
+ */
+bool writeMicrobenchReport(const char *path, const MicrobenchOptions *options,
+                           const std::vector<Microbench> &benches) {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    return false;
+  }
+
+  char date[32];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+  fprintf(file, "{\n \"context\": {\"date\": \"%s\", \"executable\": \"host\", \"num_cpus\": %u, "
+                "\"repetitions\": %u},\n \"benchmarks\": [\n",
+          date, std::thread::hardware_concurrency(), options->repetitions);
+
+  for (size_t idx = 0; idx < benches.size(); ++idx) {
+    const Microbench &bench = benches[idx];
+    fprintf(file, "  {\"name\": \"%s\", \"run_name\": \"%s\", \"run_type\": \"iteration\", "
+                  "\"iterations\": %llu, \"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\"}%s\n",
+            bench.label.c_str(), bench.label.c_str(), (unsigned long long)bench.iterations, bench.time,
+            bench.time, idx + 1 < benches.size() ? "," : "");
+  }
+
+  fprintf(file, " ]\n}\n");
+  return fclose(file) == 0;
+}
+
+/**
+ * @brief Parse the comma separated message lengths.
+ * 
+ * @param arg 
+ * @param options 
+ * @return true 
+ * @return false if a length is not a number up to the message size
+ */
+bool parseMicrobenchLengths(const char *arg, MicrobenchOptions *options) {
+  options->lengthCount = 0;
+
+  while (*arg != '\0' && options->lengthCount < MICROBENCH_MAX_LENGTHS) {
+    char *end;
+    unsigned long len = strtoul(arg, &end, 10);
+    if (end == arg || len > MESSAGE_SIZE || (*end != ',' && *end != '\0')) {
+      return false;
+    }
+
+    options->lengths[options->lengthCount++] = len;
+    arg = *end == ',' ? end + 1 : end;
+  }
+
+  return *arg == '\0' && options->lengthCount > 0;
+}
+
+/**
+ * @brief Get the value of the --name=value flag.
+ * 
+ * @param arg 
+ * @param name 
+ * @return const char* NULL if the arg is another flag
+ */
+const char *getMicrobenchFlag(const char *arg, const char *name) {
+  size_t len = strlen(name);
+  return strncmp(arg, name, len) == 0 && arg[len] == '=' ? arg + len + 1 : NULL;
+}
+
+/**
+ * @brief Time the buffer, keypad decoding and render primitives of
+ * Bench.h over the message lengths and cursor positions, the render
+ * draws into the framebuffer of the fuzz panel. Prints the time per
+ * call like Google Benchmark, with more repetitions the median is
+ * kept, and stores the JSON report for tools/benchcompare.py.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on a bad flag or when the report can not be written
+ */
+int main(int argc, char **argv) {
+  MicrobenchOptions options = {NULL, 0.05, 1, NULL, {0, 16, 80, MESSAGE_SIZE}, 4};
+
+  for (int idx = 1; idx < argc; ++idx) {
+    const char *value;
+    char *end = NULL;
+
+    if ((value = getMicrobenchFlag(argv[idx], "--benchmark_filter")) != NULL) {
+      options.filter = value;
+    }
+    else if ((value = getMicrobenchFlag(argv[idx], "--benchmark_min_time")) != NULL) {
+      options.minTime = strtod(value, &end);
+    }
+    else if ((value = getMicrobenchFlag(argv[idx], "--benchmark_repetitions")) != NULL) {
+      options.repetitions = strtoul(value, &end, 10);
+    }
+    else if ((value = getMicrobenchFlag(argv[idx], "--benchmark_out")) != NULL) {
+      options.out = value;
+    }
+    else if ((value = getMicrobenchFlag(argv[idx], "--lengths")) != NULL) {
+      if (!parseMicrobenchLengths(value, &options)) {
+        value = NULL;
+      }
+    }
+
+    bool valid = value != NULL && (end == NULL || (*end == '\0' && end != value));
+    if (!valid || options.minTime < 0 || options.repetitions == 0) {
+      fprintf(stderr, "usage: %s [--benchmark_filter=REGEX] [--benchmark_min_time=S] "
+                      "[--benchmark_repetitions=N] [--benchmark_out=FILE] [--lengths=N,...]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  regex_t filter;
+  if (options.filter != NULL && regcomp(&filter, options.filter, REG_EXTENDED | REG_NOSUB) != 0) {
+    fprintf(stderr, "%s: bad filter\n", options.filter);
+    return 1;
+  }
+
+  std::vector<Microbench> benches;
+  addMicrobenches(&options, options.filter != NULL ? &filter : NULL, &benches);
+  if (options.filter != NULL) {
+    regfree(&filter);
+  }
+
+  initHistory();
+
+  printf("%-36s %12s %12s\n", "Benchmark", "Time", "Iterations");
+  printf("%s\n", std::string(62, '-').c_str());
+
+  for (Microbench &bench : benches) {
+    std::vector<double> times;
+    for (unsigned run = 0; run < options.repetitions; ++run) {
+      times.push_back(runMicrobench(&bench, options.minTime, &bench.iterations));
+    }
+
+    std::sort(times.begin(), times.end());
+    bench.time = times.size() % 2 ? times[times.size() / 2]
+                                  : (times[times.size() / 2 - 1] + times[times.size() / 2]) / 2;
+
+    printf("%-36s %9.1f ns %12llu\n", bench.label.c_str(), bench.time, (unsigned long long)bench.iterations);
+  }
+
+  if (options.out != NULL && !writeMicrobenchReport(options.out, &options, benches)) {
+    fprintf(stderr, "%s: can not write\n", options.out);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file Pipeline.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <atomic>
+
+#include "Display.h"
+#include "Editor.h"
+#include "History.h"
+#include "Keypad.h"
+#include "Panel.h"
+#include "Render.h"
+
+// Keys typed before the same count is deleted again
+#define PIPELINE_TYPED_KEYS 24
+
+/**
+ * @brief Structure for the benchmark options.
+ * 
+ */
+typedef struct {
+  unsigned duration;
+  unsigned rowTime;
+  unsigned burst;
+} PipelineOptions;
+
+/**
+ * @brief Structure for the result of one run.
+ * 
+ */
+typedef struct {
+  uint64_t keys;
+  double seconds;
+  FrameStats frames;
+  RenderStats render;
+} PipelineResult;
+
+// Editor driven by the input step, drawing to the device panel
+Editor PipelineEditor;
+
+// Keys pressed at one input step
+unsigned pipelineBurst = 1;
+
+// Keys handled by the input step, read after the run
+std::atomic<uint64_t> pipelineKeys(0);
+
+/**
+ * @brief Get the next key, digits typing a letter each, then as many
+ * deletes.
+ * 
+ * @param count keys pressed before
+ * @return Key 
+ */
+Key getPipelineKey(uint64_t count) {
+  uint64_t idx = count % (2 * PIPELINE_TYPED_KEYS);
+  return idx < PIPELINE_TYPED_KEYS ? (Key)(KEY_2 + idx % 8) : KEY_H;
+}
+
+/**
+ * @brief Input step of the benchmark, press the keys of one burst on
+ * the editor instead of the keypad scan.
+ * 
+ * @return uint32_t always 0, the next step is due at once
+ */
+uint32_t runPipelineStep() {
+  setEditorTime(&PipelineEditor, millis());
+
+  uint64_t keys = pipelineKeys.load(std::memory_order_relaxed);
+  for (unsigned idx = 0; idx < pipelineBurst; ++idx) {
+    handlePress(&PipelineEditor, getPipelineKey(keys++));
+  }
+  pipelineKeys.store(keys, std::memory_order_relaxed);
+
+  return 0;
+}
+
+/**
+ * @brief Flush hook of the single task run, the input waits for the
+ * panel like the device without the render task.
+ * 
+ * @param editor 
+ */
+void flushPipelineInline(Editor *editor) {
+  uint32_t startTime = micros();
+  editor->display->display();
+  recordFlush(micros() - startTime);
+}
+
+/**
+ * @brief Reset the editor and panel with the flush hook and draw the
+ * header.
+ * 
+ * @param flush 
+ */
+void resetPipelineEditor(EditorFlush flush) {
+  initEditor(&PipelineEditor, &Display, flush);
+  resetDisplay(&PipelineEditor);
+  drawHeader(&PipelineEditor);
+}
+
+/**
+ * @brief Get the frame statistics since the start ones.
+ * 
+ * @param start 
+ * @return FrameStats 
+ */
+FrameStats getPipelineFrames(FrameStats start) {
+  FrameStats stats = getFrameStats();
+  stats.flushes -= start.flushes;
+  stats.flushTime -= start.flushTime;
+  return stats;
+}
+
+/**
+ * @brief Run the input steps and the flushes in the calling thread for
+ * the duration, paced like the input task.
+ * 
+ * @param options 
+ * @param result 
+ */
+void runPipelineInline(const PipelineOptions *options, PipelineResult *result) {
+  resetPipelineEditor(flushPipelineInline);
+  pipelineKeys = 0;
+
+  FrameStats frames = getFrameStats();
+  unsigned long startTime = millis();
+
+  while (millis() - startTime < options->duration) {
+    uint32_t idle = runPipelineStep();
+    delay(idle == 0 ? 1 : idle);
+  }
+
+  result->seconds = (millis() - startTime) / 1000.0;
+  result->keys = pipelineKeys;
+  result->frames = getPipelineFrames(frames);
+  result->render = {0, 0};
+}
+
+/**
+ * @brief Run the input task and render task on their threads for the
+ * duration, the input publishes frames to the render task.
+ * 
+ * @param options 
+ * @param result 
+ */
+void runPipelineSplit(const PipelineOptions *options, PipelineResult *result) {
+  resetPipelineEditor(flushDevice);
+  pipelineKeys = 0;
+  initRender();
+
+  FrameStats frames = getFrameStats();
+  unsigned long startTime = millis();
+
+  startTasks(runPipelineStep);
+  delay(options->duration);
+  stopHostTasks();
+
+  result->seconds = (millis() - startTime) / 1000.0;
+  result->keys = pipelineKeys;
+  result->frames = getPipelineFrames(frames);
+  result->render = getRenderStats();
+}
+
+/**
+ * @brief Print the result of the run.
+ * 
+ * @param name 
+ * @param result 
+ */
+void printPipelineResult(const char *name, const PipelineResult *result) {
+  printf("%-7s %10llu keys %10.0f keys/s %8u flushes %6.1f %% render busy",
+         name, (unsigned long long)result->keys, result->keys / result->seconds, result->frames.flushes,
+         result->frames.flushTime / (result->seconds * 10000.0));
+  if (result->render.published > 0) {
+    printf(" %8u published %8u coalesced", result->render.published, result->render.coalesced);
+  }
+  printf("\n");
+}
+
+/**
+ * @brief Parse the unsigned option value.
+ * 
+ * @param arg 
+ * @param value 
+ * @return true 
+ * @return false if the value is not a number
+ */
+bool parsePipelineValue(const char *arg, unsigned *value) {
+  char *end;
+  unsigned long parsed = strtoul(arg, &end, 0);
+
+  if (*arg == '\0' || *end != '\0' || parsed > UINT32_MAX) {
+    return false;
+  }
+
+  *value = parsed;
+  return true;
+}
+
+/**
+ * @brief Measure the keystroke throughput of the input while the
+ * panel flush saturates the render, first with the flush in the input
+ * task, then with the input task and render task split over two
+ * threads like the two cores of the device.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on a bad option or when the split run handles fewer
+ * keys than the single task one
+ */
+int main(int argc, char **argv) {
+  PipelineOptions options = {2000, 100, 1};
+
+  for (int idx = 1; idx < argc; ++idx) {
+    bool valid = idx + 1 < argc;
+
+    if (valid && strcmp(argv[idx], "--ms") == 0) {
+      valid = parsePipelineValue(argv[++idx], &options.duration) && options.duration > 0;
+    }
+    else if (valid && strcmp(argv[idx], "--row-us") == 0) {
+      valid = parsePipelineValue(argv[++idx], &options.rowTime);
+    }
+    else if (valid && strcmp(argv[idx], "--burst") == 0) {
+      valid = parsePipelineValue(argv[++idx], &options.burst) && options.burst > 0;
+    }
+    else {
+      valid = false;
+    }
+
+    if (!valid) {
+      fprintf(stderr, "usage: %s [--ms N] [--row-us N] [--burst N]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  initHistory();
+  setHostRowTime(options.rowTime);
+  pipelineBurst = options.burst;
+
+  printf("%u ms per run, %u us per panel row (%u us per frame), %u keys per step\n", options.duration,
+         options.rowTime, options.rowTime * DisplayPanel::HEIGHT, options.burst);
+
+  PipelineResult inlineResult;
+  runPipelineInline(&options, &inlineResult);
+  printPipelineResult("single", &inlineResult);
+
+  PipelineResult splitResult;
+  runPipelineSplit(&options, &splitResult);
+  printPipelineResult("split", &splitResult);
+
+  double speedup = (splitResult.keys / splitResult.seconds) / (inlineResult.keys / inlineResult.seconds);
+  printf("speedup: %.2fx\n", speedup);
+
+  return speedup >= 1.0 ? 0 : 1;
+}
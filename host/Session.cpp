@@ -0,0 +1,383 @@
+/**
+ * @file Session.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "CodePage.h"
+#include "Display.h"
+#include "Editor.h"
+#include "History.h"
+#include "Keypad.h"
+
+// Keys of the script in Key order, same as tools/link.py
+const char SessionKeys[] = "0123456789*#";
+
+// Longest script line
+#define SESSION_LINE_SIZE 512
+
+/**
+ * @brief Structure for the session run options, named like the
+ * session command of tools/link.py.
+ * 
+ */
+typedef struct {
+  const char *script;
+  const char *golden;
+  const char *out;
+  bool record;
+  uint32_t budget;
+} SessionOptions;
+
+/**
+ * @brief Structure for the render work since the last snapshot.
+ * 
+ */
+typedef struct {
+  uint32_t renderTime;
+  uint32_t flushes;
+  uint32_t flushTime;
+} SessionWork;
+
+// Frame of the session, one pixel per byte, rows from the top
+typedef std::vector<uint8_t> SessionFrame;
+
+/**
+ * @brief Flush hook of the session editor, the flush runs in the step
+ * like the device without the render task.
+ * 
+ * @param editor 
+ */
+void flushSession(Editor *editor) {
+  uint32_t startTime = micros();
+  editor->display->display();
+  recordFlush(micros() - startTime);
+}
+
+/**
+ * @brief Let the editor time pass like the idle device loop, the time
+ * jumps from one timer deadline to the next.
+ * 
+ * @param editor 
+ * @param ms 
+ */
+void waitSession(Editor *editor, uint32_t ms) {
+  uint64_t end = editor->now + ms;
+
+  while (editor->now < end) {
+    uint32_t idle = getEditorIdle(editor, editor->now);
+    uint64_t next = editor->now + (idle == 0 ? 1 : idle);
+    setEditorTime(editor, next < end ? next : end);
+  }
+}
+
+/**
+ * @brief Read the panel pixels as the panel shows them, unrotated.
+ * 
+ * @param editor 
+ * @return SessionFrame 
+ */
+SessionFrame readSessionFrame(Editor *editor) {
+  SessionFrame frame(DisplayPanel::WIDTH * DisplayPanel::HEIGHT);
+
+  for (int16_t y = 0; y < DisplayPanel::HEIGHT; ++y) {
+    for (int16_t x = 0; x < DisplayPanel::WIDTH; ++x) {
+      frame[y * DisplayPanel::WIDTH + x] = editor->display->getPixel(x, y) != COLOR_BLACK;
+    }
+  }
+
+  return frame;
+}
+
+/**
+ * @brief Write the frame as binary PBM, same as write_pbm of
+ * tools/frames.py.
+ * 
+ * @param path 
+ * @param frame 
+ * @return true 
+ * @return false if the file can not be written
+ */
+bool writeSessionFrame(const std::string &path, const SessionFrame &frame) {
+  FILE *file = fopen(path.c_str(), "wb");
+  if (file == NULL) {
+    return false;
+  }
+
+  fprintf(file, "P4\n%d %d\n", DisplayPanel::WIDTH, DisplayPanel::HEIGHT);
+  for (int16_t y = 0; y < DisplayPanel::HEIGHT; ++y) {
+    for (int16_t x = 0; x < DisplayPanel::WIDTH; x += 8) {
+      uint8_t byte = 0;
+      for (int16_t bit = 0; bit < 8 && x + bit < DisplayPanel::WIDTH; ++bit) {
+        if (frame[y * DisplayPanel::WIDTH + x + bit]) {
+          byte |= 0x80 >> bit;
+        }
+      }
+      fputc(byte, file);
+    }
+  }
+
+  return fclose(file) == 0;
+}
+
+/**
+ * @brief Read the binary PBM of the panel size.
+ * 
+ * @param path 
+ * @param frame 
+ * @return true 
+ * @return false if the file is missing or not a PBM of the panel size
+ */
+bool readSessionFrame(const std::string &path, SessionFrame *frame) {
+  FILE *file = fopen(path.c_str(), "rb");
+  if (file == NULL) {
+    return false;
+  }
+
+  int width = 0;
+  int height = 0;
+  bool valid = fscanf(file, "P4 %d %d", &width, &height) == 2 && fgetc(file) != EOF &&
+               width == DisplayPanel::WIDTH && height == DisplayPanel::HEIGHT;
+
+  frame->assign(DisplayPanel::WIDTH * DisplayPanel::HEIGHT, 0);
+  for (int16_t y = 0; valid && y < DisplayPanel::HEIGHT; ++y) {
+    for (int16_t x = 0; valid && x < DisplayPanel::WIDTH; x += 8) {
+      int byte = fgetc(file);
+      valid = byte != EOF;
+      for (int16_t bit = 0; valid && bit < 8 && x + bit < DisplayPanel::WIDTH; ++bit) {
+        (*frame)[y * DisplayPanel::WIDTH + x + bit] = (byte >> (7 - bit)) & 1;
+      }
+    }
+  }
+
+  fclose(file);
+  return valid;
+}
+
+/**
+ * @brief Count the pixels the frames differ in.
+ * 
+ * @param a 
+ * @param b 
+ * @return uint32_t 
+ */
+uint32_t diffSessionFrames(const SessionFrame &a, const SessionFrame &b) {
+  uint32_t count = 0;
+
+  for (size_t idx = 0; idx < a.size() && idx < b.size(); ++idx) {
+    count += a[idx] != b[idx];
+  }
+
+  return count;
+}
+
+/**
+ * @brief Get the key of the script key char.
+ * 
+ * @param arg 
+ * @return Key KEY_NONE if the char is not a key
+ */
+Key getSessionKey(const char *arg) {
+  const char *pos = strchr(SessionKeys, arg[0]);
+  return arg[0] != '\0' && arg[1] == '\0' && pos != NULL ? (Key)(pos - SessionKeys) : KEY_NONE;
+}
+
+/**
+ * @brief Run the session script on a fresh editor like the device runs
+ * the frames of tools/link.py session, with the time of the waits
+ * passing on the editor clock. Every snapshot is compared with its
+ * golden frame, recorded or written out, and the render time, flushes,
+ * flush time and pixels changed since the last snapshot are printed.
+ * 
+ * @param options 
+ * @return int number of failed snapshots, -1 on a bad script
+ */
+int runSession(const SessionOptions *options) {
+  FILE *script = fopen(options->script, "r");
+  if (script == NULL) {
+    fprintf(stderr, "%s: can not read\n", options->script);
+    return -1;
+  }
+
+  static Editor editor;
+  static DisplayPanel panel;
+  initEditor(&editor, &panel, flushSession);
+  initDisplay(&editor);
+  initHistory();
+  drawHeader(&editor);
+
+  SessionWork work = {0, 0, 0};
+  SessionFrame previous;
+  int failed = 0;
+  char line[SESSION_LINE_SIZE];
+
+  printf("%-16s %10s %8s %10s %8s %8s\n", "frame", "render us", "flushes", "flush us", "changed", "diff");
+
+  for (unsigned number = 1; fgets(line, sizeof(line), script) != NULL; ++number) {
+    line[strcspn(line, "\r\n")] = '\0';
+
+    char *step = line + strspn(line, " \t");
+    if (*step == '\0' || *step == '#') {
+      continue;
+    }
+
+    size_t stepLen = strcspn(step, " \t");
+    char *arg = step + stepLen;
+    if (*arg != '\0') {
+      *arg++ = '\0';
+    }
+    // The text keeps its spaces, other args are trimmed
+    if (strcmp(step, "text") != 0) {
+      arg += strspn(arg, " \t");
+      arg[strcspn(arg, " \t")] = '\0';
+    }
+
+    if (strcmp(step, "wait") == 0) {
+      waitSession(&editor, strtoul(arg, NULL, 10));
+      continue;
+    }
+
+    touchEditor(&editor);
+    FrameStats before = getFrameStats();
+    uint32_t startTime = micros();
+
+    Key key = getSessionKey(arg);
+    if (strcmp(step, "press") == 0 && key != KEY_NONE) {
+      handlePress(&editor, key);
+    }
+    else if (strcmp(step, "hold") == 0 && key != KEY_NONE) {
+      handleLongPress(&editor, key, editor.now);
+    }
+    else if (strcmp(step, "release") == 0 && key != KEY_NONE) {
+      handleLongRelease(&editor, key, editor.now);
+    }
+    else if (strcmp(step, "text") == 0) {
+      char text[SESSION_LINE_SIZE];
+      size_t len = decodeUtf8((const uint8_t *)arg, strlen(arg), text, sizeof(text));
+      handleText(&editor, text, len > UINT8_MAX ? UINT8_MAX : len, false, editor.now);
+      drawHeader(&editor);
+    }
+    else if (strcmp(step, "clear") == 0) {
+      clearMessage(&editor);
+      refreshMessage(&editor, editor.now);
+      drawHeader(&editor);
+    }
+    else if (strcmp(step, "snap") == 0 && *arg != '\0') {
+      snapshotDisplay(&editor);
+      SessionFrame frame = readSessionFrame(&editor);
+
+      uint32_t changed = previous.empty() ? 0 : diffSessionFrames(previous, frame);
+      std::string status = "-";
+
+      if (options->record) {
+        std::string path = std::string(options->golden) + "/" + arg + ".pbm";
+        if (!writeSessionFrame(path, frame)) {
+          fprintf(stderr, "%s: can not write\n", path.c_str());
+          fclose(script);
+          return -1;
+        }
+        status = "recorded";
+      }
+      else if (options->golden != NULL) {
+        SessionFrame golden;
+        if (readSessionFrame(std::string(options->golden) + "/" + arg + ".pbm", &golden)) {
+          uint32_t count = diffSessionFrames(golden, frame);
+          status = count == 0 ? "ok" : std::to_string(count) + " px";
+          failed += count != 0;
+        }
+      }
+
+      if (options->out != NULL) {
+        writeSessionFrame(std::string(options->out) + "/" + arg + ".pbm", frame);
+      }
+      if (options->budget > 0 && work.renderTime > options->budget) {
+        status += " slow";
+        failed++;
+      }
+
+      printf("%-16s %10u %8u %10u %8u %8s\n", arg, work.renderTime, work.flushes, work.flushTime, changed,
+             status.c_str());
+      previous = frame;
+      work = {0, 0, 0};
+      continue;
+    }
+    else {
+      fprintf(stderr, "%s:%u: unknown step '%s'\n", options->script, number, step);
+      fclose(script);
+      return -1;
+    }
+
+    FrameStats after = getFrameStats();
+    work.renderTime += micros() - startTime;
+    work.flushes += after.flushes - before.flushes;
+    work.flushTime += after.flushTime - before.flushTime;
+  }
+
+  fclose(script);
+  return failed;
+}
+
+/**
+ * @brief Replay the session script headless on the host panel and
+ * compare its snapshots with the golden frames.
+ * 
+ * @param argc 
+ * @param argv 
+ * @return int 1 on a bad option or script or when a snapshot differs
+ * from its golden frame or takes over the render budget
+ */
+int main(int argc, char **argv) {
+  SessionOptions options = {NULL, NULL, NULL, false, 0};
+
+  for (int idx = 1; idx < argc; ++idx) {
+    bool valid = idx + 1 < argc;
+
+    if (strcmp(argv[idx], "--record") == 0) {
+      options.record = true;
+      continue;
+    }
+    else if (valid && strcmp(argv[idx], "--golden") == 0) {
+      options.golden = argv[++idx];
+    }
+    else if (valid && strcmp(argv[idx], "--out") == 0) {
+      options.out = argv[++idx];
+    }
+    else if (valid && strcmp(argv[idx], "--budget-us") == 0) {
+      options.budget = strtoul(argv[++idx], NULL, 10);
+    }
+    else if (argv[idx][0] != '-' && options.script == NULL) {
+      options.script = argv[idx];
+      continue;
+    }
+    else {
+      valid = false;
+    }
+
+    if (!valid) {
+      options.script = NULL;
+      break;
+    }
+  }
+
+  if (options.script == NULL || (options.record && options.golden == NULL)) {
+    fprintf(stderr, "usage: %s SCRIPT [--golden DIR] [--record] [--out DIR] [--budget-us N]\n", argv[0]);
+    return 1;
+  }
+
+  return runSession(&options) == 0 ? 0 : 1;
+}
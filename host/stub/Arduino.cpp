@@ -0,0 +1,215 @@
+/**
+ * @file Arduino.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+/**
+ * @brief Structure for a task thread with its notification count.
+ * 
+ */
+struct HostTask {
+  std::thread thread;
+  std::mutex lock;
+  std::condition_variable wake;
+  uint32_t notified = 0;
+};
+
+/**
+ * @brief Thrown out of the delay and notification wait to end the
+ * task loop on stopHostTasks.
+ * 
+ */
+struct HostTaskStop {
+};
+
+// Start of the host time
+const std::chrono::steady_clock::time_point HostStart = std::chrono::steady_clock::now();
+
+// Running tasks, the task of the calling thread and the stop request
+std::list<HostTask> HostTasks;
+std::mutex hostTasksLock;
+thread_local HostTask *currentTask = NULL;
+std::atomic<bool> hostTasksStopping(false);
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+unsigned long millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - HostStart).count();
+}
+
+unsigned long micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - HostStart).count();
+}
+
+void delay(unsigned long ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(unsigned int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void pinMode(uint8_t /*pin*/, uint8_t /*mode*/) {
+}
+
+void digitalWrite(uint8_t /*pin*/, uint8_t /*value*/) {
+}
+
+int digitalRead(uint8_t /*pin*/) {
+  return HIGH;
+}
+
+void HardwareSerial::begin(unsigned long /*baud*/) {
+}
+
+size_t HardwareSerial::setRxBufferSize(size_t size) {
+  return size;
+}
+
+int HardwareSerial::available() {
+  return 0;
+}
+
+int HardwareSerial::read() {
+  return -1;
+}
+
+size_t HardwareSerial::write(uint8_t /*value*/) {
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t * /*data*/, size_t len) {
+  return len;
+}
+
+void HardwareSerial::flush() {
+}
+
+void SPIClass::begin(int8_t /*sck*/, int8_t /*miso*/, int8_t /*mosi*/, int8_t /*ss*/) {
+}
+
+void SPIClass::beginTransaction(SPISettings /*settings*/) {
+}
+
+void SPIClass::writeBytes(const uint8_t * /*data*/, uint32_t /*len*/) {
+}
+
+void SPIClass::endTransaction() {
+}
+
+/**
+ * @brief Leave the task loop when the tasks are stopping.
+ * 
+ * @param task 
+ */
+void checkTaskStop(HostTask *task) {
+  if (task != NULL && hostTasksStopping) {
+    throw HostTaskStop();
+  }
+}
+
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char * /*name*/, uint32_t /*stackSize*/,
+                                   void *arg, UBaseType_t /*priority*/, TaskHandle_t *handle,
+                                   BaseType_t /*core*/) {
+  std::lock_guard<std::mutex> guard(hostTasksLock);
+  HostTask *hostTask = &HostTasks.emplace_back();
+
+  if (handle != NULL) {
+    *handle = hostTask;
+  }
+
+  hostTask->thread = std::thread([hostTask, task, arg]() {
+    currentTask = hostTask;
+    try {
+      task(arg);
+    }
+    catch (HostTaskStop &) {
+    }
+  });
+  return pdPASS;
+}
+
+void vTaskDelay(TickType_t ticks) {
+  HostTask *task = currentTask;
+  checkTaskStop(task);
+
+  if (task == NULL) {
+    delay(ticks);
+    return;
+  }
+
+  std::unique_lock<std::mutex> guard(task->lock);
+  task->wake.wait_for(guard, std::chrono::milliseconds(ticks), []() { return hostTasksStopping.load(); });
+  guard.unlock();
+  checkTaskStop(task);
+}
+
+void xTaskNotifyGive(TaskHandle_t handle) {
+  HostTask *task = (HostTask *)handle;
+  {
+    std::lock_guard<std::mutex> guard(task->lock);
+    task->notified++;
+  }
+  task->wake.notify_one();
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  HostTask *task = currentTask;
+  checkTaskStop(task);
+
+  std::unique_lock<std::mutex> guard(task->lock);
+  auto ready = [task]() { return task->notified > 0 || hostTasksStopping; };
+  if (ticks == portMAX_DELAY) {
+    task->wake.wait(guard, ready);
+  }
+  else {
+    task->wake.wait_for(guard, std::chrono::milliseconds(ticks), ready);
+  }
+  guard.unlock();
+  checkTaskStop(task);
+
+  guard.lock();
+  uint32_t count = task->notified;
+  if (count > 0) {
+    task->notified = clear ? 0 : count - 1;
+  }
+  return count;
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t /*task*/) {
+  return 0;
+}
+
+void stopHostTasks() {
+  std::lock_guard<std::mutex> guard(hostTasksLock);
+  hostTasksStopping = true;
+
+  // The task lock orders the stop with a waiting task
+  for (HostTask &task : HostTasks) {
+    {
+      std::lock_guard<std::mutex> taskGuard(task.lock);
+    }
+    task.wake.notify_all();
+    task.thread.join();
+  }
+
+  HostTasks.clear();
+  hostTasksStopping = false;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file Arduino.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+// Host stand-in for the Arduino core and the FreeRTOS task calls used
+// by the sketch
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define IRAM_ATTR
+
+/**
+ * @brief Get the time since start in ms.
+ * 
+ * @return unsigned long 
+ */
+unsigned long millis();
+
+/**
+ * @brief Get the time since start in us.
+ * 
+ * @return unsigned long 
+ */
+unsigned long micros();
+
+/**
+ * @brief Sleep the calling thread.
+ * 
+ * @param ms 
+ */
+void delay(unsigned long ms);
+
+/**
+ * @brief Sleep the calling thread, the task threads stand for cores of
+ * their own, so the wait does not take a host core.
+ * 
+ * @param us 
+ */
+void delayMicroseconds(unsigned int us);
+
+/**
+ * @brief Pin mode is ignored on the host.
+ * 
+ * @param pin 
+ * @param mode 
+ */
+void pinMode(uint8_t pin, uint8_t mode);
+
+/**
+ * @brief Pin writes are ignored on the host.
+ * 
+ * @param pin 
+ * @param value 
+ */
+void digitalWrite(uint8_t pin, uint8_t value);
+
+/**
+ * @brief Every pin reads high, the keypad sees no pressed key.
+ * 
+ * @param pin 
+ * @return int 
+ */
+int digitalRead(uint8_t pin);
+
+/**
+ * @brief Serial port without a peer, nothing is ever received and
+ * written bytes are dropped.
+ * 
+ */
+class HardwareSerial {
+public:
+  void begin(unsigned long baud);
+  size_t setRxBufferSize(size_t size);
+  int available();
+  int read();
+  size_t write(uint8_t value);
+  size_t write(const uint8_t *data, size_t len);
+  void flush();
+};
+
+extern HardwareSerial Serial;
+
+// FreeRTOS types and constants, a tick is 1 ms
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdPASS 1
+#define portMAX_DELAY 0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+/**
+ * @brief Run the task function on its own thread, the core is
+ * ignored and the stack size is not enforced.
+ * 
+ * @param task 
+ * @param name 
+ * @param stackSize 
+ * @param arg 
+ * @param priority 
+ * @param handle 
+ * @param core 
+ * @return BaseType_t 
+ */
+BaseType_t xTaskCreatePinnedToCore(void (*task)(void *), const char *name, uint32_t stackSize,
+                                   void *arg, UBaseType_t priority, TaskHandle_t *handle,
+                                   BaseType_t core);
+
+/**
+ * @brief Sleep the calling task for the ticks.
+ * 
+ * @param ticks 
+ */
+void vTaskDelay(TickType_t ticks);
+
+/**
+ * @brief Give the notification to the task.
+ * 
+ * @param task 
+ */
+void xTaskNotifyGive(TaskHandle_t task);
+
+/**
+ * @brief Wait for a notification of the calling task.
+ * 
+ * @param clear take all given notifications at once
+ * @param ticks 
+ * @return uint32_t notification count before the take
+ */
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+
+/**
+ * @brief The host has no stack high water mark.
+ * 
+ * @param task 
+ * @return UBaseType_t always 0
+ */
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task);
+
+/**
+ * @brief Stop all tasks at their next delay or notification wait and
+ * join their threads, host only.
+ * 
+ */
+void stopHostTasks();
+
+#endif
@@ -0,0 +1,142 @@
+/**
+ * @file Esp.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include <esp_partition.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/gpio.h>
+#include <driver/uart.h>
+
+#include <mutex>
+
+// Phonebook partition of partitions.csv and its flash content
+const esp_partition_t HostPartition = {
+  ESP_PARTITION_TYPE_DATA, (esp_partition_subtype_t)0x40, 0x300000, 0xF0000, 4096, "phonebook"
+};
+uint8_t HostFlash[0xF0000];
+std::once_flag hostFlashErased;
+
+size_t heap_caps_get_free_size(uint32_t /*caps*/) {
+  return 0;
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t /*caps*/) {
+  return 0;
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t /*caps*/) {
+  return 0;
+}
+
+int64_t esp_timer_get_time() {
+  return micros();
+}
+
+esp_err_t esp_sleep_enable_gpio_wakeup() {
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_uart_wakeup(uart_port_t /*port*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_enable_timer_wakeup(uint64_t /*time*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_sleep_disable_wakeup_source(esp_sleep_source_t /*source*/) {
+  return ESP_OK;
+}
+
+esp_err_t esp_light_sleep_start() {
+  return ESP_OK;
+}
+
+esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause() {
+  return ESP_SLEEP_WAKEUP_TIMER;
+}
+
+esp_err_t gpio_wakeup_enable(gpio_num_t /*pin*/, gpio_int_type_t /*type*/) {
+  return ESP_OK;
+}
+
+esp_err_t gpio_wakeup_disable(gpio_num_t /*pin*/) {
+  return ESP_OK;
+}
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t /*port*/, int /*edges*/) {
+  return ESP_OK;
+}
+
+/**
+ * @brief Check the range lies inside the partition.
+ * 
+ * @param partition 
+ * @param offset 
+ * @param size 
+ * @return true 
+ * @return false 
+ */
+bool isPartitionRange(const esp_partition_t *partition, size_t offset, size_t size) {
+  return partition == &HostPartition && offset <= partition->size && size <= partition->size - offset;
+}
+
+const esp_partition_t *esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype,
+                                                const char *label) {
+  if ((type != ESP_PARTITION_TYPE_ANY && type != HostPartition.type) ||
+      (subtype != ESP_PARTITION_SUBTYPE_ANY && subtype != HostPartition.subtype) ||
+      (label != NULL && strcmp(label, HostPartition.label) != 0)) {
+    return NULL;
+  }
+
+  std::call_once(hostFlashErased, []() { memset(HostFlash, 0xFF, sizeof(HostFlash)); });
+  return &HostPartition;
+}
+
+esp_err_t esp_partition_mmap(const esp_partition_t *partition, size_t offset, size_t size,
+                             esp_partition_mmap_memory_t /*memory*/, const void **data,
+                             esp_partition_mmap_handle_t *handle) {
+  if (!isPartitionRange(partition, offset, size)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  *data = HostFlash + offset;
+  *handle = 1;
+  return ESP_OK;
+}
+
+void esp_partition_munmap(esp_partition_mmap_handle_t /*handle*/) {
+}
+
+esp_err_t esp_partition_erase_range(const esp_partition_t *partition, size_t offset, size_t size) {
+  if (!isPartitionRange(partition, offset, size) || offset % partition->erase_size != 0 ||
+      size % partition->erase_size != 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  memset(HostFlash + offset, 0xFF, size);
+  return ESP_OK;
+}
+
+esp_err_t esp_partition_write(const esp_partition_t *partition, size_t offset, const void *data, size_t size) {
+  if (!isPartitionRange(partition, offset, size)) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  // Flash writes only clear bits
+  const uint8_t *bytes = (const uint8_t *)data;
+  for (size_t idx = 0; idx < size; ++idx) {
+    HostFlash[offset + idx] &= bytes[idx];
+  }
+  return ESP_OK;
+}
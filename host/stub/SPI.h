@@ -0,0 +1,48 @@
+/**
+ * @file SPI.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include <stdint.h>
+
+#define MSBFIRST 1
+#define SPI_MODE0 0
+
+/**
+ * @brief Structure for the SPI transaction clock, bit order and mode.
+ * 
+ */
+struct SPISettings {
+  uint32_t clock;
+  uint8_t bitOrder;
+  uint8_t dataMode;
+
+  SPISettings(uint32_t clock = 1000000, uint8_t bitOrder = MSBFIRST, uint8_t dataMode = SPI_MODE0)
+    : clock(clock), bitOrder(bitOrder), dataMode(dataMode) {
+  }
+};
+
+/**
+ * @brief SPI bus without a device, written bytes are dropped.
+ * 
+ */
+class SPIClass {
+public:
+  void begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss);
+  void beginTransaction(SPISettings settings);
+  void writeBytes(const uint8_t *data, uint32_t len);
+  void endTransaction();
+};
+
+extern SPIClass SPI;
+
+#endif
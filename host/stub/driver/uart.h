@@ -0,0 +1,23 @@
+/**
+ * @file uart.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef DRIVER_UART_H
+#define DRIVER_UART_H
+
+#include "esp_err.h"
+
+typedef int uart_port_t;
+
+#define UART_NUM_0 0
+
+esp_err_t uart_set_wakeup_threshold(uart_port_t port, int edges);
+
+#endif
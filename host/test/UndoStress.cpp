@@ -0,0 +1,456 @@
+/**
+ * @file UndoStress.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "Undo.h"
+#include "Buffer.h"
+#include "Editor.h"
+#include "Layout.h"
+
+// Random operations of the stress run
+#define STRESS_OPS 100000
+
+// Chars written and inserted by the run, words, separators and
+// sentence ends
+const char StressChars[] = "abcdefghijklmnopqrstuvwxyz    ..?!,'";
+
+/**
+ * @brief Structure for one edit group of the reference model, the
+ * text and cursor before it, the text after it, its payload bytes in
+ * the undo arena and where redo leaves the cursor.
+ * 
+ */
+typedef struct {
+  OpType type;
+  uint8_t index;
+  uint8_t len;
+  std::string before;
+  uint8_t beforeCursor;
+  std::string after;
+  size_t bytes;
+} ModelGroup;
+
+/**
+ * @brief Structure for the reference model of the undo log, applied
+ * groups are undone from the back and undone groups are redone from
+ * the back, the last group stays open for a multitap cycle or a
+ * delete burst until sealed.
+ * 
+ */
+typedef struct {
+  std::string text;
+  uint8_t cursor;
+  std::vector<ModelGroup> applied;
+  std::vector<ModelGroup> undone;
+  bool sealed;
+  uint64_t lastDeleteTime;
+} UndoModel;
+
+// Editor under test, only the buffer and undo log parts are used
+Editor StressEditor;
+
+/**
+ * @brief Get the next xorshift random value.
+ * 
+ * @param state 
+ * @return uint32_t 
+ */
+uint32_t nextStressRandom(uint32_t *state) {
+  uint32_t value = *state;
+  value ^= value << 13;
+  value ^= value >> 17;
+  value ^= value << 5;
+  *state = value;
+  return value;
+}
+
+/**
+ * @brief Get the arena bytes of the applied groups.
+ * 
+ * @param model 
+ * @return size_t 
+ */
+size_t getModelBytes(const UndoModel *model) {
+  size_t bytes = 0;
+  for (const ModelGroup &group : model->applied) {
+    bytes += group.bytes;
+  }
+  return bytes;
+}
+
+/**
+ * @brief Drop the oldest groups until the arena fits the size more
+ * bytes, the newest group is kept.
+ * 
+ * @param model 
+ * @param size 
+ */
+void reserveModel(UndoModel *model, size_t size) {
+  while (getModelBytes(model) + size > UNDO_ARENA_SIZE && model->applied.size() > 1) {
+    model->applied.erase(model->applied.begin());
+  }
+}
+
+/**
+ * @brief Start a new group, the redo groups are dropped and the oldest
+ * group goes when the log is full.
+ * 
+ * @param model 
+ * @param type 
+ * @param index 
+ * @param len 
+ * @param bytes 
+ * @param cursor 
+ */
+void pushModelGroup(UndoModel *model, OpType type, uint8_t index, uint8_t len, size_t bytes, uint8_t cursor) {
+  reserveModel(model, bytes);
+  if (model->applied.size() == UNDO_MAX_OPS) {
+    model->applied.erase(model->applied.begin());
+  }
+
+  model->applied.push_back({type, index, len, model->text, cursor, "", bytes});
+  model->sealed = false;
+}
+
+/**
+ * @brief Write the char on the cursor like a typed key, a multitap
+ * cycle replaces the char before the cursor and stays in the group of
+ * its first write.
+ * 
+ * @param model 
+ * @param ch 
+ * @param isCycle 
+ */
+void writeStressChar(UndoModel *model, char ch, bool isCycle) {
+  Editor *editor = &StressEditor;
+
+  if (isCycle) {
+    editor->bufferIndex--;
+    model->cursor--;
+  }
+  else if (model->text.size() == MESSAGE_SIZE) {
+    return;
+  }
+
+  ModelGroup *open = !model->sealed && !model->applied.empty() ? &model->applied.back() : NULL;
+  bool merged = isCycle && open != NULL && open->type == OP_WRITE && open->index == model->cursor;
+
+  model->undone.clear();
+  if (!merged) {
+    pushModelGroup(model, OP_WRITE, model->cursor, 1, 2, model->cursor);
+  }
+
+  recordWrite(editor, editor->bufferIndex, ch, isCycle);
+  setBufferChar(editor, ch);
+  editor->bufferIndex++;
+
+  if (model->cursor == model->text.size()) {
+    model->text.push_back(ch);
+  }
+  else {
+    model->text[model->cursor] = ch;
+  }
+  model->cursor++;
+}
+
+/**
+ * @brief Insert the text on the cursor in one operation.
+ * 
+ * @param model 
+ * @param text 
+ * @param len 
+ */
+void insertStressText(UndoModel *model, const char *text, uint8_t len) {
+  Editor *editor = &StressEditor;
+  uint8_t inserted = insertBufferString(editor, editor->bufferIndex, text, len);
+
+  size_t free = MESSAGE_SIZE - model->text.size();
+  uint8_t expected = len < free ? len : free;
+  if (inserted != expected) {
+    printf("insert of %u chars inserted %u, expected %u\n", len, inserted, expected);
+    exit(1);
+  }
+
+  if (inserted == 0) {
+    return;
+  }
+
+  model->undone.clear();
+  pushModelGroup(model, OP_INSERT, model->cursor, inserted, inserted, model->cursor);
+  model->sealed = true;
+
+  recordInsert(editor, editor->bufferIndex, inserted);
+  editor->bufferIndex += inserted;
+
+  model->text.insert(model->cursor, text, inserted);
+  model->cursor += inserted;
+}
+
+/**
+ * @brief Delete the char like the delete key, the last char is deleted
+ * backward, a char inside the message forward, deletes in a row within
+ * the group delay extend the open burst.
+ * 
+ * @param model 
+ * @param time 
+ */
+void deleteStressChar(UndoModel *model, uint64_t time) {
+  Editor *editor = &StressEditor;
+
+  if (editor->bufferIndex == 0) {
+    return;
+  }
+
+  bool backward = model->cursor == model->text.size();
+  uint8_t index = backward ? model->cursor - 1 : model->cursor;
+  OpType type = backward ? OP_DELETE_BACK : OP_DELETE;
+
+  ModelGroup *open = !model->sealed && !model->applied.empty() ? &model->applied.back() : NULL;
+  bool burst = open != NULL && open->type == type && open->len < MESSAGE_SIZE &&
+               time - model->lastDeleteTime <= UNDO_GROUP_DELAY &&
+               (backward ? open->index == index + 1 : open->index == index);
+
+  model->undone.clear();
+  if (burst) {
+    reserveModel(model, 1);
+    open = &model->applied.back();
+    open->index = index;
+    open->len++;
+    open->bytes++;
+  }
+  else {
+    pushModelGroup(model, type, index, 1, 1, index);
+  }
+  model->lastDeleteTime = time;
+
+  if (backward) {
+    editor->bufferIndex--;
+    recordDelete(editor, editor->bufferIndex, true, time);
+    setBufferChar(editor, MESSAGE_END);
+  }
+  else {
+    recordDelete(editor, editor->bufferIndex, false, time);
+    removeBufferChar(editor);
+  }
+
+  model->text.erase(index, 1);
+  model->cursor = index;
+}
+
+/**
+ * @brief Clear the whole message as one sealed group.
+ * 
+ * @param model 
+ */
+void clearStressMessage(UndoModel *model) {
+  Editor *editor = &StressEditor;
+
+  if (model->text.empty()) {
+    return;
+  }
+
+  model->undone.clear();
+  pushModelGroup(model, OP_DELETE, 0, model->text.size(), model->text.size(), model->cursor);
+  model->sealed = true;
+
+  recordClear(editor);
+  clearBuffer(editor);
+
+  model->text.clear();
+  model->cursor = 0;
+}
+
+/**
+ * @brief Undo the last applied group, the text and cursor before it
+ * come back, an empty log keeps the open group open.
+ * 
+ * @param model 
+ */
+void undoStress(UndoModel *model) {
+  bool undone = undoEdit(&StressEditor);
+
+  if (undone != !model->applied.empty()) {
+    printf("undo returned %d with %zu groups\n", undone, model->applied.size());
+    exit(1);
+  }
+
+  if (undone) {
+    ModelGroup group = model->applied.back();
+    model->applied.pop_back();
+    group.after = model->text;
+    model->text = group.before;
+    model->cursor = group.beforeCursor;
+    model->undone.push_back(group);
+    model->sealed = true;
+  }
+}
+
+/**
+ * @brief Redo the last undone group, the cursor ends after the written
+ * or inserted chars or on the deleted ones, nothing to redo keeps the
+ * open group open.
+ * 
+ * @param model 
+ */
+void redoStress(UndoModel *model) {
+  bool redone = redoEdit(&StressEditor);
+
+  if (redone != !model->undone.empty()) {
+    printf("redo returned %d with %zu groups\n", redone, model->undone.size());
+    exit(1);
+  }
+
+  if (redone) {
+    ModelGroup group = model->undone.back();
+    model->undone.pop_back();
+    model->text = group.after;
+    model->cursor = group.type == OP_WRITE || group.type == OP_INSERT ? group.index + group.len : group.index;
+    model->applied.push_back(group);
+    model->sealed = true;
+  }
+}
+
+/**
+ * @brief Compare the editor with the model, the message and its clear
+ * tail, the cursor, the word stops and the undo log report.
+ * 
+ * @param model 
+ * @param op 
+ * @return true 
+ * @return false 
+ */
+bool checkStress(const UndoModel *model, uint32_t op) {
+  Editor *editor = &StressEditor;
+  size_t len = model->text.size();
+
+  if (len != getBufferLen(editor) || memcmp(editor->buffer, model->text.data(), len) != 0) {
+    printf("op %u: message '%s', expected '%s'\n", op, editor->buffer, model->text.c_str());
+    return false;
+  }
+
+  for (size_t idx = len; idx <= MESSAGE_SIZE; ++idx) {
+    if (editor->buffer[idx] != MESSAGE_END) {
+      printf("op %u: tail not clear at %zu\n", op, idx);
+      return false;
+    }
+  }
+
+  if (editor->bufferIndex != model->cursor) {
+    printf("op %u: cursor %u, expected %u\n", op, editor->bufferIndex, model->cursor);
+    return false;
+  }
+
+  for (size_t idx = 0; idx <= MESSAGE_SIZE; ++idx) {
+    bool stop = idx == len || (idx < len && model->text[idx] != ' ' && (idx == 0 || model->text[idx - 1] == ' '));
+    if (stop != ((editor->wordStops[idx / 32] >> (idx % 32)) & 1)) {
+      printf("op %u: word stop %zu is %d\n", op, idx, !stop);
+      return false;
+    }
+  }
+
+  UndoStats stats = getUndoStats(editor);
+  size_t bytes = getModelBytes(model);
+  for (const ModelGroup &group : model->undone) {
+    bytes += group.bytes;
+  }
+
+  if (stats.undoOps != model->applied.size() || stats.redoOps != model->undone.size() ||
+      stats.arenaUsed != bytes || stats.arenaUsed > stats.arenaSize || stats.arenaPeak < stats.arenaUsed) {
+    printf("op %u: undo %u redo %u arena %zu, expected undo %zu redo %zu arena %zu\n", op, stats.undoOps,
+           stats.redoOps, stats.arenaUsed, model->applied.size(), model->undone.size(), bytes);
+    return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Run the random writes, multitap cycles, inserts, deletes,
+ * clears, cursor moves, undos and redos on the editor buffer and its
+ * undo log and check every step against the reference model.
+ * 
+ * @param argc 
+ * @param argv optional seed and operation count
+ * @return int 1 on the first mismatch
+ */
+int main(int argc, char **argv) {
+  uint32_t state = argc > 1 ? strtoul(argv[1], NULL, 0) | 1 : 1;
+  uint32_t ops = argc > 2 ? strtoul(argv[2], NULL, 0) : STRESS_OPS;
+
+  Editor *editor = &StressEditor;
+  editor->layout = getLayout(LAYOUT_ENGLISH);
+  editor->layoutIndex = LAYOUT_ENGLISH;
+  clearBuffer(editor);
+  resetUndo(editor);
+
+  UndoModel model = {"", 0, {}, {}, true, 0};
+  uint64_t time = 0;
+
+  for (uint32_t op = 0; op < ops; ++op) {
+    uint32_t value = nextStressRandom(&state);
+    uint8_t choice = value % 16;
+    char ch = StressChars[(value >> 8) % (sizeof(StressChars) - 1)];
+
+    // Mostly short gaps so deletes burst and cycles repeat
+    time += (value >> 16) % 4 == 0 ? (value >> 20) % 2000 : (value >> 20) % 200;
+
+    if (choice < 5) {
+      writeStressChar(&model, ch, false);
+    }
+    else if (choice < 7) {
+      if (model.cursor > 0) {
+        writeStressChar(&model, ch, true);
+      }
+    }
+    else if (choice < 8) {
+      char text[MESSAGE_SIZE];
+      uint8_t len = (value >> 12) % 24;
+      for (uint8_t idx = 0; idx < len; ++idx) {
+        text[idx] = StressChars[nextStressRandom(&state) % (sizeof(StressChars) - 1)];
+      }
+      insertStressText(&model, text, len);
+    }
+    else if (choice < 11) {
+      deleteStressChar(&model, time);
+    }
+    else if (choice < 12) {
+      if ((value >> 12) % 8 == 0) {
+        clearStressMessage(&model);
+      }
+    }
+    else if (choice < 13) {
+      model.cursor = (value >> 12) % (model.text.size() + 1);
+      editor->bufferIndex = model.cursor;
+    }
+    else if (choice < 15) {
+      undoStress(&model);
+    }
+    else {
+      redoStress(&model);
+    }
+
+    if (!checkStress(&model, op)) {
+      return 1;
+    }
+  }
+
+  UndoStats stats = getUndoStats(editor);
+  printf("%u ops, arena peak %zu of %zu bytes, %u undo and %u redo groups left\n", ops, stats.arenaPeak,
+         stats.arenaSize, stats.undoOps, stats.redoOps);
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file Arena.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "Memory.h"
+#include "Undo.h"
+#include "Buffer.h"
+#include "Editor.h"
+#include "History.h"
+#include "Index.h"
+#include "Flow.h"
+
+/**
+ * @brief Set the arena usage from counts of its units.
+ * 
+ * @param arena 
+ * @param unit unit size in bytes
+ * @param size 
+ * @param used 
+ * @param peak 
+ */
+void setMemoryArena(MemoryArena *arena, uint32_t unit, uint32_t size, uint32_t used, uint32_t peak) {
+  arena->size = size * unit;
+  arena->used = used * unit;
+  arena->peak = peak * unit;
+}
+
+/**
+ * @brief Get the usage of the editor message buffer and undo arena
+ * and of the shared history, index and flow pools, gathered from the
+ * usage reports of the modules, works without the device.
+ * 
+ * @param editor 
+ * @param arenas ARENAS entries
+ */
+void getMemoryArenas(Editor *editor, MemoryArena *arenas) {
+  setMemoryArena(&arenas[ARENA_MESSAGE], 1, MESSAGE_SIZE, getBufferLen(editor), editor->bufferPeak);
+
+  UndoStats undo = getUndoStats(editor);
+  setMemoryArena(&arenas[ARENA_UNDO], 1, undo.arenaSize, undo.arenaUsed, undo.arenaPeak);
+
+  HistoryStats history = getHistoryStats();
+  setMemoryArena(&arenas[ARENA_HISTORY_SLABS], HISTORY_SLAB_SIZE, HISTORY_SLABS,
+                 HISTORY_SLABS - history.freeSlabs, history.peakSlabs);
+  setMemoryArena(&arenas[ARENA_HISTORY_ENTRIES], sizeof(HistoryEntry), HISTORY_ENTRIES,
+                 history.count, history.peakCount);
+
+  IndexStats index = getIndexStats();
+  setMemoryArena(&arenas[ARENA_INDEX_TERMS], sizeof(IndexTerm), INDEX_TERMS, index.terms, index.peakTerms);
+  setMemoryArena(&arenas[ARENA_INDEX_BLOCKS], sizeof(IndexBlock), INDEX_BLOCKS,
+                 INDEX_BLOCKS - index.freeBlocks, index.peakBlocks);
+
+  FlowStats flow = getFlowStats();
+  setMemoryArena(&arenas[ARENA_FLOW_FRAMES], FLOW_FRAME_SIZE, FLOW_FRAMES, flow.running, flow.peak);
+}
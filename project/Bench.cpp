@@ -0,0 +1,144 @@
+/**
+ * @file Bench.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Bench.h"
+#include "Fuzz.h"
+#include "Editor.h"
+#include "Buffer.h"
+#include "Keypad.h"
+#include "Display.h"
+#include "Shared.h"
+
+// Message text of the benchmarks, sentences of short words
+const char BenchText[] = "See you at noon. The bus is late! Call me back? ";
+
+// Last result of the timed calls, keeps the calls from being optimized out
+SHARED_STATE volatile uint32_t benchSink = 0;
+
+/**
+ * @brief Fill the message up to the length with the benchmark text,
+ * put the cursor on the index and scroll to its page.
+ * 
+ * @param editor 
+ * @param len 
+ * @param index 
+ */
+void fillBenchMessage(Editor *editor, uint8_t len, uint8_t index) {
+  clearBuffer(editor);
+
+  while (getBufferLen(editor) < len) {
+    uint8_t left = len - getBufferLen(editor);
+    uint8_t size = sizeof(BenchText) - 1;
+    insertBufferString(editor, getBufferLen(editor), BenchText, left < size ? left : size);
+  }
+
+  editor->bufferIndex = index;
+  editor->caseMode = MODE_SMART;
+
+  int row = index / CHARS_PER_LINE;
+  editor->scrollRow = (row / VISIBLE_LINES) * VISIBLE_LINES;
+  editor->display->setCursor(MIN_X_POS + (index % CHARS_PER_LINE) * FONT_WIDTH,
+                             MIN_Y_POS + (row - editor->scrollRow) * FONT_HEIGHT);
+}
+
+/**
+ * @brief Reset the fuzz editor, fill its message and call the
+ * primitive the iterations times, the time of all calls is taken at
+ * once. The buffer writes restore the message every other call and
+ * the removed char is put back at the end without any bookkeeping,
+ * so every call sees the same message length. The render runs into
+ * the fuzz panel, its flush is skipped.
+ * 
+ * @param bench 
+ * @param len 
+ * @param index 
+ * @param iterations 
+ * @return BenchResult 
+ */
+BenchResult runBench(BenchCase bench, uint8_t len, uint8_t index, uint16_t iterations) {
+  BenchResult result = {0, 0};
+
+  if (bench >= BENCHES || len > MESSAGE_SIZE || index > len || iterations > BENCH_MAX_ITERATIONS ||
+      (bench == BENCH_REMOVE_CHAR && index == len)) {
+    return result;
+  }
+
+  Editor *editor = resetFuzzEditor();
+  fillBenchMessage(editor, len, index);
+
+  char original = getBufferCharByIndex(editor, index);
+  uint32_t startTime = micros();
+
+  switch (bench) {
+    case BENCH_SET_CHAR:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        editor->bufferIndex = index;
+        setBufferChar(editor, (i & 1) ? original : 'x');
+      }
+      break;
+
+    case BENCH_REMOVE_CHAR:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        removeBufferCharOnIndex(editor, index);
+        editor->buffer[len - 1] = original;
+      }
+      break;
+
+    case BENCH_BUFFER_LEN:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        benchSink = getBufferLen(editor);
+      }
+      break;
+
+    case BENCH_KEY_CHAR:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        benchSink = getKeyChar(editor, (Key)(KEY_0 + i % 10));
+      }
+      break;
+
+    case BENCH_SENTENCE_START:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        benchSink = isSentenceStart(editor);
+      }
+      break;
+
+    case BENCH_CURSOR_POS:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        Coord crs = getTargetCursorPos(editor, (Move)(i % 4));
+        benchSink = crs.x + crs.y;
+      }
+      break;
+
+    case BENCH_DRAW_MESSAGE:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        drawMessage(editor);
+      }
+      break;
+
+    case BENCH_DRAW_HEADER:
+      for (uint16_t i = 0; i < iterations; ++i) {
+        drawHeader(editor);
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  result.time = micros() - startTime;
+  result.iterations = iterations;
+  return result;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file Bench.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+
+// Maximal calls of one benchmark run, keeps the run short enough
+// not to starve the idle task
+#define BENCH_MAX_ITERATIONS 4096
+
+/**
+ * @brief Enum values for the benchmarked primitives.
+ * 
+ */
+typedef enum {
+  BENCH_SET_CHAR,
+  BENCH_REMOVE_CHAR,
+  BENCH_BUFFER_LEN,
+  BENCH_KEY_CHAR,
+  BENCH_SENTENCE_START,
+  BENCH_CURSOR_POS,
+  BENCH_DRAW_MESSAGE,
+  BENCH_DRAW_HEADER,
+  BENCHES
+} BenchCase;
+
+/**
+ * @brief Structure for benchmark run result, no iterations when the
+ * case, message length or cursor index is not valid.
+ * 
+ */
+typedef struct {
+  uint16_t iterations;
+  uint32_t time;
+} BenchResult;
+
+/**
+ * @brief Time the primitive on the message of the length with the
+ * cursor on the index.
+ * 
+ * @param bench 
+ * @param len 
+ * @param index 
+ * @param iterations 
+ * @return BenchResult 
+ */
+BenchResult runBench(BenchCase bench, uint8_t len, uint8_t index, uint16_t iterations);
+
+#endif
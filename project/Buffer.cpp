@@ -12,32 +12,167 @@
 #include <stdint.h>
 #include <string.h>
 #include "Buffer.h"
+#include "Editor.h"
+#include "Spell.h"
 
-// Message buffer
-char Buffer[MESSAGE_SIZE + 1] = {'\0'};
+/**
+ * @brief Check whether the index is a word stop, the first char of
+ * a word or the message end.
+ * 
+ * @param editor 
+ * @param index 
+ * @return true 
+ * @return false 
+ */
+bool isWordStop(Editor *editor, uint8_t index) {
+  char ch = editor->buffer[index];
+  char prev = index > 0 ? editor->buffer[index - 1] : ' ';
+
+  if (ch == MESSAGE_END) {
+    return index == 0 || prev != MESSAGE_END;
+  }
+
+  return ch != ' ' && prev == ' ';
+}
+
+/**
+ * @brief Update the word stop bit of the index from the message text.
+ * 
+ * @param editor 
+ * @param index 
+ */
+void updateWordStop(Editor *editor, int index) {
+  if (index < 0 || index > MESSAGE_SIZE) {
+    return;
+  }
+
+  uint32_t mask = 1UL << (index % 32);
+  if (isWordStop(editor, index)) {
+    editor->wordStops[index / 32] |= mask;
+  }
+  else {
+    editor->wordStops[index / 32] &= ~mask;
+  }
+}
+
+/**
+ * @brief Get the mask of the bitmap word with the bits below index.
+ * 
+ * @param word 
+ * @param index 
+ * @return uint32_t 
+ */
+uint32_t getLowMask(int word, int index) {
+  if (word < index / 32) return UINT32_MAX;
+  if (word > index / 32) return 0;
+  return (1UL << (index % 32)) - 1;
+}
 
-// Buffer current position index 
-uint8_t bufferIndex = 0;
+/**
+ * @brief Clear the spell marks of the chars from the index up to the
+ * end, with the chars of the words joined to them. A word is checked
+ * again when it is finished.
+ * 
+ * @param editor 
+ * @param index 
+ * @param end 
+ * @param joined also clear the words touching the range
+ */
+void clearSpellMarks(Editor *editor, uint8_t index, uint8_t end, bool joined) {
+  if (joined) {
+    while (index > 0 && isSpellChar(editor->buffer[index - 1])) index--;
+    while (end < MESSAGE_SIZE && isSpellChar(editor->buffer[end])) end++;
+  }
+
+  for (uint8_t idx = index; idx < end; ++idx) {
+    editor->spellMarks[idx / 32] &= ~(1UL << (idx % 32));
+  }
+}
+
+/**
+ * @brief Move the bits of the bitmap from the index on by the count
+ * of chars inserted or removed at the index, the bits of the inserted
+ * chars are not defined.
+ * 
+ * @param bitmap 
+ * @param index 
+ * @param len 
+ * @param inserted 
+ */
+void shiftBitmap(uint32_t *bitmap, uint8_t index, uint8_t len, bool inserted) {
+  uint32_t old[WORD_INDEX_SIZE];
+  memcpy(old, bitmap, sizeof(old));
+
+  int words = len / 32;
+  int bits = len % 32;
+
+  for (int w = 0; w < WORD_INDEX_SIZE; ++w) {
+    uint32_t value = 0;
+
+    if (inserted) {
+      int from = w - words;
+      if (from >= 0) value = old[from] << bits;
+      if (bits != 0 && from >= 1) value |= old[from - 1] >> (32 - bits);
+    }
+    else {
+      int from = w + words;
+      if (from < WORD_INDEX_SIZE) value = old[from] >> bits;
+      if (bits != 0 && from + 1 < WORD_INDEX_SIZE) value |= old[from + 1] << (32 - bits);
+    }
+
+    uint32_t low = getLowMask(w, index);
+    bitmap[w] = (old[w] & low) | (value & ~low);
+  }
+}
+
+/**
+ * @brief Move the word stops and spell marks from the index on by the
+ * count of chars inserted or removed at the index, the shifted text
+ * keeps its stops, so only the stops around the edit are read from
+ * the text again. The words touching the edit lose their marks.
+ * 
+ * @param editor 
+ * @param index 
+ * @param len 
+ * @param inserted 
+ */
+void shiftWordStops(Editor *editor, uint8_t index, uint8_t len, bool inserted) {
+  // Nothing inserted or removed leaves the marks of the words
+  if (len == 0) {
+    return;
+  }
+
+  shiftBitmap(editor->wordStops, index, len, inserted);
+  shiftBitmap(editor->spellMarks, index, len, inserted);
+  clearSpellMarks(editor, index, inserted ? index + len : index, true);
+
+  int last = inserted ? index + len : index;
+  for (int idx = index; idx <= last; ++idx) {
+    updateWordStop(editor, idx);
+  }
+}
 
 /**
  * @brief Get the char in buffer on bufferIndex position
  * 
+ * @param editor 
  * @return char 
  */
-char getBufferChar() {
-  return getBufferCharByIndex(bufferIndex);
+char getBufferChar(Editor *editor) {
+  return getBufferCharByIndex(editor, editor->bufferIndex);
 }
 
 /**
  * @brief Get the char value from the buffer on
  * specified index, checks if the index in buffer range. 
  * 
+ * @param editor 
  * @param index 
  * @return char 
  */
-char getBufferCharByIndex(uint8_t index) {
-  if (index >= 0 && index < MESSAGE_SIZE) {
-    return Buffer[index];
+char getBufferCharByIndex(Editor *editor, uint8_t index) {
+  if (index < MESSAGE_SIZE) {
+    return editor->buffer[index];
   }
 
   return MESSAGE_END;
@@ -46,61 +181,195 @@ char getBufferCharByIndex(uint8_t index) {
 /**
  * @brief Removes the char from buffer on bufferIndex.
  * 
+ * @param editor 
  */
-void removeBufferChar() {
-  removeBufferCharOnIndex(bufferIndex);
+void removeBufferChar(Editor *editor) {
+  removeBufferCharOnIndex(editor, editor->bufferIndex);
 }
 
 /**
  * @brief Removes the char from buffer on passed index by
  * shifting the array from the index position.
  * 
+ * @param editor 
  * @param index 
  */
-void removeBufferCharOnIndex(uint8_t index) {
-  size_t bufferLen = strlen(Buffer);
+void removeBufferCharOnIndex(Editor *editor, uint8_t index) {
+  size_t bufferLen = strlen(editor->buffer);
 
   if (bufferLen == 0 || index >= bufferLen) {
     return;
   }
   
-  for (int idx = index; idx < bufferLen - 1; ++idx) {
-    Buffer[idx] = Buffer[idx + 1];
+  for (size_t idx = index; idx < bufferLen - 1; ++idx) {
+    editor->buffer[idx] = editor->buffer[idx + 1];
   }
   
-  Buffer[bufferLen - 1] = MESSAGE_END; 
+  editor->buffer[bufferLen - 1] = MESSAGE_END; 
+  shiftWordStops(editor, index, 1, false);
 }
 
 /**
  * @brief Set the buffer char on the bufferIndex position.
  * 
+ * @param editor 
  * @param ch 
  */
-void setBufferChar(char ch) {
-  if (bufferIndex >= 0 && bufferIndex < MESSAGE_SIZE) {
-    Buffer[bufferIndex] = ch;
+void setBufferChar(Editor *editor, char ch) {
+  setBufferCharOnIndex(editor, editor->bufferIndex, ch);
+}
+
+/**
+ * @brief Set the buffer char on passed index, checks if the
+ * index in buffer range.
+ * 
+ * @param editor 
+ * @param index 
+ * @param ch 
+ */
+void setBufferCharOnIndex(Editor *editor, uint8_t index, char ch) {
+  if (index < MESSAGE_SIZE) {
+    bool joined = isSpellChar(editor->buffer[index]) || isSpellChar(ch);
+    editor->buffer[index] = ch;
+    clearSpellMarks(editor, index, index + 1, joined);
+    if (ch != MESSAGE_END && index >= editor->bufferPeak) editor->bufferPeak = index + 1;
+    updateWordStop(editor, index);
+    updateWordStop(editor, index + 1);
+  }
+}
+
+/**
+ * @brief Insert the string into buffer on passed index by
+ * shifting the rest of message once, the string is cut to
+ * the free space left in buffer.
+ * 
+ * @param editor 
+ * @param index 
+ * @param str 
+ * @param len 
+ * @return uint8_t count of inserted chars
+ */
+uint8_t insertBufferString(Editor *editor, uint8_t index, const char *str, uint8_t len) {
+  size_t bufferLen = strlen(editor->buffer);
+
+  if (index > bufferLen) {
+    return 0;
+  }
+
+  // Cut the string to the free space
+  if (len > MESSAGE_SIZE - bufferLen) {
+    len = MESSAGE_SIZE - bufferLen;
   }
+
+  memmove(&editor->buffer[index + len], &editor->buffer[index], bufferLen - index + 1);
+  memcpy(&editor->buffer[index], str, len);
+  shiftWordStops(editor, index, len, true);
+  if (bufferLen + len > editor->bufferPeak) editor->bufferPeak = bufferLen + len;
+
+  return len;
+}
+
+/**
+ * @brief Removes the range of chars from buffer on passed index
+ * by shifting the rest of message once and clearing the freed tail.
+ * 
+ * @param editor 
+ * @param index 
+ * @param len 
+ */
+void removeBufferRange(Editor *editor, uint8_t index, uint8_t len) {
+  size_t bufferLen = strlen(editor->buffer);
+
+  if (index >= bufferLen) {
+    return;
+  }
+
+  if (len > bufferLen - index) {
+    len = bufferLen - index;
+  }
+
+  memmove(&editor->buffer[index], &editor->buffer[index + len], bufferLen - index - len);
+  memset(&editor->buffer[bufferLen - len], MESSAGE_END, len);
+  shiftWordStops(editor, index, len, false);
 }
 
 /**
  * @brief Get the current length of buffer message.
  * 
+ * @param editor 
  * @return size_t 
  */
-size_t getBufferLen() {
-  return strlen(Buffer);
+size_t getBufferLen(Editor *editor) {
+  return strlen(editor->buffer);
+}
+
+/**
+ * @brief Get the first word stop after the index from the word stop
+ * bitmap, at most one pass over its few words.
+ * 
+ * @param editor 
+ * @param index 
+ * @return uint8_t the word stop or index when the index is the end
+ */
+uint8_t getNextWordStop(Editor *editor, uint8_t index) {
+  for (int w = (index + 1) / 32; w < WORD_INDEX_SIZE; ++w) {
+    uint32_t stops = editor->wordStops[w] & ~getLowMask(w, index + 1);
+
+    if (stops != 0) {
+      return w * 32 + __builtin_ctz(stops);
+    }
+  }
+
+  return index;
+}
+
+/**
+ * @brief Get the last word stop before the index from the word stop
+ * bitmap, at most one pass over its few words.
+ * 
+ * @param editor 
+ * @param index 
+ * @return uint8_t the word stop or message start
+ */
+uint8_t getPrevWordStop(Editor *editor, uint8_t index) {
+  for (int w = index / 32; w >= 0; --w) {
+    uint32_t stops = editor->wordStops[w] & getLowMask(w, index);
+
+    if (stops != 0) {
+      return w * 32 + 31 - __builtin_clz(stops);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Check whether the char on the index is in a word marked as
+ * misspelled.
+ * 
+ * @param editor 
+ * @param index 
+ * @return true 
+ * @return false 
+ */
+bool isSpellMark(Editor *editor, uint8_t index) {
+  return index <= MESSAGE_SIZE && (editor->spellMarks[index / 32] >> (index % 32)) & 1;
 }
 
 /**
  * @brief Clear the buffer and reset the bufferIndex to 0.
  * 
+ * @param editor 
  */
-void clearBuffer() {
-  size_t bufferLen = strlen(Buffer);
+void clearBuffer(Editor *editor) {
+  size_t bufferLen = strlen(editor->buffer);
 
-  for (int idx = 0; idx < bufferLen; ++idx) {
-    Buffer[idx] = MESSAGE_END;
+  for (size_t idx = 0; idx < bufferLen; ++idx) {
+    editor->buffer[idx] = MESSAGE_END;
   }
 
-  bufferIndex = 0;
+  memset(editor->wordStops, 0, sizeof(editor->wordStops));
+  memset(editor->spellMarks, 0, sizeof(editor->spellMarks));
+  updateWordStop(editor, 0);
+  editor->bufferIndex = 0;
 }
\ No newline at end of file
@@ -18,54 +18,123 @@
 // Message end symbol
 #define MESSAGE_END '\0'
 
+// Words of the word stop bitmap, one bit for every index up to the message end
+#define WORD_INDEX_SIZE ((MESSAGE_SIZE + 32) / 32)
+
+struct Editor;
+
 /**
  * @brief Get char from buffer on specified index
  * 
+ * @param editor 
  * @param index 
  * @return char 
  */
-char getBufferCharByIndex(uint8_t index);
+char getBufferCharByIndex(Editor *editor, uint8_t index);
 
 /**
  * @brief Get char on the current position of bufferIndex
  * 
+ * @param editor 
  * @return char 
  */
-char getBufferChar();
+char getBufferChar(Editor *editor);
 
 /**
  * @brief Set char on the current position of bufferIndex
  * 
+ * @param editor 
+ * @param ch 
+ */
+void setBufferChar(Editor *editor, char ch);
+
+/**
+ * @brief Set char on the specified index
+ * 
+ * @param editor 
+ * @param index 
  * @param ch 
  */
-void setBufferChar(char ch);
+void setBufferCharOnIndex(Editor *editor, uint8_t index, char ch);
 
+/**
+ * @brief Insert string into buffer on specified index
+ * and shift the rest of message
+ * 
+ * @param editor 
+ * @param index 
+ * @param str 
+ * @param len 
+ * @return uint8_t 
+ */
+uint8_t insertBufferString(Editor *editor, uint8_t index, const char *str, uint8_t len);
+
+/**
+ * @brief Remove range of chars from buffer on specified index
+ * 
+ * @param editor 
+ * @param index 
+ * @param len 
+ */
+void removeBufferRange(Editor *editor, uint8_t index, uint8_t len);
 
 /**
  * @brief Remove char from buffer on specified position
  * and shift the array if necessary
  * 
+ * @param editor 
  * @param index 
  */
-void removeBufferCharOnIndex(uint8_t index);
+void removeBufferCharOnIndex(Editor *editor, uint8_t index);
 
 /**
  * @brief Remove char on the current position of bufferIndex
  * 
+ * @param editor 
  */
-void removeBufferChar();
+void removeBufferChar(Editor *editor);
 
 /**
  * @brief Get current length of buffer
  * 
+ * @param editor 
  * @return size_t 
  */
-size_t getBufferLen();
+size_t getBufferLen(Editor *editor);
+
+/**
+ * @brief Get the next word start or message end after index
+ * 
+ * @param editor 
+ * @param index 
+ * @return uint8_t 
+ */
+uint8_t getNextWordStop(Editor *editor, uint8_t index);
+
+/**
+ * @brief Get the previous word start before index
+ * 
+ * @param editor 
+ * @param index 
+ * @return uint8_t 
+ */
+uint8_t getPrevWordStop(Editor *editor, uint8_t index);
+
+/**
+ * @brief Check whether the char on index is in a misspelled word
+ * 
+ * @param editor 
+ * @param index 
+ * @return true 
+ * @return false 
+ */
+bool isSpellMark(Editor *editor, uint8_t index);
 
 /**
  * @brief Clear whole buffer and reset bufferIndex
  * 
+ * @param editor 
  */
-void clearBuffer();
+void clearBuffer(Editor *editor);
 
 #endif
\ No newline at end of file
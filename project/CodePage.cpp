@@ -0,0 +1,265 @@
+/**
+ * @file CodePage.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "CodePage.h"
+
+// Unicode of every code of the internal one byte code page, ASCII,
+// the GSM 03.38 chars missing in ISO 8859-2 from 0x80 and ISO 8859-2
+// from 0xA0, zero for codes without char, generated by tools/codepage.py
+const uint16_t CodePageUnicode[256] = {
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // 0x00
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // 0x08
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // 0x10
+  0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // 0x18
+  0x0020, 0x0021, 0x0022, 0x0023, 0x0024, 0x0025, 0x0026, 0x0027, // 0x20
+  0x0028, 0x0029, 0x002A, 0x002B, 0x002C, 0x002D, 0x002E, 0x002F, // 0x28
+  0x0030, 0x0031, 0x0032, 0x0033, 0x0034, 0x0035, 0x0036, 0x0037, // 0x30
+  0x0038, 0x0039, 0x003A, 0x003B, 0x003C, 0x003D, 0x003E, 0x003F, // 0x38
+  0x0040, 0x0041, 0x0042, 0x0043, 0x0044, 0x0045, 0x0046, 0x0047, // 0x40
+  0x0048, 0x0049, 0x004A, 0x004B, 0x004C, 0x004D, 0x004E, 0x004F, // 0x48
+  0x0050, 0x0051, 0x0052, 0x0053, 0x0054, 0x0055, 0x0056, 0x0057, // 0x50
+  0x0058, 0x0059, 0x005A, 0x005B, 0x005C, 0x005D, 0x005E, 0x005F, // 0x58
+  0x0060, 0x0061, 0x0062, 0x0063, 0x0064, 0x0065, 0x0066, 0x0067, // 0x60
+  0x0068, 0x0069, 0x006A, 0x006B, 0x006C, 0x006D, 0x006E, 0x006F, // 0x68
+  0x0070, 0x0071, 0x0072, 0x0073, 0x0074, 0x0075, 0x0076, 0x0077, // 0x70
+  0x0078, 0x0079, 0x007A, 0x007B, 0x007C, 0x007D, 0x007E, 0x0000, // 0x78
+  0x00A3, 0x00A5, 0x00E8, 0x00F9, 0x00EC, 0x00F2, 0x00D8, 0x00F8, // 0x80
+  0x00C5, 0x00E5, 0x0394, 0x03A6, 0x0393, 0x039B, 0x03A9, 0x03A0, // 0x88
+  0x03A8, 0x03A3, 0x0398, 0x039E, 0x00C6, 0x00E6, 0x00D1, 0x00F1, // 0x90
+  0x00A1, 0x00BF, 0x00E0, 0x20AC, 0x0000, 0x0000, 0x0000, 0x0000, // 0x98
+  0x00A0, 0x0104, 0x02D8, 0x0141, 0x00A4, 0x013D, 0x015A, 0x00A7, // 0xA0
+  0x00A8, 0x0160, 0x015E, 0x0164, 0x0179, 0x00AD, 0x017D, 0x017B, // 0xA8
+  0x00B0, 0x0105, 0x02DB, 0x0142, 0x00B4, 0x013E, 0x015B, 0x02C7, // 0xB0
+  0x00B8, 0x0161, 0x015F, 0x0165, 0x017A, 0x02DD, 0x017E, 0x017C, // 0xB8
+  0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7, // 0xC0
+  0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E, // 0xC8
+  0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7, // 0xD0
+  0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF, // 0xD8
+  0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7, // 0xE0
+  0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F, // 0xE8
+  0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7, // 0xF0
+  0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9  // 0xF8
+};
+
+// Codes of the non-ASCII chars sorted by Unicode
+const CodePageEntry CodePageCodes[CODEPAGE_EXTRA] = {
+  {0x00A0, 0xA0}, {0x00A1, 0x98}, {0x00A3, 0x80}, {0x00A4, 0xA4}, {0x00A5, 0x81}, {0x00A7, 0xA7},
+  {0x00A8, 0xA8}, {0x00AD, 0xAD}, {0x00B0, 0xB0}, {0x00B4, 0xB4}, {0x00B8, 0xB8}, {0x00BF, 0x99},
+  {0x00C1, 0xC1}, {0x00C2, 0xC2}, {0x00C4, 0xC4}, {0x00C5, 0x88}, {0x00C6, 0x94}, {0x00C7, 0xC7},
+  {0x00C9, 0xC9}, {0x00CB, 0xCB}, {0x00CD, 0xCD}, {0x00CE, 0xCE}, {0x00D1, 0x96}, {0x00D3, 0xD3},
+  {0x00D4, 0xD4}, {0x00D6, 0xD6}, {0x00D7, 0xD7}, {0x00D8, 0x86}, {0x00DA, 0xDA}, {0x00DC, 0xDC},
+  {0x00DD, 0xDD}, {0x00DF, 0xDF}, {0x00E0, 0x9A}, {0x00E1, 0xE1}, {0x00E2, 0xE2}, {0x00E4, 0xE4},
+  {0x00E5, 0x89}, {0x00E6, 0x95}, {0x00E7, 0xE7}, {0x00E8, 0x82}, {0x00E9, 0xE9}, {0x00EB, 0xEB},
+  {0x00EC, 0x84}, {0x00ED, 0xED}, {0x00EE, 0xEE}, {0x00F1, 0x97}, {0x00F2, 0x85}, {0x00F3, 0xF3},
+  {0x00F4, 0xF4}, {0x00F6, 0xF6}, {0x00F7, 0xF7}, {0x00F8, 0x87}, {0x00F9, 0x83}, {0x00FA, 0xFA},
+  {0x00FC, 0xFC}, {0x00FD, 0xFD}, {0x0102, 0xC3}, {0x0103, 0xE3}, {0x0104, 0xA1}, {0x0105, 0xB1},
+  {0x0106, 0xC6}, {0x0107, 0xE6}, {0x010C, 0xC8}, {0x010D, 0xE8}, {0x010E, 0xCF}, {0x010F, 0xEF},
+  {0x0110, 0xD0}, {0x0111, 0xF0}, {0x0118, 0xCA}, {0x0119, 0xEA}, {0x011A, 0xCC}, {0x011B, 0xEC},
+  {0x0139, 0xC5}, {0x013A, 0xE5}, {0x013D, 0xA5}, {0x013E, 0xB5}, {0x0141, 0xA3}, {0x0142, 0xB3},
+  {0x0143, 0xD1}, {0x0144, 0xF1}, {0x0147, 0xD2}, {0x0148, 0xF2}, {0x0150, 0xD5}, {0x0151, 0xF5},
+  {0x0154, 0xC0}, {0x0155, 0xE0}, {0x0158, 0xD8}, {0x0159, 0xF8}, {0x015A, 0xA6}, {0x015B, 0xB6},
+  {0x015E, 0xAA}, {0x015F, 0xBA}, {0x0160, 0xA9}, {0x0161, 0xB9}, {0x0162, 0xDE}, {0x0163, 0xFE},
+  {0x0164, 0xAB}, {0x0165, 0xBB}, {0x016E, 0xD9}, {0x016F, 0xF9}, {0x0170, 0xDB}, {0x0171, 0xFB},
+  {0x0179, 0xAC}, {0x017A, 0xBC}, {0x017B, 0xAF}, {0x017C, 0xBF}, {0x017D, 0xAE}, {0x017E, 0xBE},
+  {0x02C7, 0xB7}, {0x02D8, 0xA2}, {0x02D9, 0xFF}, {0x02DB, 0xB2}, {0x02DD, 0xBD}, {0x0393, 0x8C},
+  {0x0394, 0x8A}, {0x0398, 0x92}, {0x039B, 0x8D}, {0x039E, 0x93}, {0x03A0, 0x8F}, {0x03A3, 0x91},
+  {0x03A6, 0x8B}, {0x03A8, 0x90}, {0x03A9, 0x8E}, {0x20AC, 0x9B}
+};
+
+// Search key of every code, lower case letters without diacritics,
+// digits and zero for word separators, generated by tools/codepage.py
+const uint8_t CodePageFold[256] = {
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x00
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x10
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x20
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x30
+  0x00, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, // 0x40
+  0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x50
+  0x00, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, // 0x60
+  0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x70
+  0x00, 0x00, 0x65, 0x75, 0x69, 0x6F, 0x87, 0x87, 0x61, 0x61, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, // 0x80
+  0x90, 0x91, 0x92, 0x93, 0x95, 0x95, 0x6E, 0x6E, 0x00, 0x00, 0x61, 0x00, 0x00, 0x00, 0x00, 0x00, // 0x90
+  0x00, 0x61, 0x00, 0xB3, 0x00, 0x6C, 0x73, 0x00, 0x00, 0x73, 0x73, 0x74, 0x7A, 0x00, 0x7A, 0x7A, // 0xA0
+  0x00, 0x61, 0x00, 0xB3, 0x00, 0x6C, 0x73, 0x00, 0x00, 0x73, 0x73, 0x74, 0x7A, 0x00, 0x7A, 0x7A, // 0xB0
+  0x72, 0x61, 0x61, 0x61, 0x61, 0x6C, 0x63, 0x63, 0x63, 0x65, 0x65, 0x65, 0x65, 0x69, 0x69, 0x64, // 0xC0
+  0xF0, 0x6E, 0x6E, 0x6F, 0x6F, 0x6F, 0x6F, 0x00, 0x72, 0x75, 0x75, 0x75, 0x75, 0x79, 0x74, 0xDF, // 0xD0
+  0x72, 0x61, 0x61, 0x61, 0x61, 0x6C, 0x63, 0x63, 0x63, 0x65, 0x65, 0x65, 0x65, 0x69, 0x69, 0x64, // 0xE0
+  0xF0, 0x6E, 0x6E, 0x6F, 0x6F, 0x6F, 0x6F, 0x00, 0x72, 0x75, 0x75, 0x75, 0x75, 0x79, 0x74, 0x00  // 0xF0
+};
+
+/**
+ * @brief Get the code page char of the Unicode char, ASCII directly,
+ * other chars by binary search of the sorted codes.
+ * 
+ * @param unicode 
+ * @return char the char or CODEPAGE_UNKNOWN if it has no code
+ */
+char getCodePageChar(uint16_t unicode) {
+  if (unicode >= 0x20 && unicode < 0x7F) {
+    return (char)unicode;
+  }
+
+  int low = 0;
+  int high = CODEPAGE_EXTRA - 1;
+
+  while (low <= high) {
+    int mid = (low + high) / 2;
+
+    if (CodePageCodes[mid].unicode == unicode) {
+      return (char)CodePageCodes[mid].code;
+    }
+
+    if (CodePageCodes[mid].unicode < unicode) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+
+  return CODEPAGE_UNKNOWN;
+}
+
+/**
+ * @brief Decode UTF-8 text to code page chars, malformed sequences
+ * and chars without code are stored as CODEPAGE_UNKNOWN.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t number of decoded chars, at most size
+ */
+size_t decodeUtf8(const uint8_t *src, size_t len, char *dst, size_t size) {
+  size_t count = 0;
+  size_t idx = 0;
+
+  while (idx < len && count < size) {
+    uint8_t lead = src[idx++];
+    uint32_t unicode = lead;
+    int extra = 0;
+
+    if (lead >= 0xF0) {
+      unicode = lead & 0x07;
+      extra = 3;
+    }
+    else if (lead >= 0xE0) {
+      unicode = lead & 0x0F;
+      extra = 2;
+    }
+    else if (lead >= 0xC0) {
+      unicode = lead & 0x1F;
+      extra = 1;
+    }
+    else if (lead >= 0x80) {
+      unicode = 0xFFFF;
+    }
+
+    for (; extra > 0 && idx < len && (src[idx] & 0xC0) == 0x80; --extra) {
+      unicode = (unicode << 6) | (src[idx++] & 0x3F);
+    }
+
+    dst[count++] = extra == 0 && unicode <= 0xFFFF ? getCodePageChar(unicode) : CODEPAGE_UNKNOWN;
+  }
+
+  return count;
+}
+
+/**
+ * @brief Encode one code page char to UTF-8, chars without Unicode
+ * as CODEPAGE_UNKNOWN.
+ * 
+ * @param ch 
+ * @param dst at least 3 bytes
+ * @return uint8_t number of bytes
+ */
+uint8_t encodeUtf8Char(char ch, uint8_t *dst) {
+  uint16_t unicode = getUnicode(ch);
+
+  if (unicode == 0) {
+    unicode = CODEPAGE_UNKNOWN;
+  }
+
+  if (unicode < 0x80) {
+    dst[0] = unicode;
+    return 1;
+  }
+
+  if (unicode < 0x800) {
+    dst[0] = 0xC0 | (unicode >> 6);
+    dst[1] = 0x80 | (unicode & 0x3F);
+    return 2;
+  }
+
+  dst[0] = 0xE0 | (unicode >> 12);
+  dst[1] = 0x80 | ((unicode >> 6) & 0x3F);
+  dst[2] = 0x80 | (unicode & 0x3F);
+  return 3;
+}
+
+/**
+ * @brief Encode code page chars to UTF-8, stops before the first
+ * char that does not fit.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t number of bytes
+ */
+size_t encodeUtf8(const char *src, size_t len, uint8_t *dst, size_t size) {
+  size_t count = 0;
+  uint8_t bytes[3];
+
+  for (size_t idx = 0; idx < len; ++idx) {
+    uint8_t n = encodeUtf8Char(src[idx], bytes);
+
+    if (count + n > size) {
+      break;
+    }
+
+    for (uint8_t byte = 0; byte < n; ++byte) {
+      dst[count++] = bytes[byte];
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief Encode code page chars to big endian UCS-2 as used by the
+ * SMS UCS-2 alphabet, stops before the first char that does not fit.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t number of bytes
+ */
+size_t encodeUcs2(const char *src, size_t len, uint8_t *dst, size_t size) {
+  size_t count = 0;
+
+  for (size_t idx = 0; idx < len && count + 2 <= size; ++idx) {
+    uint16_t unicode = getUnicode(src[idx]);
+
+    if (unicode == 0) {
+      unicode = CODEPAGE_UNKNOWN;
+    }
+
+    dst[count++] = unicode >> 8;
+    dst[count++] = unicode & 0xFF;
+  }
+
+  return count;
+}
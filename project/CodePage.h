@@ -0,0 +1,110 @@
+/**
+ * @file CodePage.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef CODEPAGE_H
+#define CODEPAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Chars of the code page above ASCII
+#define CODEPAGE_EXTRA 124
+
+// Char stored for text without a code
+#define CODEPAGE_UNKNOWN '?'
+
+/**
+ * @brief Structure for the code of one Unicode char.
+ * 
+ */
+typedef struct {
+  uint16_t unicode;
+  uint8_t code;
+} CodePageEntry;
+
+// Unicode of every code, zero for codes without char
+extern const uint16_t CodePageUnicode[256];
+
+/**
+ * @brief Get the Unicode of the code page char.
+ * 
+ * @param ch 
+ * @return uint16_t the Unicode or zero if the code has no char
+ */
+inline uint16_t getUnicode(char ch) {
+  return CodePageUnicode[(uint8_t)ch];
+}
+
+// Search key of every code, zero for word separators
+extern const uint8_t CodePageFold[256];
+
+/**
+ * @brief Get the search key of the char, letters are folded to lower
+ * case without diacritics, so typed queries match any spelling.
+ * 
+ * @param ch 
+ * @return char the key or zero if the char separates words
+ */
+inline char foldChar(char ch) {
+  return CodePageFold[(uint8_t)ch];
+}
+
+/**
+ * @brief Get the code page char of the Unicode char.
+ * 
+ * @param unicode 
+ * @return char 
+ */
+char getCodePageChar(uint16_t unicode);
+
+/**
+ * @brief Decode UTF-8 text to code page chars.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t 
+ */
+size_t decodeUtf8(const uint8_t *src, size_t len, char *dst, size_t size);
+
+/**
+ * @brief Encode one code page char to UTF-8.
+ * 
+ * @param ch 
+ * @param dst 
+ * @return uint8_t 
+ */
+uint8_t encodeUtf8Char(char ch, uint8_t *dst);
+
+/**
+ * @brief Encode code page chars to UTF-8.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t 
+ */
+size_t encodeUtf8(const char *src, size_t len, uint8_t *dst, size_t size);
+
+/**
+ * @brief Encode code page chars to big endian UCS-2.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return size_t 
+ */
+size_t encodeUcs2(const char *src, size_t len, uint8_t *dst, size_t size);
+
+#endif
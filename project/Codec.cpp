@@ -0,0 +1,355 @@
+/**
+ * @file Codec.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Codec.h"
+#include "CodePage.h"
+
+// Septets of every code page char, the GSM 03.38 septet, the
+// extension septet with CODEC_ESCAPE set or CODEC_VERBATIM,
+// generated by tools/smscodec.py
+const uint8_t CodecSeptets[256] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0x00
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0x10
+  0x20, 0x21, 0x22, 0x23, 0x02, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, // 0x20
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, // 0x30
+  0x00, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x40
+  0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0xBC, 0xAF, 0xBE, 0x94, 0x11, // 0x50
+  0xFF, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, // 0x60
+  0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0xA8, 0xC0, 0xA9, 0xBD, 0xFF, // 0x70
+  0x01, 0x03, 0x04, 0x06, 0x07, 0x08, 0x0B, 0x0C, 0x0E, 0x0F, 0x10, 0x12, 0x13, 0x14, 0x15, 0x16, // 0x80
+  0x17, 0x18, 0x19, 0x1A, 0x1C, 0x1D, 0x5D, 0x7D, 0x40, 0x60, 0x7F, 0xE5, 0xFF, 0xFF, 0xFF, 0xFF, // 0x90
+  0xFF, 0xFF, 0xFF, 0xFF, 0x24, 0xFF, 0xFF, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0xA0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0xB0
+  0xFF, 0xFF, 0xFF, 0xFF, 0x5B, 0xFF, 0xFF, 0x09, 0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0xC0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x5C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x5E, 0xFF, 0xFF, 0x1E, // 0xD0
+  0xFF, 0xFF, 0xFF, 0xFF, 0x7B, 0xFF, 0xFF, 0xFF, 0xFF, 0x05, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 0xE0
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x7E, 0xFF, 0xFF, 0xFF  // 0xF0
+};
+
+// Code page char of every GSM 03.38 septet
+const uint8_t CodecChars[128] = {
+  0x40, 0x80, 0x24, 0x81, 0x82, 0xE9, 0x83, 0x84, 0x85, 0xC7, 0x00, 0x86, 0x87, 0x00, 0x88, 0x89, // 0x00
+  0x8A, 0x5F, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x90, 0x91, 0x92, 0x93, 0x00, 0x94, 0x95, 0xDF, 0xC9, // 0x10
+  0x20, 0x21, 0x22, 0x23, 0xA4, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, // 0x20
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F, // 0x30
+  0x98, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, // 0x40
+  0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0xC4, 0xD6, 0x96, 0xDC, 0xA7, // 0x50
+  0x99, 0x61, 0x62, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, 0x6D, 0x6E, 0x6F, // 0x60
+  0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0xE4, 0xF6, 0x97, 0xFC, 0x9A  // 0x70
+};
+
+// Meaning of the septet after ESC, a dictionary word index,
+// CODEC_EXTENSION for an extension table char or CODEC_NONE
+const uint8_t CodecEscapes[128] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, // 0x00
+  0x08, 0x09, CODEC_EXTENSION, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, // 0x08
+  0x0F, 0x10, 0x11, 0x12, CODEC_EXTENSION, 0x13, 0x14, 0x15, // 0x10
+  0x16, 0x17, 0x18, CODEC_NONE, 0x19, 0x1A, 0x1B, 0x1C, // 0x18
+  0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, // 0x20
+  CODEC_EXTENSION, CODEC_EXTENSION, 0x25, 0x26, 0x27, 0x28, 0x29, CODEC_EXTENSION, // 0x28
+  0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, // 0x30
+  0x32, 0x33, 0x34, 0x35, CODEC_EXTENSION, CODEC_EXTENSION, CODEC_EXTENSION, 0x36, // 0x38
+  CODEC_EXTENSION, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, // 0x40
+  0x3E, 0x3F, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, // 0x48
+  0x46, 0x47, 0x48, 0x49, 0x4A, 0x4B, 0x4C, 0x4D, // 0x50
+  0x4E, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, // 0x58
+  0x56, 0x57, 0x58, 0x59, 0x5A, CODEC_EXTENSION, 0x5B, 0x5C, // 0x60
+  0x5D, 0x5E, 0x5F, 0x60, 0x61, 0x62, 0x63, 0x64, // 0x68
+  0x65, 0x66, 0x67, 0x68, 0x69, 0x6A, 0x6B, 0x6C, // 0x70
+  0x6D, 0x6E, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE  // 0x78
+};
+
+// Extension table septets and their code page chars
+const CodecExtension CodecExtensions[CODEC_EXTENSIONS] = {
+  {0x14, 0x5E}, {0x28, 0x7B}, {0x29, 0x7D}, {0x2F, 0x5C}, {0x3C, 0x5B}, {0x3D, 0x7E}, {0x3E, 0x5D}, {0x40, 0x7C}, {0x65, 0x9B}
+};
+
+// Septet after ESC of every dictionary word
+const uint8_t CodecWordSeptets[] = {
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0x10, // 0x00
+  0x11, 0x12, 0x13, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, // 0x10
+  0x23, 0x24, 0x25, 0x26, 0x27, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35, // 0x20
+  0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3F, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, // 0x30
+  0x4A, 0x4B, 0x4C, 0x4D, 0x4E, 0x4F, 0x50, 0x51, 0x52, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, // 0x40
+  0x5A, 0x5B, 0x5C, 0x5D, 0x5E, 0x5F, 0x60, 0x61, 0x62, 0x63, 0x64, 0x66, 0x67, 0x68, 0x69, 0x6A, // 0x50
+  0x6B, 0x6C, 0x6D, 0x6E, 0x6F, 0x70, 0x71, 0x72, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79  // 0x60
+};
+
+// Dictionary words by first char and longest first, trained on
+// tools/messages/sms.txt
+const char *const CodecWords[] = {
+  " minut.", " probl", " talk ", " zavol", " call", " dnes",
+  " for ", " home", " the ", " this", " you ", " are",
+  " bud", " is ", " me ", " my ", " na ", " tam",
+  " to ", " you", " za ", " \xE8" "as", " be", " co",
+  " do", " ho", " je", " mi", " mo", " ne",
+  " no", " po", " pr", " se", " ta", " v ",
+  " we", ", d", ", j", ", o", ", z", "Can",
+  "Dob", "I'm ", "Jsem", "The ", "all me ", "ation",
+  "at ", "atu", "ck ", "day", "der", "echno",
+  "e js", "e a", "ed ", "eet", "em.", "eme",
+  "ext", "e\xE8" "e", "fic", "get", "here ", "hank",
+  "inner", "ill ", "ing ", "in ", "it ", "kend",
+  "kol", "late", "ment", "me ", "me.", "night",
+  "ning", "nce", "nd ", "oc, ", "oon.", "orry",
+  "our ", "on ", "out", "ow ", "please", "read",
+  "st ", "tomorrow", "today", "t's ", "ter", "tra",
+  "u n", "uju", "ve ", "ved", "when", "\xB9",
+  "\xBE", "\xE1", "\xEC", "\xED", "\xEF ", "\xF8",
+  "\xF9\xBE", "\xF9", "\xFD"
+};
+
+// First dictionary word of every code page char or CODEC_NONE
+const uint8_t CodecFirst[256] = {
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x00
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x08
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x10
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x18
+  0x00, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x20
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x25, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x28
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x30
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x38
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x29, 0x2A, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x40
+  CODEC_NONE, 0x2B, 0x2C, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x48
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x2D, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x50
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x58
+  CODEC_NONE, 0x2E, CODEC_NONE, 0x32, 0x33, 0x35, 0x3E, 0x3F, // 0x60
+  0x40, 0x42, CODEC_NONE, 0x47, 0x49, 0x4A, 0x4D, 0x51, // 0x68
+  0x58, CODEC_NONE, 0x59, 0x5A, 0x5B, 0x60, 0x62, 0x64, // 0x70
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x78
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x80
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x88
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x90
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0x98
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xA0
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xA8
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xB0
+  CODEC_NONE, 0x65, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x66, CODEC_NONE, // 0xB8
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xC0
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xC8
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xD0
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xD8
+  CODEC_NONE, 0x67, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xE0
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x68, 0x69, CODEC_NONE, 0x6A, // 0xE8
+  CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, CODEC_NONE, // 0xF0
+  0x6B, 0x6C, CODEC_NONE, CODEC_NONE, CODEC_NONE, 0x6E, CODEC_NONE, CODEC_NONE  // 0xF8
+};
+
+static_assert(sizeof(CodecWords) / sizeof(CodecWords[0]) == CODEC_WORDS, "CODEC_WORDS must match the generated dictionary");
+static_assert(sizeof(CodecWordSeptets) == CODEC_WORDS, "Every dictionary word needs its septet");
+
+/**
+ * @brief Find the longest dictionary word at the text position, the
+ * words of one first char are sorted longest first.
+ * 
+ * @param text 
+ * @param pos 
+ * @param len 
+ * @param wordLen length of the found word
+ * @return uint8_t word index or CODEC_NONE
+ */
+uint8_t findCodecWord(const char *text, uint8_t pos, uint8_t len, uint8_t *wordLen) {
+  char ch = text[pos];
+
+  for (uint8_t idx = CodecFirst[(uint8_t)ch]; idx < CODEC_WORDS && CodecWords[idx][0] == ch; ++idx) {
+    const char *word = CodecWords[idx];
+    uint8_t matched = 1;
+    while (word[matched] != '\0' && pos + matched < len && word[matched] == text[pos + matched]) {
+      matched++;
+    }
+
+    if (word[matched] == '\0') {
+      *wordLen = matched;
+      return idx;
+    }
+  }
+
+  return CODEC_NONE;
+}
+
+/**
+ * @brief Pack the code page text, dictionary words become ESC and
+ * the word septet, other chars their GSM 03.38 septets, 7 bits each
+ * from the lowest bit of the first byte like an SMS.
+ * 
+ * @param text 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return uint8_t packed bytes or zero if they do not fit the size
+ * or the text has a char without code
+ */
+uint8_t encodeMessage(const char *text, uint8_t len, uint8_t *dst, uint8_t size) {
+  uint32_t bits = 0;
+  uint8_t count = 0;
+  uint8_t out = 0;
+  uint8_t pos = 0;
+
+  while (pos < len) {
+    uint8_t septets[3];
+    uint8_t septetCount = 0;
+    uint8_t wordLen = 0;
+    uint8_t word = findCodecWord(text, pos, len, &wordLen);
+
+    if (word != CODEC_NONE) {
+      septets[septetCount++] = CODEC_ESC;
+      septets[septetCount++] = CodecWordSeptets[word];
+      pos += wordLen;
+    }
+    else {
+      uint8_t ch = text[pos++];
+      uint8_t septet = CodecSeptets[ch];
+
+      if (septet == CODEC_VERBATIM) {
+        // Only the backtick and codes above ASCII survive the low bits
+        if (ch < 0x80 && ch != '`') return 0;
+        septets[septetCount++] = CODEC_ESC;
+        septets[septetCount++] = CODEC_ESC;
+        septets[septetCount++] = ch == '`' ? 0 : ch & 0x7F;
+      }
+      else if (septet & CODEC_ESCAPE) {
+        septets[septetCount++] = CODEC_ESC;
+        septets[septetCount++] = septet & 0x7F;
+      }
+      else {
+        septets[septetCount++] = septet;
+      }
+    }
+
+    for (uint8_t idx = 0; idx < septetCount; ++idx) {
+      bits |= (uint32_t)septets[idx] << count;
+      count += 7;
+
+      while (count >= 8) {
+        if (out == size) return 0;
+        dst[out++] = bits & 0xFF;
+        bits >>= 8;
+        count -= 8;
+      }
+    }
+  }
+
+  if (count > 0) {
+    if (out == size) return 0;
+    dst[out++] = bits & 0xFF;
+  }
+
+  return out;
+}
+
+/**
+ * @brief Start decoding the packed text, the bytes are fetched only
+ * when the next septet needs them.
+ * 
+ * @param reader 
+ * @param fetch 
+ * @param context passed to fetch
+ * @param len chars of the text
+ */
+void openCodecReader(CodecReader *reader, CodecFetch fetch, void *context, uint8_t len) {
+  reader->fetch = fetch;
+  reader->context = context;
+  reader->bits = 0;
+  reader->count = 0;
+  reader->word = NULL;
+  reader->left = len;
+}
+
+/**
+ * @brief Get the next septet, fetching a byte when fewer than
+ * 7 bits are left.
+ * 
+ * @param reader 
+ * @return uint8_t 
+ */
+uint8_t readSeptet(CodecReader *reader) {
+  if (reader->count < 7) {
+    reader->bits |= (uint16_t)reader->fetch(reader->context) << reader->count;
+    reader->count += 8;
+  }
+
+  uint8_t septet = reader->bits & 0x7F;
+  reader->bits >>= 7;
+  reader->count -= 7;
+  return septet;
+}
+
+/**
+ * @brief Take the next char of the pending dictionary word.
+ * 
+ * @param reader 
+ * @return char 
+ */
+char readWordChar(CodecReader *reader) {
+  char ch = *reader->word++;
+  if (*reader->word == '\0') reader->word = NULL;
+  return ch;
+}
+
+/**
+ * @brief Decode the next char.
+ * 
+ * @param reader 
+ * @return char 
+ */
+char readCodecChar(CodecReader *reader) {
+  if (reader->word != NULL) {
+    return readWordChar(reader);
+  }
+
+  uint8_t septet = readSeptet(reader);
+  if (septet != CODEC_ESC) {
+    return CodecChars[septet];
+  }
+
+  septet = readSeptet(reader);
+  if (septet == CODEC_ESC) {
+    septet = readSeptet(reader);
+    return septet == 0 ? '`' : 0x80 | septet;
+  }
+
+  uint8_t escape = CodecEscapes[septet];
+  if (escape == CODEC_EXTENSION) {
+    for (uint8_t idx = 0; idx < CODEC_EXTENSIONS; ++idx) {
+      if (CodecExtensions[idx].septet == septet) return CodecExtensions[idx].code;
+    }
+  }
+  else if (escape != CODEC_NONE) {
+    reader->word = CodecWords[escape];
+    return readWordChar(reader);
+  }
+
+  return CODEPAGE_UNKNOWN;
+}
+
+/**
+ * @brief Decode the next chars straight into the destination, no
+ * copy of the whole text is made.
+ * 
+ * @param reader 
+ * @param dst NULL to skip the chars
+ * @param len 
+ * @return uint8_t number of decoded chars
+ */
+uint8_t readCodec(CodecReader *reader, char *dst, uint8_t len) {
+  if (len > reader->left) len = reader->left;
+
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    char ch = readCodecChar(reader);
+    if (dst != NULL) dst[idx] = ch;
+  }
+
+  reader->left -= len;
+  return len;
+}
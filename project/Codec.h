@@ -0,0 +1,101 @@
+/**
+ * @file Codec.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef CODEC_H
+#define CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Words of the static dictionary, generated by tools/smscodec.py
+#define CODEC_WORDS 111
+
+// Chars of the GSM 03.38 extension table in the code page
+#define CODEC_EXTENSIONS 9
+
+// Escape septet of the extension table, dictionary words and
+// verbatim chars
+#define CODEC_ESC 0x1B
+
+// Septet table marks, the septet follows ESC or the char is sent
+// verbatim as ESC ESC and its low 7 bits
+#define CODEC_ESCAPE 0x80
+#define CODEC_VERBATIM 0xFF
+
+// Escape table marks, extension table char or unused septet
+#define CODEC_EXTENSION 0xFE
+#define CODEC_NONE 0xFF
+
+// Encode and decode rounds of the link codec benchmark
+#define CODEC_BENCH_ROUNDS 16
+
+/**
+ * @brief Structure for one char of the GSM 03.38 extension table.
+ * 
+ */
+typedef struct {
+  uint8_t septet;
+  uint8_t code;
+} CodecExtension;
+
+/**
+ * @brief Get the next byte of the packed text.
+ * 
+ */
+typedef uint8_t (*CodecFetch)(void *context);
+
+/**
+ * @brief Structure for a streaming decoder, the unread bits of the
+ * last fetched byte, the rest of the pending dictionary word and the
+ * chars left.
+ * 
+ */
+typedef struct {
+  CodecFetch fetch;
+  void *context;
+  uint16_t bits;
+  uint8_t count;
+  const char *word;
+  uint8_t left;
+} CodecReader;
+
+/**
+ * @brief Pack the code page text.
+ * 
+ * @param text 
+ * @param len 
+ * @param dst 
+ * @param size 
+ * @return uint8_t 
+ */
+uint8_t encodeMessage(const char *text, uint8_t len, uint8_t *dst, uint8_t size);
+
+/**
+ * @brief Start decoding the packed text.
+ * 
+ * @param reader 
+ * @param fetch 
+ * @param context 
+ * @param len 
+ */
+void openCodecReader(CodecReader *reader, CodecFetch fetch, void *context, uint8_t len);
+
+/**
+ * @brief Decode the next chars.
+ * 
+ * @param reader 
+ * @param dst 
+ * @param len 
+ * @return uint8_t 
+ */
+uint8_t readCodec(CodecReader *reader, char *dst, uint8_t len);
+
+#endif
@@ -4,14 +4,12 @@
  * @brief 
  * @version 0.1
  * @date 2025-12-16
- *
+ * 
  * @copyright Copyright (c) 2025
  * 
  */
 
-#include <SPI.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
+#include <Arduino.h>
 
 #include <stdint.h>
 #include <stdio.h>
@@ -20,134 +18,254 @@
 #include "Display.h"
 #include "Buffer.h"
 #include "Keypad.h"
+#include "Undo.h"
+#include "Mirror.h"
+#include "Render.h"
+#include "Editor.h"
+#include "CodePage.h"
+#include "Flow.h"
+#include "Latency.h"
+#include "Spell.h"
+
+// Display flush statistics, counted by the device flush only, so
+// they stay process wide even with editors on many host threads
+FrameStats frameStats = {0, 0, 0};
+
+// Display panel driver of the device editor
+DisplayPanel Display;
+
+// Cursor move repeat delays of the held key, the last one repeats
+const uint16_t MoveRepeatDelays[CURSOR_MOVE_STEPS] = {
+  CURSOR_MOVE_DELAY, CURSOR_MOVE_DELAY, 150, 100, 70, 50, 35, 25
+};
 
-extern uint64_t now;
-extern uint8_t bufferIndex;
+/**
+ * @brief Start the display panel and reset it.
+ * 
+ * @param editor 
+ */
+void initDisplay(Editor *editor) {
+  editor->display->begin();
+  resetDisplay(editor);
+  flushDisplay(editor);
+}
 
-// Flag for cursor visibility
-bool cursorVisible = false;
+/**
+ * @brief Clear the display panel of the editor, set size and color
+ * of the text, set rotation of display and cursor coordinates.
+ * 
+ * @param editor 
+ */
+void resetDisplay(Editor *editor) {
+  editor->display->clearDisplay();
+  editor->display->setTextSize(TEXT_SIZE);
+  editor->display->setTextColor(COLOR_WHITE);
+  editor->display->setRotation(DISPLAY_ROTATION);
+  editor->display->setCursor(MIN_X_POS, MIN_Y_POS);
+}
 
-// Flag for cursor enabled
-bool cursorEnabled = true;
+/**
+ * @brief Send the framebuffer of the editor to its display, the
+ * editor flush hook is used when set.
+ * 
+ * @param editor 
+ */
+void flushDisplay(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_FLUSH);
 
-// Time of last cursor blink
-uint64_t lastBlinkTime = 0;
+  if (editor->flush != NULL) {
+    editor->flush(editor);
+  }
+  else {
+    editor->display->display();
+  }
 
-// Counter of scroll rows
-uint16_t scrollRow = 0;
+  enterLoopPhase(phase);
+}
 
-// Adafruit display object
-Adafruit_SSD1306 Display(
-  SCREEN_WIDTH,
-  SCREEN_HEIGHT,
-  SPI_MOSI,
-  SPI_CLK,
-  SPI_DC,
-  SPI_RST,
-  SPI_CS
-);
+/**
+ * @brief Flush hook of the device editor, sends the framebuffer to
+ * the mirror and to the display, with render task the frame is only
+ * handed over to the other core.
+ * 
+ * @param editor 
+ */
+void flushDevice(Editor *editor) {
+  if (DisplayPanel::PixelFormat::PAGED) {
+    mirrorFrame(editor->display->getBuffer());
+  }
+
+#if USE_RENDER_TASK
+  publishFrame();
+#else
+  uint32_t startTime = micros();
+  editor->display->display();
+  recordFlush(micros() - startTime);
+#endif
+}
 
 /**
- * @brief Start and clear the display, set size and color
- * of the text, set rotation of display and cursor coordinates.
+ * @brief Count the flush and time spent in the display transfer.
+ * 
+ * @param time 
+ */
+void recordFlush(uint32_t time) {
+  frameStats.lastFlushTime = time;
+  frameStats.flushTime += time;
+  frameStats.flushes++;
+}
+
+/**
+ * @brief Send the current framebuffer to the host as mirror keyframe,
+ * the enabled cursor is always captured visible so the snapshot does
+ * not depend on the blink phase.
+ * 
+ * @param editor 
+ */
+void snapshotDisplay(Editor *editor) {
+  if (editor->cursorEnabled && !editor->helpVisible && !editor->pickerVisible && !editor->historyVisible &&
+      !editor->sending) {
+    drawCursor(editor, true);
+    restartBlink(editor, editor->now);
+  }
+
+  if (DisplayPanel::PixelFormat::PAGED) {
+    mirrorSnapshot(editor->display->getBuffer());
+  }
+}
+
+/**
+ * @brief Get the display flush statistics.
  * 
+ * @return FrameStats 
  */
-void initDisplay() {
-  Display.begin(SSD1306_SWITCHCAPVCC);
-  Display.clearDisplay();
-  Display.setTextSize(2);
-  Display.setTextColor(SSD1306_WHITE);
-  Display.setRotation(2);
-  Display.setCursor(MIN_X_POS, MIN_Y_POS);
-  Display.display();
+FrameStats getFrameStats() {
+  return frameStats;
 }
 
 /**
  * @brief Draw the header with active case mode, current line,
  * remaining characters and current page.
  * 
+ * @param editor 
  */
-void drawHeader() {
+void drawHeader(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_RENDER);
+
   // Save message cursor position
-  int16_t savedX = Display.getCursorX();
-  int16_t savedY = Display.getCursorY();
+  int16_t savedX = editor->display->getCursorX();
+  int16_t savedY = editor->display->getCursorY();
 
   // Clear header
-  Display.fillRect(0, 0, SCREEN_WIDTH, HEADER_HEIGHT, SSD1306_BLACK);
+  editor->display->fillRect(0, 0, SCREEN_WIDTH, HEADER_HEIGHT, COLOR_BLACK);
 
   // Case mode
-  Display.setTextSize(1);
-  Display.setTextColor(SSD1306_WHITE);
-  Display.setCursor(2, 1);
-  CaseMode mode = getCaseMode();
+  editor->display->setTextSize(1);
+  editor->display->setTextColor(COLOR_WHITE);
+  editor->display->setCursor(2, 1);
+  CaseMode mode = getCaseMode(editor);
   switch (mode) {
-    case MODE_LOWER: Display.print("abc"); break;
-    case MODE_UPPER: Display.print("ABC"); break;
-    case MODE_SMART: Display.print("Abc"); break;
-    default:         Display.print("???"); break;
+    case MODE_LOWER: editor->display->print("abc"); break;
+    case MODE_UPPER: editor->display->print("ABC"); break;
+    case MODE_SMART: editor->display->print("Abc"); break;
+    default:         editor->display->print("???"); break;
+  }
+
+  // Layout name unless the default layout is used
+  if (editor->layoutIndex != LAYOUT_ENGLISH) {
+    char name[LAYOUT_NAME_SIZE + 2] = " ";
+    memcpy(&name[1], editor->layout->name, LAYOUT_NAME_SIZE);
+    editor->display->print(name);
   }
 
   // Current line
   char line[15];
-  int currentLine = (bufferIndex / CHARS_PER_LINE) + 1;
+  int currentLine = (editor->bufferIndex / CHARS_PER_LINE) + 1;
   sprintf(line, "Line %d", currentLine);
   int16_t textWidth = strlen(line) * HEADER_FONT_WIDTH;
   int16_t lineX = (SCREEN_WIDTH - textWidth) / 2;
-  Display.setCursor(lineX, 1);
-  Display.print(line);
+  editor->display->setCursor(lineX, 1);
+  editor->display->print(line);
   
   // Remaining characters and page
   char stats[15];
-  int remaining = MESSAGE_SIZE - getBufferLen();
-  int page = (scrollRow / VISIBLE_LINES) + 1;
+  int remaining = MESSAGE_SIZE - getBufferLen(editor);
+  int page = (editor->scrollRow / VISIBLE_LINES) + 1;
   sprintf(stats, "%d/%d", remaining, page);
   int16_t statsX = SCREEN_WIDTH - (strlen(stats) * HEADER_FONT_WIDTH) - 2;
-  Display.setCursor(statsX, 1);
-  Display.print(stats);
+  editor->display->setCursor(statsX, 1);
+  editor->display->print(stats);
 
   // Restore text settings and message cursor position
-  Display.setTextSize(2);
-  Display.setTextColor(SSD1306_WHITE);
-  Display.setCursor(savedX, savedY);
+  editor->display->setTextSize(TEXT_SIZE);
+  editor->display->setTextColor(COLOR_WHITE);
+  editor->display->setCursor(savedX, savedY);
+
+  flushDisplay(editor);
 
-  Display.display();
+  enterLoopPhase(phase);
+}
+
+/**
+ * @brief Underline the char cell of the index when its word is marked
+ * as misspelled and the cell is on the scrolled page.
+ * 
+ * @param editor 
+ * @param index 
+ */
+void drawSpellMark(Editor *editor, int index) {
+  int cell = index - editor->scrollRow * CHARS_PER_LINE;
+
+  if (cell >= 0 && cell < VISIBLE_LINES * CHARS_PER_LINE && isSpellMark(editor, index)) {
+    editor->display->drawFastHLine(MIN_X_POS + (cell % CHARS_PER_LINE) * FONT_WIDTH,
+                                   MIN_Y_POS + (cell / CHARS_PER_LINE + 1) * FONT_HEIGHT - 1,
+                                   FONT_WIDTH, COLOR_WHITE);
+  }
 }
 
 /**
  * @brief Draw the message from the buffer based on scrolled page.
  * 
+ * @param editor 
  */
-void drawMessage() {
+void drawMessage(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_RENDER);
+
   // Clear the text area
-  Display.fillRect(MIN_X_POS, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, SSD1306_BLACK);
+  editor->display->fillRect(MIN_X_POS, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, COLOR_BLACK);
   
   // Get start index and characters limit of the text area
-  int startIdx = scrollRow * CHARS_PER_LINE;
+  int startIdx = editor->scrollRow * CHARS_PER_LINE;
   int maxVisibleChars = VISIBLE_LINES * CHARS_PER_LINE;
+  int bufferLen = getBufferLen(editor);
 
-  Display.setCursor(MIN_X_POS, MIN_Y_POS);
-  Display.setTextColor(SSD1306_WHITE);
+  editor->display->setCursor(MIN_X_POS, MIN_Y_POS);
+  editor->display->setTextColor(COLOR_WHITE);
 
   // Draw the message characters
   for (int i = 0; i < maxVisibleChars; i++) {
     int bufferPos = startIdx + i;
 
-    if (bufferPos >= getBufferLen()) break;
+    if (bufferPos >= bufferLen) break;
 
-    char c = getBufferCharByIndex(bufferPos);
-    Display.print(c);
+    char c = getBufferCharByIndex(editor, bufferPos);
+    editor->display->print(c);
+    drawSpellMark(editor, bufferPos);
   }
+
+  enterLoopPhase(phase);
 }
 
 /**
  * @brief Get the Target Cursor Pos object
  * 
+ * @param editor 
  * @param move 
  * @return Coord 
  */
-Coord getTargetCursorPos(Move move) {
-  int16_t x = Display.getCursorX();
-  int16_t y = Display.getCursorY();
+Coord getTargetCursorPos(Editor *editor, Move move) {
+  int16_t x = editor->display->getCursorX();
+  int16_t y = editor->display->getCursorY();
 
   switch (move) {
     // Move cursor up
@@ -200,385 +318,995 @@ Coord getTargetCursorPos(Move move) {
  * message buffer and increase the bufferIndex, if screen 
  * overflows move to another page and redraw the message
  * 
+ * @param editor 
  * @param ch 
  * @param isCycle 
  */
-void drawChar(char ch, bool isCycle) {
-  // If message length hits the message limit return
-  if (getBufferLen() == MESSAGE_SIZE) return;
+void drawChar(Editor *editor, char ch, bool isCycle) {
+  // If message length hits the message limit return, the cycle
+  // only replaces the last char
+  if (!isCycle && getBufferLen(editor) == MESSAGE_SIZE) return;
 
   // Move the cursor one position back in left direction
   if (isCycle) {
-    Coord crs = getTargetCursorPos(MOVE_LEFT);
-    Display.setCursor(crs.x, crs.y);
+    Coord crs = getTargetCursorPos(editor, MOVE_LEFT);
+    editor->display->setCursor(crs.x, crs.y);
+  }
+
+  // Cycled char is on the previous page, the page is scrolled
+  // back so the overflow below redraws the message
+  if (isCycle && editor->bufferIndex / CHARS_PER_LINE < editor->scrollRow) {
+    editor->scrollRow -= VISIBLE_LINES;
   }
 
-  setBufferChar(ch);
-  bufferIndex++;
+  // Char joining or splitting a marked word unmarks the word, its
+  // underline is removed by redrawing the message
+  uint32_t marks[WORD_INDEX_SIZE];
+  memcpy(marks, editor->spellMarks, sizeof(marks));
+
+  recordWrite(editor, editor->bufferIndex, ch, isCycle);
+  setBufferChar(editor, ch);
+  editor->bufferIndex++;
+
+  bool unmarked = memcmp(marks, editor->spellMarks, sizeof(marks)) != 0;
+
+  // Separator finishes the word before it
+  int marked = editor->bufferIndex;
+  if (!isSpellChar(ch)) {
+    marked = checkSpelling(editor, editor->bufferIndex - 1);
+  }
 
   // Handle text area overflow
-  int currentRow = bufferIndex / CHARS_PER_LINE;
-  if (currentRow >= scrollRow + VISIBLE_LINES) {
-    scrollRow += VISIBLE_LINES;
-    drawMessage();
+  int currentRow = editor->bufferIndex / CHARS_PER_LINE;
+  if (currentRow >= editor->scrollRow + VISIBLE_LINES) {
+    editor->scrollRow += VISIBLE_LINES;
+    drawMessage(editor);
     
-    Display.setCursor(MIN_X_POS, MIN_Y_POS);
+    editor->display->setCursor(MIN_X_POS, MIN_Y_POS);
+  }
+  else if (unmarked) {
+    drawMessage(editor);
+
+    int relativeRow = currentRow - editor->scrollRow;
+    int col = editor->bufferIndex % CHARS_PER_LINE;
+    editor->display->setCursor(MIN_X_POS + col * FONT_WIDTH, MIN_Y_POS + relativeRow * FONT_HEIGHT);
   }
   else {
-    Display.setTextColor(SSD1306_WHITE, SSD1306_BLACK);
-    Display.print(ch);
+    editor->display->setTextColor(COLOR_WHITE, COLOR_BLACK);
+    editor->display->print(ch);
+
+    for (int idx = marked; idx < editor->bufferIndex - 1; ++idx) {
+      drawSpellMark(editor, idx);
+    }
+  }
+
+  flushDisplay(editor);
+}
+
+/**
+ * @brief Insert the whole text into message buffer on the bufferIndex
+ * position in one buffer operation, move the bufferIndex after the
+ * text and redraw the message only once for the whole text.
+ * 
+ * @param editor 
+ * @param text 
+ * @param len 
+ * @param time 
+ * @return uint8_t count of inserted chars
+ */
+uint8_t drawText(Editor *editor, const char *text, uint8_t len, uint64_t time) {
+  uint8_t inserted = insertBufferString(editor, editor->bufferIndex, text, len);
+
+  if (inserted > 0) {
+    recordInsert(editor, editor->bufferIndex, inserted);
+
+    // Check the words finished by the separators of the text
+    for (uint8_t idx = 0; idx < inserted; ++idx) {
+      if (!isSpellChar(getBufferCharByIndex(editor, editor->bufferIndex + idx))) {
+        checkSpelling(editor, editor->bufferIndex + idx);
+      }
+    }
+
+    editor->bufferIndex += inserted;
+    refreshMessage(editor, time);
   }
 
-  Display.display();
+  return inserted;
 }
 
 /**
  * @brief Draw the cursor as filled rectangle or if there 
  * is char under the cursor draw as outline rectangle. 
  * 
+ * @param editor 
  * @param visible 
  */
-void drawCursor(bool visible) {
-  int16_t targetX = Display.getCursorX();
-  int16_t targetY = Display.getCursorY();
+void drawCursor(Editor *editor, bool visible) {
+  int16_t targetX = editor->display->getCursorX();
+  int16_t targetY = editor->display->getCursorY();
 
   // Check for cursor position screen overflow
   if (targetX + FONT_WIDTH > SCREEN_WIDTH) {
     targetX = MIN_X_POS;
     targetY += FONT_HEIGHT;
-    Display.setCursor(targetX, targetY);
+    editor->display->setCursor(targetX, targetY);
   }
 
   // Choose color of the cursor render
-  uint8_t color = visible ? SSD1306_WHITE : SSD1306_BLACK;
-  char ch = getBufferChar();
+  uint16_t color = visible ? COLOR_WHITE : COLOR_BLACK;
+  char ch = getBufferChar(editor);
   
-  // Draw outline rectangle if character present on position
-  if (ch != MESSAGE_END) {
-    Display.drawRect(targetX, targetY, FONT_WIDTH, FONT_HEIGHT, color);
+  // Draw outline rectangle if character present on position,
+  // hidden outline is removed by redrawing the whole character cell
+  if (ch != MESSAGE_END && visible) {
+    editor->display->drawRect(targetX, targetY, FONT_WIDTH, FONT_HEIGHT, color);
+  }
+  else if (ch != MESSAGE_END) {
+    editor->display->setTextColor(COLOR_WHITE, COLOR_BLACK);
+    editor->display->print(ch);
+    drawSpellMark(editor, editor->bufferIndex);
+    editor->display->setCursor(targetX, targetY);
   }
   else {
-    Display.fillRect(targetX, targetY, FONT_WIDTH, FONT_HEIGHT, color);
+    editor->display->fillRect(targetX, targetY, FONT_WIDTH, FONT_HEIGHT, color);
   }
   
-  Display.display();
-  cursorVisible = visible;
+  flushDisplay(editor);
+  editor->cursorVisible = visible;
 }
 
 /**
- * @brief Periodically redraw the cursor.
+ * @brief Toggle the cursor on blink timeout, the cursor is not
+ * blinking while disabled, help shown or the send notes shown.
  * 
+ * @param editor 
  */
-void updateCursor() {
-  // Draw the cursor if delay expired and cursor enabled
-  if (now - lastBlinkTime >= CURSOR_BLINK_DELAY && cursorEnabled) {
-    cursorVisible = !cursorVisible;
-    drawCursor(cursorVisible);
-    lastBlinkTime = now;
+void updateCursor(Editor *editor) {
+  if (editor->cursorEnabled && !editor->helpVisible && !editor->sending) {
+    editor->cursorVisible = !editor->cursorVisible;
+    drawCursor(editor, editor->cursorVisible);
   }
 }
 
+/**
+ * @brief Plan the next cursor blink from the time, cursor drawn
+ * on move or edit stays shown for the whole blink delay.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void restartBlink(Editor *editor, uint64_t time) {
+  armTimer(&editor->timers, &editor->blinkTimer, time + CURSOR_BLINK_DELAY);
+}
+
 /**
  * @brief Enable redrawing of the cursor.
  * 
+ * @param editor 
  */
-void enableCursor() {
-  cursorEnabled = true;
+void enableCursor(Editor *editor) {
+  editor->cursorEnabled = true;
 }
 
 /**
  * @brief Disable redrawing of the cursor.
  * 
+ * @param editor 
  */
-void disableCursor() {
-  drawCursor(false);
-  cursorEnabled = false;
+void disableCursor(Editor *editor) {
+  drawCursor(editor, false);
+  editor->cursorEnabled = false;
 }
 
 /**
  * @brief Delete the char from the message either at the end
  * of the message or inside the message and shift the text.
  * 
+ * @param editor 
  * @param time 
  */
-void deleteChar(uint64_t time) {
-  if (bufferIndex > 0) { 
-    drawCursor(false);
+void deleteChar(Editor *editor, uint64_t time) {
+  if (editor->bufferIndex > 0) { 
+    drawCursor(editor, false);
 
     // Decrease the buffer index and overwrite by termination character
     // if deleting before cursor otherwise remove on any position and shift text
-    if (bufferIndex == getBufferLen()) {
-      bufferIndex--;
-      setBufferChar(MESSAGE_END);
+    if (editor->bufferIndex == getBufferLen(editor)) {
+      editor->bufferIndex--;
+      recordDelete(editor, editor->bufferIndex, true, time);
+      setBufferChar(editor, MESSAGE_END);
     }
     else {
-      removeBufferChar();
+      recordDelete(editor, editor->bufferIndex, false, time);
+      removeBufferChar(editor);
     }
     
     // Handle screen overflow
-    int targetRow = bufferIndex / CHARS_PER_LINE;
-    if (targetRow < scrollRow) {
-       if (scrollRow >= VISIBLE_LINES) scrollRow -= VISIBLE_LINES;
-       else scrollRow = 0;
+    int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+    if (targetRow < editor->scrollRow) {
+       if (editor->scrollRow >= VISIBLE_LINES) editor->scrollRow -= VISIBLE_LINES;
+       else editor->scrollRow = 0;
     }
 
-    drawMessage(); 
+    drawMessage(editor); 
 
     // Set row value
-    int16_t relativeRow = targetRow - scrollRow;
+    int16_t relativeRow = targetRow - editor->scrollRow;
     if (relativeRow < 0) relativeRow = 0; 
     
     // Set cursor new position
-    int16_t newX = (bufferIndex % CHARS_PER_LINE) * FONT_WIDTH;
+    int16_t newX = (editor->bufferIndex % CHARS_PER_LINE) * FONT_WIDTH;
     int16_t newY = MIN_Y_POS + (relativeRow * FONT_HEIGHT);
-    Display.setCursor(newX, newY);
+    editor->display->setCursor(newX, newY);
 
-    drawCursor(true);
-    Display.display();
+    drawCursor(editor, true);
+    flushDisplay(editor);
     
-    lastBlinkTime = time;
+    restartBlink(editor, time);
   }
 }
 
+/**
+ * @brief Block the next move for the repeat delay of the held key,
+ * the delay shortens with every repeat along the acceleration curve.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void startMoveDelay(Editor *editor, uint64_t time) {
+  uint8_t step = editor->moveRepeats < CURSOR_MOVE_STEPS ? editor->moveRepeats : CURSOR_MOVE_STEPS - 1;
+  armTimer(&editor->timers, &editor->moveTimer, time + MoveRepeatDelays[step] + 1);
+
+  if (editor->moveRepeats < UINT8_MAX) {
+    editor->moveRepeats++;
+  }
+}
+
+/**
+ * @brief Jump the cursor to the next word start or message end, or
+ * to the previous word start, scroll to its page if needed.
+ * 
+ * @param editor 
+ * @param forward 
+ * @param time 
+ */
+void jumpWord(Editor *editor, bool forward, uint64_t time) {
+  uint8_t target = forward ? getNextWordStop(editor, editor->bufferIndex)
+                           : getPrevWordStop(editor, editor->bufferIndex);
+
+  drawCursor(editor, false);
+  editor->bufferIndex = target;
+
+  int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+  if (targetRow < editor->scrollRow || targetRow >= editor->scrollRow + VISIBLE_LINES) {
+    refreshMessage(editor, time);
+    return;
+  }
+
+  int16_t x = MIN_X_POS + (editor->bufferIndex % CHARS_PER_LINE) * FONT_WIDTH;
+  int16_t y = MIN_Y_POS + (targetRow - editor->scrollRow) * FONT_HEIGHT;
+  editor->display->setCursor(x, y);
+
+  drawCursor(editor, true);
+  restartBlink(editor, time);
+}
+
 /**
  * @brief Move the cursor up in the message text.
  * 
+ * @param editor 
  * @param time 
  */
-void moveUp(uint64_t time) {
-  if (bufferIndex >= CHARS_PER_LINE) {
+void moveUp(Editor *editor, uint64_t time) {
+  if (editor->bufferIndex >= CHARS_PER_LINE) {
     // Move up if cursor speed delay expired
-    if (time - lastBlinkTime > CURSOR_MOVE_DELAY) {
-      drawCursor(false);
-      bufferIndex -= CHARS_PER_LINE;
+    if (!isTimerArmed(&editor->moveTimer)) {
+      drawCursor(editor, false);
+      startMoveDelay(editor, time);
+      editor->bufferIndex -= CHARS_PER_LINE;
 
       // Handle the screen overflow
-      int targetRow = bufferIndex / CHARS_PER_LINE;
-      if (targetRow < scrollRow) {
-        int16_t savedX = Display.getCursorX();
+      int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+      if (targetRow < editor->scrollRow) {
+        int16_t savedX = editor->display->getCursorX();
 
-        if (scrollRow >= VISIBLE_LINES) scrollRow -= VISIBLE_LINES;
-        else scrollRow = 0;
+        if (editor->scrollRow >= VISIBLE_LINES) editor->scrollRow -= VISIBLE_LINES;
+        else editor->scrollRow = 0;
 
-        drawMessage();
-        Display.setCursor(savedX, MAX_Y_POS);
+        drawMessage(editor);
+        editor->display->setCursor(savedX, MAX_Y_POS);
       }
       else {
-        Coord crs = getTargetCursorPos(MOVE_UP);
-        Display.setCursor(crs.x, crs.y);
+        Coord crs = getTargetCursorPos(editor, MOVE_UP);
+        editor->display->setCursor(crs.x, crs.y);
       }
 
-      drawCursor(true);
-      lastBlinkTime = time;
+      drawCursor(editor, true);
+      restartBlink(editor, time);
     }
   }
   else {
-    drawCursor(true);
-    lastBlinkTime = time;
+    drawCursor(editor, true);
+    restartBlink(editor, time);
   }
 }
 
 /**
- * @brief Move the cursor left in the message text.
+ * @brief Move the cursor left in the message text, by words once
+ * the key is held for the word repeats.
  * 
+ * @param editor 
  * @param time 
  */
-void moveLeft(uint64_t time) {
-  if (bufferIndex > 0) {
+void moveLeft(Editor *editor, uint64_t time) {
+  if (editor->moveRepeats >= CURSOR_WORD_REPEATS && editor->bufferIndex > 0) {
+    if (!isTimerArmed(&editor->moveTimer)) {
+      startMoveDelay(editor, time);
+      jumpWord(editor, false, time);
+    }
+  }
+  else if (editor->bufferIndex > 0) {
     // Move left if cursor speed delay expired
-    if (time - lastBlinkTime > CURSOR_MOVE_DELAY) {
-      drawCursor(false);
-      bufferIndex--;
+    if (!isTimerArmed(&editor->moveTimer)) {
+      drawCursor(editor, false);
+      startMoveDelay(editor, time);
+      editor->bufferIndex--;
 
       // Handle the possible screen overflow
-      int targetRow = bufferIndex / CHARS_PER_LINE;
-      if (targetRow < scrollRow) {
-        if (scrollRow >= VISIBLE_LINES) scrollRow -= VISIBLE_LINES;
-        else scrollRow = 0;
+      int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+      if (targetRow < editor->scrollRow) {
+        if (editor->scrollRow >= VISIBLE_LINES) editor->scrollRow -= VISIBLE_LINES;
+        else editor->scrollRow = 0;
 
-        drawMessage();
-        Display.setCursor(MAX_X_POS, MAX_Y_POS);
+        drawMessage(editor);
+        editor->display->setCursor(MAX_X_POS, MAX_Y_POS);
       } 
       else {
-        Coord crs = getTargetCursorPos(MOVE_LEFT);
-        Display.setCursor(crs.x, crs.y);
+        Coord crs = getTargetCursorPos(editor, MOVE_LEFT);
+        editor->display->setCursor(crs.x, crs.y);
       }
 
-      drawCursor(true);
-      lastBlinkTime = time;
+      drawCursor(editor, true);
+      restartBlink(editor, time);
     }
   }
   else {
-    drawCursor(true);
-    lastBlinkTime = time;
+    drawCursor(editor, true);
+    restartBlink(editor, time);
   }
 }
 
 /**
- * @brief Move the cursor right in the message text.
+ * @brief Move the cursor right in the message text, by words once
+ * the key is held for the word repeats.
  * 
+ * @param editor 
  * @param time 
  */
-void moveRight(uint64_t time) {
-  if (bufferIndex < getBufferLen()) {
+void moveRight(Editor *editor, uint64_t time) {
+  if (editor->moveRepeats >= CURSOR_WORD_REPEATS && editor->bufferIndex < getBufferLen(editor)) {
+    if (!isTimerArmed(&editor->moveTimer)) {
+      startMoveDelay(editor, time);
+      jumpWord(editor, true, time);
+    }
+  }
+  else if (editor->bufferIndex < getBufferLen(editor)) {
     // Move right if cursor speed delay expired
-    if ((time - lastBlinkTime > CURSOR_MOVE_DELAY)) {
-      drawCursor(false);
-      bufferIndex++;
+    if (!isTimerArmed(&editor->moveTimer)) {
+      drawCursor(editor, false);
+      startMoveDelay(editor, time);
+      editor->bufferIndex++;
       
       // Handle the possible screen overflow
-      int targetRow = bufferIndex / CHARS_PER_LINE;
-      if (targetRow >= scrollRow + VISIBLE_LINES) {
-        scrollRow += VISIBLE_LINES;
-        drawMessage();
-        Display.setCursor(MIN_X_POS, MIN_Y_POS);
+      int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+      if (targetRow >= editor->scrollRow + VISIBLE_LINES) {
+        editor->scrollRow += VISIBLE_LINES;
+        drawMessage(editor);
+        editor->display->setCursor(MIN_X_POS, MIN_Y_POS);
       }
       else {
-        Coord crs = getTargetCursorPos(MOVE_RIGHT);
-        Display.setCursor(crs.x, crs.y);
+        Coord crs = getTargetCursorPos(editor, MOVE_RIGHT);
+        editor->display->setCursor(crs.x, crs.y);
       }
 
-      drawCursor(true);
-      lastBlinkTime = time;
+      drawCursor(editor, true);
+      restartBlink(editor, time);
     }
   }
   else {
-    drawCursor(true);
-    lastBlinkTime = time;
+    drawCursor(editor, true);
+    restartBlink(editor, time);
   }
 }
 
 /**
  * @brief Move the cursor down in the message text.
  * 
+ * @param editor 
  * @param time 
  */
-void moveDown(uint64_t time) {
-  if (bufferIndex + CHARS_PER_LINE <= getBufferLen()) {
+void moveDown(Editor *editor, uint64_t time) {
+  int bufferLen = getBufferLen(editor);
+
+  if (editor->bufferIndex + CHARS_PER_LINE <= bufferLen) {
     // Move down if cursor speed delay expired
-    if (time - lastBlinkTime > CURSOR_MOVE_DELAY) {
-      drawCursor(false);
-      bufferIndex += CHARS_PER_LINE;
+    if (!isTimerArmed(&editor->moveTimer)) {
+      drawCursor(editor, false);
+      startMoveDelay(editor, time);
+      editor->bufferIndex += CHARS_PER_LINE;
 
       // Handle the possible screen overflow
-      int targetRow = bufferIndex / CHARS_PER_LINE;
-      if (targetRow >= scrollRow + VISIBLE_LINES) {
-        int16_t savedX = Display.getCursorX();
-        scrollRow += VISIBLE_LINES;
-        drawMessage();
-        Display.setCursor(savedX, MIN_Y_POS);
+      int targetRow = editor->bufferIndex / CHARS_PER_LINE;
+      if (targetRow >= editor->scrollRow + VISIBLE_LINES) {
+        int16_t savedX = editor->display->getCursorX();
+        editor->scrollRow += VISIBLE_LINES;
+        drawMessage(editor);
+        editor->display->setCursor(savedX, MIN_Y_POS);
       }
       else {
-        Coord crs = getTargetCursorPos(MOVE_DOWN);
-        Display.setCursor(crs.x, crs.y);
+        Coord crs = getTargetCursorPos(editor, MOVE_DOWN);
+        editor->display->setCursor(crs.x, crs.y);
       }
 
-      drawCursor(true);
-      lastBlinkTime = time;
+      drawCursor(editor, true);
+      restartBlink(editor, time);
     }
   }
   else {
-    drawCursor(true);
-    lastBlinkTime = time;
+    drawCursor(editor, true);
+    restartBlink(editor, time);
   }
 }
 
 /**
  * @brief Draw the help table with the terminal control informations.
  * 
- * @param time 
+ * @param editor 
  */
-void showHelp(uint64_t time) {
-  drawCursor(false);
-  Display.fillRect(0, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, SSD1306_BLACK);
+void showHelp(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_RENDER);
 
-  Display.setTextSize(1);
-  Display.setTextColor(SSD1306_WHITE);
+  drawCursor(editor, false);
+  editor->helpVisible = true;
+  editor->display->fillRect(0, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, COLOR_BLACK);
+
+  editor->display->setTextSize(1);
+  editor->display->setTextColor(COLOR_WHITE);
   
   // Set the positions
   int16_t y = MIN_Y_POS + 4;
   int16_t lineStep = 10;
   int16_t col1_Key = 4;
   int16_t col1_Act = 16;
-  int16_t col2_Key = 68;
-  int16_t col2_Act = 80;
+  int16_t col2_Key = (SCREEN_WIDTH / 2) + 4;
+  int16_t col2_Act = col2_Key + 12;
 
   // Display the content
-  Display.setCursor(col1_Key, y); Display.print("0");
-  Display.setCursor(col1_Act, y); Display.print(": Clear");
-  Display.setCursor(col2_Key, y); Display.print("2");
-  Display.setCursor(col2_Act, y); Display.print(": UP");
+  editor->display->setCursor(col1_Key, y); editor->display->print("0");
+  editor->display->setCursor(col1_Act, y); editor->display->print(": Clear");
+  editor->display->setCursor(col2_Key, y); editor->display->print("2");
+  editor->display->setCursor(col2_Act, y); editor->display->print(": UP");
   y += lineStep;
-  Display.setCursor(col1_Key, y); Display.print("5");
-  Display.setCursor(col1_Act, y); Display.print(": Send");
-  Display.setCursor(col2_Key, y); Display.print("4");
-  Display.setCursor(col2_Act, y); Display.print(": LEFT");
+  editor->display->setCursor(col1_Key, y); editor->display->print("5");
+  editor->display->setCursor(col1_Act, y); editor->display->print(": Send");
+  editor->display->setCursor(col2_Key, y); editor->display->print("4");
+  editor->display->setCursor(col2_Act, y); editor->display->print(": LEFT");
   y += lineStep;
-  Display.setCursor(col1_Key, y); Display.print("*");
-  Display.setCursor(col1_Act, y); Display.print(": Mode");
-  Display.setCursor(col2_Key, y); Display.print("6");
-  Display.setCursor(col2_Act, y); Display.print(": RIGHT");
+  editor->display->setCursor(col1_Key, y); editor->display->print("*");
+  editor->display->setCursor(col1_Act, y); editor->display->print(": Mode");
+  editor->display->setCursor(col2_Key, y); editor->display->print("6");
+  editor->display->setCursor(col2_Act, y); editor->display->print(": RIGHT");
   y += lineStep;
-  Display.setCursor(col1_Key, y); Display.print("#");
-  Display.setCursor(col1_Act, y); Display.print(": Del");
-  Display.setCursor(col2_Key, y); Display.print("8");
-  Display.setCursor(col2_Act, y); Display.print(": DOWN");
+  editor->display->setCursor(col1_Key, y); editor->display->print("#");
+  editor->display->setCursor(col1_Act, y); editor->display->print(": Del");
+  editor->display->setCursor(col2_Key, y); editor->display->print("8");
+  editor->display->setCursor(col2_Act, y); editor->display->print(": DOWN");
+
+  editor->display->drawFastVLine((SCREEN_WIDTH / 2) - 2, MIN_Y_POS + 2, 40, COLOR_WHITE);
+  flushDisplay(editor);
 
-  Display.drawFastVLine(62, MIN_Y_POS + 2, 40, SSD1306_WHITE);
-  Display.display();
+  enterLoopPhase(phase);
 }
 
 /**
  * @brief Hide the help table and redraw the message.
  * 
+ * @param editor 
  * @param time 
  */
-void hideHelp(uint64_t time) {
-  drawMessage();
+void hideHelp(Editor *editor, uint64_t time) {
+  editor->helpVisible = false;
+  refreshMessage(editor, time);
+}
+
+/**
+ * @brief Open the recipient picker over the message with empty query
+ * listing the whole phonebook.
+ * 
+ * @param editor 
+ */
+void openPicker(Editor *editor) {
+  drawCursor(editor, false);
+  editor->pickerVisible = true;
+  editor->pickerArmed = false;
+  editor->pickerSelected = 0;
+  resetSearch(&editor->search);
+  drawPicker(editor);
+}
+
+/**
+ * @brief Close the recipient picker and redraw the message.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void closePicker(Editor *editor, uint64_t time) {
+  editor->pickerVisible = false;
+  refreshMessage(editor, time);
+}
+
+/**
+ * @brief Draw the recipient picker in the small font, the query
+ * digits and match count on the first row, then the page of matches
+ * with the selected one inverted, name on the left and number on
+ * the right.
+ * 
+ * @param editor 
+ */
+void drawPicker(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_RENDER);
+
+  char line[LIST_LINE_CHARS + 1];
+  uint32_t count = getSearchCount(&editor->search);
+
+  editor->display->fillRect(0, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, COLOR_BLACK);
+  editor->display->setTextSize(1);
+  editor->display->setTextColor(COLOR_WHITE);
+
+  // Query and match count
+  snprintf(line, sizeof(line), "To: %.*s", (int)editor->search.len, editor->search.digits);
+  editor->display->setCursor(2, MIN_Y_POS);
+  editor->display->print(line);
+
+  snprintf(line, sizeof(line), "%lu", (unsigned long)count);
+  editor->display->setCursor(SCREEN_WIDTH - (strlen(line) * HEADER_FONT_WIDTH) - 2, MIN_Y_POS);
+  editor->display->print(line);
+
+  // Page of matches with the selected one
+  uint32_t first = editor->pickerSelected - editor->pickerSelected % LIST_ROWS;
+  for (uint32_t row = 0; row < LIST_ROWS; ++row) {
+    Contact contact;
+    if (!getSearchContact(&editor->search, first + row, &contact)) {
+      break;
+    }
+
+    size_t numberLen = contact.numberLen < LIST_LINE_CHARS / 2 ? contact.numberLen : LIST_LINE_CHARS / 2;
+    size_t nameLen = LIST_LINE_CHARS - numberLen - 1;
+    if (contact.nameLen < nameLen) nameLen = contact.nameLen;
+
+    memset(line, ' ', LIST_LINE_CHARS);
+    memcpy(line, contact.name, nameLen);
+    memcpy(&line[LIST_LINE_CHARS - numberLen], &contact.number[contact.numberLen - numberLen], numberLen);
+    line[LIST_LINE_CHARS] = '\0';
+
+    int16_t y = MIN_Y_POS + (row + 1) * HEADER_FONT_HEIGHT;
+    if (first + row == editor->pickerSelected) {
+      editor->display->fillRect(0, y, SCREEN_WIDTH, HEADER_FONT_HEIGHT, COLOR_WHITE);
+      editor->display->setTextColor(COLOR_BLACK);
+    }
+    else {
+      editor->display->setTextColor(COLOR_WHITE);
+    }
 
-  // Set the original cursor position
-  int currentAbsRow = bufferIndex / CHARS_PER_LINE;
-  int relativeRow = currentAbsRow - scrollRow;
-  int col = bufferIndex % CHARS_PER_LINE;
+    editor->display->setCursor(0, y);
+    editor->display->print(line);
+  }
+
+  editor->display->setTextSize(TEXT_SIZE);
+  editor->display->setTextColor(COLOR_WHITE);
+  flushDisplay(editor);
+
+  enterLoopPhase(phase);
+}
+
+/**
+ * @brief Get the next older or newer message shown in the list, with
+ * a query only the matching messages are shown.
+ * 
+ * @param editor 
+ * @param id 
+ * @param older 
+ * @return uint16_t id or HISTORY_NONE past the list end
+ */
+uint16_t getShownHistory(Editor *editor, uint16_t id, bool older) {
+  while (id != HISTORY_NONE) {
+    const HistoryEntry *entry = getHistoryEntry(id);
+    id = older ? entry->older : entry->newer;
+
+    if (id == HISTORY_NONE || editor->query.len == 0 || isMessageFound(&editor->query, id)) {
+      break;
+    }
+  }
+
+  return id;
+}
+
+/**
+ * @brief Select the newest shown message on the top row.
+ * 
+ * @param editor 
+ */
+void selectNewestHistory(Editor *editor) {
+  uint16_t newest = getHistoryNewest();
+
+  if (newest != HISTORY_NONE && editor->query.len > 0 && !isMessageFound(&editor->query, newest)) {
+    newest = getShownHistory(editor, newest, true);
+  }
+
+  editor->historyTop = newest;
+  editor->historySelected = newest;
+  editor->historyRow = 0;
+}
+
+/**
+ * @brief Open the message history list over the message with the
+ * newest message selected on the top row, without a query.
+ * 
+ * @param editor 
+ */
+void openHistory(Editor *editor) {
+  drawCursor(editor, false);
+  editor->historyVisible = true;
+  editor->historyOpened = false;
+  editor->historySearching = false;
+  editor->query.len = 0;
+  selectNewestHistory(editor);
+  drawHistory(editor);
+}
+
+/**
+ * @brief Close the message history and redraw the message, a query
+ * multitap cycle does not continue in the message.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void closeHistory(Editor *editor, uint64_t time) {
+  editor->historyVisible = false;
+  editor->historyOpened = false;
+  editor->historySearching = false;
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+  refreshMessage(editor, time);
+}
+
+/**
+ * @brief Search the history for the words of the typed query and
+ * select the newest match, an empty query shows all messages.
+ * 
+ * @param editor 
+ */
+void searchHistory(Editor *editor) {
+  if (editor->query.len > 0) {
+    findMessages(&editor->query);
+  }
+
+  selectNewestHistory(editor);
+}
+
+/**
+ * @brief Select the next older or newer message of the list, the
+ * list scrolls by one row past its edge. Only the links of the
+ * selected and top message are followed, with a query up to the
+ * next match.
+ * 
+ * @param editor 
+ * @param older 
+ */
+void scrollHistory(Editor *editor, bool older) {
+  if (editor->historySelected == HISTORY_NONE) {
+    return;
+  }
+
+  uint16_t next = getShownHistory(editor, editor->historySelected, older);
+  if (next == HISTORY_NONE) {
+    return;
+  }
+
+  editor->historySelected = next;
+
+  if (older && editor->historyRow + 1 < LIST_ROWS) {
+    editor->historyRow++;
+  }
+  else if (older) {
+    editor->historyTop = getShownHistory(editor, editor->historyTop, true);
+  }
+  else if (editor->historyRow > 0) {
+    editor->historyRow--;
+  }
+  else {
+    editor->historyTop = next;
+  }
+}
+
+/**
+ * @brief Delete the selected message, the older shown message moves
+ * up to its row and gets selected, without older message the newer
+ * one above is selected.
+ * 
+ * @param editor 
+ */
+void deleteSelectedHistory(Editor *editor) {
+  uint16_t id = editor->historySelected;
+  if (id == HISTORY_NONE) {
+    return;
+  }
+
+  uint16_t older = getShownHistory(editor, id, true);
+  uint16_t newer = getShownHistory(editor, id, false);
+
+  if (older != HISTORY_NONE) {
+    editor->historySelected = older;
+  }
+  else {
+    editor->historySelected = newer;
+    if (editor->historyRow > 0) editor->historyRow--;
+  }
+
+  if (editor->historyTop == id) {
+    editor->historyTop = editor->historySelected;
+  }
+
+  editor->historyOpened = false;
+  dropMessageFound(&editor->query, id);
+  deleteHistory(id);
+}
+
+/**
+ * @brief Draw the rows of the history list from the top message,
+ * the direction mark, the number of the other side and the text
+ * start, only the chars shown on the visible rows are read.
+ * 
+ * @param editor 
+ */
+void drawHistoryList(Editor *editor) {
+  char line[LIST_LINE_CHARS + 1];
+  HistoryStats stats = getHistoryStats();
+
+  // Title or the query with its match count
+  if (editor->historySearching || editor->query.len > 0) {
+    snprintf(line, sizeof(line), "/%.*s%s", (int)editor->query.len, editor->query.text,
+             editor->historySearching ? "_" : "");
+  }
+  else {
+    snprintf(line, sizeof(line), "History");
+  }
+  editor->display->setCursor(2, MIN_Y_POS);
+  editor->display->print(line);
+
+  snprintf(line, sizeof(line), "%u", editor->query.len > 0 ? editor->query.count : stats.count);
+  editor->display->setCursor(SCREEN_WIDTH - (strlen(line) * HEADER_FONT_WIDTH) - 2, MIN_Y_POS);
+  editor->display->print(line);
+
+  uint16_t id = editor->historyTop;
+  for (uint8_t row = 0; row < LIST_ROWS && id != HISTORY_NONE; ++row) {
+    const HistoryEntry *entry = getHistoryEntry(id);
+
+    // Mark, number cut to its end and the text start
+    memset(line, ' ', LIST_LINE_CHARS);
+    line[0] = (entry->flags & HISTORY_SENT) ? '>' : (entry->flags & HISTORY_UNREAD) ? '*' : '<';
+
+    char peer[HISTORY_PEER_SIZE];
+    uint8_t peerLen = readHistoryPeer(id, peer);
+    uint8_t shown = peerLen < HISTORY_PREVIEW_PEER ? peerLen : HISTORY_PREVIEW_PEER;
+    memcpy(&line[1], &peer[peerLen - shown], shown);
+
+    uint8_t start = 2 + shown;
+    readHistoryText(id, 0, &line[start], LIST_LINE_CHARS - start);
+    line[LIST_LINE_CHARS] = '\0';
+
+    int16_t y = MIN_Y_POS + (row + 1) * HEADER_FONT_HEIGHT;
+    if (id == editor->historySelected) {
+      editor->display->fillRect(0, y, SCREEN_WIDTH, HEADER_FONT_HEIGHT, COLOR_WHITE);
+      editor->display->setTextColor(COLOR_BLACK);
+    }
+    else {
+      editor->display->setTextColor(COLOR_WHITE);
+    }
+
+    editor->display->setCursor(0, y);
+    editor->display->print(line);
+    id = getShownHistory(editor, id, true);
+  }
+}
+
+/**
+ * @brief Draw the opened message, the number of the other side on
+ * the first row and the text wrapped from the scroll row, decoded
+ * row by row without a copy of the whole text.
+ * 
+ * @param editor 
+ */
+void drawHistoryMessage(Editor *editor) {
+  char line[LIST_LINE_CHARS + 1];
+  uint16_t id = editor->historySelected;
+  const HistoryEntry *entry = getHistoryEntry(id);
+
+  char peer[HISTORY_PEER_SIZE];
+  uint8_t peerLen = readHistoryPeer(id, peer);
+  snprintf(line, sizeof(line), "%s %.*s", (entry->flags & HISTORY_SENT) ? "To" : "From",
+           (int)peerLen, peer);
+  editor->display->setCursor(2, MIN_Y_POS);
+  editor->display->print(line);
+
+  // One pass over the stored text, rows are decoded straight into
+  // the line
+  HistoryText text;
+  openHistoryText(&text, id);
+  readHistoryChars(&text, NULL, editor->historyScroll * LIST_LINE_CHARS);
+
+  for (uint8_t row = 0; row < LIST_ROWS; ++row) {
+    uint8_t len = readHistoryChars(&text, line, LIST_LINE_CHARS);
+    line[len] = '\0';
+
+    editor->display->setCursor(0, MIN_Y_POS + (row + 1) * HEADER_FONT_HEIGHT);
+    editor->display->print(line);
+  }
+}
+
+/**
+ * @brief Draw the message history list or the opened message in the
+ * small font over the text area.
+ * 
+ * @param editor 
+ */
+void drawHistory(Editor *editor) {
+  LoopPhase phase = enterLoopPhase(LOOP_RENDER);
+
+  editor->display->fillRect(0, MIN_Y_POS, SCREEN_WIDTH, SCREEN_HEIGHT - MIN_Y_POS, COLOR_BLACK);
+  editor->display->setTextSize(1);
+  editor->display->setTextColor(COLOR_WHITE);
+
+  if (editor->historyOpened) {
+    drawHistoryMessage(editor);
+  }
+  else if (editor->historySelected != HISTORY_NONE || editor->historySearching || editor->query.len > 0) {
+    drawHistoryList(editor);
+  }
+  else {
+    editor->display->setCursor(2, MIN_Y_POS);
+    editor->display->print("No messages");
+  }
+
+  editor->display->setTextSize(TEXT_SIZE);
+  editor->display->setTextColor(COLOR_WHITE);
+  flushDisplay(editor);
+
+  enterLoopPhase(phase);
+}
+
+/**
+ * @brief Scroll to the page with bufferIndex, redraw the message
+ * and set the cursor on the bufferIndex position.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void refreshMessage(Editor *editor, uint64_t time) {
+  int currentAbsRow = editor->bufferIndex / CHARS_PER_LINE;
+  editor->scrollRow = (currentAbsRow / VISIBLE_LINES) * VISIBLE_LINES;
+
+  drawMessage(editor);
+
+  // Set the cursor position
+  int relativeRow = currentAbsRow - editor->scrollRow;
+  int col = editor->bufferIndex % CHARS_PER_LINE;
   int16_t x = MIN_X_POS + (col * FONT_WIDTH);
   int16_t y = MIN_Y_POS + (relativeRow * FONT_HEIGHT);
 
-  Display.setCursor(x, y);
-  drawCursor(true);
-  lastBlinkTime = time;
+  editor->display->setCursor(x, y);
+  drawCursor(editor, true);
+  restartBlink(editor, time);
 }
 
 /**
  * @brief Clear the text area.
  * 
+ * @param editor 
  */
-void clearMessage() {
-  if (getBufferLen() > 0) {
-    clearBuffer();
-    scrollRow = 0;
-    drawMessage();
+void clearMessage(Editor *editor) {
+  if (getBufferLen(editor) > 0) {
+    recordClear(editor);
+    clearBuffer(editor);
+    editor->scrollRow = 0;
+    drawMessage(editor);
   }
 }
 
 /**
- * @brief If message not empty send the message and clear the text area.
+ * @brief Show the send notes over the cleared message, the sending
+ * note until the transport takes the message or the ack timeout, then
+ * the sent note for a while, and restore the message with its cursor.
+ * The keypad scan and cursor blink go on between the steps.
  * 
+ * @param editor 
+ * @return Flow 
  */
-void sendMessage() {
-  // If message not empty send the message
-  if (getBufferLen() > 0) {
-    clearMessage();
-    Display.setCursor(MIN_X_POS, MIN_Y_POS);
-    Display.print("Sending...");
-    Display.display();
+Flow runSendFlow(Editor *editor) {
+  // The notes replace the help of a star chord send
+  editor->helpVisible = false;
+  drawCursor(editor, false);
+  editor->display->setCursor(MIN_X_POS, MIN_Y_POS);
+  editor->display->print("Sending...");
+  flushDisplay(editor);
+
+  co_await waitFlowEvent(FLOW_EVENT_SENT, editor->now + SEND_ACK_TIMEOUT);
+
+  editor->display->setCursor(MIN_X_POS, MIN_Y_POS + FONT_HEIGHT);
+  editor->display->print("SMS sent.");
+  flushDisplay(editor);
 
-    delay(2000);
+  co_await sleepFlow(editor->now + SEND_NOTE_DELAY);
+
+  editor->sending = false;
+  refreshMessage(editor, editor->now);
+  drawHeader(editor);
+}
+
+/**
+ * @brief If message not empty send the message in UCS-2 to the
+ * recipient, clear the text area and start the send flow showing
+ * the send notes, the message is restored right away if no flow
+ * frame is free.
+ * 
+ * @param editor 
+ * @param recipient contact picked from the phonebook or NULL
+ */
+void sendMessage(Editor *editor, const Contact *recipient) {
+  // If message not empty send the message
+  if (getBufferLen(editor) > 0) {
+    editor->sentMessageLen = encodeUcs2(editor->buffer, getBufferLen(editor), editor->sentMessage,
+                                        sizeof(editor->sentMessage));
+
+    size_t numberLen = 0;
+    if (recipient != NULL) {
+      numberLen = recipient->numberLen < RECIPIENT_SIZE ? recipient->numberLen : RECIPIENT_SIZE;
+      memcpy(editor->sentRecipient, recipient->number, numberLen);
+    }
+    editor->sentRecipient[numberLen] = '\0';
+    addHistory(HISTORY_SENT, editor->sentRecipient, numberLen, editor->buffer, getBufferLen(editor));
 
-    Display.setCursor(MIN_X_POS, MIN_Y_POS + FONT_HEIGHT);
-    Display.print("SMS sent.");
-    Display.display();
+    clearMessage(editor);
+    resetUndo(editor);
 
-    delay(1000);
-    drawMessage();
+    editor->sending = true;
+    if (!startFlow(runSendFlow(editor), &editor->timers)) {
+      editor->sending = false;
+      refreshMessage(editor, editor->now);
+    }
   }
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Get the last sent message of the editor in UCS-2.
+ * 
+ * @param editor 
+ * @param len length in bytes
+ * @return const uint8_t* 
+ */
+const uint8_t *getSentMessage(Editor *editor, size_t *len) {
+  *len = editor->sentMessageLen;
+  return editor->sentMessage;
+}
+
+/**
+ * @brief Get the number of the last sent message recipient of the
+ * editor.
+ * 
+ * @param editor 
+ * @return const char* the number or empty string if the message was
+ * sent without recipient
+ */
+const char *getSentRecipient(Editor *editor) {
+  return editor->sentRecipient;
+}
@@ -12,9 +12,49 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#include "Panel.h"
+#include "Phonebook.h"
+#include "History.h"
+#include "Index.h"
+
+// Display backends
+#define BACKEND_SSD1306_128X64 1
+#define BACKEND_SH1106_128X64 2
+#define BACKEND_ST7789_128X128 3
+#define BACKEND_ST7789_240X240 4
+#define BACKEND_HOST_128X64 5
+
+// Selected display backend
+#ifndef DISPLAY_BACKEND
+#define DISPLAY_BACKEND BACKEND_SSD1306_128X64
+#endif
+
+// Panel driver and message text size of the backend
+#if DISPLAY_BACKEND == BACKEND_SSD1306_128X64
+typedef Panel<128, 64, MonoPages, Ssd1306Flush> DisplayPanel;
+#define TEXT_SIZE 2
+#elif DISPLAY_BACKEND == BACKEND_SH1106_128X64
+typedef Panel<128, 64, MonoPages, Sh1106Flush> DisplayPanel;
+#define TEXT_SIZE 2
+#elif DISPLAY_BACKEND == BACKEND_ST7789_128X128
+typedef Panel<128, 128, Rgb565, St7789Flush<>> DisplayPanel;
+#define TEXT_SIZE 2
+#elif DISPLAY_BACKEND == BACKEND_ST7789_240X240
+typedef Panel<240, 240, MonoPages, St7789Flush<>> DisplayPanel;
+#define TEXT_SIZE 3
+#elif DISPLAY_BACKEND == BACKEND_HOST_128X64
+typedef Panel<128, 64, MonoPages, HostFlush> DisplayPanel;
+#define TEXT_SIZE 2
+#else
+#error "Unknown DISPLAY_BACKEND"
+#endif
+
 // Screen size config
-#define SCREEN_WIDTH 128
-#define SCREEN_HEIGHT 64
+#define SCREEN_WIDTH (DisplayPanel::WIDTH)
+#define SCREEN_HEIGHT (DisplayPanel::HEIGHT)
+
+// Display is mounted upside down
+#define DISPLAY_ROTATION 2
 
 // SPI pins config
 #define SPI_MOSI 23
@@ -24,18 +64,40 @@
 #define SPI_RST  17
 
 // Text font size
-#define FONT_WIDTH 12
-#define FONT_HEIGHT 16
+#define FONT_WIDTH (GLYPH_CELL_WIDTH * TEXT_SIZE)
+#define FONT_HEIGHT (GLYPH_CELL_HEIGHT * TEXT_SIZE)
 
 // Header size
 #define HEADER_HEIGHT 10
-#define HEADER_FONT_WIDTH 6
-#define HEADER_FONT_HEIGHT 8
+#define HEADER_FONT_WIDTH GLYPH_CELL_WIDTH
+#define HEADER_FONT_HEIGHT GLYPH_CELL_HEIGHT
 
 // Delay values for cursor
 #define CURSOR_BLINK_DELAY 700
 #define CURSOR_MOVE_DELAY 200
 
+// Steps of the cursor move repeat acceleration
+#define CURSOR_MOVE_STEPS 8
+
+// Held left or right moves jump by words after these repeats
+#define CURSOR_WORD_REPEATS 12
+
+// Rows of the recipient picker and message history lists and chars
+// of one row in the small font, the first row shows the list title
+#define LIST_ROWS ((SCREEN_HEIGHT - MIN_Y_POS) / HEADER_FONT_HEIGHT - 1)
+#define LIST_LINE_CHARS (SCREEN_WIDTH / HEADER_FONT_WIDTH)
+
+// Number chars shown on a history list row, the number end
+#define HISTORY_PREVIEW_PEER 9
+
+// Longest wait for the transport to take the sent message and time
+// the sent note stays shown in ms
+#define SEND_ACK_TIMEOUT 2000
+#define SEND_NOTE_DELAY 1000
+
+// Longest kept number of the sent message recipient
+#define RECIPIENT_SIZE 24
+
 // Number of characters on one line and total lines
 #define CHARS_PER_LINE (SCREEN_WIDTH / FONT_WIDTH)
 #define VISIBLE_LINES ((SCREEN_HEIGHT / FONT_HEIGHT) - 1)
@@ -65,118 +127,313 @@ typedef struct {
   int16_t y;
 } Coord;
 
+/**
+ * @brief Structure for display flush statistics.
+ * 
+ */
+typedef struct {
+  uint32_t flushes;
+  uint32_t flushTime;
+  uint32_t lastFlushTime;
+} FrameStats;
+
+struct Editor;
+
+// Display panel of the device
+extern DisplayPanel Display;
+
 /**
  * @brief Initialize the display.
  * 
+ * @param editor 
+ */
+void initDisplay(Editor *editor);
+
+/**
+ * @brief Reset the display panel without the hardware start.
+ * 
+ * @param editor 
  */
-void initDisplay();
+void resetDisplay(Editor *editor);
+
+/**
+ * @brief Flush the framebuffer.
+ * 
+ * @param editor 
+ */
+void flushDisplay(Editor *editor);
+
+/**
+ * @brief Flush the device framebuffer to mirror and display.
+ * 
+ * @param editor 
+ */
+void flushDevice(Editor *editor);
+
+/**
+ * @brief Count the display flush.
+ * 
+ * @param time 
+ */
+void recordFlush(uint32_t time);
+
+/**
+ * @brief Send the current framebuffer to the host.
+ * 
+ * @param editor 
+ */
+void snapshotDisplay(Editor *editor);
+
+/**
+ * @brief Get the display flush statistics.
+ * 
+ * @return FrameStats 
+ */
+FrameStats getFrameStats();
 
 /**
  * @brief Draw the header.
  * 
+ * @param editor 
  */
-void drawHeader();
+void drawHeader(Editor *editor);
 
 /**
  * @brief Draw the message.
  * 
+ * @param editor 
  */
-void drawMessage();
+void drawMessage(Editor *editor);
 
 /**
  * @brief Get the the target coords based on move.
  * 
+ * @param editor 
  * @param direction 
  * @return Coord 
  */
-Coord getTargetCursorPos(Move move);
+Coord getTargetCursorPos(Editor *editor, Move move);
 
 /**
  * @brief Draw the char.
  * 
+ * @param editor 
  * @param ch 
  */
-void drawChar(char ch, bool isCycle);
+void drawChar(Editor *editor, char ch, bool isCycle);
+
+/**
+ * @brief Insert and draw the whole text at once.
+ * 
+ * @param editor 
+ * @param text 
+ * @param len 
+ * @param time 
+ * @return uint8_t 
+ */
+uint8_t drawText(Editor *editor, const char *text, uint8_t len, uint64_t time);
 
 /**
  * @brief Draw the cursor.
  * 
+ * @param editor 
  * @param visible 
  */
-void drawCursor(bool visible);
+void drawCursor(Editor *editor, bool visible);
 
 /**
- * @brief Show or hide the cursor.
+ * @brief Toggle the cursor on blink timeout.
  * 
+ * @param editor 
  */
-void updateCursor();
+void updateCursor(Editor *editor);
+
+/**
+ * @brief Plan the next cursor blink.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void restartBlink(Editor *editor, uint64_t time);
 
 /**
  * @brief Enable the cursor.
  * 
+ * @param editor 
  */
-void enableCursor();
+void enableCursor(Editor *editor);
 
 /**
  * @brief Disable the cursor.
  * 
+ * @param editor 
  */
-void disableCursor();
+void disableCursor(Editor *editor);
 
 /**
  * @brief Delete char from text.
  * 
+ * @param editor 
  */
-void deleteChar(uint64_t time);
+void deleteChar(Editor *editor, uint64_t time);
 
 /**
  * @brief Move up in text.
  * 
+ * @param editor 
  * @param time 
  */
-void moveUp(uint64_t time);
+void moveUp(Editor *editor, uint64_t time);
 
 /**
  * @brief Move left in text.
 
  * 
+ * @param editor 
  */
-void moveLeft(uint64_t time);
+void moveLeft(Editor *editor, uint64_t time);
 
 /**
  * @brief Move right in text.
  * 
+ * @param editor 
  */
-void moveRight(uint64_t time);
+void moveRight(Editor *editor, uint64_t time);
+
+/**
+ * @brief Jump to the next or previous word.
+ * 
+ * @param editor 
+ * @param forward 
+ * @param time 
+ */
+void jumpWord(Editor *editor, bool forward, uint64_t time);
 
 /**
  * @brief Move down in text.
  * 
+ * @param editor 
  */
-void moveDown(uint64_t time);
+void moveDown(Editor *editor, uint64_t time);
 
 /**
  * @brief Show the help table.
  * 
+ * @param editor 
  */
-void showHelp(uint64_t time);
+void showHelp(Editor *editor);
 
 /**
  * @brief Hide the help table.
  * 
+ * @param editor 
+ */
+void hideHelp(Editor *editor, uint64_t time);
+
+/**
+ * @brief Open the recipient picker.
+ * 
+ * @param editor 
+ */
+void openPicker(Editor *editor);
+
+/**
+ * @brief Close the recipient picker.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void closePicker(Editor *editor, uint64_t time);
+
+/**
+ * @brief Draw the recipient picker.
+ * 
+ * @param editor 
+ */
+void drawPicker(Editor *editor);
+
+/**
+ * @brief Open the message history list.
+ * 
+ * @param editor 
+ */
+void openHistory(Editor *editor);
+
+/**
+ * @brief Close the message history.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void closeHistory(Editor *editor, uint64_t time);
+
+/**
+ * @brief Select the next older or newer message of the list.
+ * 
+ * @param editor 
+ * @param older 
+ */
+void scrollHistory(Editor *editor, bool older);
+
+/**
+ * @brief Search the history for the typed query.
+ * 
+ * @param editor 
+ */
+void searchHistory(Editor *editor);
+
+/**
+ * @brief Delete the selected message of the list.
+ * 
+ * @param editor 
+ */
+void deleteSelectedHistory(Editor *editor);
+
+/**
+ * @brief Draw the message history list or the opened message.
+ * 
+ * @param editor 
  */
-void hideHelp(uint64_t time);
+void drawHistory(Editor *editor);
+
+/**
+ * @brief Redraw the message and cursor on bufferIndex.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void refreshMessage(Editor *editor, uint64_t time);
 
 /**
  * @brief Clear the message.
  * 
+ * @param editor 
+ */
+void clearMessage(Editor *editor);
+
+/**
+ * @brief Send the message to the recipient.
+ * 
+ * @param editor 
+ * @param recipient 
+ */
+void sendMessage(Editor *editor, const Contact *recipient);
+
+/**
+ * @brief Get the last sent message in UCS-2.
+ * 
+ * @param editor 
+ * @param len 
+ * @return const uint8_t* 
  */
-void clearMessage();
+const uint8_t *getSentMessage(Editor *editor, size_t *len);
 
 /**
- * @brief Send the message.
+ * @brief Get the number of the last sent message recipient.
  * 
+ * @param editor 
+ * @return const char* 
  */
-void sendMessage();
+const char *getSentRecipient(Editor *editor);
 
 #endif
\ No newline at end of file
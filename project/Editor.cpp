@@ -0,0 +1,226 @@
+/**
+ * @file Editor.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Editor.h"
+#include "Flow.h"
+
+/**
+ * @brief Restore the cursor after the multitap delay expired.
+ * 
+ * @param timer 
+ */
+void handleMultitapTimeout(Timer *timer) {
+  enableCursor((Editor *)timer->context);
+}
+
+/**
+ * @brief Blink the cursor and plan the next blink.
+ * 
+ * @param timer 
+ */
+void handleBlinkTimeout(Timer *timer) {
+  Editor *editor = (Editor *)timer->context;
+  updateCursor(editor);
+  restartBlink(editor, timer->deadline);
+}
+
+/**
+ * @brief Stop the cursor blink when the editor was not used
+ * for the idle delay, so no timer wakes the editor up.
+ * 
+ * @param timer 
+ */
+void handleIdleTimeout(Timer *timer) {
+  Editor *editor = (Editor *)timer->context;
+  editor->idle = true;
+
+  cancelTimer(&editor->timers, &editor->blinkTimer);
+  disableCursor(editor);
+}
+
+/**
+ * @brief Clear the message, set the initial keypad and cursor
+ * state, stop the running flows, start the cursor blink and idle
+ * delay on the empty timer wheel and empty undo log, then attach
+ * the display panel, without flush hook the panel is flushed
+ * directly.
+ * 
+ * @param editor 
+ * @param display 
+ * @param flush 
+ */
+void initEditor(Editor *editor, DisplayPanel *display, EditorFlush flush) {
+  memset(editor->buffer, MESSAGE_END, sizeof(editor->buffer));
+  clearBuffer(editor);
+  editor->bufferPeak = 0;
+  editor->now = 0;
+
+  editor->caseMode = MODE_SMART;
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+  editor->layout = getLayout(LAYOUT_ENGLISH);
+  editor->layoutIndex = LAYOUT_ENGLISH;
+  resetCadence(&editor->cadence);
+
+  editor->cursorVisible = false;
+  editor->cursorEnabled = true;
+  editor->helpVisible = false;
+  editor->pickerVisible = false;
+  editor->pickerArmed = false;
+  editor->pickerSelected = 0;
+  resetSearch(&editor->search);
+  editor->historyVisible = false;
+  editor->historyOpened = false;
+  editor->historyTop = HISTORY_NONE;
+  editor->historySelected = HISTORY_NONE;
+  editor->historyRow = 0;
+  editor->historyScroll = 0;
+  editor->historySearching = false;
+  editor->query.len = 0;
+  editor->query.count = 0;
+  editor->sending = false;
+  editor->sentMessageLen = 0;
+  editor->sentRecipient[0] = '\0';
+  editor->scrollRow = 0;
+  editor->idle = false;
+  editor->moveRepeats = 0;
+
+  stopFlows(&editor->timers);
+  initTimerWheel(&editor->timers, 0);
+  initTimer(&editor->multitapTimer, handleMultitapTimeout, editor);
+  initTimer(&editor->blinkTimer, handleBlinkTimeout, editor);
+  initTimer(&editor->moveTimer, NULL, editor);
+  initTimer(&editor->deleteTimer, NULL, editor);
+  initTimer(&editor->undoTimer, NULL, editor);
+  initTimer(&editor->idleTimer, handleIdleTimeout, editor);
+  restartBlink(editor, 0);
+  armTimer(&editor->timers, &editor->idleTimer, EDITOR_IDLE_DELAY);
+
+  editor->display = display;
+  editor->flush = flush;
+
+  resetUndo(editor);
+  editor->undo.arenaPeak = 0;
+  editor->undo.lastRecordTime = 0;
+}
+
+/**
+ * @brief Check the message is terminated with clear tail, bufferIndex
+ * is inside the message, the word stops match the text, the scroll is
+ * on the page start with the bufferIndex row and the display cursor
+ * is on the bufferIndex cell, the cursor past the line end is taken
+ * as the next line start.
+ * 
+ * @param editor 
+ * @return EditorCheck 
+ */
+EditorCheck checkEditor(Editor *editor) {
+  if (editor->buffer[MESSAGE_SIZE] != MESSAGE_END) {
+    return CHECK_TERMINATOR;
+  }
+
+  size_t len = getBufferLen(editor);
+  for (size_t idx = len; idx < MESSAGE_SIZE; ++idx) {
+    if (editor->buffer[idx] != MESSAGE_END) {
+      return CHECK_TAIL;
+    }
+  }
+
+  if (editor->bufferIndex > len) {
+    return CHECK_INDEX;
+  }
+
+  for (size_t idx = 0; idx <= MESSAGE_SIZE; ++idx) {
+    bool stop = (idx == len) || (editor->buffer[idx] != ' ' && idx < len &&
+                                 (idx == 0 || editor->buffer[idx - 1] == ' '));
+    if (stop != ((editor->wordStops[idx / 32] >> (idx % 32)) & 1)) {
+      return CHECK_WORDS;
+    }
+  }
+
+  int row = editor->bufferIndex / CHARS_PER_LINE;
+  if (editor->scrollRow % VISIBLE_LINES != 0 || row < editor->scrollRow ||
+      row >= editor->scrollRow + VISIBLE_LINES) {
+    return CHECK_SCROLL;
+  }
+
+  // Help table, recipient picker, history and send notes move the
+  // display cursor
+  if (editor->helpVisible || editor->pickerVisible || editor->historyVisible || editor->sending) {
+    return CHECK_OK;
+  }
+
+  int16_t x = editor->display->getCursorX();
+  int16_t y = editor->display->getCursorY();
+  if (x + FONT_WIDTH > SCREEN_WIDTH) {
+    x = MIN_X_POS;
+    y += FONT_HEIGHT;
+  }
+
+  if (x != MIN_X_POS + (editor->bufferIndex % CHARS_PER_LINE) * FONT_WIDTH ||
+      y != MIN_Y_POS + (row - editor->scrollRow) * FONT_HEIGHT) {
+    return CHECK_CURSOR;
+  }
+
+  return CHECK_OK;
+}
+
+/**
+ * @brief Set the editor time and fire the timers expired up to
+ * the time, the time never goes back.
+ * 
+ * @param editor 
+ * @param now 
+ */
+void setEditorTime(Editor *editor, uint64_t now) {
+  if (now > editor->now) {
+    editor->now = now;
+  }
+
+  advanceTimers(&editor->timers, editor->now);
+}
+
+/**
+ * @brief Restart the idle delay from the editor time, the idle
+ * editor gets the cursor and its blink back.
+ * 
+ * @param editor 
+ */
+void touchEditor(Editor *editor) {
+  if (editor->idle) {
+    editor->idle = false;
+    enableCursor(editor);
+    restartBlink(editor, editor->now);
+  }
+
+  armTimer(&editor->timers, &editor->idleTimer, editor->now + EDITOR_IDLE_DELAY);
+}
+
+/**
+ * @brief Get the time left from now until the next editor timer
+ * fires, zero if a timer is already due.
+ * 
+ * @param editor 
+ * @param now 
+ * @return uint32_t 
+ */
+uint32_t getEditorIdle(Editor *editor, uint64_t now) {
+  uint64_t deadline = getNextDeadline(&editor->timers);
+
+  if (deadline <= now) {
+    return 0;
+  }
+
+  return deadline - now > UINT32_MAX ? UINT32_MAX : deadline - now;
+}
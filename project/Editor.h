@@ -0,0 +1,183 @@
+/**
+ * @file Editor.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef EDITOR_H
+#define EDITOR_H
+
+#include <stdint.h>
+
+#include "Buffer.h"
+#include "Display.h"
+#include "Index.h"
+#include "Keypad.h"
+#include "Layout.h"
+#include "Phonebook.h"
+#include "Undo.h"
+#include "Timer.h"
+
+// Inactivity before the editor goes idle
+#define EDITOR_IDLE_DELAY 30000
+
+struct Editor;
+
+// Hook for sending the editor framebuffer out
+typedef void (*EditorFlush)(Editor *editor);
+
+/**
+ * @brief Enum values for editor invariant check result.
+ * 
+ */
+typedef enum {
+  CHECK_OK, CHECK_TERMINATOR, CHECK_TAIL, CHECK_INDEX,
+  CHECK_SCROLL, CHECK_CURSOR, CHECK_FRAME, CHECK_WORDS
+} EditorCheck;
+
+/**
+ * @brief Structure for the whole state of one terminal instance,
+ * every editor function works only with the passed editor.
+ * 
+ */
+struct Editor {
+  // Message buffer and its current position index
+  char buffer[MESSAGE_SIZE + 1];
+  uint8_t bufferIndex;
+
+  // Longest message ever held in the buffer
+  uint8_t bufferPeak;
+
+  // Bitmap of word starts and message end for word jumps
+  uint32_t wordStops[WORD_INDEX_SIZE];
+
+  // Bitmap of the chars of misspelled words
+  uint32_t spellMarks[WORD_INDEX_SIZE];
+
+  // Current time of the editor loop step
+  uint64_t now;
+
+  // Active case mode, multitap key and symbol index
+  CaseMode caseMode;
+  Key lastKey;
+  uint8_t symbolIndex;
+
+  // Keypad layout of the key symbols and its index
+  const Layout *layout;
+  uint8_t layoutIndex;
+
+  // Tapping cadence setting the multitap delay
+  MultitapCadence cadence;
+
+  // Cursor visible, cursor enabled and help shown flags
+  bool cursorVisible;
+  bool cursorEnabled;
+  bool helpVisible;
+
+  // Recipient picker shown, its digit search and selected match,
+  // send key released since the picker opened
+  bool pickerVisible;
+  bool pickerArmed;
+  uint32_t pickerSelected;
+  PhonebookSearch search;
+
+  // Message history shown, message opened, message on the top row,
+  // selected message with its row and scroll row of the opened one
+  bool historyVisible;
+  bool historyOpened;
+  uint16_t historyTop;
+  uint16_t historySelected;
+  uint8_t historyRow;
+  uint8_t historyScroll;
+
+  // History query typed and its matches, a non-empty query filters
+  // the history list
+  bool historySearching;
+  MessageQuery query;
+
+  // Send flow shows its notes over the message, keys are ignored
+  bool sending;
+
+  // Last sent message in UCS-2 as handed over for sending and the
+  // number of its recipient, empty without phonebook
+  uint8_t sentMessage[MESSAGE_SIZE * 2];
+  uint16_t sentMessageLen;
+  char sentRecipient[RECIPIENT_SIZE + 1];
+
+  // Counter of scroll rows
+  uint16_t scrollRow;
+
+  // No key or link activity for the idle delay flag
+  bool idle;
+
+  // Wheel owning all editor timeouts
+  TimerWheel timers;
+
+  // Multitap expire and cursor blink timers
+  Timer multitapTimer;
+  Timer blinkTimer;
+
+  // Move, delete and undo or redo repeat is blocked while armed
+  Timer moveTimer;
+  uint8_t moveRepeats;
+  Timer deleteTimer;
+  Timer undoTimer;
+
+  // Idle timer restarted by every activity
+  Timer idleTimer;
+
+  // Display panel and its flush hook
+  DisplayPanel *display;
+  EditorFlush flush;
+
+  // Undo log of the message edits
+  UndoLog undo;
+};
+
+/**
+ * @brief Reset the editor state and attach the display panel.
+ * 
+ * @param editor 
+ * @param display 
+ * @param flush 
+ */
+void initEditor(Editor *editor, DisplayPanel *display, EditorFlush flush);
+
+/**
+ * @brief Check the editor state invariants.
+ * 
+ * @param editor 
+ * @return EditorCheck 
+ */
+EditorCheck checkEditor(Editor *editor);
+
+/**
+ * @brief Set the editor time and fire the expired timers.
+ * 
+ * @param editor 
+ * @param now 
+ */
+void setEditorTime(Editor *editor, uint64_t now);
+
+/**
+ * @brief Restart the idle delay and wake up the idle editor.
+ * 
+ * @param editor 
+ */
+void touchEditor(Editor *editor);
+
+/**
+ * @brief Get the time left until the next editor timer.
+ * 
+ * @param editor 
+ * @param now 
+ * @return uint32_t 
+ */
+uint32_t getEditorIdle(Editor *editor, uint64_t now);
+
+#endif
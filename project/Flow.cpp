@@ -0,0 +1,195 @@
+/**
+ * @file Flow.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Flow.h"
+#include "Shared.h"
+
+// Frame pool, taken once and never returned to the heap, the promise
+// of every running flow is registered at its frame
+alignas(max_align_t) SHARED_STATE uint8_t FlowFrames[FLOW_FRAMES][FLOW_FRAME_SIZE];
+SHARED_STATE FlowPromise *flowPromises[FLOW_FRAMES];
+SHARED_STATE bool flowFrameUsed[FLOW_FRAMES];
+SHARED_STATE FlowStats flowStats = {0, 0, 0, 0};
+
+/**
+ * @brief Get the pool frame holding the address.
+ * 
+ * @param address 
+ * @return uint8_t FLOW_FRAMES if the address is outside the pool, the
+ * promise of a flow whose frame the compiler placed elsewhere
+ */
+uint8_t getFlowFrame(const void *address) {
+  const uint8_t *byte = (const uint8_t *)address;
+
+  if (byte < &FlowFrames[0][0] || byte >= &FlowFrames[0][0] + sizeof(FlowFrames)) {
+    return FLOW_FRAMES;
+  }
+
+  return (byte - &FlowFrames[0][0]) / FLOW_FRAME_SIZE;
+}
+
+/**
+ * @brief Take a free pool frame for the coroutine frame.
+ * 
+ * @param size 
+ * @return void* frame or NULL if the pool is full or the frame does
+ * not fit, the flow is then not created
+ */
+void *FlowPromise::operator new(size_t size) noexcept {
+  if (size > flowStats.frameSize) flowStats.frameSize = size;
+
+  for (uint8_t idx = 0; idx < FLOW_FRAMES && size <= FLOW_FRAME_SIZE; ++idx) {
+    if (!flowFrameUsed[idx]) {
+      flowFrameUsed[idx] = true;
+      flowStats.running++;
+      if (flowStats.running > flowStats.peak) flowStats.peak = flowStats.running;
+      return FlowFrames[idx];
+    }
+  }
+
+  flowStats.failed++;
+  return NULL;
+}
+
+/**
+ * @brief Return the coroutine frame to the pool.
+ * 
+ * @param frame 
+ */
+void FlowPromise::operator delete(void *frame) noexcept {
+  flowFrameUsed[getFlowFrame(frame)] = false;
+  flowStats.running--;
+}
+
+/**
+ * @brief Resume the flow of the expired timer, an awaited event did
+ * not come.
+ * 
+ * @param timer 
+ */
+void handleFlowTimeout(Timer *timer) {
+  FlowPromise *promise = (FlowPromise *)timer->context;
+  promise->event = FLOW_EVENT_NONE;
+  std::coroutine_handle<FlowPromise>::from_promise(*promise).resume();
+}
+
+/**
+ * @brief Register the promise at its pool frame, a promise outside
+ * the pool is not registered and gets no events.
+ * 
+ */
+FlowPromise::FlowPromise() {
+  initTimer(&timer, handleFlowTimeout, this);
+
+  uint8_t frame = getFlowFrame(this);
+  if (frame < FLOW_FRAMES) flowPromises[frame] = this;
+}
+
+/**
+ * @brief Disarm the timer of the ended or destroyed flow.
+ * 
+ */
+FlowPromise::~FlowPromise() {
+  if (wheel != NULL) cancelTimer(wheel, &timer);
+
+  uint8_t frame = getFlowFrame(this);
+  if (frame < FLOW_FRAMES) flowPromises[frame] = NULL;
+}
+
+/**
+ * @brief Arm the flow timer on the deadline.
+ * 
+ * @param handle 
+ */
+void FlowSleep::await_suspend(std::coroutine_handle<FlowPromise> handle) noexcept {
+  FlowPromise *promise = &handle.promise();
+  armTimer(promise->wheel, &promise->timer, deadline);
+}
+
+/**
+ * @brief Mark the awaited event and arm the flow timer on the
+ * deadline.
+ * 
+ * @param handle 
+ */
+void FlowWait::await_suspend(std::coroutine_handle<FlowPromise> handle) noexcept {
+  promise = &handle.promise();
+  promise->event = event;
+  promise->signaled = false;
+  armTimer(promise->wheel, &promise->timer, deadline);
+}
+
+/**
+ * @brief Run the created flow to its first suspension, its timers
+ * are armed on the wheel.
+ * 
+ * @param flow 
+ * @param wheel 
+ * @return true 
+ * @return false no frame was free
+ */
+bool startFlow(Flow flow, TimerWheel *wheel) {
+  if (!flow.handle) {
+    return false;
+  }
+
+  flow.handle.promise().wheel = wheel;
+  flow.handle.resume();
+  return true;
+}
+
+/**
+ * @brief Destroy the suspended flows of the timer wheel, called
+ * before the wheel is reset.
+ * 
+ * @param wheel 
+ */
+void stopFlows(TimerWheel *wheel) {
+  for (uint8_t idx = 0; idx < FLOW_FRAMES; ++idx) {
+    FlowPromise *promise = flowPromises[idx];
+
+    if (promise != NULL && promise->wheel == wheel) {
+      std::coroutine_handle<FlowPromise>::from_promise(*promise).destroy();
+    }
+  }
+}
+
+/**
+ * @brief Resume the flows of the wheel waiting for the event, their
+ * timeout is disarmed.
+ * 
+ * @param wheel 
+ * @param event 
+ */
+void signalFlowEvent(TimerWheel *wheel, FlowEvent event) {
+  for (uint8_t idx = 0; idx < FLOW_FRAMES; ++idx) {
+    FlowPromise *promise = flowPromises[idx];
+
+    if (promise != NULL && promise->wheel == wheel && promise->event == event) {
+      cancelTimer(wheel, &promise->timer);
+      promise->event = FLOW_EVENT_NONE;
+      promise->signaled = true;
+      std::coroutine_handle<FlowPromise>::from_promise(*promise).resume();
+    }
+  }
+}
+
+/**
+ * @brief Get the flow pool usage.
+ * 
+ * @return FlowStats 
+ */
+FlowStats getFlowStats() {
+  return flowStats;
+}
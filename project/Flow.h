@@ -0,0 +1,198 @@
+/**
+ * @file Flow.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef FLOW_H
+#define FLOW_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <coroutine>
+
+#include "Timer.h"
+
+// Frames of the flow pool, at most this many flows run at once
+#ifndef FLOW_FRAMES
+#define FLOW_FRAMES 4
+#endif
+
+// Size of one flow frame in bytes, a flow with a larger frame does
+// not start
+#ifndef FLOW_FRAME_SIZE
+#define FLOW_FRAME_SIZE 256
+#endif
+
+/**
+ * @brief Enum values for events a flow can wait for.
+ * 
+ */
+typedef enum {
+  FLOW_EVENT_NONE,
+  FLOW_EVENT_SENT
+} FlowEvent;
+
+/**
+ * @brief Structure for flow pool usage report, the running flows,
+ * their most at once, flows not started for a full pool or a too
+ * large frame and the largest frame.
+ * 
+ */
+typedef struct {
+  uint8_t running;
+  uint8_t peak;
+  uint32_t failed;
+  uint16_t frameSize;
+} FlowStats;
+
+struct FlowPromise;
+
+/**
+ * @brief Structure for a started flow, a stackless coroutine run by
+ * the editor timers, the handle is empty if no frame was free.
+ * 
+ */
+struct Flow {
+  using promise_type = FlowPromise;
+  std::coroutine_handle<FlowPromise> handle;
+};
+
+/**
+ * @brief Structure for the flow state kept in its frame, the timer
+ * wheel resuming it, its timer and the awaited event.
+ * 
+ */
+struct FlowPromise {
+  TimerWheel *wheel = NULL;
+  Timer timer;
+  FlowEvent event = FLOW_EVENT_NONE;
+  bool signaled = false;
+
+  FlowPromise();
+  ~FlowPromise();
+
+  static void *operator new(size_t size) noexcept;
+  static void operator delete(void *frame) noexcept;
+
+  static Flow get_return_object_on_allocation_failure() noexcept {
+    return Flow{nullptr};
+  }
+
+  Flow get_return_object() noexcept {
+    return Flow{std::coroutine_handle<FlowPromise>::from_promise(*this)};
+  }
+
+  // A flow runs from startFlow and frees its frame at the end
+  std::suspend_always initial_suspend() noexcept {
+    return {};
+  }
+
+  std::suspend_never final_suspend() noexcept {
+    return {};
+  }
+
+  void return_void() noexcept {
+  }
+
+  void unhandled_exception() noexcept {
+  }
+};
+
+/**
+ * @brief Structure for awaiting the deadline of the flow timer.
+ * 
+ */
+struct FlowSleep {
+  uint64_t deadline;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<FlowPromise> handle) noexcept;
+
+  void await_resume() const noexcept {
+  }
+};
+
+/**
+ * @brief Structure for awaiting the event until the deadline.
+ * 
+ */
+struct FlowWait {
+  FlowEvent event;
+  uint64_t deadline;
+  FlowPromise *promise;
+
+  bool await_ready() const noexcept {
+    return false;
+  }
+
+  void await_suspend(std::coroutine_handle<FlowPromise> handle) noexcept;
+
+  bool await_resume() const noexcept {
+    return promise->signaled;
+  }
+};
+
+/**
+ * @brief Run the created flow to its first suspension.
+ * 
+ * @param flow 
+ * @param wheel 
+ * @return true 
+ * @return false 
+ */
+bool startFlow(Flow flow, TimerWheel *wheel);
+
+/**
+ * @brief Destroy the flows of the timer wheel.
+ * 
+ * @param wheel 
+ */
+void stopFlows(TimerWheel *wheel);
+
+/**
+ * @brief Resume the flows waiting for the event.
+ * 
+ * @param wheel 
+ * @param event 
+ */
+void signalFlowEvent(TimerWheel *wheel, FlowEvent event);
+
+/**
+ * @brief Suspend the flow until the deadline.
+ * 
+ * @param deadline 
+ * @return FlowSleep 
+ */
+inline FlowSleep sleepFlow(uint64_t deadline) {
+  return FlowSleep{deadline};
+}
+
+/**
+ * @brief Suspend the flow until the event or the deadline, the await
+ * is true if the event came.
+ * 
+ * @param event 
+ * @param deadline 
+ * @return FlowWait 
+ */
+inline FlowWait waitFlowEvent(FlowEvent event, uint64_t deadline) {
+  return FlowWait{event, deadline, NULL};
+}
+
+/**
+ * @brief Get the flow pool usage.
+ * 
+ * @return FlowStats 
+ */
+FlowStats getFlowStats();
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ * @file Font.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+
+#include "Font.h"
+
+// Classic 5x7 glyphs for printable ASCII chars followed by the glyphs
+// of the internal code page chars, accents use the top two rows
+const uint8_t FontGlyphs[][GLYPH_WIDTH] = {
+  {0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+  {0x00, 0x00, 0x5F, 0x00, 0x00}, // '!'
+  {0x00, 0x07, 0x00, 0x07, 0x00}, // '"'
+  {0x14, 0x7F, 0x14, 0x7F, 0x14}, // '#'
+  {0x24, 0x2A, 0x7F, 0x2A, 0x12}, // '$'
+  {0x23, 0x13, 0x08, 0x64, 0x62}, // '%'
+  {0x36, 0x49, 0x56, 0x20, 0x50}, // '&'
+  {0x00, 0x08, 0x07, 0x03, 0x00}, // '''
+  {0x00, 0x1C, 0x22, 0x41, 0x00}, // '('
+  {0x00, 0x41, 0x22, 0x1C, 0x00}, // ')'
+  {0x2A, 0x1C, 0x7F, 0x1C, 0x2A}, // '*'
+  {0x08, 0x08, 0x3E, 0x08, 0x08}, // '+'
+  {0x00, 0x80, 0x70, 0x30, 0x00}, // ','
+  {0x08, 0x08, 0x08, 0x08, 0x08}, // '-'
+  {0x00, 0x00, 0x60, 0x60, 0x00}, // '.'
+  {0x20, 0x10, 0x08, 0x04, 0x02}, // '/'
+  {0x3E, 0x51, 0x49, 0x45, 0x3E}, // '0'
+  {0x00, 0x42, 0x7F, 0x40, 0x00}, // '1'
+  {0x72, 0x49, 0x49, 0x49, 0x46}, // '2'
+  {0x21, 0x41, 0x49, 0x4D, 0x33}, // '3'
+  {0x18, 0x14, 0x12, 0x7F, 0x10}, // '4'
+  {0x27, 0x45, 0x45, 0x45, 0x39}, // '5'
+  {0x3C, 0x4A, 0x49, 0x49, 0x31}, // '6'
+  {0x41, 0x21, 0x11, 0x09, 0x07}, // '7'
+  {0x36, 0x49, 0x49, 0x49, 0x36}, // '8'
+  {0x46, 0x49, 0x49, 0x29, 0x1E}, // '9'
+  {0x00, 0x00, 0x14, 0x00, 0x00}, // ':'
+  {0x00, 0x40, 0x34, 0x00, 0x00}, // ';'
+  {0x00, 0x08, 0x14, 0x22, 0x41}, // '<'
+  {0x14, 0x14, 0x14, 0x14, 0x14}, // '='
+  {0x00, 0x41, 0x22, 0x14, 0x08}, // '>'
+  {0x02, 0x01, 0x59, 0x09, 0x06}, // '?'
+  {0x3E, 0x41, 0x5D, 0x59, 0x4E}, // '@'
+  {0x7C, 0x12, 0x11, 0x12, 0x7C}, // 'A'
+  {0x7F, 0x49, 0x49, 0x49, 0x36}, // 'B'
+  {0x3E, 0x41, 0x41, 0x41, 0x22}, // 'C'
+  {0x7F, 0x41, 0x41, 0x41, 0x3E}, // 'D'
+  {0x7F, 0x49, 0x49, 0x49, 0x41}, // 'E'
+  {0x7F, 0x09, 0x09, 0x09, 0x01}, // 'F'
+  {0x3E, 0x41, 0x41, 0x51, 0x73}, // 'G'
+  {0x7F, 0x08, 0x08, 0x08, 0x7F}, // 'H'
+  {0x00, 0x41, 0x7F, 0x41, 0x00}, // 'I'
+  {0x20, 0x40, 0x41, 0x3F, 0x01}, // 'J'
+  {0x7F, 0x08, 0x14, 0x22, 0x41}, // 'K'
+  {0x7F, 0x40, 0x40, 0x40, 0x40}, // 'L'
+  {0x7F, 0x02, 0x1C, 0x02, 0x7F}, // 'M'
+  {0x7F, 0x04, 0x08, 0x10, 0x7F}, // 'N'
+  {0x3E, 0x41, 0x41, 0x41, 0x3E}, // 'O'
+  {0x7F, 0x09, 0x09, 0x09, 0x06}, // 'P'
+  {0x3E, 0x41, 0x51, 0x21, 0x5E}, // 'Q'
+  {0x7F, 0x09, 0x19, 0x29, 0x46}, // 'R'
+  {0x26, 0x49, 0x49, 0x49, 0x32}, // 'S'
+  {0x03, 0x01, 0x7F, 0x01, 0x03}, // 'T'
+  {0x3F, 0x40, 0x40, 0x40, 0x3F}, // 'U'
+  {0x1F, 0x20, 0x40, 0x20, 0x1F}, // 'V'
+  {0x3F, 0x40, 0x38, 0x40, 0x3F}, // 'W'
+  {0x63, 0x14, 0x08, 0x14, 0x63}, // 'X'
+  {0x03, 0x04, 0x78, 0x04, 0x03}, // 'Y'
+  {0x61, 0x59, 0x49, 0x4D, 0x43}, // 'Z'
+  {0x00, 0x7F, 0x41, 0x41, 0x41}, // '['
+  {0x02, 0x04, 0x08, 0x10, 0x20}, // '\'
+  {0x00, 0x41, 0x41, 0x41, 0x7F}, // ']'
+  {0x04, 0x02, 0x01, 0x02, 0x04}, // '^'
+  {0x40, 0x40, 0x40, 0x40, 0x40}, // '_'
+  {0x00, 0x03, 0x07, 0x08, 0x00}, // '`'
+  {0x20, 0x54, 0x54, 0x78, 0x40}, // 'a'
+  {0x7F, 0x28, 0x44, 0x44, 0x38}, // 'b'
+  {0x38, 0x44, 0x44, 0x44, 0x28}, // 'c'
+  {0x38, 0x44, 0x44, 0x28, 0x7F}, // 'd'
+  {0x38, 0x54, 0x54, 0x54, 0x18}, // 'e'
+  {0x00, 0x08, 0x7E, 0x09, 0x02}, // 'f'
+  {0x18, 0xA4, 0xA4, 0x9C, 0x78}, // 'g'
+  {0x7F, 0x08, 0x04, 0x04, 0x78}, // 'h'
+  {0x00, 0x44, 0x7D, 0x40, 0x00}, // 'i'
+  {0x20, 0x40, 0x40, 0x3D, 0x00}, // 'j'
+  {0x7F, 0x10, 0x28, 0x44, 0x00}, // 'k'
+  {0x00, 0x41, 0x7F, 0x40, 0x00}, // 'l'
+  {0x7C, 0x04, 0x78, 0x04, 0x78}, // 'm'
+  {0x7C, 0x08, 0x04, 0x04, 0x78}, // 'n'
+  {0x38, 0x44, 0x44, 0x44, 0x38}, // 'o'
+  {0xFC, 0x18, 0x24, 0x24, 0x18}, // 'p'
+  {0x18, 0x24, 0x24, 0x18, 0xFC}, // 'q'
+  {0x7C, 0x08, 0x04, 0x04, 0x08}, // 'r'
+  {0x48, 0x54, 0x54, 0x54, 0x24}, // 's'
+  {0x04, 0x04, 0x3F, 0x44, 0x24}, // 't'
+  {0x3C, 0x40, 0x40, 0x20, 0x7C}, // 'u'
+  {0x1C, 0x20, 0x40, 0x20, 0x1C}, // 'v'
+  {0x3C, 0x40, 0x30, 0x40, 0x3C}, // 'w'
+  {0x44, 0x28, 0x10, 0x28, 0x44}, // 'x'
+  {0x4C, 0x90, 0x90, 0x90, 0x7C}, // 'y'
+  {0x44, 0x64, 0x54, 0x4C, 0x44}, // 'z'
+  {0x00, 0x08, 0x36, 0x41, 0x00}, // '{'
+  {0x00, 0x00, 0x77, 0x00, 0x00}, // '|'
+  {0x00, 0x41, 0x36, 0x08, 0x00}, // '}'
+  {0x02, 0x01, 0x02, 0x04, 0x02}, // '~'
+
+  // Code page chars from 0x7F, generated by tools/glyphs.py
+  {0x02, 0x01, 0x51, 0x09, 0x06}, // 0x7F
+  {0x48, 0x7E, 0x49, 0x41, 0x42}, // '£'
+  {0x2B, 0x2C, 0x78, 0x2C, 0x2B}, // '¥'
+  {0x38, 0x55, 0x56, 0x54, 0x18}, // 'è'
+  {0x3C, 0x41, 0x42, 0x20, 0x7C}, // 'ù'
+  {0x00, 0x45, 0x7E, 0x40, 0x00}, // 'ì'
+  {0x38, 0x45, 0x46, 0x44, 0x38}, // 'ò'
+  {0x5E, 0x31, 0x49, 0x46, 0x3D}, // 'Ø'
+  {0x58, 0x64, 0x54, 0x4C, 0x34}, // 'ø'
+  {0xF8, 0x23, 0x25, 0x23, 0xF8}, // 'Å'
+  {0x20, 0x57, 0x55, 0x7B, 0x40}, // 'å'
+  {0x70, 0x4C, 0x43, 0x4C, 0x70}, // 'Δ'
+  {0x0C, 0x12, 0x7F, 0x12, 0x0C}, // 'Φ'
+  {0x7F, 0x01, 0x01, 0x01, 0x03}, // 'Γ'
+  {0x70, 0x0C, 0x03, 0x0C, 0x70}, // 'Λ'
+  {0x5E, 0x61, 0x01, 0x61, 0x5E}, // 'Ω'
+  {0x7F, 0x01, 0x01, 0x01, 0x7F}, // 'Π'
+  {0x07, 0x08, 0x7F, 0x08, 0x07}, // 'Ψ'
+  {0x63, 0x55, 0x49, 0x41, 0x63}, // 'Σ'
+  {0x3E, 0x49, 0x49, 0x49, 0x3E}, // 'Θ'
+  {0x41, 0x49, 0x49, 0x49, 0x41}, // 'Ξ'
+  {0x7E, 0x09, 0x7F, 0x49, 0x41}, // 'Æ'
+  {0x20, 0x54, 0x78, 0x54, 0x58}, // 'æ'
+  {0xFE, 0x09, 0x11, 0x22, 0xFD}, // 'Ñ'
+  {0x7E, 0x09, 0x05, 0x06, 0x79}, // 'ñ'
+  {0x00, 0x00, 0x7D, 0x00, 0x00}, // '¡'
+  {0x30, 0x48, 0x45, 0x40, 0x20}, // '¿'
+  {0x20, 0x55, 0x56, 0x78, 0x40}, // 'à'
+  {0x14, 0x3E, 0x55, 0x41, 0x22}, // '€'
+  {0x02, 0x01, 0x51, 0x09, 0x06}, // 0x9C
+  {0x02, 0x01, 0x51, 0x09, 0x06}, // 0x9D
+  {0x02, 0x01, 0x51, 0x09, 0x06}, // 0x9E
+  {0x02, 0x01, 0x51, 0x09, 0x06}, // 0x9F
+  {0x00, 0x00, 0x00, 0x00, 0x00}, // 0xA0
+  {0x7C, 0x12, 0x11, 0x92, 0xFC}, // 'Ą'
+  {0x00, 0x01, 0x02, 0x01, 0x00}, // '˘'
+  {0x7F, 0x48, 0x44, 0x40, 0x40}, // 'Ł'
+  {0x22, 0x1C, 0x14, 0x1C, 0x22}, // '¤'
+  {0x7F, 0x40, 0x43, 0x40, 0x40}, // 'Ľ'
+  {0x48, 0x94, 0x96, 0x95, 0x60}, // 'Ś'
+  {0x00, 0x4A, 0x55, 0x29, 0x00}, // '§'
+  {0x00, 0x01, 0x00, 0x01, 0x00}, // '¨'
+  {0x48, 0x95, 0x96, 0x95, 0x60}, // 'Š'
+  {0x26, 0x49, 0xC9, 0xC9, 0x32}, // 'Ş'
+  {0x04, 0x05, 0xFE, 0x05, 0x04}, // 'Ť'
+  {0xC4, 0xB4, 0x96, 0x9D, 0x84}, // 'Ź'
+  {0x08, 0x08, 0x08, 0x08, 0x00}, // 0xAD
+  {0xC4, 0xB5, 0x96, 0x9D, 0x84}, // 'Ž'
+  {0xC4, 0xB4, 0x95, 0x9C, 0x84}, // 'Ż'
+  {0x00, 0x06, 0x09, 0x09, 0x06}, // '°'
+  {0x20, 0x54, 0x54, 0xF8, 0xC0}, // 'ą'
+  {0x00, 0x00, 0x80, 0x40, 0x00}, // '˛'
+  {0x00, 0x49, 0x7F, 0x44, 0x00}, // 'ł'
+  {0x00, 0x00, 0x02, 0x01, 0x00}, // '´'
+  {0x00, 0x41, 0x7F, 0x40, 0x03}, // 'ľ'
+  {0x48, 0x54, 0x56, 0x55, 0x24}, // 'ś'
+  {0x00, 0x01, 0x02, 0x01, 0x00}, // 'ˇ'
+  {0x00, 0x00, 0x80, 0x40, 0x00}, // '¸'
+  {0x48, 0x55, 0x56, 0x55, 0x24}, // 'š'
+  {0x48, 0x54, 0xD4, 0xD4, 0x24}, // 'ş'
+  {0x04, 0x04, 0x3F, 0x44, 0x27}, // 'ť'
+  {0x44, 0x64, 0x56, 0x4D, 0x44}, // 'ź'
+  {0x00, 0x02, 0x01, 0x02, 0x01}, // '˝'
+  {0x44, 0x65, 0x56, 0x4D, 0x44}, // 'ž'
+  {0x44, 0x64, 0x55, 0x4C, 0x44}, // 'ż'
+  {0xFC, 0x14, 0x36, 0x55, 0x88}, // 'Ŕ'
+  {0xF8, 0x20, 0x26, 0x21, 0xF8}, // 'Á'
+  {0xF8, 0x22, 0x25, 0x22, 0xF8}, // 'Â'
+  {0xF8, 0x21, 0x26, 0x21, 0xF8}, // 'Ă'
+  {0xF8, 0x21, 0x24, 0x21, 0xF8}, // 'Ä'
+  {0xFC, 0x80, 0x82, 0x81, 0x80}, // 'Ĺ'
+  {0x78, 0x84, 0x86, 0x85, 0x40}, // 'Ć'
+  {0x3E, 0x41, 0xC1, 0xC1, 0x22}, // 'Ç'
+  {0x78, 0x85, 0x86, 0x85, 0x40}, // 'Č'
+  {0xFC, 0x94, 0x96, 0x95, 0x84}, // 'É'
+  {0x7F, 0x49, 0x49, 0xC9, 0xC1}, // 'Ę'
+  {0xFC, 0x95, 0x94, 0x95, 0x84}, // 'Ë'
+  {0xFC, 0x95, 0x96, 0x95, 0x84}, // 'Ě'
+  {0x00, 0x84, 0xFE, 0x85, 0x00}, // 'Í'
+  {0x00, 0x86, 0xFD, 0x86, 0x00}, // 'Î'
+  {0xFC, 0x85, 0x86, 0x85, 0x78}, // 'Ď'
+  {0x08, 0x7F, 0x49, 0x41, 0x3E}, // 'Đ'
+  {0xFC, 0x08, 0x12, 0x21, 0xFC}, // 'Ń'
+  {0xFC, 0x09, 0x12, 0x21, 0xFC}, // 'Ň'
+  {0x78, 0x84, 0x86, 0x85, 0x78}, // 'Ó'
+  {0x78, 0x86, 0x85, 0x86, 0x78}, // 'Ô'
+  {0x78, 0x86, 0x85, 0x86, 0x79}, // 'Ő'
+  {0x78, 0x85, 0x84, 0x85, 0x78}, // 'Ö'
+  {0x22, 0x14, 0x08, 0x14, 0x22}, // '×'
+  {0xFC, 0x15, 0x36, 0x55, 0x88}, // 'Ř'
+  {0x7C, 0x83, 0x81, 0x83, 0x7C}, // 'Ů'
+  {0x7C, 0x80, 0x82, 0x81, 0x7C}, // 'Ú'
+  {0x7C, 0x82, 0x81, 0x82, 0x7D}, // 'Ű'
+  {0x7C, 0x81, 0x80, 0x81, 0x7C}, // 'Ü'
+  {0x04, 0x08, 0xF2, 0x09, 0x04}, // 'Ý'
+  {0x03, 0x01, 0xFF, 0x81, 0x03}, // 'Ţ'
+  {0x7E, 0x01, 0x49, 0x56, 0x20}, // 'ß'
+  {0x7C, 0x08, 0x06, 0x05, 0x08}, // 'ŕ'
+  {0x20, 0x54, 0x56, 0x79, 0x40}, // 'á'
+  {0x20, 0x56, 0x55, 0x7A, 0x40}, // 'â'
+  {0x20, 0x55, 0x56, 0x79, 0x40}, // 'ă'
+  {0x20, 0x55, 0x54, 0x79, 0x40}, // 'ä'
+  {0x00, 0x41, 0x7F, 0x41, 0x00}, // 'ĺ'
+  {0x38, 0x44, 0x46, 0x45, 0x28}, // 'ć'
+  {0x38, 0x44, 0xC4, 0xC4, 0x28}, // 'ç'
+  {0x38, 0x45, 0x46, 0x45, 0x28}, // 'č'
+  {0x38, 0x54, 0x56, 0x55, 0x18}, // 'é'
+  {0x38, 0x54, 0x54, 0xD4, 0x98}, // 'ę'
+  {0x38, 0x55, 0x54, 0x55, 0x18}, // 'ë'
+  {0x38, 0x55, 0x56, 0x55, 0x18}, // 'ě'
+  {0x00, 0x44, 0x7E, 0x41, 0x00}, // 'í'
+  {0x00, 0x46, 0x7D, 0x42, 0x00}, // 'î'
+  {0x38, 0x44, 0x44, 0x7F, 0x03}, // 'ď'
+  {0x38, 0x44, 0x44, 0x4A, 0x7F}, // 'đ'
+  {0x7C, 0x08, 0x06, 0x05, 0x78}, // 'ń'
+  {0x7C, 0x09, 0x06, 0x05, 0x78}, // 'ň'
+  {0x38, 0x44, 0x46, 0x45, 0x38}, // 'ó'
+  {0x38, 0x46, 0x45, 0x46, 0x38}, // 'ô'
+  {0x38, 0x46, 0x45, 0x46, 0x39}, // 'ő'
+  {0x38, 0x45, 0x44, 0x45, 0x38}, // 'ö'
+  {0x08, 0x08, 0x2A, 0x08, 0x08}, // '÷'
+  {0x7C, 0x09, 0x06, 0x05, 0x08}, // 'ř'
+  {0x3C, 0x43, 0x41, 0x23, 0x7C}, // 'ů'
+  {0x3C, 0x40, 0x42, 0x21, 0x7C}, // 'ú'
+  {0x3C, 0x42, 0x41, 0x22, 0x7D}, // 'ű'
+  {0x3C, 0x41, 0x40, 0x21, 0x7C}, // 'ü'
+  {0x4C, 0x90, 0x92, 0x91, 0x7C}, // 'ý'
+  {0x04, 0x04, 0xBF, 0xC4, 0x24}, // 'ţ'
+  {0x00, 0x00, 0x01, 0x00, 0x00}  // '˙'
+};
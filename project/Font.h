@@ -0,0 +1,50 @@
+/**
+ * @file Font.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+
+// Glyph size in pixels, one column byte per glyph column
+#define GLYPH_WIDTH 5
+#define GLYPH_HEIGHT 8
+
+// Glyph cell size with spacing
+#define GLYPH_CELL_WIDTH 6
+#define GLYPH_CELL_HEIGHT 8
+
+// First and last char with glyph, every code page char above
+// the control chars has one
+#define FONT_FIRST_CHAR 0x20
+#define FONT_LAST_CHAR 0xFF
+
+// Glyph drawn for chars without glyph
+#define FONT_MISSING_CHAR '?'
+
+// Glyph columns, bit 0 is the top row
+extern const uint8_t FontGlyphs[][GLYPH_WIDTH];
+
+/**
+ * @brief Get the glyph columns of the char.
+ * 
+ * @param ch 
+ * @return const uint8_t* 
+ */
+inline const uint8_t *getGlyph(uint8_t ch) {
+  if (ch < FONT_FIRST_CHAR) {
+    ch = FONT_MISSING_CHAR;
+  }
+
+  return FontGlyphs[ch - FONT_FIRST_CHAR];
+}
+
+#endif
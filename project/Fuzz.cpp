@@ -0,0 +1,245 @@
+/**
+ * @file Fuzz.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Fuzz.h"
+#include "Editor.h"
+#include "Display.h"
+#include "Keypad.h"
+#include "Undo.h"
+#include "Buffer.h"
+#include "Shared.h"
+
+// Editor driven by the fuzz runs, the device editor is not touched
+SHARED_STATE Editor FuzzEditor;
+
+// Display panel of the fuzz editor, never sent to the hardware
+SHARED_STATE DisplayPanel FuzzPanel;
+
+// Reference rendering of the fuzz editor text area
+SHARED_STATE DisplayPanel FuzzReference;
+
+// Delays between steps, around the editor timeouts
+const uint16_t FuzzDelays[] = {
+  0, 1, CURSOR_MOVE_DELAY, CURSOR_MOVE_DELAY + 1,
+  DELETE_SPEED_DELAY + 1, UNDO_SPEED_DELAY + 1,
+  MULTITAP_MIN_DELAY - 1, MULTITAP_DELAY - 1, MULTITAP_DELAY,
+  MULTITAP_MAX_DELAY, CURSOR_BLINK_DELAY, 2000
+};
+
+// Text inserted by the fuzz runs
+const char FuzzText[] = "hello world. 0123456789 abc? def!";
+
+/**
+ * @brief Get the next xorshift random value.
+ * 
+ * @param state 
+ * @return uint32_t 
+ */
+uint32_t nextRandom(uint32_t *state) {
+  uint32_t value = *state;
+  value ^= value << 13;
+  value ^= value >> 17;
+  value ^= value << 5;
+  *state = value;
+  return value;
+}
+
+/**
+ * @brief Get the random delay between steps.
+ * 
+ * @param state 
+ * @return uint16_t 
+ */
+uint16_t nextDelay(uint32_t *state) {
+  return FuzzDelays[nextRandom(state) % (sizeof(FuzzDelays) / sizeof(FuzzDelays[0]))];
+}
+
+/**
+ * @brief Flush hook of the fuzz editor, the frame stays in the panel.
+ * 
+ * @param editor 
+ */
+void skipFlush(Editor * /*editor*/) {
+}
+
+/**
+ * @brief Render the visible message page into the reference panel
+ * cell by cell and compare it with the editor text area, the cell
+ * under the cursor is skipped.
+ * 
+ * @param editor 
+ * @return EditorCheck 
+ */
+EditorCheck checkFrame(Editor *editor) {
+  if (editor->helpVisible || editor->historyVisible || editor->sending) {
+    return CHECK_OK;
+  }
+
+  FuzzReference.clearDisplay();
+  FuzzReference.setRotation(DISPLAY_ROTATION);
+  FuzzReference.setTextSize(TEXT_SIZE);
+  FuzzReference.setTextColor(COLOR_WHITE);
+
+  size_t len = getBufferLen(editor);
+  size_t startIdx = editor->scrollRow * CHARS_PER_LINE;
+
+  for (size_t idx = startIdx; idx < len && idx < startIdx + VISIBLE_LINES * CHARS_PER_LINE; ++idx) {
+    size_t cell = idx - startIdx;
+    FuzzReference.setCursor(MIN_X_POS + (cell % CHARS_PER_LINE) * FONT_WIDTH,
+                            MIN_Y_POS + (cell / CHARS_PER_LINE) * FONT_HEIGHT);
+    FuzzReference.print(getBufferCharByIndex(editor, idx));
+
+    if (isSpellMark(editor, idx)) {
+      FuzzReference.drawFastHLine(MIN_X_POS + (cell % CHARS_PER_LINE) * FONT_WIDTH,
+                                  MIN_Y_POS + (cell / CHARS_PER_LINE + 1) * FONT_HEIGHT - 1,
+                                  FONT_WIDTH, COLOR_WHITE);
+    }
+  }
+
+  size_t cursorCell = editor->bufferIndex - startIdx;
+  int16_t cursorX = MIN_X_POS + (cursorCell % CHARS_PER_LINE) * FONT_WIDTH;
+  int16_t cursorY = MIN_Y_POS + (cursorCell / CHARS_PER_LINE) * FONT_HEIGHT;
+
+  for (int16_t y = MIN_Y_POS; y < MIN_Y_POS + VISIBLE_LINES * FONT_HEIGHT; ++y) {
+    for (int16_t x = MIN_X_POS; x < MIN_X_POS + CHARS_PER_LINE * FONT_WIDTH; ++x) {
+      if (x >= cursorX && x < cursorX + FONT_WIDTH && y >= cursorY && y < cursorY + FONT_HEIGHT) {
+        continue;
+      }
+
+      if ((editor->display->getPixel(x, y) != COLOR_BLACK) != (FuzzReference.getPixel(x, y) != COLOR_BLACK)) {
+        return CHECK_FRAME;
+      }
+    }
+  }
+
+  return CHECK_OK;
+}
+
+/**
+ * @brief Apply one random step on the editor, key press, long press
+ * hold with release, text insert or star chord, then advance the
+ * editor time and fire its timers.
+ * Long press of send key is taken as press, it stores the message
+ * in the history, so is long press of history key, the history is
+ * shared with the device editor.
+ * 
+ * @param editor 
+ * @param state 
+ * @param key 
+ * @param action 
+ */
+void runFuzzStep(Editor *editor, uint32_t *state, Key *key, FuzzAction *action) {
+  uint32_t value = nextRandom(state);
+  uint8_t choice = (value >> 8) % 9;
+
+  *key = (Key)(value % (KEY_H + 1));
+  *action = choice < 6 ? FUZZ_PRESS : choice == 6 ? FUZZ_HOLD : choice == 7 ? FUZZ_TEXT : FUZZ_CHORD;
+
+  // Chords take only digits
+  if (*action == FUZZ_CHORD && *key > KEY_9) {
+    *action = FUZZ_HOLD;
+  }
+
+  if ((*action == FUZZ_HOLD || *action == FUZZ_CHORD) && (*key == KEY_5 || *key == KEY_9)) {
+    *action = FUZZ_PRESS;
+  }
+
+  switch (*action) {
+    case FUZZ_PRESS:
+      handlePress(editor, *key);
+      break;
+
+    case FUZZ_HOLD:
+      for (uint8_t repeat = 0; repeat <= (value >> 16) % FUZZ_MAX_HOLD; ++repeat) {
+        handleLongPress(editor, *key, editor->now);
+        setEditorTime(editor, editor->now + nextDelay(state));
+      }
+      handleLongRelease(editor, *key, editor->now);
+      break;
+
+    case FUZZ_TEXT: {
+      uint8_t offset = (value >> 16) % (sizeof(FuzzText) - 1);
+      uint8_t len = (value >> 24) % (sizeof(FuzzText) - offset);
+      handleText(editor, FuzzText + offset, len, value & 1, editor->now);
+      drawHeader(editor);
+      break;
+    }
+
+    case FUZZ_CHORD:
+      handleChord(editor, KEYPAD_CHORD_KEY, *key, editor->now);
+      break;
+  }
+
+  setEditorTime(editor, editor->now + nextDelay(state));
+}
+
+/**
+ * @brief Initialize the fuzz editor with its cleared panel and the
+ * header drawn, the fuzz runs and benchmarks start from it.
+ * 
+ * @return Editor* 
+ */
+Editor *resetFuzzEditor() {
+  Editor *editor = &FuzzEditor;
+  initEditor(editor, &FuzzPanel, skipFlush);
+  resetDisplay(editor);
+  drawHeader(editor);
+  return editor;
+}
+
+/**
+ * @brief Reset the fuzz editor and apply the random steps generated
+ * from the seed, the editor invariants and the text area are checked
+ * after every step, the run stops on the first violation.
+ * 
+ * @param seed 
+ * @param steps 
+ * @return FuzzResult 
+ */
+FuzzResult runFuzz(uint32_t seed, uint16_t steps) {
+  FuzzResult result = {0, 0, CHECK_OK, 0, 0, 0};
+  uint32_t state = seed != 0 ? seed : 1;
+  uint32_t startTime = micros();
+
+  if (steps > FUZZ_MAX_STEPS) {
+    steps = FUZZ_MAX_STEPS;
+  }
+
+  Editor *editor = resetFuzzEditor();
+
+  while (result.steps < steps) {
+    Key key;
+    FuzzAction action;
+    runFuzzStep(editor, &state, &key, &action);
+    result.steps++;
+
+    EditorCheck check = checkEditor(editor);
+    if (check == CHECK_OK) {
+      check = checkFrame(editor);
+    }
+
+    if (check != CHECK_OK) {
+      result.failStep = result.steps - 1;
+      result.check = check;
+      result.key = key;
+      result.action = action;
+      break;
+    }
+  }
+
+  result.time = micros() - startTime;
+  return result;
+}
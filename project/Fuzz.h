@@ -0,0 +1,83 @@
+/**
+ * @file Fuzz.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stdint.h>
+
+#include "Editor.h"
+
+// Maximal number of steps of one fuzz run, keeps the run short
+// enough not to starve the idle task
+#define FUZZ_MAX_STEPS 1024
+
+// Maximal number of long press repeats of one hold, long enough
+// to reach the word jumps of held cursor moves
+#define FUZZ_MAX_HOLD 16
+
+/**
+ * @brief Enum values for fuzz step actions.
+ * 
+ */
+typedef enum {
+  FUZZ_PRESS, FUZZ_HOLD, FUZZ_TEXT, FUZZ_CHORD
+} FuzzAction;
+
+/**
+ * @brief Structure for fuzz run result, on violation the failing
+ * step, its key and action are set.
+ * 
+ */
+typedef struct {
+  uint16_t steps;
+  uint16_t failStep;
+  uint8_t check;
+  uint8_t key;
+  uint8_t action;
+  uint32_t time;
+} FuzzResult;
+
+/**
+ * @brief Initialize the fuzz editor.
+ * 
+ * @return Editor* 
+ */
+Editor *resetFuzzEditor();
+
+/**
+ * @brief Apply one random step on the editor.
+ * 
+ * @param editor 
+ * @param state 
+ * @param key 
+ * @param action 
+ */
+void runFuzzStep(Editor *editor, uint32_t *state, Key *key, FuzzAction *action);
+
+/**
+ * @brief Run the random timed key sequence on the fuzz editor.
+ * 
+ * @param seed 
+ * @param steps 
+ * @return FuzzResult 
+ */
+FuzzResult runFuzz(uint32_t seed, uint16_t steps);
+
+/**
+ * @brief Compare the editor text area with the reference rendering.
+ * 
+ * @param editor 
+ * @return EditorCheck 
+ */
+EditorCheck checkFrame(Editor *editor);
+
+#endif
@@ -0,0 +1,370 @@
+/**
+ * @file History.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "History.h"
+#include "Buffer.h"
+#include "Index.h"
+#include "Shared.h"
+
+static_assert((HISTORY_PEER_SIZE + MESSAGE_SIZE + HISTORY_SLAB_DATA - 1) / HISTORY_SLAB_DATA <= HISTORY_SLABS,
+              "History pool must fit the longest message");
+
+// Slab pool and message entries, allocated once and never returned
+// to the heap, free slabs and entries are chained through next and
+// older links
+SHARED_STATE HistorySlab HistorySlabs[HISTORY_SLABS];
+SHARED_STATE HistoryEntry HistoryEntries[HISTORY_ENTRIES];
+SHARED_STATE uint16_t freeSlab = HISTORY_NONE;
+SHARED_STATE uint16_t freeEntry = HISTORY_NONE;
+
+// Newest and oldest message and the pool usage
+SHARED_STATE uint16_t historyNewest = HISTORY_NONE;
+SHARED_STATE uint16_t historyOldest = HISTORY_NONE;
+SHARED_STATE HistoryStats historyStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+/**
+ * @brief Put all slabs and entries on the free lists, the history
+ * and its search index are empty.
+ * 
+ */
+void initHistory() {
+  for (uint16_t idx = 0; idx < HISTORY_SLABS; ++idx) {
+    HistorySlabs[idx].next = idx + 1 < HISTORY_SLABS ? idx + 1 : HISTORY_NONE;
+  }
+
+  for (uint16_t idx = 0; idx < HISTORY_ENTRIES; ++idx) {
+    HistoryEntries[idx].older = idx + 1 < HISTORY_ENTRIES ? idx + 1 : HISTORY_NONE;
+  }
+
+  freeSlab = 0;
+  freeEntry = 0;
+  historyNewest = HISTORY_NONE;
+  historyOldest = HISTORY_NONE;
+  historyStats = {0, HISTORY_SLABS, HISTORY_ENTRIES, 0, 0, 0, 0, 0};
+  initIndex();
+}
+
+/**
+ * @brief Get the number of slabs holding the bytes.
+ * 
+ * @param size 
+ * @return uint16_t 
+ */
+uint16_t getSlabCount(size_t size) {
+  return (size + HISTORY_SLAB_DATA - 1) / HISTORY_SLAB_DATA;
+}
+
+/**
+ * @brief Copy the bytes into the slab chain from the byte offset.
+ * 
+ * @param slab first slab of the chain
+ * @param offset 
+ * @param src 
+ * @param len 
+ * @return uint16_t slab holding the next byte
+ */
+uint16_t writeSlabs(uint16_t slab, size_t offset, const char *src, size_t len) {
+  while (len > 0) {
+    size_t pos = offset % HISTORY_SLAB_DATA;
+    size_t part = HISTORY_SLAB_DATA - pos < len ? HISTORY_SLAB_DATA - pos : len;
+
+    memcpy(&HistorySlabs[slab].data[pos], src, part);
+    src += part;
+    offset += part;
+    len -= part;
+
+    if (offset % HISTORY_SLAB_DATA == 0) {
+      slab = HistorySlabs[slab].next;
+    }
+  }
+
+  return slab;
+}
+
+/**
+ * @brief Copy the bytes out of the message chain from the byte
+ * offset, the slabs before the offset are skipped, at most the
+ * slabs of the longest message.
+ * 
+ * @param slab first slab of the chain
+ * @param offset 
+ * @param dst 
+ * @param len 
+ */
+void readSlabs(uint16_t slab, size_t offset, char *dst, size_t len) {
+  for (size_t skip = offset / HISTORY_SLAB_DATA; skip > 0; --skip) {
+    slab = HistorySlabs[slab].next;
+  }
+
+  while (len > 0) {
+    size_t pos = offset % HISTORY_SLAB_DATA;
+    size_t part = HISTORY_SLAB_DATA - pos < len ? HISTORY_SLAB_DATA - pos : len;
+
+    memcpy(dst, &HistorySlabs[slab].data[pos], part);
+    dst += part;
+    offset += part;
+    len -= part;
+    slab = HistorySlabs[slab].next;
+  }
+}
+
+/**
+ * @brief Store the message as the newest one, the oldest messages
+ * are dropped until the pool has the slabs and entry for it. The
+ * number of the other side is cut to HISTORY_PEER_SIZE.
+ * 
+ * Every dropped message frees at least one slab or the entry, so
+ * a store drops at most the slabs of the longest message and its
+ * cost does not depend on the history size. The text is stored
+ * packed by the message codec when that saves bytes, its words are
+ * added to the search index.
+ * 
+ * @param flags 
+ * @param peer number of the other side
+ * @param peerLen 
+ * @param text 
+ * @param len 
+ * @return uint16_t id of the message or HISTORY_NONE if the pool
+ * has no room
+ */
+uint16_t addHistory(uint8_t flags, const char *peer, uint8_t peerLen, const char *text, uint8_t len) {
+  if (peerLen > HISTORY_PEER_SIZE) peerLen = HISTORY_PEER_SIZE;
+
+  uint8_t packed[MESSAGE_SIZE];
+  uint8_t size = len > 0 ? encodeMessage(text, len, packed, len - 1) : 0;
+  if (size > 0) flags |= HISTORY_PACKED;
+  else size = len;
+  uint16_t slabs = getSlabCount(peerLen + size);
+
+  while ((historyStats.freeSlabs < slabs || freeEntry == HISTORY_NONE) && historyOldest != HISTORY_NONE) {
+    deleteHistory(historyOldest);
+    historyStats.evictions++;
+  }
+
+  if (historyStats.freeSlabs < slabs || freeEntry == HISTORY_NONE) {
+    return HISTORY_NONE;
+  }
+
+  uint16_t id = freeEntry;
+  HistoryEntry *entry = &HistoryEntries[id];
+  freeEntry = entry->older;
+
+  // Take the slabs from the free list head, the chain stays linked
+  entry->slab = slabs > 0 ? freeSlab : HISTORY_NONE;
+  for (uint16_t idx = 0; idx < slabs; ++idx) {
+    uint16_t last = freeSlab;
+    freeSlab = HistorySlabs[last].next;
+    if (idx + 1 == slabs) HistorySlabs[last].next = HISTORY_NONE;
+  }
+
+  uint16_t slab = writeSlabs(entry->slab, 0, peer, peerLen);
+  writeSlabs(slab, peerLen, (flags & HISTORY_PACKED) ? (const char *)packed : text, size);
+
+  entry->peerLen = peerLen;
+  entry->len = len;
+  entry->size = size;
+  entry->flags = flags;
+  entry->newer = HISTORY_NONE;
+  entry->older = historyNewest;
+
+  if (historyNewest != HISTORY_NONE) {
+    HistoryEntries[historyNewest].newer = id;
+  }
+  else {
+    historyOldest = id;
+  }
+  historyNewest = id;
+
+  historyStats.count++;
+  historyStats.freeSlabs -= slabs;
+  historyStats.freeEntries--;
+  historyStats.chars += len;
+  historyStats.bytes += size;
+  if (HISTORY_SLABS - historyStats.freeSlabs > historyStats.peakSlabs) historyStats.peakSlabs = HISTORY_SLABS - historyStats.freeSlabs;
+  if (historyStats.count > historyStats.peakCount) historyStats.peakCount = historyStats.count;
+
+  indexMessage(id, text, len);
+  return id;
+}
+
+/**
+ * @brief Remove the message words from the search index, unlink
+ * the message and return its slab chain and entry to the free lists.
+ * 
+ * @param id 
+ */
+void deleteHistory(uint16_t id) {
+  HistoryEntry *entry = &HistoryEntries[id];
+
+  unindexMessage(id);
+
+  if (entry->newer != HISTORY_NONE) HistoryEntries[entry->newer].older = entry->older;
+  else historyNewest = entry->older;
+
+  if (entry->older != HISTORY_NONE) HistoryEntries[entry->older].newer = entry->newer;
+  else historyOldest = entry->newer;
+
+  uint16_t slabs = getSlabCount(entry->peerLen + entry->size);
+  if (slabs > 0) {
+    uint16_t last = entry->slab;
+    while (HistorySlabs[last].next != HISTORY_NONE) {
+      last = HistorySlabs[last].next;
+    }
+    HistorySlabs[last].next = freeSlab;
+    freeSlab = entry->slab;
+  }
+
+  entry->older = freeEntry;
+  freeEntry = id;
+
+  historyStats.count--;
+  historyStats.freeSlabs += slabs;
+  historyStats.freeEntries++;
+  historyStats.chars -= entry->len;
+  historyStats.bytes -= entry->size;
+}
+
+/**
+ * @brief Get the newest message.
+ * 
+ * @return uint16_t id or HISTORY_NONE if the history is empty
+ */
+uint16_t getHistoryNewest() {
+  return historyNewest;
+}
+
+/**
+ * @brief Get the message of the id with the links to the newer and
+ * older message.
+ * 
+ * @param id 
+ * @return const HistoryEntry* 
+ */
+const HistoryEntry *getHistoryEntry(uint16_t id) {
+  return &HistoryEntries[id];
+}
+
+/**
+ * @brief Read the number of the other side, not terminated.
+ * 
+ * @param id 
+ * @param dst buffer of HISTORY_PEER_SIZE
+ * @return uint8_t number length
+ */
+uint8_t readHistoryPeer(uint16_t id, char *dst) {
+  const HistoryEntry *entry = &HistoryEntries[id];
+  readSlabs(entry->slab, 0, dst, entry->peerLen);
+  return entry->peerLen;
+}
+
+/**
+ * @brief Get the next stored byte of the message text and move to
+ * the next slab at the slab end.
+ * 
+ * @param context the read text
+ * @return uint8_t 
+ */
+uint8_t fetchHistoryByte(void *context) {
+  HistoryText *text = (HistoryText *)context;
+
+  if (text->slab == HISTORY_NONE) {
+    return 0;
+  }
+
+  uint8_t value = HistorySlabs[text->slab].data[text->pos++];
+  if (text->pos == HISTORY_SLAB_DATA) {
+    text->slab = HistorySlabs[text->slab].next;
+    text->pos = 0;
+  }
+  return value;
+}
+
+/**
+ * @brief Start reading the message text at the slab after the number
+ * of the other side, packed text is decoded as it is read.
+ * 
+ * @param text 
+ * @param id 
+ */
+void openHistoryText(HistoryText *text, uint16_t id) {
+  const HistoryEntry *entry = &HistoryEntries[id];
+
+  text->slab = entry->slab;
+  for (uint8_t skip = entry->peerLen / HISTORY_SLAB_DATA; skip > 0; --skip) {
+    text->slab = HistorySlabs[text->slab].next;
+  }
+  text->pos = entry->peerLen % HISTORY_SLAB_DATA;
+  text->packed = entry->flags & HISTORY_PACKED;
+  text->left = entry->len;
+  openCodecReader(&text->reader, fetchHistoryByte, text, entry->len);
+}
+
+/**
+ * @brief Read the next chars of the message text straight from the
+ * slabs, only the slabs up to the read chars are visited.
+ * 
+ * @param text 
+ * @param dst NULL to skip the chars
+ * @param len 
+ * @return uint8_t number of read chars
+ */
+uint8_t readHistoryChars(HistoryText *text, char *dst, uint8_t len) {
+  if (text->packed) {
+    return readCodec(&text->reader, dst, len);
+  }
+
+  if (len > text->left) len = text->left;
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    uint8_t value = fetchHistoryByte(text);
+    if (dst != NULL) dst[idx] = value;
+  }
+
+  text->left -= len;
+  return len;
+}
+
+/**
+ * @brief Read at most len chars of the message text from the offset,
+ * the chars before the offset are decoded and dropped.
+ * 
+ * @param id 
+ * @param offset 
+ * @param dst 
+ * @param len 
+ * @return uint8_t number of read chars
+ */
+uint8_t readHistoryText(uint16_t id, uint8_t offset, char *dst, uint8_t len) {
+  HistoryText text;
+  openHistoryText(&text, id);
+  readHistoryChars(&text, NULL, offset);
+  return readHistoryChars(&text, dst, len);
+}
+
+/**
+ * @brief Clear the unread flag of the message.
+ * 
+ * @param id 
+ */
+void markHistoryRead(uint16_t id) {
+  HistoryEntries[id].flags &= ~HISTORY_UNREAD;
+}
+
+/**
+ * @brief Get the history pool usage.
+ * 
+ * @return HistoryStats 
+ */
+HistoryStats getHistoryStats() {
+  return historyStats;
+}
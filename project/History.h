@@ -0,0 +1,207 @@
+/**
+ * @file History.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "Codec.h"
+
+// Slab size of the message pool in bytes, link to the next slab
+// and the message bytes
+#define HISTORY_SLAB_SIZE 32
+#define HISTORY_SLAB_DATA (HISTORY_SLAB_SIZE - 2)
+
+// Slabs in the pool, the oldest messages are dropped when it is full
+#ifndef HISTORY_SLABS
+#define HISTORY_SLABS 1408
+#endif
+
+// Most messages kept in the history
+#ifndef HISTORY_ENTRIES
+#define HISTORY_ENTRIES 512
+#endif
+
+// Static RAM of the history pools and the search index together, the
+// ESP32 core leaves about 121 KB of static DRAM next to its Bluetooth
+// reserve and the core, panel, render and undo state take the rest
+#ifndef MESSAGE_RAM_BUDGET
+#define MESSAGE_RAM_BUDGET (96 * 1024)
+#endif
+
+// Longest kept number of the other side
+#define HISTORY_PEER_SIZE 20
+
+// No entry or slab
+#define HISTORY_NONE 0xFFFF
+
+// Message flags, sent by this device, not opened yet and the text
+// stored packed by the message codec
+#define HISTORY_SENT 0x01
+#define HISTORY_UNREAD 0x02
+#define HISTORY_PACKED 0x04
+
+/**
+ * @brief Structure for one pool slab, a message takes a chain of
+ * slabs holding the number of the other side and the text.
+ * 
+ */
+typedef struct {
+  uint16_t next;
+  char data[HISTORY_SLAB_DATA];
+} HistorySlab;
+
+/**
+ * @brief Structure for one history message, linked from the newest
+ * to the oldest message, with its first slab, lengths in chars and
+ * the stored text size in bytes.
+ * 
+ */
+typedef struct {
+  uint16_t newer;
+  uint16_t older;
+  uint16_t slab;
+  uint8_t peerLen;
+  uint8_t len;
+  uint8_t size;
+  uint8_t flags;
+} HistoryEntry;
+
+/**
+ * @brief Structure for a message text read in order, the slab and
+ * byte of the next stored byte and the decoder of packed text.
+ * 
+ */
+typedef struct {
+  uint16_t slab;
+  uint8_t pos;
+  bool packed;
+  uint8_t left;
+  CodecReader reader;
+} HistoryText;
+
+/**
+ * @brief Structure for history pool usage report, with the text
+ * chars of the kept messages and the bytes storing them, the most
+ * slabs and messages ever kept.
+ * 
+ */
+typedef struct {
+  uint16_t count;
+  uint16_t freeSlabs;
+  uint16_t freeEntries;
+  uint32_t evictions;
+  uint32_t chars;
+  uint32_t bytes;
+  uint16_t peakSlabs;
+  uint16_t peakCount;
+} HistoryStats;
+
+// Static RAM of the slab pool and the message entries
+#define HISTORY_RAM (HISTORY_SLABS * sizeof(HistorySlab) + HISTORY_ENTRIES * sizeof(HistoryEntry))
+
+static_assert(HISTORY_SLABS < HISTORY_NONE && HISTORY_ENTRIES < HISTORY_NONE, "History ids must fit below HISTORY_NONE");
+
+/**
+ * @brief Put all slabs and entries on the free lists.
+ * 
+ */
+void initHistory();
+
+/**
+ * @brief Store the message as the newest one.
+ * 
+ * @param flags 
+ * @param peer 
+ * @param peerLen 
+ * @param text 
+ * @param len 
+ * @return uint16_t 
+ */
+uint16_t addHistory(uint8_t flags, const char *peer, uint8_t peerLen, const char *text, uint8_t len);
+
+/**
+ * @brief Delete the message and free its slabs.
+ * 
+ * @param id 
+ */
+void deleteHistory(uint16_t id);
+
+/**
+ * @brief Get the newest message.
+ * 
+ * @return uint16_t 
+ */
+uint16_t getHistoryNewest();
+
+/**
+ * @brief Get the message of the id.
+ * 
+ * @param id 
+ * @return const HistoryEntry* 
+ */
+const HistoryEntry *getHistoryEntry(uint16_t id);
+
+/**
+ * @brief Read the number of the other side.
+ * 
+ * @param id 
+ * @param dst 
+ * @return uint8_t 
+ */
+uint8_t readHistoryPeer(uint16_t id, char *dst);
+
+/**
+ * @brief Read the message text from the offset.
+ * 
+ * @param id 
+ * @param offset 
+ * @param dst 
+ * @param len 
+ * @return uint8_t 
+ */
+uint8_t readHistoryText(uint16_t id, uint8_t offset, char *dst, uint8_t len);
+
+/**
+ * @brief Start reading the message text.
+ * 
+ * @param text 
+ * @param id 
+ */
+void openHistoryText(HistoryText *text, uint16_t id);
+
+/**
+ * @brief Read the next chars of the message text.
+ * 
+ * @param text 
+ * @param dst 
+ * @param len 
+ * @return uint8_t 
+ */
+uint8_t readHistoryChars(HistoryText *text, char *dst, uint8_t len);
+
+/**
+ * @brief Clear the unread flag of the message.
+ * 
+ * @param id 
+ */
+void markHistoryRead(uint16_t id);
+
+/**
+ * @brief Get the history pool usage.
+ * 
+ * @return HistoryStats 
+ */
+HistoryStats getHistoryStats();
+
+#endif
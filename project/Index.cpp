@@ -0,0 +1,657 @@
+/**
+ * @file Index.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Index.h"
+#include "Buffer.h"
+#include "CodePage.h"
+#include "Shared.h"
+
+/**
+ * @brief Structure for reading one posting list block by block, from
+ * the newest serial.
+ * 
+ */
+typedef struct {
+  uint16_t block;
+  uint8_t pos;
+  uint32_t serial;
+} PostingReader;
+
+// Word hash table with linear probing, empty slots have zero hash,
+// and the posting block pool with its free list
+SHARED_STATE IndexTerm IndexTerms[INDEX_TERMS];
+SHARED_STATE IndexBlock IndexBlocks[INDEX_BLOCKS];
+SHARED_STATE uint16_t freeBlock = INDEX_NONE;
+SHARED_STATE IndexStats indexStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+// Serial of every kept message and the postings it added, and the
+// message of every serial map cell, a deleted serial frees its cell
+SHARED_STATE uint32_t IndexSerials[HISTORY_ENTRIES];
+SHARED_STATE uint8_t IndexPostings[HISTORY_ENTRIES];
+SHARED_STATE uint16_t IndexSlots[INDEX_SERIALS];
+SHARED_STATE uint32_t nextSerial = 1;
+
+// Running compaction sweep and its next slot
+SHARED_STATE bool sweeping = false;
+SHARED_STATE uint16_t sweepSlot = 0;
+
+// Messages with words left out of the full index, their text is
+// searched instead
+SHARED_STATE uint32_t unindexedMessages[INDEX_MATCH_WORDS];
+
+// Kept messages of one posting list and the postings of one query
+// word as a message bitmap
+SHARED_STATE uint16_t postingIds[HISTORY_ENTRIES];
+SHARED_STATE uint32_t postingFound[INDEX_MATCH_WORDS];
+
+/**
+ * @brief Put all posting blocks on the free list and clear the word
+ * table and the serials, the index is empty.
+ * 
+ */
+void initIndex() {
+  for (uint16_t idx = 0; idx < INDEX_BLOCKS; ++idx) {
+    IndexBlocks[idx].next = idx + 1 < INDEX_BLOCKS ? idx + 1 : INDEX_NONE;
+  }
+
+  memset(IndexTerms, 0, sizeof(IndexTerms));
+  memset(IndexSerials, 0, sizeof(IndexSerials));
+  memset(IndexPostings, 0, sizeof(IndexPostings));
+  memset(IndexSlots, 0xFF, sizeof(IndexSlots));
+  memset(unindexedMessages, 0, sizeof(unindexedMessages));
+  freeBlock = 0;
+  nextSerial = 1;
+  sweeping = false;
+  sweepSlot = 0;
+  indexStats = {0, INDEX_BLOCKS, 0, 0, 0, 0, 0, 0};
+}
+
+/**
+ * @brief Read the next word of the text from the position and hash
+ * its search keys with FNV-1a, chars without key separate words.
+ * 
+ * @param text 
+ * @param len 
+ * @param pos position after the word on return
+ * @param hash non-zero hash of the word
+ * @return true 
+ * @return false if there is no next word
+ */
+bool readWord(const char *text, uint8_t len, uint8_t *pos, uint32_t *hash) {
+  while (*pos < len && foldChar(text[*pos]) == 0) {
+    (*pos)++;
+  }
+
+  if (*pos == len) {
+    return false;
+  }
+
+  uint32_t value = 2166136261UL;
+  for (; *pos < len && foldChar(text[*pos]) != 0; (*pos)++) {
+    value = (value ^ (uint8_t)foldChar(text[*pos])) * 16777619UL;
+  }
+
+  *hash = value != 0 ? value : 1;
+  return true;
+}
+
+/**
+ * @brief Find the slot of the word hash, probing from its home slot
+ * up to the first empty slot.
+ * 
+ * @param hash 
+ * @return uint16_t slot of the word or the empty slot for it
+ */
+uint16_t findTerm(uint32_t hash) {
+  uint16_t slot = hash & (INDEX_TERMS - 1);
+
+  while (IndexTerms[slot].hash != 0 && IndexTerms[slot].hash != hash) {
+    slot = (slot + 1) & (INDEX_TERMS - 1);
+  }
+
+  return slot;
+}
+
+/**
+ * @brief Clear the slot and move the following words of the probe
+ * run back over it, so lookups never need deleted slot marks.
+ * 
+ * @param slot 
+ */
+void removeTerm(uint16_t slot) {
+  uint16_t hole = slot;
+
+  for (uint16_t next = (slot + 1) & (INDEX_TERMS - 1); IndexTerms[next].hash != 0;
+       next = (next + 1) & (INDEX_TERMS - 1)) {
+    uint16_t home = IndexTerms[next].hash & (INDEX_TERMS - 1);
+
+    // The word may move back only if the hole is between its home
+    // slot and its slot
+    if (((next - home) & (INDEX_TERMS - 1)) >= ((next - hole) & (INDEX_TERMS - 1))) {
+      IndexTerms[hole] = IndexTerms[next];
+      hole = next;
+    }
+  }
+
+  IndexTerms[hole].hash = 0;
+}
+
+/**
+ * @brief Get the kept message of the serial.
+ * 
+ * @param serial 
+ * @return uint16_t HISTORY_NONE if the message is deleted
+ */
+uint16_t getSerialMessage(uint32_t serial) {
+  uint16_t id = IndexSlots[serial % INDEX_SERIALS];
+  return id != HISTORY_NONE && IndexSerials[id] == serial ? id : HISTORY_NONE;
+}
+
+/**
+ * @brief Read the next message serial of the posting list, the list
+ * starts with the newest one.
+ * 
+ * @param reader 
+ * @return uint32_t 
+ */
+uint32_t readPosting(PostingReader *reader) {
+  uint32_t delta = 0;
+  uint8_t shift = 0;
+  uint8_t byte;
+
+  if (reader->pos == INDEX_BLOCK_DATA || IndexBlocks[reader->block].data[reader->pos] == 0) {
+    reader->block = IndexBlocks[reader->block].next;
+    reader->pos = 0;
+  }
+
+  do {
+    byte = IndexBlocks[reader->block].data[reader->pos++];
+    delta |= (uint32_t)(byte & 0x7F) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+
+  reader->serial -= delta;
+  return reader->serial;
+}
+
+/**
+ * @brief Decode the posting list of the word to the kept messages,
+ * newest first, the postings of deleted messages are skipped.
+ * 
+ * @param term 
+ * @param ids 
+ * @return uint16_t number of kept messages
+ */
+uint16_t readPostings(const IndexTerm *term, uint16_t *ids) {
+  PostingReader reader = {term->block, 0, term->last};
+  uint16_t count = 0;
+
+  for (uint16_t idx = 0; idx < term->count; ++idx) {
+    uint16_t id = getSerialMessage(idx == 0 ? reader.serial : readPosting(&reader));
+    if (id != HISTORY_NONE) {
+      ids[count++] = id;
+    }
+  }
+
+  return count;
+}
+
+/**
+ * @brief Get the number of varint bytes of the delta.
+ * 
+ * @param delta 
+ * @return uint8_t 
+ */
+uint8_t getVarintSize(uint32_t delta) {
+  uint8_t size = 1;
+
+  while (delta >= 0x80) {
+    delta >>= 7;
+    size++;
+  }
+
+  return size;
+}
+
+/**
+ * @brief Return the block chain to the free list.
+ * 
+ * @param block 
+ */
+void freeChain(uint16_t block) {
+  while (block != INDEX_NONE) {
+    uint16_t next = IndexBlocks[block].next;
+    IndexBlocks[block].next = freeBlock;
+    freeBlock = block;
+    indexStats.freeBlocks++;
+    block = next;
+  }
+}
+
+/**
+ * @brief Put the newer serial in front of the posting list of the
+ * word, its delta goes to the front of the first block or to a new
+ * first block, the rest of the list is never touched.
+ * 
+ * @param term 
+ * @param serial 
+ * @return true 
+ * @return false if the first block is full and the pool is empty
+ */
+bool prependPosting(IndexTerm *term, uint32_t serial) {
+  if (term->count == 0) {
+    term->last = serial;
+    term->block = INDEX_NONE;
+    term->count = 1;
+    return true;
+  }
+
+  uint32_t delta = serial - term->last;
+  uint8_t size = getVarintSize(delta);
+  uint16_t block = term->block;
+  uint8_t used = INDEX_BLOCK_DATA;
+
+  if (block != INDEX_NONE) {
+    const uint8_t *end = (const uint8_t *)memchr(IndexBlocks[block].data, 0, INDEX_BLOCK_DATA);
+    used = end != NULL ? end - IndexBlocks[block].data : INDEX_BLOCK_DATA;
+  }
+
+  if (used + size > INDEX_BLOCK_DATA) {
+    if (freeBlock == INDEX_NONE) {
+      return false;
+    }
+
+    block = freeBlock;
+    freeBlock = IndexBlocks[block].next;
+    IndexBlocks[block].next = term->block;
+    memset(IndexBlocks[block].data, 0, INDEX_BLOCK_DATA);
+    term->block = block;
+    used = 0;
+
+    indexStats.freeBlocks--;
+    if (INDEX_BLOCKS - indexStats.freeBlocks > indexStats.peakBlocks) indexStats.peakBlocks = INDEX_BLOCKS - indexStats.freeBlocks;
+  }
+
+  uint8_t *data = IndexBlocks[block].data;
+  memmove(&data[size], data, used);
+  for (uint8_t pos = 0; pos < size; ++pos) {
+    data[pos] = (delta & 0x7F) | (pos + 1 < size ? 0x80 : 0);
+    delta >>= 7;
+  }
+
+  term->last = serial;
+  term->count++;
+  return true;
+}
+
+/**
+ * @brief Mark the message as searched by its text.
+ * 
+ * @param id 
+ */
+void markUnindexed(uint16_t id) {
+  uint32_t mask = 1UL << (id % 32);
+
+  if (!(unindexedMessages[id / 32] & mask)) {
+    unindexedMessages[id / 32] |= mask;
+    indexStats.unindexed++;
+  }
+}
+
+/**
+ * @brief Rewrite the posting list of the word without the deleted
+ * messages, the word leaves the table when none is kept. A kept
+ * message that no longer fits the pool is searched by its text.
+ * 
+ * @param slot 
+ * @return true 
+ * @return false if the word left the table
+ */
+bool compactTerm(uint16_t slot) {
+  IndexTerm *term = &IndexTerms[slot];
+  uint16_t count = readPostings(term, postingIds);
+
+  indexStats.dead -= term->count - count;
+  freeChain(term->block);
+  term->count = 0;
+
+  if (count == 0) {
+    removeTerm(slot);
+    indexStats.terms--;
+    return false;
+  }
+
+  for (uint16_t idx = count; idx-- > 0;) {
+    if (!prependPosting(term, IndexSerials[postingIds[idx]])) {
+      markUnindexed(postingIds[idx]);
+      IndexPostings[postingIds[idx]]--;
+      indexStats.postings--;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Start a sweep over the word table once more postings are
+ * dead than kept and enough of them to pay for it, or once the table
+ * or pool is full and some are dead.
+ * 
+ * @param full 
+ */
+void startSweep(bool full) {
+  if (!sweeping && indexStats.dead >= INDEX_MIN_DEAD && (full || indexStats.dead > indexStats.postings)) {
+    sweeping = true;
+    sweepSlot = 0;
+  }
+}
+
+/**
+ * @brief Compact the next slots of the running sweep, a slice stops
+ * after INDEX_SWEEP_SLOTS slots or INDEX_SWEEP_POSTINGS postings, a
+ * list is always rewritten whole.
+ * 
+ * @return true 
+ * @return false if no sweep is running
+ */
+bool compactSlice() {
+  uint16_t slots = 0;
+  uint32_t postings = 0;
+
+  if (!sweeping) {
+    return false;
+  }
+
+  // A removed word pulls the next one of its probe run into the slot,
+  // so the slot is compacted again, the words of the run only move
+  // back to slots the sweep has not passed yet
+  while (sweepSlot < INDEX_TERMS && slots < INDEX_SWEEP_SLOTS && postings < INDEX_SWEEP_POSTINGS) {
+    slots++;
+
+    if (IndexTerms[sweepSlot].hash == 0) {
+      sweepSlot++;
+      continue;
+    }
+
+    postings += IndexTerms[sweepSlot].count;
+    if (compactTerm(sweepSlot)) {
+      sweepSlot++;
+    }
+  }
+
+  if (sweepSlot == INDEX_TERMS) {
+    sweeping = false;
+    indexStats.sweeps++;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Add the message serial to the posting list of the word, a
+ * new word takes an empty slot of the table. A full table or pool
+ * runs one more slice of the sweep first.
+ * 
+ * @param hash 
+ * @param id 
+ * @return true 
+ * @return false if the table or the block pool is full
+ */
+bool addPosting(uint32_t hash, uint16_t id) {
+  uint32_t serial = IndexSerials[id];
+  IndexTerm *term = &IndexTerms[findTerm(hash)];
+
+  if (term->hash == 0 && indexStats.terms >= INDEX_MAX_TERMS) {
+    startSweep(true);
+    if (!compactSlice() || indexStats.terms >= INDEX_MAX_TERMS) {
+      return false;
+    }
+    term = &IndexTerms[findTerm(hash)];
+  }
+
+  if (term->hash == 0) {
+    term->count = 0;
+  }
+  else if (term->last == serial) {
+    return true;
+  }
+
+  if (!prependPosting(term, serial)) {
+    startSweep(true);
+    if (!compactSlice()) {
+      return false;
+    }
+    term = &IndexTerms[findTerm(hash)];
+    if (term->hash == 0) {
+      term->count = 0;
+    }
+    if (!prependPosting(term, serial)) {
+      return false;
+    }
+  }
+
+  if (term->hash == 0) {
+    term->hash = hash;
+    indexStats.terms++;
+    if (indexStats.terms > indexStats.peakTerms) indexStats.peakTerms = indexStats.terms;
+  }
+
+  IndexPostings[id]++;
+  indexStats.postings++;
+  return true;
+}
+
+/**
+ * @brief Give the message the next serial, skipping the serials whose
+ * map cell an old kept message still holds.
+ * 
+ * @param id 
+ */
+void takeSerial(uint16_t id) {
+  while (IndexSlots[nextSerial % INDEX_SERIALS] != HISTORY_NONE) {
+    nextSerial++;
+  }
+
+  IndexSlots[nextSerial % INDEX_SERIALS] = id;
+  IndexSerials[id] = nextSerial++;
+  IndexPostings[id] = 0;
+}
+
+/**
+ * @brief Add every word of the message to the index, the new serial
+ * is the newest, so every posting goes to the front of its list and
+ * nothing is rewritten, only a running sweep compacts its next slice
+ * first. A message with a word that does not fit is searched by its
+ * text.
+ * 
+ * @param id 
+ * @param text 
+ * @param len 
+ */
+void indexMessage(uint16_t id, const char *text, uint8_t len) {
+  uint8_t pos = 0;
+  uint32_t hash;
+
+  compactSlice();
+  takeSerial(id);
+  while (readWord(text, len, &pos, &hash)) {
+    if (!addPosting(hash, id)) {
+      markUnindexed(id);
+    }
+  }
+}
+
+/**
+ * @brief Delete the message serial, its postings stay in the lists
+ * as dead ones until a sweep passes them, so the delete takes the
+ * same time at any index size.
+ * 
+ * @param id 
+ */
+void unindexMessage(uint16_t id) {
+  if (IndexSerials[id] == 0) {
+    return;
+  }
+
+  IndexSlots[IndexSerials[id] % INDEX_SERIALS] = HISTORY_NONE;
+  IndexSerials[id] = 0;
+
+  indexStats.postings -= IndexPostings[id];
+  indexStats.dead += IndexPostings[id];
+  IndexPostings[id] = 0;
+
+  uint32_t mask = 1UL << (id % 32);
+  if (unindexedMessages[id / 32] & mask) {
+    unindexedMessages[id / 32] &= ~mask;
+    indexStats.unindexed--;
+  }
+
+  startSweep(false);
+}
+
+/**
+ * @brief Check whether the stored message text has all the words.
+ * 
+ * @param id 
+ * @param hashes 
+ * @param words 
+ * @return true 
+ * @return false 
+ */
+bool hasMessageWords(uint16_t id, const uint32_t *hashes, uint8_t words) {
+  char text[MESSAGE_SIZE];
+  uint8_t len = readHistoryText(id, 0, text, MESSAGE_SIZE);
+  uint8_t pos = 0;
+  uint32_t hash;
+  uint8_t found = 0;
+
+  while (readWord(text, len, &pos, &hash)) {
+    for (uint8_t word = 0; word < words; ++word) {
+      if (hashes[word] == hash) found |= 1 << word;
+    }
+  }
+
+  return found == (1 << words) - 1;
+}
+
+/**
+ * @brief Find the messages with all query words, the posting list
+ * of the rarest word gives the candidates and the other lists clear
+ * the messages without their word. Each list is decoded once, so the
+ * search costs the postings of the query words, not the history
+ * size. Messages left out of the index are searched by their text.
+ * 
+ * @param query 
+ * @return uint16_t number of matching messages
+ */
+uint16_t findMessages(MessageQuery *query) {
+  uint32_t hashes[INDEX_QUERY_WORDS];
+  const IndexTerm *terms[INDEX_QUERY_WORDS];
+  uint8_t words = 0;
+  uint8_t pos = 0;
+  uint8_t rarest = 0;
+  bool indexed = true;
+
+  memset(query->matches, 0, sizeof(query->matches));
+  query->count = 0;
+
+  while (words < INDEX_QUERY_WORDS && readWord(query->text, query->len, &pos, &hashes[words])) {
+    const IndexTerm *term = &IndexTerms[findTerm(hashes[words])];
+    indexed &= term->hash != 0;
+    terms[words] = term;
+
+    if (term->count < terms[rarest]->count) {
+      rarest = words;
+    }
+    words++;
+  }
+
+  if (words == 0) {
+    return 0;
+  }
+
+  if (indexed) {
+    uint16_t count = readPostings(terms[rarest], postingIds);
+    for (uint16_t idx = 0; idx < count; ++idx) {
+      query->matches[postingIds[idx] / 32] |= 1UL << (postingIds[idx] % 32);
+    }
+
+    for (uint8_t word = 0; word < words; ++word) {
+      if (word == rarest) {
+        continue;
+      }
+
+      memset(postingFound, 0, sizeof(postingFound));
+      count = readPostings(terms[word], postingIds);
+      for (uint16_t idx = 0; idx < count; ++idx) {
+        postingFound[postingIds[idx] / 32] |= 1UL << (postingIds[idx] % 32);
+      }
+
+      for (uint8_t idx = 0; idx < INDEX_MATCH_WORDS; ++idx) {
+        query->matches[idx] &= postingFound[idx];
+      }
+    }
+  }
+
+  for (uint16_t idx = 0; idx < INDEX_MATCH_WORDS && indexStats.unindexed > 0; ++idx) {
+    for (uint32_t bits = unindexedMessages[idx] & ~query->matches[idx]; bits != 0; bits &= bits - 1) {
+      uint16_t id = idx * 32 + __builtin_ctz(bits);
+
+      if (hasMessageWords(id, hashes, words)) {
+        query->matches[idx] |= 1UL << (id % 32);
+      }
+    }
+  }
+
+  for (uint8_t idx = 0; idx < INDEX_MATCH_WORDS; ++idx) {
+    query->count += __builtin_popcount(query->matches[idx]);
+  }
+
+  return query->count;
+}
+
+/**
+ * @brief Check whether the message matches the last search of the
+ * query.
+ * 
+ * @param query 
+ * @param id 
+ * @return true 
+ * @return false 
+ */
+bool isMessageFound(const MessageQuery *query, uint16_t id) {
+  return query->matches[id / 32] & (1UL << (id % 32));
+}
+
+/**
+ * @brief Drop the deleted message from the query matches.
+ * 
+ * @param query 
+ * @param id 
+ */
+void dropMessageFound(MessageQuery *query, uint16_t id) {
+  if (isMessageFound(query, id)) {
+    query->matches[id / 32] &= ~(1UL << (id % 32));
+    query->count--;
+  }
+}
+
+/**
+ * @brief Get the index usage.
+ * 
+ * @return IndexStats 
+ */
+IndexStats getIndexStats() {
+  return indexStats;
+}
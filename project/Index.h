@@ -0,0 +1,187 @@
+/**
+ * @file Index.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef INDEX_H
+#define INDEX_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "History.h"
+
+// Slots of the word hash table, a power of two
+#ifndef INDEX_TERMS
+#define INDEX_TERMS 2048
+#endif
+
+// Posting block size in bytes, link to the next block and the
+// delta encoded message serials
+#define INDEX_BLOCK_SIZE 8
+#define INDEX_BLOCK_DATA (INDEX_BLOCK_SIZE - 2)
+
+// Posting blocks in the pool
+#ifndef INDEX_BLOCKS
+#define INDEX_BLOCKS 1280
+#endif
+
+// No term block
+#define INDEX_NONE 0xFFFF
+
+// Most words in the hash table, probes stay short below this load
+#define INDEX_MAX_TERMS (INDEX_TERMS / 4 * 3)
+
+// Serial map cells, twice the history, so a free cell for the next
+// serial is always near
+#define INDEX_SERIALS (2 * HISTORY_ENTRIES)
+
+// Dead postings before a compaction sweep is worth its cost
+#ifndef INDEX_MIN_DEAD
+#define INDEX_MIN_DEAD 128
+#endif
+
+// Word slots and postings one store compacts at most while a sweep
+// runs, a sweep spreads over INDEX_TERMS / INDEX_SWEEP_SLOTS stores
+#ifndef INDEX_SWEEP_SLOTS
+#define INDEX_SWEEP_SLOTS 64
+#endif
+#ifndef INDEX_SWEEP_POSTINGS
+#define INDEX_SWEEP_POSTINGS 256
+#endif
+
+// Longest query and most query words, further chars are ignored
+#define INDEX_QUERY_SIZE 24
+#define INDEX_QUERY_WORDS 4
+
+// Words of the message bitmap
+#define INDEX_MATCH_WORDS ((HISTORY_ENTRIES + 31) / 32)
+
+/**
+ * @brief Structure for one word of the hash table, the word hash,
+ * the serial of its newest message, the first block of the older
+ * serials and the number of postings with the deleted ones.
+ * 
+ */
+typedef struct {
+  uint32_t hash;
+  uint32_t last;
+  uint16_t block;
+  uint16_t count;
+} IndexTerm;
+
+/**
+ * @brief Structure for one posting block, a posting list is a chain
+ * of blocks from the newest one with the descending message serials
+ * as varint deltas, the unused bytes at the block end are zero.
+ * 
+ */
+typedef struct {
+  uint16_t next;
+  uint8_t data[INDEX_BLOCK_DATA];
+} IndexBlock;
+
+/**
+ * @brief Structure for index usage report, with the postings of the
+ * deleted messages waiting for compaction, the sweeps done and the
+ * most words and posting blocks ever used.
+ * 
+ */
+typedef struct {
+  uint16_t terms;
+  uint16_t freeBlocks;
+  uint32_t postings;
+  uint32_t dead;
+  uint32_t sweeps;
+  uint16_t unindexed;
+  uint16_t peakTerms;
+  uint16_t peakBlocks;
+} IndexStats;
+
+/**
+ * @brief Structure for a message query, the typed text in the code
+ * page and the bitmap of the matching message ids.
+ * 
+ */
+typedef struct {
+  uint8_t len;
+  char text[INDEX_QUERY_SIZE];
+  uint16_t count;
+  uint32_t matches[INDEX_MATCH_WORDS];
+} MessageQuery;
+
+// Static RAM of the serial of every kept message with its posting
+// count and posting list id, and of the serial map
+#define INDEX_SERIAL_RAM (HISTORY_ENTRIES * (sizeof(uint32_t) + sizeof(uint8_t) + sizeof(uint16_t)) + INDEX_SERIALS * sizeof(uint16_t))
+
+// Static RAM of the index, the word table, block pool, serials and
+// the unindexed and query word bitmaps
+#define INDEX_RAM (INDEX_TERMS * sizeof(IndexTerm) + INDEX_BLOCKS * sizeof(IndexBlock) + INDEX_SERIAL_RAM + 2 * INDEX_MATCH_WORDS * sizeof(uint32_t))
+
+static_assert((INDEX_TERMS & (INDEX_TERMS - 1)) == 0, "INDEX_TERMS must be a power of two");
+static_assert(INDEX_BLOCKS < INDEX_NONE, "Index block ids must fit below INDEX_NONE");
+static_assert(INDEX_SERIALS > HISTORY_ENTRIES, "INDEX_SERIALS must exceed the kept messages");
+static_assert(HISTORY_RAM + INDEX_RAM <= MESSAGE_RAM_BUDGET, "History and index must fit MESSAGE_RAM_BUDGET");
+
+/**
+ * @brief Empty the index.
+ * 
+ */
+void initIndex();
+
+/**
+ * @brief Add the message words to the index.
+ * 
+ * @param id 
+ * @param text 
+ * @param len 
+ */
+void indexMessage(uint16_t id, const char *text, uint8_t len);
+
+/**
+ * @brief Remove the message words from the index.
+ * 
+ * @param id 
+ */
+void unindexMessage(uint16_t id);
+
+/**
+ * @brief Find the messages with all query words.
+ * 
+ * @param query 
+ * @return uint16_t 
+ */
+uint16_t findMessages(MessageQuery *query);
+
+/**
+ * @brief Check whether the message matches the query.
+ * 
+ * @param query 
+ * @param id 
+ * @return true 
+ * @return false 
+ */
+bool isMessageFound(const MessageQuery *query, uint16_t id);
+
+/**
+ * @brief Drop the message from the query matches.
+ * 
+ * @param query 
+ * @param id 
+ */
+void dropMessageFound(MessageQuery *query, uint16_t id);
+
+/**
+ * @brief Get the index usage.
+ * 
+ * @return IndexStats 
+ */
+IndexStats getIndexStats();
+
+#endif
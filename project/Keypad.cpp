@@ -10,17 +10,16 @@
  */
 
 #include <Arduino.h>
+#include <driver/gpio.h>
 
 #include <string.h>
-#include <ctype.h>
 #include <stdint.h>
 
 #include "Keypad.h"
 #include "Display.h"
 #include "Buffer.h"
-
-extern uint64_t now;
-extern uint8_t bufferIndex;
+#include "Undo.h"
+#include "Editor.h"
 
 // GPIO columns pins                  C1, C2, C3
 const uint8_t ColPins[KEYPAD_COLS] = {25, 26, 13};
@@ -37,38 +36,36 @@ const Key Keypad[KEYPAD_ROWS][KEYPAD_COLS] = {
 //  COL1   COL2   COL3
 };
 
-// Key symbols
-const char* KeySymbols[] = {
-  " 0",     // Key 0
-  ".,?!1",  // Key 1
-  "abc2",   // Key 2
-  "def3",   // Key 3
-  "ghi4",   // Key 4
-  "jkl5",   // Key 5
-  "mno6",   // Key 6
-  "pqrs7",  // Key 7
-  "tuv8",   // Key 8
-  "wxyz9"   // Key 9
-};
+// Scan statistics of every scan rate
+ScanStats scanStats[SCAN_RATES];
+
+// Rate of the current scan period
+ScanRate scanRate = SCAN_SLOW;
 
-// Upper case mode active flag 
-CaseMode activeCaseMode = MODE_SMART;
+// Time of the last scan in us
+uint32_t lastScanTime = 0;
 
-// Multitap index of key character
-Key lastKey = KEY_NONE;
+// Debounced key matrix
+Debouncer keypadDebouncer = {0, 0, 0};
 
-// Current key symbol index
-uint8_t symbolIndex = 0;
+// Matrix bitmaps of keys differing from the debounced state, keys
+// held past long press delay, keys used by chord and short presses
+// waiting for handling
+uint16_t unsettledKeys = 0;
+uint16_t longPressKeys = 0;
+uint16_t chordKeys = 0;
+uint16_t pendingKeys = 0;
 
-// Last key press time
-uint64_t lastPressTime = 0;
+// Time of the debounced press and last long press call of every key
+uint64_t keyPressTimes[KEYPAD_KEYS];
+uint64_t keyHoldTimes[KEYPAD_KEYS];
 
-// Last delete time
-uint64_t lastDeleteTime = 0;
+// Time in us the key started to change
+uint32_t keySeenTimes[KEYPAD_KEYS];
 
 /**
  * @brief Set pins for columns as OUTPUT and initialize them to HIGH
- * and set rows pins as INPUT_PULLUP resistors.
+ * and set rows pins as INPUT_PULLUP resistors, start the scan clock.
  * 
  */
 void initKeypad() {
@@ -80,272 +77,884 @@ void initKeypad() {
   for (int r = 0; r < KEYPAD_ROWS; ++r) {
     pinMode(RowPins[r], INPUT_PULLUP);
   } 
+
+  lastScanTime = micros();
 }
 
 /**
- * @brief Iterates over the columns pins, set the pin LOW, then
- * iterates over the rows pins and checks if any pin is set to 
- * LOW, so it was pressed, otherwise the row pin is HIGH
- * thanks to the used internal pull-up resistors. 
- * Finally set the column pin back to HIGH level and return the
- * pressed key enum value or KEY_NONE.
+ * @brief Set all columns pins LOW so a press of any key pulls its
+ * row pin LOW, and enable the rows pins as light sleep wakeup
+ * sources on LOW level.
  * 
- * Also handles keys long press, if key long press detected call 
- * handler for long press and return KEY_NONE.
+ */
+void sleepKeypad() {
+  for (int c = 0; c < KEYPAD_COLS; ++c) {
+    digitalWrite(ColPins[c], LOW);
+  }
+
+  for (int r = 0; r < KEYPAD_ROWS; ++r) {
+    gpio_wakeup_enable((gpio_num_t)RowPins[r], GPIO_INTR_LOW_LEVEL);
+  }
+}
+
+/**
+ * @brief Check whether a key is still pressed after wakeup, then
+ * disable the rows wakeup and set the columns pins back to HIGH,
+ * so the next scan reads the pressed key the usual way. The sleep
+ * is not counted as scan time.
  * 
+ * @return true if any key is pressed
+ * @return false 
+ */
+bool wakeKeypad() {
+  bool pressed = false;
+  lastScanTime = micros();
+
+  for (int r = 0; r < KEYPAD_ROWS; ++r) {
+    if (digitalRead(RowPins[r]) == LOW) {
+      pressed = true;
+    }
+    gpio_wakeup_disable((gpio_num_t)RowPins[r]);
+  }
+
+  for (int c = 0; c < KEYPAD_COLS; ++c) {
+    digitalWrite(ColPins[c], HIGH);
+  }
+
+  return pressed;
+}
+
+/**
+ * @brief Count the scan at the rate and the time since the previous
+ * scan, that is the longest time a key could wait for this scan.
+ * 
+ * @param rate 
+ * @return uint32_t time since the previous scan in us
+ */
+uint32_t recordScan(ScanRate rate) {
+  uint32_t now = micros();
+  uint32_t gap = now - lastScanTime;
+  lastScanTime = now;
+
+  scanStats[rate].scans++;
+  scanStats[rate].time += gap;
+  return gap;
+}
+
+/**
+ * @brief Count the key press found by the scan at the rate and its
+ * input latency, the press came at most one scan period ago.
+ * 
+ * @param rate 
+ * @param latency 
+ */
+void recordScanPress(ScanRate rate, uint32_t latency) {
+  scanStats[rate].presses++;
+  scanStats[rate].totalLatency += latency;
+  if (latency > scanStats[rate].maxLatency) {
+    scanStats[rate].maxLatency = latency;
+  }
+}
+
+/**
+ * @brief Get the key of the matrix bit.
+ * 
+ * @param bit 
  * @return Key 
  */
-Key scanKeypad() {
-  uint64_t currentMillis = now;
+Key getMatrixKey(int bit) {
+  return Keypad[bit / KEYPAD_COLS][bit % KEYPAD_COLS];
+}
 
-  // After multitap delay expire restore the cursor 
-  if (currentMillis - lastPressTime >= MULTITAP_DELAY) {
-    enableCursor();
+/**
+ * @brief Get the matrix bit mask of the key.
+ * 
+ * @param key 
+ * @return uint16_t 
+ */
+uint16_t getKeyMask(Key key) {
+  for (int bit = 0; bit < KEYPAD_KEYS; ++bit) {
+    if (getMatrixKey(bit) == key) {
+      return 1 << bit;
+    }
   }
 
+  return 0;
+}
+
+/**
+ * @brief Iterates over the columns pins, set the pin LOW, then
+ * iterates over the rows pins and checks if any pin is set to 
+ * LOW, so it was pressed, otherwise the row pin is HIGH
+ * thanks to the used internal pull-up resistors. 
+ * Finally set the column pin back to HIGH level.
+ * 
+ * @return uint16_t matrix bitmap of the pressed keys
+ */
+uint16_t readKeypad() {
+  uint16_t sample = 0;
+
   for (int c = 0; c < KEYPAD_COLS; ++c) {
     digitalWrite(ColPins[c], LOW);
 
     for (int r = 0; r < KEYPAD_ROWS; ++r) {
       if (digitalRead(RowPins[r]) == LOW) {
-        bool longPressTriggered = false;
-        uint64_t pressStartTime = millis();
-
-        // Handle long press
-        while(digitalRead(RowPins[r]) == LOW) {
-          uint64_t loopTime = millis();
-
-          // If key pressed longer than long press delay
-          if (loopTime - pressStartTime > LONG_PRESS_DELAY) {
-            handleLongPress(Keypad[r][c], loopTime);
-            longPressTriggered = true;
-          }
-
-          delay(20);
-        }
-
-        uint64_t pressEndTime = millis();
-        digitalWrite(ColPins[c], HIGH);
-
-        // If hold press not detected return pressed key
-        if (longPressTriggered) {
-          if (Keypad[r][c] == KEY_S) {
-            hideHelp(pressEndTime);
-          }
-          return KEY_NONE;
-        }
-        else {
-          return Keypad[r][c];
-        }
+        sample |= 1 << (r * KEYPAD_COLS + c);
       }
     }
 
     digitalWrite(ColPins[c], HIGH);
   }
-  
-  return KEY_NONE;
+
+  return sample;
+}
+
+/**
+ * @brief Get the keys the matrix without diodes cannot tell apart.
+ * When two rows share two or more pressed columns, the corners of
+ * the rectangle connect each other and a released corner reads as
+ * pressed, so all keys of the rectangle are ambiguous.
+ * 
+ * @param sample 
+ * @return uint16_t 
+ */
+uint16_t getGhostKeys(uint16_t sample) {
+  uint16_t ghosts = 0;
+
+  for (int r1 = 0; r1 < KEYPAD_ROWS - 1; ++r1) {
+    uint16_t row1 = (sample >> (r1 * KEYPAD_COLS)) & KEYPAD_ROW_MASK;
+
+    for (int r2 = r1 + 1; r2 < KEYPAD_ROWS; ++r2) {
+      uint16_t common = row1 & (sample >> (r2 * KEYPAD_COLS));
+
+      // Two or more common columns
+      if (common & (common - 1)) {
+        ghosts |= (common << (r1 * KEYPAD_COLS)) | (common << (r2 * KEYPAD_COLS));
+      }
+    }
+  }
+
+  return ghosts;
+}
+
+/**
+ * @brief Reset the debouncer to all keys released.
+ * 
+ * @param debouncer 
+ */
+void resetDebouncer(Debouncer *debouncer) {
+  debouncer->state = 0;
+  debouncer->count0 = 0;
+  debouncer->count1 = 0;
+}
+
+/**
+ * @brief Debounce all keys of the matrix at once with 2 bit vertical
+ * counters, bit n of both counters is the counter of key n. The counter
+ * of a key runs while its sample differs from the debounced state and
+ * is cleared by any sample equal to the state, the key toggles on the
+ * KEYPAD_DEBOUNCE_SCANS differing sample in a row. Ambiguous keys keep
+ * their debounced state.
+ * 
+ * @param debouncer 
+ * @param sample 
+ * @return uint16_t mask of the toggled keys
+ */
+uint16_t debounceKeys(Debouncer *debouncer, uint16_t sample) {
+  uint16_t ghosts = getGhostKeys(sample);
+  sample = (sample & ~ghosts) | (debouncer->state & ghosts);
+
+  uint16_t delta = sample ^ debouncer->state;
+  debouncer->count1 = (debouncer->count1 ^ debouncer->count0) & delta;
+  debouncer->count0 = ~debouncer->count0 & delta;
+
+  uint16_t toggled = delta & ~(debouncer->count0 | debouncer->count1);
+  debouncer->state ^= toggled;
+  return toggled;
+}
+
+/**
+ * @brief Handle the debounced key edges. A digit pressed while the
+ * chord key is held runs the chord, both keys are then used by the
+ * chord. A released key held past the long press delay ends the long
+ * press, other released keys not used by a chord wait as short
+ * presses.
+ * 
+ * @param editor 
+ * @param toggled 
+ */
+void handleKeyEdges(Editor *editor, uint16_t toggled) {
+  uint16_t pressed = toggled & keypadDebouncer.state;
+  uint16_t released = toggled & ~keypadDebouncer.state;
+  uint16_t chordMask = getKeyMask(KEYPAD_CHORD_KEY);
+
+  while (pressed) {
+    int bit = __builtin_ctz(pressed);
+    pressed &= pressed - 1;
+
+    Key key = getMatrixKey(bit);
+    keyPressTimes[bit] = editor->now;
+    recordScanPress(scanRate, lastScanTime - keySeenTimes[bit]);
+
+    if ((keypadDebouncer.state & chordMask) && key >= KEY_0 && key <= KEY_9) {
+      chordKeys |= (1 << bit) | chordMask;
+      handleChord(editor, KEYPAD_CHORD_KEY, key, editor->now);
+    }
+  }
+
+  while (released) {
+    int bit = __builtin_ctz(released);
+    uint16_t mask = 1 << bit;
+    released &= released - 1;
+
+    if (longPressKeys & mask) {
+      handleLongRelease(editor, getMatrixKey(bit), editor->now);
+    }
+    else if (!(chordKeys & mask)) {
+      pendingKeys |= mask;
+    }
+
+    longPressKeys &= ~mask;
+    chordKeys &= ~mask;
+  }
 }
 
 /**
- * @brief Get the symbols string for the passed key value, also
- * checks if passed key value is in interval between key 0 and 9.  * 
+ * @brief Call the long press handler of every key held longer than
+ * the long press delay, then again every repeat delay. Keys used by
+ * a chord do not long press.
+ * 
+ * @param editor 
+ */
+void handleKeyHolds(Editor *editor) {
+  uint16_t held = keypadDebouncer.state & ~chordKeys;
+
+  while (held) {
+    int bit = __builtin_ctz(held);
+    uint16_t mask = 1 << bit;
+    held &= held - 1;
+
+    if (editor->now - keyPressTimes[bit] > LONG_PRESS_DELAY &&
+        (!(longPressKeys & mask) || editor->now - keyHoldTimes[bit] >= LONG_PRESS_REPEAT_DELAY)) {
+      longPressKeys |= mask;
+      keyHoldTimes[bit] = editor->now;
+      handleLongPress(editor, getMatrixKey(bit), editor->now);
+    }
+  }
+}
+
+/**
+ * @brief Read the whole matrix once and debounce it, remember when
+ * every key started to change for the input latency, handle the key
+ * edges and held keys, then return the next short pressed key.
+ * 
+ * Keys are independent, so any number of keys can be held at once,
+ * short presses are returned in release order one per call.
+ * 
+ * @param editor 
+ * @return Key 
+ */
+Key scanKeypad(Editor *editor) {
+  uint32_t gap = recordScan(scanRate);
+  uint16_t sample = readKeypad();
+
+  // The change came at most one scan period ago
+  uint16_t started = (sample ^ keypadDebouncer.state) & ~unsettledKeys;
+  while (started) {
+    int bit = __builtin_ctz(started);
+    started &= started - 1;
+    keySeenTimes[bit] = lastScanTime - gap;
+  }
+
+  uint16_t toggled = debounceKeys(&keypadDebouncer, sample);
+  unsettledKeys = sample ^ keypadDebouncer.state;
+
+  handleKeyEdges(editor, toggled);
+  handleKeyHolds(editor);
+
+  if (pendingKeys == 0) {
+    return KEY_NONE;
+  }
+
+  int bit = __builtin_ctz(pendingKeys);
+  pendingKeys &= pendingKeys - 1;
+  return getMatrixKey(bit);
+}
+
+/**
+ * @brief Run the chord of the held chord key and pressed digit,
+ * the star chord with left or right jumps by word, with zero selects
+ * the next layout, with other digits runs the long press action of
+ * the digit at once. The multitap cycle
+ * ends, so the next press does not cycle the char left behind.
+ * 
+ * @param editor 
+ * @param chord 
  * @param key 
- * @return const char* 
+ * @param time 
  */
-const char* getSymbols(Key key) {
-  if (key < KEY_0 || key > KEY_9) {
-    return NULL;
+void handleChord(Editor *editor, Key chord, Key key, uint64_t time) {
+  if (chord != KEY_S || editor->pickerVisible || editor->historyVisible || editor->sending) {
+    return;
+  }
+
+  // The chord ends the multitap cycle
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+
+  if (key == KEY_4 || key == KEY_6) {
+    touchEditor(editor);
+    jumpWord(editor, key == KEY_6, time);
+    drawHeader(editor);
+  }
+  else if (key == KEY_0) {
+    touchEditor(editor);
+    selectLayout(editor, (editor->layoutIndex + 1) % getLayoutCount());
+    drawHeader(editor);
+  }
+  else {
+    handleLongPress(editor, key, time);
   }
 
-  return KeySymbols[key];
+  // A chord is one step, it does not speed up the next held move
+  editor->moveRepeats = 0;
 }
 
 /**
- * @brief Get the char value from the symbols for passed keypad
- * key and current position of symbolIndex.
- *  
+ * @brief Get the delay until the next keypad scan, none while short
+ * presses wait, the fast rate while a key is held or changing or the
+ * multitap cycle is open and the next press is expected soon,
+ * otherwise the slow rate.
+ * 
+ * @param editor 
+ * @return uint32_t 
+ */
+uint32_t getScanDelay(Editor *editor) {
+  if (pendingKeys != 0) {
+    scanRate = SCAN_FAST;
+    return 0;
+  }
+
+  if (keypadDebouncer.state != 0 || unsettledKeys != 0 ||
+      isTimerArmed(&editor->multitapTimer)) {
+    scanRate = SCAN_FAST;
+    return KEYPAD_FAST_SCAN_DELAY;
+  }
+
+  scanRate = SCAN_SLOW;
+  return KEYPAD_SLOW_SCAN_DELAY;
+}
+
+/**
+ * @brief Get the keypad scan statistics of the rate.
+ * 
+ * @param rate 
+ * @return ScanStats 
+ */
+ScanStats getScanStats(ScanRate rate) {
+  return scanStats[rate];
+}
+
+/**
+ * @brief Handle the pressed key by calling the handle functions
+ * and redraw the header, every key restarts the editor idle delay.
+ * 
+ * @param editor 
  * @param key 
- * @return char 
  */
-char getKeyChar(Key key) {
-  const char *symbols = getSymbols(key);
+void handlePress(Editor *editor, Key key) {
+  if (key == KEY_NONE) {
+    return;
+  }
 
-  if (symbols == NULL) {
-    return KEY_NONE;
+  touchEditor(editor);
+
+  if (editor->sending) {
+    return;
   }
 
-  return symbols[symbolIndex];
+  if (editor->pickerVisible) {
+    handlePickerKey(editor, key);
+    return;
+  }
+
+  if (editor->historyVisible) {
+    handleHistoryKey(editor, key);
+    return;
+  }
+
+  switch (key) {
+    // Numerical key
+    case KEY_0: case KEY_1: 
+    case KEY_2: case KEY_3: 
+    case KEY_4: case KEY_5: 
+    case KEY_6: case KEY_7: 
+    case KEY_8: case KEY_9:
+      handleKey(editor, key);
+      break;
+
+    // Star key
+    case KEY_S:
+      switchCaseMode(editor);
+      break;
+
+    // Hashtag key
+    case KEY_H:
+      handleDelete(editor, editor->now);
+      break;
+
+    default:
+      return;
+  }
+
+  drawHeader(editor);
 }
 
 /**
- * @brief Get smart case formatted char value from the input
+ * @brief Handle release of the key after long press, hide
+ * the help after star key hold, the next held move starts slow.
+ * The send key released in the recipient picker arms the send.
  * 
- * @param input 
- * @return char 
+ * @param editor 
+ * @param key 
+ * @param time 
+ */
+void handleLongRelease(Editor *editor, Key key, uint64_t time) {
+  touchEditor(editor);
+  editor->moveRepeats = 0;
+
+  if (editor->sending) {
+    return;
+  }
+
+  if (editor->pickerVisible) {
+    editor->pickerArmed |= key == KEY_5;
+  }
+  else if (key == KEY_S && !editor->historyVisible) {
+    hideHelp(editor, time);
+  }
+}
+
+/**
+ * @brief Get the symbol cycle of the passed key value in the active
+ * layout, also checks if passed key value is in interval between
+ * key 0 and 9.
+ * 
+ * @param editor 
+ * @param key 
+ * @return const KeyCycle* 
  */
-char getSmartCase(char input) {
-  if (isdigit(input)) {
-    return input;
+const KeyCycle *getKeyCycle(Editor *editor, Key key) {
+  if (key < KEY_0 || key > KEY_9) {
+    return NULL;
   }
 
+  return &editor->layout->keys[key];
+}
+
+/**
+ * @brief Check whether the next char starts a sentence, the first
+ * char of the message or a char after a sentence end and space.
+ * 
+ * @param editor 
+ * @return true 
+ * @return false 
+ */
+bool isSentenceStart(Editor *editor) {
   // Capitalize the first letter of message
-  if (bufferIndex == 0) {
-    return toupper(input);
+  if (editor->bufferIndex == 0) {
+    return true;
   }
 
   // Check for sentence end
-  if (bufferIndex >= 2) {
-    const char prevChar = getBufferCharByIndex(bufferIndex - 1);
-    const char prevPrevChar = getBufferCharByIndex(bufferIndex - 2);
+  if (editor->bufferIndex >= 2) {
+    const char prevChar = getBufferCharByIndex(editor, editor->bufferIndex - 1);
+    const char prevPrevChar = getBufferCharByIndex(editor, editor->bufferIndex - 2);
 
-    if (prevChar == ' ' && 
-        (prevPrevChar == '.' || prevPrevChar == '!' || prevPrevChar == '?')) {
-      return toupper(input);
-    }
+    return prevChar == ' ' && 
+           (prevPrevChar == '.' || prevPrevChar == '!' || prevPrevChar == '?');
   }
 
-  return tolower(input);
+  return false;
+}
+
+/**
+ * @brief Get the char value from the symbol cycle for passed keypad
+ * key and current position of symbolIndex, the upper case variant
+ * in upper case mode and at sentence start in smart case mode.
+ * Digits and symbols are their own upper case variant.
+ *  
+ * @param editor 
+ * @param key 
+ * @return char 
+ */
+char getKeyChar(Editor *editor, Key key) {
+  const KeyCycle *cycle = getKeyCycle(editor, key);
+
+  if (cycle == NULL) {
+    return KEY_NONE;
+  }
+
+  bool upper = editor->caseMode == MODE_UPPER ||
+               (editor->caseMode == MODE_SMART && isSentenceStart(editor));
+
+  return upper ? cycle->upper[editor->symbolIndex] : cycle->lower[editor->symbolIndex];
 }
 
 /**
  * @brief Get the key char for the passed key,
- * if it is key cycle decrement bufferIndex, case the correct
- * final char value based on active mode and call display draw char.
+ * if it is key cycle decrement bufferIndex first, so the case
+ * is taken from the chars before the cycled one, and call
+ * display draw char.
  * 
+ * @param editor 
  * @param key 
+ * @param isCycle 
  */
-void displayKey(Key key, bool isCycle) {
-  char input = getKeyChar(key);
-
+void displayKey(Editor *editor, Key key, bool isCycle) {
   // Decrease buffer index if key cycle present
-  if (isCycle && bufferIndex > 0) bufferIndex--;
+  if (isCycle && editor->bufferIndex > 0) editor->bufferIndex--;
+
+  drawChar(editor, getKeyChar(editor, key), isCycle);
+}
+
+/**
+ * @brief Reset the tapping cadence, the initial tap average and
+ * deviation give the initial multitap delay and no letter gap is
+ * known yet.
+ * 
+ * @param cadence 
+ */
+void resetCadence(MultitapCadence *cadence) {
+  cadence->tapAverage = (MULTITAP_DELAY * 3 / 5) << MULTITAP_AVERAGE_SHIFT;
+  cadence->tapDeviation = MULTITAP_DELAY * 2 / 5;
+  cadence->letterAverage = MULTITAP_MAX_GAP << MULTITAP_DEVIATION_SHIFT;
+  cadence->delay = MULTITAP_DELAY;
+  cadence->lastTime = 0;
+}
+
+/**
+ * @brief Add the interval since the previous key press to the
+ * cadence averages, intervals of a cycle and late taps to the tap
+ * average and deviation, intervals between letters to the letter gap.
+ * The multitap delay is the tap average plus 4 deviations, like the
+ * TCP retransmit timeout, but at most the usual letter gap unless
+ * that gets too close to the taps, within the delay bounds.
+ * 
+ * @param cadence 
+ * @param isCycle press continues the multitap cycle
+ * @param isLate press of the cycle key just after the delay expired
+ * @param interval time since the previous key press in ms
+ */
+void updateCadence(MultitapCadence *cadence, bool isCycle, bool isLate, uint32_t interval) {
+  if (interval > MULTITAP_MAX_GAP) {
+    return;
+  }
 
-  // Format smart case char value
-  if (activeCaseMode == MODE_SMART) {
-    input = getSmartCase(input);
+  if (isCycle || isLate) {
+    int32_t error = (int32_t)interval - (cadence->tapAverage >> MULTITAP_AVERAGE_SHIFT);
+    cadence->tapAverage += error;
+    cadence->tapDeviation += (error < 0 ? -error : error) - (cadence->tapDeviation >> MULTITAP_DEVIATION_SHIFT);
+  }
+  else {
+    cadence->letterAverage += interval - (cadence->letterAverage >> MULTITAP_DEVIATION_SHIFT);
   }
 
-  // Convert to upper case in upper case mode
-  if (activeCaseMode == MODE_UPPER && !isdigit(input)) {
-    input = toupper(input);
+  uint32_t tap = cadence->tapAverage >> MULTITAP_AVERAGE_SHIFT;
+  uint32_t letter = cadence->letterAverage >> MULTITAP_DEVIATION_SHIFT;
+  uint32_t delay = tap + cadence->tapDeviation;
+
+  if (delay > letter) {
+    delay = letter > tap + tap / 4 ? letter : tap + tap / 4;
   }
 
-  drawChar(input, isCycle);
+  if (delay < MULTITAP_MIN_DELAY) delay = MULTITAP_MIN_DELAY;
+  if (delay > MULTITAP_MAX_DELAY) delay = MULTITAP_MAX_DELAY;
+  cadence->delay = delay;
 }
 
 /**
- * @brief Handle key cycle, call display key and 
- * update last press time
- *  
+ * @brief Advance the multitap cycle of the key, the symbol index
+ * moves on when the key continues the cycle, otherwise the key
+ * starts a new cycle. The multitap delay follows the learned
+ * tapping cadence and is armed again.
+ * 
+ * @param editor 
  * @param key 
+ * @return true if the key continues the cycle
+ * @return false 
  */
-void handleKey(Key key) {
-  // Check for key cycle conditions
-  if (key == lastKey && (now - lastPressTime < MULTITAP_DELAY)) {
-    disableCursor();
+bool cycleKey(Editor *editor, Key key) {
+  MultitapCadence *cadence = &editor->cadence;
+  bool isCycle = key == editor->lastKey && isTimerArmed(&editor->multitapTimer);
+
+#if MULTITAP_ADAPTIVE
+  uint64_t interval = editor->now - cadence->lastTime;
+  if (interval > UINT32_MAX) interval = UINT32_MAX;
 
+  bool isLate = !isCycle && key == editor->lastKey && interval < (uint32_t)cadence->delay + MULTITAP_LATE_WINDOW;
+  updateCadence(cadence, isCycle, isLate, interval);
+#endif
+
+  cadence->lastTime = editor->now;
+
+  // Check for key cycle conditions
+  if (isCycle) {
     // Increase the key symbols index
-    size_t symbolsLen = strlen(KeySymbols[key]);
-    symbolIndex++;
+    editor->symbolIndex++;
 
-    if (symbolIndex >= symbolsLen) {
-      symbolIndex = 0;
+    if (editor->symbolIndex >= editor->layout->keys[key].len) {
+      editor->symbolIndex = 0;
     }
-
-    displayKey(key, true);
   }
   else {
-    symbolIndex = 0;
-    displayKey(key, false);
-    lastKey = key;
+    editor->symbolIndex = 0;
+    editor->lastKey = key;
   }
 
-  lastPressTime = now;
+  armTimer(&editor->timers, &editor->multitapTimer, editor->now + cadence->delay);
+  return isCycle;
+}
+
+/**
+ * @brief Handle key cycle and call display key, the cycled
+ * char replaces the previous one.
+ *  
+ * @param editor 
+ * @param key 
+ */
+void handleKey(Editor *editor, Key key) {
+  bool isCycle = cycleKey(editor, key);
+
+  if (isCycle) {
+    disableCursor(editor);
+  }
+
+  displayKey(editor, key, isCycle);
 }
 
 /**
  * @brief Get the active mode.
  * 
+ * @param editor 
  * @return CaseMode 
  */
-CaseMode getCaseMode() {
-  return activeCaseMode;
+CaseMode getCaseMode(Editor *editor) {
+  return editor->caseMode;
 }
 
 /**
  * @brief Switch the active case mode to next one.
  * 
+ * @param editor 
  */
-void switchCaseMode() {
-  int next = (int)activeCaseMode + 1;
+void switchCaseMode(Editor *editor) {
+  int next = (int)editor->caseMode + 1;
   if (next > 2) next = 0;
-  activeCaseMode = (CaseMode)next;
+  editor->caseMode = (CaseMode)next;
+}
+
+/**
+ * @brief Select the keypad layout of the index, the multitap cycle
+ * ends as its symbols may not exist in the new layout.
+ * 
+ * @param editor 
+ * @param index 
+ * @return true 
+ * @return false if there is no layout of the index
+ */
+bool selectLayout(Editor *editor, uint8_t index) {
+  const Layout *layout = getLayout(index);
+
+  if (layout == NULL) {
+    return false;
+  }
+
+  editor->layout = layout;
+  editor->layoutIndex = index;
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+  return true;
 }
 
 /**
  * @brief Call display delete char, reset last key and
  * symbolIndex and update the last delete time.
  * 
+ * @param editor 
  * @param time 
  */
-void handleDelete(uint64_t time) {
-  deleteChar(time);
+void handleDelete(Editor *editor, uint64_t time) {
+  deleteChar(editor, time);
 
   // Resey the last key and symbol index
-  lastKey = KEY_NONE;
-  symbolIndex = 0;
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+
+  armTimer(&editor->timers, &editor->deleteTimer, time + DELETE_SPEED_DELAY + 1);
+}
+
+/**
+ * @brief Insert the text on bufferIndex either batched in one buffer
+ * operation with single redraw or char by char the same way as typed
+ * keys, reset the last key and symbolIndex. Nothing is inserted
+ * while the send notes are shown.
+ * 
+ * @param editor 
+ * @param text 
+ * @param len 
+ * @param batched 
+ * @param time 
+ * @return uint8_t count of inserted chars
+ */
+uint8_t handleText(Editor *editor, const char *text, uint8_t len, bool batched, uint64_t time) {
+  uint8_t inserted = 0;
+
+  if (editor->sending) {
+    return 0;
+  }
+
+  if (batched) {
+    inserted = drawText(editor, text, len, time);
+  }
+  else {
+    for (; inserted < len && getBufferLen(editor) < MESSAGE_SIZE; ++inserted) {
+      drawChar(editor, text[inserted], false);
+      drawHeader(editor);
+    }
+  }
+
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+
+  return inserted;
+}
+
+/**
+ * @brief Undo the last edit, redraw the message, reset the last
+ * key and symbolIndex and update the last undo time.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void handleUndo(Editor *editor, uint64_t time) {
+  if (undoEdit(editor)) {
+    refreshMessage(editor, time);
+  }
+
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
 
-  lastDeleteTime = time;
+  armTimer(&editor->timers, &editor->undoTimer, time + UNDO_SPEED_DELAY + 1);
+}
+
+/**
+ * @brief Redo the last undone edit, redraw the message, reset the
+ * last key and symbolIndex and update the last undo time.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void handleRedo(Editor *editor, uint64_t time) {
+  if (redoEdit(editor)) {
+    refreshMessage(editor, time);
+  }
+
+  editor->lastKey = KEY_NONE;
+  editor->symbolIndex = 0;
+
+  armTimer(&editor->timers, &editor->undoTimer, time + UNDO_SPEED_DELAY + 1);
 }
 
 /**
  * @brief Handle key long press, based on pressed key calls
  * the action function and redraw the header.
  * 
+ * @param editor 
  * @param key 
  * @param currentLoopTime 
  */
-void handleLongPress(Key key, uint64_t currentLoopTime) {
+void handleLongPress(Editor *editor, Key key, uint64_t currentLoopTime) {
+  touchEditor(editor);
+
+  if (editor->sending) {
+    return;
+  }
+
+  if (editor->pickerVisible) {
+    handlePickerLongPress(editor, key, currentLoopTime);
+    return;
+  }
+
+  if (editor->historyVisible) {
+    handleHistoryLongPress(editor, key, currentLoopTime);
+    return;
+  }
+
   switch (key) {
     // Clear message
     case KEY_0:
-      clearMessage();
+      clearMessage(editor);
+      break;
+
+    // Undo
+    case KEY_1:
+      if (!isTimerArmed(&editor->undoTimer)) {
+        handleUndo(editor, currentLoopTime);
+      }
       break;
 
     // Move top
     case KEY_2:
-      moveUp(currentLoopTime);
+      moveUp(editor, currentLoopTime);
+      break;
+
+    // Redo
+    case KEY_3:
+      if (!isTimerArmed(&editor->undoTimer)) {
+        handleRedo(editor, currentLoopTime);
+      }
       break;
 
     // Move left
     case KEY_4:
-      moveLeft(currentLoopTime);
+      moveLeft(editor, currentLoopTime);
       break;
 
-    // Send message
+    // Pick the recipient from the phonebook or send message
     case KEY_5:
-      sendMessage();
+      if (getContactCount() > 0 && getBufferLen(editor) > 0) {
+        openPicker(editor);
+      }
+      else {
+        sendMessage(editor, NULL);
+      }
       break;
 
     // Move right
     case KEY_6:
-      moveRight(currentLoopTime);
+      moveRight(editor, currentLoopTime);
       break;
 
     // Move down
     case KEY_8:
-      moveDown(currentLoopTime);
+      moveDown(editor, currentLoopTime);
+      break;
+
+    // Message history
+    case KEY_9:
+      openHistory(editor);
       break;
 
     // Show help
     case KEY_S:
-      showHelp(currentLoopTime);
+      showHelp(editor);
       break;
 
     // Delete
     case KEY_H:
-      if (currentLoopTime - lastDeleteTime > DELETE_SPEED_DELAY) {
-        handleDelete(currentLoopTime);
+      if (!isTimerArmed(&editor->deleteTimer)) {
+        handleDelete(editor, currentLoopTime);
       }
       break;
     
@@ -353,5 +962,167 @@ void handleLongPress(Key key, uint64_t currentLoopTime) {
       break;
   }
 
-  drawHeader();
-}
\ No newline at end of file
+  drawHeader(editor);
+}
+
+/**
+ * @brief Handle the key pressed in the recipient picker, digits
+ * extend the query, star selects the next match, hashtag removes the
+ * last digit or closes the picker when the query is empty.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handlePickerKey(Editor *editor, Key key) {
+  if (key >= KEY_0 && key <= KEY_9) {
+    pushSearchDigit(&editor->search, '0' + key);
+    editor->pickerSelected = 0;
+  }
+  else if (key == KEY_S) {
+    uint32_t count = getSearchCount(&editor->search);
+    editor->pickerSelected = count > 0 ? (editor->pickerSelected + 1) % count : 0;
+  }
+  else if (key == KEY_H && editor->search.len > 0) {
+    popSearchDigit(&editor->search);
+    editor->pickerSelected = 0;
+  }
+  else if (key == KEY_H) {
+    closePicker(editor, editor->now);
+    drawHeader(editor);
+    return;
+  }
+
+  drawPicker(editor);
+}
+
+/**
+ * @brief Handle the key held in the recipient picker, the send key
+ * sends the message to the selected contact once it was released
+ * after opening the picker, so the held send key does not send
+ * right away. Other keys do nothing.
+ * 
+ * @param editor 
+ * @param key 
+ * @param time 
+ */
+void handlePickerLongPress(Editor *editor, Key key, uint64_t time) {
+  Contact contact;
+
+  if (key == KEY_5 && editor->pickerArmed &&
+      getSearchContact(&editor->search, editor->pickerSelected, &contact)) {
+    closePicker(editor, time);
+    sendMessage(editor, &contact);
+    drawHeader(editor);
+  }
+}
+
+/**
+ * @brief Handle the key pressed while typing the history query,
+ * digits type the lower case chars with the same multitap cycle as
+ * the message, hashtag removes the last char and with empty query
+ * shows all messages again, star ends typing and keeps the matches
+ * listed. The history is searched after every change.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handleQueryKey(Editor *editor, Key key) {
+  MessageQuery *query = &editor->query;
+
+  if (key >= KEY_0 && key <= KEY_9) {
+    bool isCycle = cycleKey(editor, key);
+
+    if (isCycle && query->len > 0) {
+      query->len--;
+    }
+
+    if (query->len < INDEX_QUERY_SIZE) {
+      query->text[query->len++] = getKeyCycle(editor, key)->lower[editor->symbolIndex];
+    }
+  }
+  else if (key == KEY_H && query->len > 0) {
+    query->len--;
+  }
+  else if (key == KEY_H || key == KEY_S) {
+    editor->historySearching = false;
+  }
+
+  // Only digits continue the cycle
+  if (key == KEY_H || key == KEY_S) {
+    editor->lastKey = KEY_NONE;
+    editor->symbolIndex = 0;
+  }
+
+  searchHistory(editor);
+}
+
+/**
+ * @brief Handle the key pressed in the message history, in the list
+ * two and eight select the newer and older message, five opens it,
+ * star types a query listing only the messages with all its words,
+ * in the opened message two and eight scroll its rows, hashtag goes
+ * back to the list, clears the query and closes the history from
+ * the list.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handleHistoryKey(Editor *editor, Key key) {
+  if (editor->historySearching) {
+    handleQueryKey(editor, key);
+  }
+  else if (editor->historyOpened) {
+    uint8_t len = getHistoryEntry(editor->historySelected)->len;
+
+    if (key == KEY_2 && editor->historyScroll > 0) {
+      editor->historyScroll--;
+    }
+    else if (key == KEY_8 && (editor->historyScroll + LIST_ROWS) * LIST_LINE_CHARS < len) {
+      editor->historyScroll++;
+    }
+    else if (key == KEY_H) {
+      editor->historyOpened = false;
+    }
+  }
+  else if (key == KEY_2 || key == KEY_8) {
+    scrollHistory(editor, key == KEY_8);
+  }
+  else if (key == KEY_5 && editor->historySelected != HISTORY_NONE) {
+    markHistoryRead(editor->historySelected);
+    editor->historyOpened = true;
+    editor->historyScroll = 0;
+  }
+  else if (key == KEY_S) {
+    editor->historySearching = true;
+    editor->lastKey = KEY_NONE;
+    editor->symbolIndex = 0;
+  }
+  else if (key == KEY_H && editor->query.len > 0) {
+    editor->query.len = 0;
+    searchHistory(editor);
+  }
+  else if (key == KEY_H) {
+    closeHistory(editor, editor->now);
+    drawHeader(editor);
+    return;
+  }
+
+  drawHistory(editor);
+}
+
+/**
+ * @brief Handle the key held in the message history, zero deletes
+ * the selected or opened message, again after the delete delay
+ * while held. Other keys do nothing.
+ * 
+ * @param editor 
+ * @param key 
+ * @param time 
+ */
+void handleHistoryLongPress(Editor *editor, Key key, uint64_t time) {
+  if (key == KEY_0 && !isTimerArmed(&editor->deleteTimer)) {
+    deleteSelectedHistory(editor);
+    drawHistory(editor);
+    armTimer(&editor->timers, &editor->deleteTimer, time + DELETE_SPEED_DELAY + 1);
+  }
+}
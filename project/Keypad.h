@@ -12,19 +12,69 @@
 #ifndef KEYPAD_H
 #define KEYPAD_H
 
+#include <stdint.h>
+
+#include "Layout.h"
+
 // Keypad cols and rows number
 #define KEYPAD_COLS 3
 #define KEYPAD_ROWS 4
 
-// Key multitap delay
+// Keys of the matrix, key bit is row * KEYPAD_COLS + column
+#define KEYPAD_KEYS (KEYPAD_ROWS * KEYPAD_COLS)
+#define KEYPAD_ROW_MASK ((1 << KEYPAD_COLS) - 1)
+
+// Key held for the chords with digits
+#define KEYPAD_CHORD_KEY KEY_S
+
+// Initial key multitap delay
 #define MULTITAP_DELAY 500
 
+// Learn the multitap delay from the tapping cadence
+#ifndef MULTITAP_ADAPTIVE
+#define MULTITAP_ADAPTIVE 1
+#endif
+
+// Bounds of the learned multitap delay
+#ifndef MULTITAP_MIN_DELAY
+#define MULTITAP_MIN_DELAY 250
+#endif
+
+#ifndef MULTITAP_MAX_DELAY
+#define MULTITAP_MAX_DELAY 1000
+#endif
+
+// Weights of the tap average and deviation averages as shifts,
+// 1/8 and 1/4 of every new interval
+#define MULTITAP_AVERAGE_SHIFT 3
+#define MULTITAP_DEVIATION_SHIFT 2
+
+// Same key pressed this long after the multitap delay expired is
+// taken as a too slow tap of the cycle
+#define MULTITAP_LATE_WINDOW 150
+
+// Longer gaps between letters are pauses, not the typing cadence
+#define MULTITAP_MAX_GAP 2000
+
 // Delay for long press
 #define LONG_PRESS_DELAY 500
 
 // Delay for delete long press
 #define DELETE_SPEED_DELAY 200
 
+// Long press handler repeat while the key is held
+#define LONG_PRESS_REPEAT_DELAY 20
+
+// Delay between keypad scans while a key is held or multitap is open
+#define KEYPAD_FAST_SCAN_DELAY 1
+
+// Delay between keypad scans otherwise
+#define KEYPAD_SLOW_SCAN_DELAY 20
+
+// Differing scans in a row toggling the debounced key, fixed by the
+// 2 bit vertical counters
+#define KEYPAD_DEBOUNCE_SCANS 4
+
 /**
  * @brief Enum values for keypad keys.
  * 
@@ -43,80 +93,327 @@ typedef enum {
   MODE_LOWER, MODE_UPPER, MODE_SMART
 } CaseMode;
 
+/**
+ * @brief Structure for the learned tapping cadence, exponentially
+ * weighted averages of the tap interval within a cycle, its deviation
+ * and the gap between letters. The averages are kept scaled up by
+ * their weight, the tap average by 8, deviation and letter gap by 4.
+ * 
+ */
+typedef struct {
+  uint16_t tapAverage;
+  uint16_t tapDeviation;
+  uint16_t letterAverage;
+  uint16_t delay;
+  uint64_t lastTime;
+} MultitapCadence;
+
+/**
+ * @brief Enum values for keypad scan rate.
+ * 
+ */
+typedef enum {
+  SCAN_FAST, SCAN_SLOW, SCAN_RATES
+} ScanRate;
+
+/**
+ * @brief Structure for keypad scan statistics of one rate, times in us.
+ * 
+ */
+typedef struct {
+  uint32_t scans;
+  uint64_t time;
+  uint32_t presses;
+  uint64_t totalLatency;
+  uint32_t maxLatency;
+} ScanStats;
+
+/**
+ * @brief Structure for debounced key matrix, bit n of the counters is
+ * the 2 bit counter of key n.
+ * 
+ */
+typedef struct {
+  uint16_t state;
+  uint16_t count0;
+  uint16_t count1;
+} Debouncer;
+
+struct Editor;
+
 /**
  * @brief Initialize the keypad.
  */
 void initKeypad(); 
 
+/**
+ * @brief Pull all columns LOW so any key press pulls its row LOW
+ * and wakes the device up.
+ * 
+ */
+void sleepKeypad();
+
+/**
+ * @brief Restore the columns after sleep.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool wakeKeypad();
+
+/**
+ * @brief Get the keys ambiguous because of matrix ghosting.
+ * 
+ * @param sample 
+ * @return uint16_t 
+ */
+uint16_t getGhostKeys(uint16_t sample);
+
+/**
+ * @brief Reset the debouncer.
+ * 
+ * @param debouncer 
+ */
+void resetDebouncer(Debouncer *debouncer);
+
+/**
+ * @brief Debounce the matrix sample.
+ * 
+ * @param debouncer 
+ * @param sample 
+ * @return uint16_t 
+ */
+uint16_t debounceKeys(Debouncer *debouncer, uint16_t sample);
+
 /**
  * @brief Scan the keypad manually.
  * 
+ * @param editor 
  * @return Key 
  */
-Key scanKeypad();
+Key scanKeypad(Editor *editor);
+
+/**
+ * @brief Get the delay until the next keypad scan.
+ * 
+ * @param editor 
+ * @return uint32_t 
+ */
+uint32_t getScanDelay(Editor *editor);
+
+/**
+ * @brief Get the keypad scan statistics.
+ * 
+ * @param rate 
+ * @return ScanStats 
+ */
+ScanStats getScanStats(ScanRate rate);
+
+/**
+ * @brief Handle the short pressed key.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handlePress(Editor *editor, Key key);
 
 /**
- * @brief Get the symbols for the keypad key.
+ * @brief Handle the digit pressed while the chord key is held.
  * 
+ * @param editor 
+ * @param chord 
  * @param key 
- * @return const char* 
+ * @param time 
  */
-const char* getSymbols(Key key);
+void handleChord(Editor *editor, Key chord, Key key, uint64_t time);
+
+/**
+ * @brief Handle the key release after long press.
+ * 
+ * @param editor 
+ * @param key 
+ * @param time 
+ */
+void handleLongRelease(Editor *editor, Key key, uint64_t time);
+
+/**
+ * @brief Get the symbol cycle of the key in the active layout.
+ * 
+ * @param editor 
+ * @param key 
+ * @return const KeyCycle* 
+ */
+const KeyCycle *getKeyCycle(Editor *editor, Key key);
 
 /**
  * @brief Get the char to be displayed.
  * 
+ * @param editor 
  * @param key 
  * @return char 
  */
-char getKeyChar(Key key);
+char getKeyChar(Editor *editor, Key key);
 
 /**
- * @brief Get char in smart case 
+ * @brief Check whether the next char starts a sentence.
  * 
- * @param input 
- * @return char 
+ * @param editor 
+ * @return true 
+ * @return false 
  */
-char getSmartCase(char input);
+bool isSentenceStart(Editor *editor);
 
 /**
  * @brief Display the char value.
  * 
+ * @param editor 
  * @param key 
  * @param isCycle 
  */
-void displayKey(Key key, bool isCycle);
+void displayKey(Editor *editor, Key key, bool isCycle);
+
+/**
+ * @brief Reset the tapping cadence to the initial multitap delay.
+ * 
+ * @param cadence 
+ */
+void resetCadence(MultitapCadence *cadence);
+
+/**
+ * @brief Learn the tapping cadence from the key press.
+ * 
+ * @param cadence 
+ * @param isCycle 
+ * @param isLate 
+ * @param interval 
+ */
+void updateCadence(MultitapCadence *cadence, bool isCycle, bool isLate, uint32_t interval);
+
+/**
+ * @brief Advance the multitap cycle of the key.
+ * 
+ * @param editor 
+ * @param key 
+ * @return true 
+ * @return false 
+ */
+bool cycleKey(Editor *editor, Key key);
 
 /**
  * @brief Handle the pressed key.
  * 
+ * @param editor 
  * @param key 
  */
-void handleKey(Key key);
+void handleKey(Editor *editor, Key key);
 
 /**
  * @brief Get the active case mode.
  * 
+ * @param editor 
  * @return CaseMode 
  */
-CaseMode getCaseMode();
+CaseMode getCaseMode(Editor *editor);
 
 /**
  * @brief Switch the active case mode.
  * 
+ * @param editor 
+ */
+void switchCaseMode(Editor *editor);
+
+/**
+ * @brief Select the keypad layout of the index.
+ * 
+ * @param editor 
+ * @param index 
+ * @return true 
+ * @return false 
  */
-void switchCaseMode();
+bool selectLayout(Editor *editor, uint8_t index);
 
 /**
  * @brief Handle delete key pressed.
  * 
+ * @param editor 
+ */
+void handleDelete(Editor *editor, uint64_t time);
+
+/**
+ * @brief Handle text received from the host link.
+ * 
+ * @param editor 
+ * @param text 
+ * @param len 
+ * @param batched 
+ * @param time 
+ * @return uint8_t 
  */
-void handleDelete(uint64_t time);
+uint8_t handleText(Editor *editor, const char *text, uint8_t len, bool batched, uint64_t time);
+
+/**
+ * @brief Handle undo key long press.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void handleUndo(Editor *editor, uint64_t time);
+
+/**
+ * @brief Handle redo key long press.
+ * 
+ * @param editor 
+ * @param time 
+ */
+void handleRedo(Editor *editor, uint64_t time);
 
 /**
  * @brief 
  * 
+ * @param editor 
+ */
+void handleLongPress(Editor *editor, Key key, uint64_t time);
+
+/**
+ * @brief Handle the key pressed in the recipient picker.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handlePickerKey(Editor *editor, Key key);
+
+/**
+ * @brief Handle the key held in the recipient picker.
+ * 
+ * @param editor 
+ * @param key 
+ * @param time 
+ */
+void handlePickerLongPress(Editor *editor, Key key, uint64_t time);
+
+/**
+ * @brief Handle the key pressed while typing the history query.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handleQueryKey(Editor *editor, Key key);
+
+/**
+ * @brief Handle the key pressed in the message history.
+ * 
+ * @param editor 
+ * @param key 
+ */
+void handleHistoryKey(Editor *editor, Key key);
+
+/**
+ * @brief Handle the key held in the message history.
+ * 
+ * @param editor 
+ * @param key 
+ * @param time 
  */
-void handleLongPress(Key key, uint64_t time);
+void handleHistoryLongPress(Editor *editor, Key key, uint64_t time);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,196 @@
+/**
+ * @file Latency.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Latency.h"
+#include "Shared.h"
+
+// Running step, its start, the part charged now and since when
+SHARED_STATE bool loopStepRunning = false;
+SHARED_STATE uint32_t loopStepStart = 0;
+SHARED_STATE uint32_t loopPhaseStart = 0;
+SHARED_STATE LoopPhase loopPhase = LOOP_EDIT;
+SHARED_STATE LoopSample loopSample;
+
+// Step time report and the watchdog
+SHARED_STATE LoopStats loopStats;
+SHARED_STATE uint32_t loopWatchdogThreshold = LOOP_WATCHDOG_THRESHOLD;
+SHARED_STATE LoopWatchdog loopWatchdog = NULL;
+
+/**
+ * @brief Start timing the input step, the step starts in the edit
+ * part.
+ * 
+ */
+void startLoopStep() {
+  loopStepStart = micros();
+  loopPhaseStart = loopStepStart;
+  loopPhase = LOOP_EDIT;
+  memset(loopSample.phases, 0, sizeof(loopSample.phases));
+  loopStepRunning = true;
+}
+
+/**
+ * @brief Charge the time since the last switch to the running part
+ * and switch to the part, nothing is timed outside the step.
+ * 
+ * @param phase 
+ * @return LoopPhase the part to enter again when the part ends
+ */
+LoopPhase enterLoopPhase(LoopPhase phase) {
+  LoopPhase previous = loopPhase;
+
+  if (loopStepRunning) {
+    uint32_t now = micros();
+    loopSample.phases[loopPhase] += now - loopPhaseStart;
+    loopPhaseStart = now;
+  }
+
+  loopPhase = phase;
+  return previous;
+}
+
+/**
+ * @brief Get the histogram bucket of the step time, the bit length
+ * of the time.
+ * 
+ * @param time 
+ * @return uint8_t 
+ */
+uint8_t getLoopBucket(uint32_t time) {
+  uint8_t bucket = 0;
+
+  while (time > 0 && bucket < LOOP_BUCKETS - 1) {
+    time >>= 1;
+    bucket++;
+  }
+
+  return bucket;
+}
+
+/**
+ * @brief Record the input step time in the histogram, a step over
+ * the budget counts as a violation of the part taking the most time,
+ * a step over the watchdog threshold is passed to the hook.
+ * 
+ */
+void endLoopStep() {
+  if (!loopStepRunning) {
+    return;
+  }
+
+  enterLoopPhase(LOOP_EDIT);
+  loopStepRunning = false;
+  loopSample.time = micros() - loopStepStart;
+
+  loopSample.cause = LOOP_SCAN;
+  for (uint8_t phase = 1; phase < LOOP_PHASES; ++phase) {
+    if (loopSample.phases[phase] > loopSample.phases[loopSample.cause]) {
+      loopSample.cause = (LoopPhase)phase;
+    }
+  }
+
+  loopStats.steps++;
+  loopStats.buckets[getLoopBucket(loopSample.time)]++;
+  if (loopSample.time > loopStats.maxTime) loopStats.maxTime = loopSample.time;
+
+  if (loopSample.time > LOOP_BUDGET) {
+    loopStats.violations++;
+    loopStats.causes[loopSample.cause]++;
+  }
+
+  if (loopWatchdog != NULL && loopSample.time > loopWatchdogThreshold) {
+    loopWatchdog(&loopSample);
+  }
+}
+
+/**
+ * @brief Set the watchdog hook and the step time in us over which
+ * the step is passed to it.
+ * 
+ * @param threshold 
+ * @param watchdog NULL to stop the reports
+ */
+void setLoopWatchdog(uint32_t threshold, LoopWatchdog watchdog) {
+  loopWatchdogThreshold = threshold;
+  loopWatchdog = watchdog;
+}
+
+/**
+ * @brief Get the watchdog threshold in us.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getLoopWatchdogThreshold() {
+  return loopWatchdogThreshold;
+}
+
+/**
+ * @brief Clear the histogram, violations and the longest step.
+ * 
+ */
+void resetLoopStats() {
+  memset(&loopStats, 0, sizeof(loopStats));
+}
+
+/**
+ * @brief Get the step time report.
+ * 
+ * @return const LoopStats*
+ */
+const LoopStats *getLoopStats() {
+  return &loopStats;
+}
+
+/**
+ * @brief Add the steps, violations and histogram of the report to the
+ * sum, the longest step is the longer one.
+ * 
+ * @param sum 
+ * @param stats 
+ */
+void addLoopStats(LoopStats *sum, const LoopStats *stats) {
+  sum->steps += stats->steps;
+  sum->violations += stats->violations;
+  if (stats->maxTime > sum->maxTime) sum->maxTime = stats->maxTime;
+
+  for (uint8_t phase = 0; phase < LOOP_PHASES; ++phase) {
+    sum->causes[phase] += stats->causes[phase];
+  }
+  for (uint8_t bucket = 0; bucket < LOOP_BUCKETS; ++bucket) {
+    sum->buckets[bucket] += stats->buckets[bucket];
+  }
+}
+
+/**
+ * @brief Get the upper bound in us of the histogram bucket holding the
+ * percent of the steps, same as the latency command of tools/link.py.
+ * 
+ * @param stats 
+ * @param percent 
+ * @return uint32_t 0 without steps
+ */
+uint32_t getLoopPercentile(const LoopStats *stats, uint8_t percent) {
+  uint64_t seen = 0;
+
+  for (uint8_t bucket = 0; bucket < LOOP_BUCKETS; ++bucket) {
+    seen += stats->buckets[bucket];
+    if (stats->buckets[bucket] > 0 && seen * 100 >= (uint64_t)percent * stats->steps) {
+      return 1UL << bucket;
+    }
+  }
+
+  return 0;
+}
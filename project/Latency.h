@@ -0,0 +1,137 @@
+/**
+ * @file Latency.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+// Histogram buckets of the input step time, bucket 0 takes steps
+// under 1 us, bucket n steps from 2^(n - 1) us, the last one the rest
+#define LOOP_BUCKETS 20
+
+// Step time budget in us, longer steps count as violations
+#ifndef LOOP_BUDGET
+#define LOOP_BUDGET 5000
+#endif
+
+// Default step time in us reported to the watchdog hook
+#ifndef LOOP_WATCHDOG_THRESHOLD
+#define LOOP_WATCHDOG_THRESHOLD 20000
+#endif
+
+/**
+ * @brief Enum values for the parts of the input step, the step time
+ * is charged to the innermost running part.
+ * 
+ */
+typedef enum {
+  LOOP_SCAN,
+  LOOP_EDIT,
+  LOOP_RENDER,
+  LOOP_FLUSH,
+  LOOP_LINK,
+  LOOP_PHASES
+} LoopPhase;
+
+/**
+ * @brief Structure for one input step, its time, the time of every
+ * part and the part taking the most.
+ * 
+ */
+typedef struct {
+  uint32_t time;
+  uint32_t phases[LOOP_PHASES];
+  LoopPhase cause;
+} LoopSample;
+
+/**
+ * @brief Structure for the step time report, the histogram, the
+ * budget violations by their cause and the longest step.
+ * 
+ */
+typedef struct {
+  uint32_t steps;
+  uint32_t violations;
+  uint32_t causes[LOOP_PHASES];
+  uint32_t maxTime;
+  uint32_t buckets[LOOP_BUCKETS];
+} LoopStats;
+
+// Handler of a step over the watchdog threshold
+typedef void (*LoopWatchdog)(const LoopSample *sample);
+
+/**
+ * @brief Start timing the input step.
+ * 
+ */
+void startLoopStep();
+
+/**
+ * @brief Charge the time from now to the part.
+ * 
+ * @param phase 
+ * @return LoopPhase 
+ */
+LoopPhase enterLoopPhase(LoopPhase phase);
+
+/**
+ * @brief Record the input step time.
+ * 
+ */
+void endLoopStep();
+
+/**
+ * @brief Set the watchdog hook and its threshold.
+ * 
+ * @param threshold 
+ * @param watchdog 
+ */
+void setLoopWatchdog(uint32_t threshold, LoopWatchdog watchdog);
+
+/**
+ * @brief Get the watchdog threshold.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getLoopWatchdogThreshold();
+
+/**
+ * @brief Clear the step time report.
+ * 
+ */
+void resetLoopStats();
+
+/**
+ * @brief Get the step time report.
+ * 
+ * @return const LoopStats*
+ */
+const LoopStats *getLoopStats();
+
+/**
+ * @brief Add the step time report to the sum.
+ * 
+ * @param sum 
+ * @param stats 
+ */
+void addLoopStats(LoopStats *sum, const LoopStats *stats);
+
+/**
+ * @brief Get the upper bound of the step time percentile.
+ * 
+ * @param stats 
+ * @param percent 
+ * @return uint32_t 
+ */
+uint32_t getLoopPercentile(const LoopStats *stats, uint8_t percent);
+
+#endif
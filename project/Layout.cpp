@@ -0,0 +1,136 @@
+/**
+ * @file Layout.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <string.h>
+#include <stdint.h>
+
+#include "Layout.h"
+
+// Built-in layouts generated at compile time, Czech letters in the
+// internal code page
+constexpr Layout BuiltinLayouts[LAYOUT_BUILTIN] = {
+  makeLayout("EN",
+    " 0", ".,?!1", "abc2", "def3", "ghi4",
+    "jkl5", "mno6", "pqrs7", "tuv8", "wxyz9"),
+
+  makeLayout("CZ",
+    " 0", ".,?!1",
+    "abc\xE1\xE8" "2",
+    "def\xEF\xE9\xEC" "3",
+    "ghi\xED" "4",
+    "jkl5",
+    "mno\xF2\xF3" "6",
+    "pqrs\xF8\xB9" "7",
+    "tuv\xBB\xFA\xF9" "8",
+    "wxyz\xFD\xBE" "9"),
+
+  makeLayout("SYM",
+    " 0", ".,?!:;1", "@#&2", "+-*/=3", "()[]4",
+    "<>{}5", "$%^6", "'\"`7", "_|\\8", "~9"),
+};
+
+// Layouts loaded from blobs and their count
+Layout ExtraLayouts[LAYOUT_EXTRA_SLOTS];
+uint8_t extraLayoutCount = 0;
+
+/**
+ * @brief Get the number of selectable layouts, built-in and loaded.
+ * 
+ * @return uint8_t 
+ */
+uint8_t getLayoutCount() {
+  return LAYOUT_BUILTIN + extraLayoutCount;
+}
+
+/**
+ * @brief Get the layout of the index, the built-in layouts are
+ * followed by the loaded ones.
+ * 
+ * @param index 
+ * @return const Layout* the layout or NULL if index is out of range
+ */
+const Layout *getLayout(uint8_t index) {
+  if (index < LAYOUT_BUILTIN) {
+    return &BuiltinLayouts[index];
+  }
+
+  if (index < getLayoutCount()) {
+    return &ExtraLayouts[index - LAYOUT_BUILTIN];
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Load a layout from the blob, magic, version and name header
+ * followed by cycle length, lower and upper case symbols of every
+ * digit key. A loaded layout of the same name is replaced, otherwise
+ * the layout takes the next free extra slot.
+ * 
+ * @param blob 
+ * @param len 
+ * @return int index of the loaded layout or -1 if the blob is
+ * malformed or no slot is free
+ */
+int loadLayout(const uint8_t *blob, size_t len) {
+  if (len < LAYOUT_BLOB_HEADER || blob[0] != LAYOUT_BLOB_MAGIC0 ||
+      blob[1] != LAYOUT_BLOB_MAGIC1 || blob[2] != LAYOUT_BLOB_VERSION) {
+    return -1;
+  }
+
+  Layout layout;
+  memset(&layout, 0, sizeof(layout));
+  memcpy(layout.name, &blob[3], LAYOUT_NAME_SIZE);
+
+  size_t offset = LAYOUT_BLOB_HEADER;
+  for (int key = 0; key < LAYOUT_KEYS; ++key) {
+    if (offset >= len) {
+      return -1;
+    }
+
+    uint8_t cycleLen = blob[offset++];
+    if (cycleLen == 0 || cycleLen > LAYOUT_MAX_CYCLE || offset + 2 * cycleLen > len) {
+      return -1;
+    }
+
+    KeyCycle *cycle = &layout.keys[key];
+    cycle->len = cycleLen;
+    memcpy(cycle->lower, &blob[offset], cycleLen);
+    memcpy(cycle->upper, &blob[offset + cycleLen], cycleLen);
+    offset += 2 * cycleLen;
+
+    // Symbols end up in the message, a zero would end it
+    if (memchr(cycle->lower, 0, cycleLen) || memchr(cycle->upper, 0, cycleLen)) {
+      return -1;
+    }
+  }
+
+  if (offset != len) {
+    return -1;
+  }
+
+  uint8_t slot = 0;
+  while (slot < extraLayoutCount &&
+         memcmp(ExtraLayouts[slot].name, layout.name, LAYOUT_NAME_SIZE) != 0) {
+    slot++;
+  }
+
+  if (slot == LAYOUT_EXTRA_SLOTS) {
+    return -1;
+  }
+
+  ExtraLayouts[slot] = layout;
+  if (slot == extraLayoutCount) {
+    extraLayoutCount++;
+  }
+
+  return LAYOUT_BUILTIN + slot;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file Layout.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef LAYOUT_H
+#define LAYOUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Keys with a symbol cycle, the digit keys
+#define LAYOUT_KEYS 10
+
+// Longest symbol cycle of one key
+#define LAYOUT_MAX_CYCLE 8
+
+// Layout name length, shown in the header
+#define LAYOUT_NAME_SIZE 4
+
+// Layouts loaded from blobs kept next to the built-in ones
+#define LAYOUT_EXTRA_SLOTS 2
+
+// Layout blob header, magic, version and name
+#define LAYOUT_BLOB_MAGIC0 'K'
+#define LAYOUT_BLOB_MAGIC1 'L'
+#define LAYOUT_BLOB_VERSION 1
+#define LAYOUT_BLOB_HEADER (3 + LAYOUT_NAME_SIZE)
+
+/**
+ * @brief Enum values for built-in layouts.
+ * 
+ */
+typedef enum {
+  LAYOUT_ENGLISH, LAYOUT_CZECH, LAYOUT_SYMBOLS, LAYOUT_BUILTIN
+} LayoutId;
+
+/**
+ * @brief Structure for the symbol cycle of one key with its cycle
+ * length and the upper case variant of every symbol.
+ * 
+ */
+typedef struct {
+  uint8_t len;
+  char lower[LAYOUT_MAX_CYCLE];
+  char upper[LAYOUT_MAX_CYCLE];
+} KeyCycle;
+
+/**
+ * @brief Structure for a keymap of all digit keys.
+ * 
+ */
+typedef struct {
+  char name[LAYOUT_NAME_SIZE];
+  KeyCycle keys[LAYOUT_KEYS];
+} Layout;
+
+/**
+ * @brief Get the upper case variant of the code page char, ASCII,
+ * ISO 8859-2 and GSM letters, other chars are kept.
+ * 
+ * @param ch 
+ * @return char 
+ */
+constexpr char getUpperChar(char ch) {
+  uint8_t code = (uint8_t)ch;
+
+  if (code >= 'a' && code <= 'z') return (char)(code - 0x20);
+  if (code >= 0xE0 && code <= 0xFE && code != 0xF7) return (char)(code - 0x20);
+  if ((code >= 0xB1 && code <= 0xBF) && code != 0xB2 && code != 0xB4 &&
+      code != 0xB7 && code != 0xB8 && code != 0xBD) return (char)(code - 0x10);
+  if (code == 0x87 || code == 0x89 || code == 0x95 || code == 0x97) return (char)(code - 1);
+  return ch;
+}
+
+/**
+ * @brief Build the key cycle of the symbols at compile time, the
+ * cycle must fit the longest cycle.
+ * 
+ * @tparam N symbols length with the terminator
+ * @param symbols 
+ * @return KeyCycle 
+ */
+template <size_t N>
+constexpr KeyCycle makeKeyCycle(const char (&symbols)[N]) {
+  static_assert(N > 1 && N - 1 <= LAYOUT_MAX_CYCLE, "key cycle does not fit LAYOUT_MAX_CYCLE");
+
+  KeyCycle cycle = {(uint8_t)(N - 1), {}, {}};
+  for (size_t idx = 0; idx < N - 1; ++idx) {
+    cycle.lower[idx] = symbols[idx];
+    cycle.upper[idx] = getUpperChar(symbols[idx]);
+  }
+  return cycle;
+}
+
+/**
+ * @brief Build the layout of the key cycles of all digit keys
+ * at compile time.
+ * 
+ * @tparam N name length with the terminator
+ * @tparam S symbols lengths of the keys
+ * @param name 
+ * @param symbols 
+ * @return Layout 
+ */
+template <size_t N, size_t... S>
+constexpr Layout makeLayout(const char (&name)[N], const char (&...symbols)[S]) {
+  static_assert(N - 1 <= LAYOUT_NAME_SIZE, "layout name does not fit LAYOUT_NAME_SIZE");
+  static_assert(sizeof...(S) == LAYOUT_KEYS, "layout needs a cycle of every digit key");
+
+  Layout layout = {{}, {makeKeyCycle(symbols)...}};
+  for (size_t idx = 0; idx < N - 1; ++idx) {
+    layout.name[idx] = name[idx];
+  }
+  return layout;
+}
+
+/**
+ * @brief Get the number of selectable layouts, built-in and loaded.
+ * 
+ * @return uint8_t 
+ */
+uint8_t getLayoutCount();
+
+/**
+ * @brief Get the layout of the index.
+ * 
+ * @param index 
+ * @return const Layout* 
+ */
+const Layout *getLayout(uint8_t index);
+
+/**
+ * @brief Load a layout from the blob into a free extra slot.
+ * 
+ * @param blob 
+ * @param len 
+ * @return int 
+ */
+int loadLayout(const uint8_t *blob, size_t len);
+
+#endif
@@ -0,0 +1,889 @@
+/**
+ * @file Link.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Link.h"
+#include "Display.h"
+#include "Keypad.h"
+#include "Mirror.h"
+#include "Editor.h"
+#include "Fuzz.h"
+#include "Power.h"
+#include "CodePage.h"
+#include "Buffer.h"
+#include "Phonebook.h"
+#include "History.h"
+#include "Index.h"
+#include "Codec.h"
+#include "Flow.h"
+#include "Latency.h"
+#include "Memory.h"
+#include "Spell.h"
+#include "Bench.h"
+
+// Frame parser state
+LinkState linkState = LINK_WAIT_STX;
+
+// Received frame
+uint8_t frameCmd = 0;
+uint8_t frameLen = 0;
+uint8_t framePos = 0;
+uint8_t frameSum = 0;
+uint8_t framePayload[LINK_MAX_PAYLOAD];
+
+// Time of the frame start
+uint64_t frameStartTime = 0;
+
+// History query of the find command, the list query is not touched
+MessageQuery linkQuery;
+
+/**
+ * @brief Start the serial communication.
+ * 
+ */
+void initLink() {
+  Serial.setRxBufferSize(LINK_RX_BUFFER_SIZE);
+  Serial.begin(LINK_BAUD);
+}
+
+/**
+ * @brief Write the uint32_t value in little endian.
+ * 
+ * @param dst 
+ * @param value 
+ */
+void putUint32(uint8_t *dst, uint32_t value) {
+  for (int idx = 0; idx < 4; ++idx) {
+    dst[idx] = (value >> (8 * idx)) & 0xFF;
+  }
+}
+
+/**
+ * @brief Read the uint32_t value in little endian.
+ * 
+ * @param src 
+ * @return uint32_t 
+ */
+uint32_t getUint32(const uint8_t *src) {
+  uint32_t value = 0;
+  for (int idx = 0; idx < 4; ++idx) {
+    value |= (uint32_t)src[idx] << (8 * idx);
+  }
+  return value;
+}
+
+/**
+ * @brief Send the frame with start byte, command, payload length,
+ * payload and XOR checksum of command, length and payload.
+ * 
+ * @param cmd 
+ * @param payload 
+ * @param len 
+ */
+void sendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len) {
+  uint8_t header[3] = {LINK_STX, cmd, len};
+  uint8_t sum = cmd ^ len;
+
+  for (int idx = 0; idx < len; ++idx) {
+    sum ^= payload[idx];
+  }
+
+  Serial.write(header, sizeof(header));
+  Serial.write(payload, len);
+  Serial.write(sum);
+}
+
+/**
+ * @brief Insert the frame UTF-8 text on bufferIndex, batched or per
+ * key, and reply with the inserted count and insert time in us.
+ * 
+ * @param editor 
+ */
+void handleInsertFrame(Editor *editor) {
+  uint32_t startTime = micros();
+
+  char text[LINK_MAX_PAYLOAD];
+  size_t len = decodeUtf8(framePayload, frameLen, text, sizeof(text));
+  uint8_t inserted = handleText(editor, text, len, frameCmd == CMD_INSERT, editor->now);
+  drawHeader(editor);
+
+  uint8_t reply[5];
+  reply[0] = inserted;
+  putUint32(&reply[1], micros() - startTime);
+  sendFrame(REPLY_INSERT, reply, sizeof(reply));
+}
+
+/**
+ * @brief Inject the key press, long press hold or release after hold
+ * and reply with the handling time, flush count, flush time and the
+ * cursor index after the key.
+ * 
+ * @param editor 
+ */
+void handleKeyFrame(Editor *editor) {
+  if (frameLen != 2 || framePayload[0] > KEY_H || framePayload[1] > KEY_ACTION_RELEASE) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  Key key = (Key)framePayload[0];
+  FrameStats before = getFrameStats();
+  uint32_t startTime = micros();
+
+  switch (framePayload[1]) {
+    case KEY_ACTION_PRESS:
+      handlePress(editor, key);
+      break;
+
+    case KEY_ACTION_HOLD:
+      handleLongPress(editor, key, editor->now);
+      break;
+
+    case KEY_ACTION_RELEASE:
+      handleLongRelease(editor, key, editor->now);
+      break;
+  }
+
+  uint32_t elapsed = micros() - startTime;
+  FrameStats after = getFrameStats();
+
+  uint8_t reply[11];
+  putUint32(&reply[0], elapsed);
+  reply[4] = (after.flushes - before.flushes) & 0xFF;
+  reply[5] = (after.flushes - before.flushes) >> 8;
+  putUint32(&reply[6], after.flushTime - before.flushTime);
+  reply[10] = editor->bufferIndex;
+  sendFrame(REPLY_KEY, reply, sizeof(reply));
+}
+
+/**
+ * @brief Run the fuzz sequence of the seed on the fuzz editor and
+ * reply with executed steps, failing step, check, key, action and
+ * run time in us.
+ * 
+ */
+void handleFuzzFrame() {
+  if (frameLen != 6) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  uint32_t seed = getUint32(&framePayload[0]);
+  uint16_t steps = framePayload[4] | (framePayload[5] << 8);
+  FuzzResult result = runFuzz(seed, steps);
+
+  uint8_t reply[11];
+  reply[0] = result.steps & 0xFF;
+  reply[1] = result.steps >> 8;
+  reply[2] = result.failStep & 0xFF;
+  reply[3] = result.failStep >> 8;
+  reply[4] = result.check;
+  reply[5] = result.key;
+  reply[6] = result.action;
+  putUint32(&reply[7], result.time);
+  sendFrame(REPLY_FUZZ, reply, sizeof(reply));
+}
+
+/**
+ * @brief Reply with the light sleep count, keypad, link and lost
+ * keypad wakeups, sleep time and active time in ms.
+ * 
+ */
+void handlePowerFrame() {
+  PowerStats stats = getPowerStats();
+
+  uint8_t reply[24];
+  putUint32(&reply[0], stats.sleeps);
+  putUint32(&reply[4], stats.keyWakeups);
+  putUint32(&reply[8], stats.linkWakeups);
+  putUint32(&reply[12], stats.lostWakeups);
+  putUint32(&reply[16], stats.sleepTime);
+  putUint32(&reply[20], stats.activeTime);
+  sendFrame(REPLY_POWER, reply, sizeof(reply));
+}
+
+/**
+ * @brief Reply with the scan count, scan time in ms, press count,
+ * average and max input latency in us of the fast and slow scan rate.
+ * 
+ */
+void handleScanFrame() {
+  uint8_t reply[5 * 4 * SCAN_RATES];
+
+  for (int rate = 0; rate < SCAN_RATES; ++rate) {
+    ScanStats stats = getScanStats((ScanRate)rate);
+    uint8_t *dst = &reply[rate * 5 * 4];
+
+    putUint32(&dst[0], stats.scans);
+    putUint32(&dst[4], stats.time / 1000);
+    putUint32(&dst[8], stats.presses);
+    putUint32(&dst[12], stats.presses > 0 ? stats.totalLatency / stats.presses : 0);
+    putUint32(&dst[16], stats.maxLatency);
+  }
+
+  sendFrame(REPLY_SCAN, reply, sizeof(reply));
+}
+
+/**
+ * @brief Run the key matrix samples of the frame through a fresh
+ * debouncer and reply with the debounced matrix after every sample,
+ * the device keypad is not touched.
+ * 
+ */
+void handleDebounceFrame() {
+  if (frameLen % 2 != 0) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  Debouncer debouncer;
+  resetDebouncer(&debouncer);
+
+  uint8_t reply[LINK_MAX_PAYLOAD];
+  for (int idx = 0; idx < frameLen; idx += 2) {
+    debounceKeys(&debouncer, framePayload[idx] | (framePayload[idx + 1] << 8));
+    reply[idx] = debouncer.state & 0xFF;
+    reply[idx + 1] = debouncer.state >> 8;
+  }
+
+  sendFrame(REPLY_DEBOUNCE, reply, frameLen);
+}
+
+/**
+ * @brief Select the layout of the index byte or load the layout blob
+ * and select it, then reply with the selected index and the names of
+ * all layouts, without payload only reply.
+ * 
+ * @param editor 
+ */
+void handleLayoutFrame(Editor *editor) {
+  bool selected = true;
+
+  if (frameLen == 1) {
+    selected = selectLayout(editor, framePayload[0]);
+  }
+  else if (frameLen > 1) {
+    int index = loadLayout(framePayload, frameLen);
+    selected = index >= 0 && selectLayout(editor, index);
+  }
+
+  if (!selected) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  drawHeader(editor);
+
+  uint8_t reply[2 + (LAYOUT_BUILTIN + LAYOUT_EXTRA_SLOTS) * LAYOUT_NAME_SIZE];
+  uint8_t count = getLayoutCount();
+  reply[0] = editor->layoutIndex;
+  reply[1] = count;
+  for (uint8_t idx = 0; idx < count; ++idx) {
+    memcpy(&reply[2 + idx * LAYOUT_NAME_SIZE], getLayout(idx)->name, LAYOUT_NAME_SIZE);
+  }
+  sendFrame(REPLY_LAYOUT, reply, 2 + count * LAYOUT_NAME_SIZE);
+}
+
+/**
+ * @brief Reply with a chunk of the message in UTF-8 from the char
+ * offset, of the last sent message in UCS-2 or of its recipient
+ * number from the byte offset, with the total length and the offset
+ * of the next chunk. Reading the sent message ends the wait of the
+ * send flow.
+ * 
+ * @param editor 
+ */
+void handleTextFrame(Editor *editor) {
+  if (frameLen != 3) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  uint16_t offset = framePayload[1] | (framePayload[2] << 8);
+  uint8_t reply[LINK_MAX_PAYLOAD];
+  size_t size = 4;
+  size_t total;
+
+  if (framePayload[0] == TEXT_MESSAGE) {
+    total = getBufferLen(editor);
+
+    while (offset < total && size + 3 <= sizeof(reply)) {
+      size += encodeUtf8Char(getBufferCharByIndex(editor, offset++), &reply[size]);
+    }
+  }
+  else if (framePayload[0] == TEXT_RECIPIENT) {
+    const char *number = getSentRecipient(editor);
+    total = strlen(number);
+
+    while (offset < total && size < sizeof(reply)) {
+      reply[size++] = number[offset++];
+    }
+  }
+  else {
+    // The host reading the sent message is the transport taking it
+    const uint8_t *sent = getSentMessage(editor, &total);
+    signalFlowEvent(&editor->timers, FLOW_EVENT_SENT);
+
+    while (offset < total && size < sizeof(reply)) {
+      reply[size++] = sent[offset++];
+    }
+  }
+
+  reply[0] = total & 0xFF;
+  reply[1] = total >> 8;
+  reply[2] = offset & 0xFF;
+  reply[3] = offset >> 8;
+  sendFrame(REPLY_TEXT, reply, size);
+}
+
+/**
+ * @brief Write the chunk of a phonebook blob at the offset, without
+ * payload open the written phonebook, reply with the contact count,
+ * index entry count and blob size of the opened phonebook.
+ * 
+ * @param editor 
+ */
+void handlePhonebookFrame(Editor *editor) {
+  bool done;
+
+  // The search ranges of the picker point into the old index
+  if (editor->pickerVisible) {
+    closePicker(editor, editor->now);
+    drawHeader(editor);
+  }
+
+  if (frameLen == 0) {
+    done = commitPhonebook();
+  }
+  else {
+    done = frameLen > 4 && writePhonebook(getUint32(framePayload), &framePayload[4], frameLen - 4);
+  }
+
+  if (!done) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  uint8_t reply[12];
+  putUint32(&reply[0], getContactCount());
+  putUint32(&reply[4], getEntryCount());
+  putUint32(&reply[8], getPhonebookSize());
+  sendFrame(REPLY_PHONEBOOK, reply, sizeof(reply));
+}
+
+/**
+ * @brief Search the phonebook digit by digit like typed in the
+ * recipient picker and reply with the match count, the total
+ * search time and the slowest digit time in us, then the first
+ * match as name and number length followed by both.
+ * 
+ */
+void handleQueryFrame() {
+  PhonebookSearch search;
+  uint32_t startTime = micros();
+  uint32_t maxTime = 0;
+  uint32_t count;
+
+  resetSearch(&search);
+  count = getSearchCount(&search);
+
+  for (uint8_t idx = 0; idx < frameLen; ++idx) {
+    uint32_t digitTime = micros();
+    count = pushSearchDigit(&search, framePayload[idx]);
+    digitTime = micros() - digitTime;
+    if (digitTime > maxTime) maxTime = digitTime;
+  }
+
+  uint32_t searchTime = micros() - startTime;
+  uint8_t reply[LINK_MAX_PAYLOAD];
+  size_t size = 12;
+  putUint32(&reply[0], count);
+  putUint32(&reply[4], searchTime);
+  putUint32(&reply[8], maxTime);
+
+  Contact contact;
+  if (getSearchContact(&search, 0, &contact) && size + 2 + contact.nameLen + contact.numberLen <= sizeof(reply)) {
+    reply[size++] = contact.nameLen;
+    reply[size++] = contact.numberLen;
+    memcpy(&reply[size], contact.name, contact.nameLen);
+    size += contact.nameLen;
+    memcpy(&reply[size], contact.number, contact.numberLen);
+    size += contact.numberLen;
+  }
+  sendFrame(REPLY_QUERY, reply, size);
+}
+
+/**
+ * @brief Store the message of the flags, number of the other side
+ * and UTF-8 text in the history and reply with its id, the history
+ * count, free slabs, evictions and the store time in us. The open
+ * history list is closed, the store may drop its messages.
+ * 
+ * @param editor 
+ */
+void handleMessageFrame(Editor *editor) {
+  if (frameLen < 2 || 2 + framePayload[1] > frameLen) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  if (editor->historyVisible) {
+    closeHistory(editor, editor->now);
+    drawHeader(editor);
+  }
+
+  uint8_t peerLen = framePayload[1];
+  char text[LINK_MAX_PAYLOAD];
+  size_t len = decodeUtf8(&framePayload[2 + peerLen], frameLen - 2 - peerLen, text, MESSAGE_SIZE);
+
+  uint32_t startTime = micros();
+  uint16_t id = addHistory(framePayload[0], (const char *)&framePayload[2], peerLen, text, len);
+  uint32_t storeTime = micros() - startTime;
+
+  HistoryStats stats = getHistoryStats();
+  uint8_t reply[14];
+  reply[0] = id & 0xFF;
+  reply[1] = id >> 8;
+  reply[2] = stats.count & 0xFF;
+  reply[3] = stats.count >> 8;
+  reply[4] = stats.freeSlabs & 0xFF;
+  reply[5] = stats.freeSlabs >> 8;
+  putUint32(&reply[6], stats.evictions);
+  putUint32(&reply[10], storeTime);
+  sendFrame(REPLY_MESSAGE, reply, sizeof(reply));
+}
+
+/**
+ * @brief Search the history for the UTF-8 query words and reply with
+ * the match count, the search time in us, the newest matching
+ * message id and the index usage.
+ * 
+ */
+void handleFindFrame() {
+  linkQuery.len = decodeUtf8(framePayload, frameLen, linkQuery.text, INDEX_QUERY_SIZE);
+
+  uint32_t startTime = micros();
+  uint16_t count = findMessages(&linkQuery);
+  uint32_t findTime = micros() - startTime;
+
+  uint16_t newest = getHistoryNewest();
+  while (newest != HISTORY_NONE && count > 0 && !isMessageFound(&linkQuery, newest)) {
+    newest = getHistoryEntry(newest)->older;
+  }
+  if (count == 0) newest = HISTORY_NONE;
+
+  IndexStats stats = getIndexStats();
+  uint8_t reply[18];
+  reply[0] = count & 0xFF;
+  reply[1] = count >> 8;
+  putUint32(&reply[2], findTime);
+  reply[6] = newest & 0xFF;
+  reply[7] = newest >> 8;
+  reply[8] = stats.terms & 0xFF;
+  reply[9] = stats.terms >> 8;
+  reply[10] = stats.freeBlocks & 0xFF;
+  reply[11] = stats.freeBlocks >> 8;
+  putUint32(&reply[12], stats.postings);
+  reply[16] = stats.unindexed & 0xFF;
+  reply[17] = stats.unindexed >> 8;
+  sendFrame(REPLY_FIND, reply, sizeof(reply));
+}
+
+/**
+ * @brief Get the next packed byte of the codec benchmark buffer.
+ * 
+ * @param context pointer to the next byte pointer
+ * @return uint8_t 
+ */
+uint8_t fetchLinkByte(void *context) {
+  const uint8_t **next = (const uint8_t **)context;
+  return *(*next)++;
+}
+
+/**
+ * @brief Pack the UTF-8 text by the message codec and decode it back,
+ * reply with its chars, packed bytes, whether the round trip matched,
+ * the time of CODEC_BENCH_ROUNDS encodes and decodes in us and the
+ * history text chars with their stored bytes.
+ * 
+ */
+void handleCodecFrame() {
+  char text[LINK_MAX_PAYLOAD];
+  uint8_t len = decodeUtf8(framePayload, frameLen, text, MESSAGE_SIZE);
+  uint8_t packed[MESSAGE_SIZE];
+  uint8_t size = 0;
+
+  uint32_t startTime = micros();
+  for (uint8_t round = 0; round < CODEC_BENCH_ROUNDS; ++round) {
+    size = encodeMessage(text, len, packed, sizeof(packed));
+  }
+  uint32_t encodeTime = micros() - startTime;
+
+  char decoded[MESSAGE_SIZE];
+  uint32_t decodeTime = 0;
+  bool isMatch = false;
+  if (size > 0) {
+    startTime = micros();
+    for (uint8_t round = 0; round < CODEC_BENCH_ROUNDS; ++round) {
+      const uint8_t *next = packed;
+      CodecReader reader;
+      openCodecReader(&reader, fetchLinkByte, &next, len);
+      readCodec(&reader, decoded, len);
+    }
+    decodeTime = micros() - startTime;
+    isMatch = memcmp(decoded, text, len) == 0;
+  }
+
+  HistoryStats stats = getHistoryStats();
+  uint8_t reply[19];
+  reply[0] = len;
+  reply[1] = size;
+  reply[2] = isMatch;
+  putUint32(&reply[3], encodeTime);
+  putUint32(&reply[7], decodeTime);
+  putUint32(&reply[11], stats.chars);
+  putUint32(&reply[15], stats.bytes);
+  sendFrame(REPLY_CODEC, reply, sizeof(reply));
+}
+
+/**
+ * @brief Watchdog hook of the input step, send the stall frame with
+ * the step time, its cause and the time of every part in us.
+ * 
+ * @param sample 
+ */
+void sendStallFrame(const LoopSample *sample) {
+  uint8_t reply[5 + LOOP_PHASES * 4];
+  putUint32(&reply[0], sample->time);
+  reply[4] = sample->cause;
+  for (uint8_t phase = 0; phase < LOOP_PHASES; ++phase) {
+    putUint32(&reply[5 + phase * 4], sample->phases[phase]);
+  }
+  sendFrame(REPLY_STALL, reply, sizeof(reply));
+}
+
+/**
+ * @brief Set the stall reports by the optional flags and watchdog
+ * threshold in us, reply with the budget, threshold, timed steps,
+ * budget violations in total and by cause, the longest step and the
+ * step time histogram, the report is cleared after the reply if
+ * asked for.
+ * 
+ */
+void handleLatencyFrame() {
+  uint8_t flags = frameLen > 0 ? framePayload[0] : 0;
+
+  if (frameLen > 0) {
+    uint32_t threshold = frameLen >= 5 ? getUint32(&framePayload[1]) : getLoopWatchdogThreshold();
+    setLoopWatchdog(threshold, (flags & LATENCY_WATCH) ? sendStallFrame : NULL);
+  }
+
+  const LoopStats *stats = getLoopStats();
+  uint8_t reply[(5 + LOOP_PHASES + LOOP_BUCKETS) * 4];
+  putUint32(&reply[0], LOOP_BUDGET);
+  putUint32(&reply[4], getLoopWatchdogThreshold());
+  putUint32(&reply[8], stats->steps);
+  putUint32(&reply[12], stats->violations);
+  putUint32(&reply[16], stats->maxTime);
+  for (uint8_t phase = 0; phase < LOOP_PHASES; ++phase) {
+    putUint32(&reply[20 + phase * 4], stats->causes[phase]);
+  }
+  for (uint8_t bucket = 0; bucket < LOOP_BUCKETS; ++bucket) {
+    putUint32(&reply[20 + (LOOP_PHASES + bucket) * 4], stats->buckets[bucket]);
+  }
+  sendFrame(REPLY_LATENCY, reply, sizeof(reply));
+
+  if (flags & LATENCY_RESET) {
+    resetLoopStats();
+  }
+}
+
+/**
+ * @brief Reply with the free heap, least free heap, largest free
+ * block, least free stack of the input and render task and the size,
+ * used and peak bytes of every arena.
+ * 
+ * @param editor 
+ */
+void handleMemoryFrame(Editor *editor) {
+  MemoryHeap heap = getMemoryHeap();
+  MemoryArena arenas[ARENAS];
+  getMemoryArenas(editor, arenas);
+
+  uint8_t reply[(5 + ARENAS * 3) * 4];
+  putUint32(&reply[0], heap.freeHeap);
+  putUint32(&reply[4], heap.minFreeHeap);
+  putUint32(&reply[8], heap.largestBlock);
+  putUint32(&reply[12], heap.inputStackFree);
+  putUint32(&reply[16], heap.renderStackFree);
+  for (uint8_t arena = 0; arena < ARENAS; ++arena) {
+    putUint32(&reply[20 + arena * 12], arenas[arena].size);
+    putUint32(&reply[24 + arena * 12], arenas[arena].used);
+    putUint32(&reply[28 + arena * 12], arenas[arena].peak);
+  }
+  sendFrame(REPLY_MEMORY, reply, sizeof(reply));
+}
+
+/**
+ * @brief Look up every word of the UTF-8 text in the spell dictionary,
+ * reply with the word count, unknown word count, the time of
+ * SPELL_BENCH_ROUNDS lookups of all words in us, the filter bytes,
+ * hash count and a bitmap of the unknown words.
+ * 
+ */
+void handleSpellFrame() {
+  char text[LINK_MAX_PAYLOAD];
+  uint8_t len = decodeUtf8(framePayload, frameLen, text, sizeof(text));
+  uint8_t starts[LINK_MAX_PAYLOAD / 2 + 1];
+  uint8_t lens[LINK_MAX_PAYLOAD / 2 + 1];
+  uint8_t words = 0;
+
+  // Split the text into the words checked while typing
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    if (isSpellChar(text[idx]) && (idx == 0 || !isSpellChar(text[idx - 1]))) {
+      starts[words] = idx;
+      lens[words] = 0;
+      words++;
+    }
+    if (isSpellChar(text[idx])) lens[words - 1]++;
+  }
+
+  uint8_t reply[11 + (LINK_MAX_PAYLOAD / 2 + 8) / 8];
+  memset(reply, 0, sizeof(reply));
+  uint8_t unknown = 0;
+
+  uint32_t startTime = micros();
+  for (uint8_t round = 0; round < SPELL_BENCH_ROUNDS; ++round) {
+    for (uint8_t word = 0; word < words; ++word) {
+      if (lens[word] <= SPELL_WORD_SIZE && !isSpellWord(&text[starts[word]], lens[word]) && round == 0) {
+        reply[11 + word / 8] |= 1 << (word % 8);
+        unknown++;
+      }
+    }
+  }
+  uint32_t lookupTime = micros() - startTime;
+
+  reply[0] = words;
+  reply[1] = unknown;
+  putUint32(&reply[2], lookupTime);
+  putUint32(&reply[6], SPELL_FILTER_BYTES);
+  reply[10] = SPELL_HASHES;
+  sendFrame(REPLY_SPELL, reply, 11 + (words + 7) / 8);
+}
+
+/**
+ * @brief Time the primitive of the frame on the fuzz editor, the
+ * payload is the case, message length, cursor index and iteration
+ * count (u16), reply with the iterations (u16) and their time in us.
+ * 
+ */
+void handleBenchFrame() {
+  if (frameLen != 5) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  uint16_t iterations = framePayload[3] | (framePayload[4] << 8);
+  BenchResult result = runBench((BenchCase)framePayload[0], framePayload[1], framePayload[2], iterations);
+  if (result.iterations == 0) {
+    sendFrame(REPLY_NAK, &frameCmd, 1);
+    return;
+  }
+
+  uint8_t reply[6];
+  reply[0] = result.iterations & 0xFF;
+  reply[1] = result.iterations >> 8;
+  putUint32(&reply[2], result.time);
+  sendFrame(REPLY_BENCH, reply, sizeof(reply));
+}
+
+/**
+ * @brief Call the handler for received frame command, every frame
+ * restarts the editor idle delay.
+ * 
+ * @param editor 
+ */
+void handleFrame(Editor *editor) {
+  touchEditor(editor);
+
+  switch (frameCmd) {
+    // Text insert
+    case CMD_INSERT:
+    case CMD_KEYS:
+      handleInsertFrame(editor);
+      break;
+
+    // Clear message
+    case CMD_CLEAR:
+      clearMessage(editor);
+      refreshMessage(editor, editor->now);
+      drawHeader(editor);
+      sendFrame(REPLY_ACK, &frameCmd, 1);
+      break;
+
+    // Start or stop the framebuffer mirror
+    case CMD_MIRROR:
+      setMirror(frameLen > 0 && framePayload[0] != 0);
+      sendFrame(REPLY_ACK, &frameCmd, 1);
+      flushDisplay(editor);
+      break;
+
+    // Inject key
+    case CMD_KEY:
+      handleKeyFrame(editor);
+      break;
+
+    // Run fuzz sequence
+    case CMD_FUZZ:
+      handleFuzzFrame();
+      break;
+
+    // Keypad scan statistics
+    case CMD_SCAN:
+      handleScanFrame();
+      break;
+
+    // Debounce synthetic key samples
+    case CMD_DEBOUNCE:
+      handleDebounceFrame();
+      break;
+
+    // Select or load keypad layout
+    case CMD_LAYOUT:
+      handleLayoutFrame(editor);
+      break;
+
+    // Read message or sent message text
+    case CMD_TEXT:
+      handleTextFrame(editor);
+      break;
+
+    // Write or open phonebook
+    case CMD_PHONEBOOK:
+      handlePhonebookFrame(editor);
+      break;
+
+    // Store message in history
+    case CMD_MESSAGE:
+      handleMessageFrame(editor);
+      break;
+
+    // Search message history
+    case CMD_FIND:
+      handleFindFrame();
+      break;
+
+    // Benchmark message codec
+    case CMD_CODEC:
+      handleCodecFrame();
+      break;
+
+    // Input step latency report
+    case CMD_LATENCY:
+      handleLatencyFrame();
+      break;
+
+    // Heap, stack and arena usage
+    case CMD_MEMORY:
+      handleMemoryFrame(editor);
+      break;
+
+    // Spell dictionary lookup
+    case CMD_SPELL:
+      handleSpellFrame();
+      break;
+
+    // Primitive microbenchmark
+    case CMD_BENCH:
+      handleBenchFrame();
+      break;
+
+    // Search phonebook
+    case CMD_QUERY:
+      handleQueryFrame();
+      break;
+
+    // Light sleep statistics
+    case CMD_POWER:
+      handlePowerFrame();
+      break;
+
+    // Send the framebuffer
+    case CMD_SNAPSHOT:
+      snapshotDisplay(editor);
+      sendFrame(REPLY_ACK, &frameCmd, 1);
+      break;
+
+    // Unknown command
+    default:
+      sendFrame(REPLY_NAK, &frameCmd, 1);
+      break;
+  }
+}
+
+/**
+ * @brief Read all available bytes through the frame parser, frames
+ * with wrong checksum are rejected by NAK, unfinished frames
+ * are dropped after timeout.
+ * 
+ * @param editor 
+ */
+void pollLink(Editor *editor) {
+  if (linkState != LINK_WAIT_STX && editor->now - frameStartTime > LINK_TIMEOUT) {
+    linkState = LINK_WAIT_STX;
+  }
+
+  while (Serial.available() > 0) {
+    uint8_t value = Serial.read();
+
+    switch (linkState) {
+      case LINK_WAIT_STX:
+        if (value == LINK_STX) {
+          frameStartTime = editor->now;
+          linkState = LINK_WAIT_CMD;
+        }
+        break;
+
+      case LINK_WAIT_CMD:
+        frameCmd = value;
+        frameSum = value;
+        linkState = LINK_WAIT_LEN;
+        break;
+
+      case LINK_WAIT_LEN:
+        frameLen = value;
+        framePos = 0;
+        frameSum ^= value;
+        linkState = frameLen > 0 ? LINK_WAIT_DATA : LINK_WAIT_SUM;
+        break;
+
+      case LINK_WAIT_DATA:
+        framePayload[framePos++] = value;
+        frameSum ^= value;
+        if (framePos == frameLen) linkState = LINK_WAIT_SUM;
+        break;
+
+      case LINK_WAIT_SUM:
+        if (value == frameSum) {
+          handleFrame(editor);
+        }
+        else {
+          sendFrame(REPLY_NAK, &frameCmd, 1);
+        }
+        linkState = LINK_WAIT_STX;
+        break;
+    }
+  }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file Link.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdint.h>
+
+// Serial link speed
+#define LINK_BAUD 921600
+
+// Frame start byte
+#define LINK_STX 0x02
+
+// Max frame payload length
+#define LINK_MAX_PAYLOAD 255
+
+// Frame bytes besides payload
+#define LINK_FRAME_OVERHEAD 4
+
+// Timeout for unfinished frame
+#define LINK_TIMEOUT 100
+
+// Serial receive buffer, holds the bytes coming while input sleeps
+#define LINK_RX_BUFFER_SIZE 1024
+
+// Frame commands from host
+#define CMD_INSERT 'I'
+#define CMD_KEYS   'K'
+#define CMD_CLEAR  'C'
+#define CMD_MIRROR 'M'
+#define CMD_KEY    'Y'
+#define CMD_SNAPSHOT 'P'
+#define CMD_FUZZ   'Z'
+#define CMD_POWER  'W'
+#define CMD_SCAN   'S'
+#define CMD_DEBOUNCE 'B'
+#define CMD_LAYOUT 'L'
+#define CMD_TEXT   'T'
+#define CMD_PHONEBOOK 'D'
+#define CMD_QUERY  'Q'
+#define CMD_MESSAGE 'R'
+#define CMD_FIND   'G'
+#define CMD_CODEC  'J'
+#define CMD_LATENCY 'H'
+#define CMD_MEMORY 'U'
+#define CMD_SPELL  'V'
+#define CMD_BENCH  'O'
+
+// Frame replies to host
+#define REPLY_ACK    'A'
+#define REPLY_INSERT 'i'
+#define REPLY_KEY    'y'
+#define REPLY_NAK    'N'
+#define REPLY_FUZZ   'z'
+#define REPLY_POWER  'w'
+#define REPLY_SCAN   's'
+#define REPLY_DEBOUNCE 'b'
+#define REPLY_LAYOUT 'l'
+#define REPLY_TEXT   't'
+#define REPLY_PHONEBOOK 'd'
+#define REPLY_QUERY  'q'
+#define REPLY_MESSAGE 'r'
+#define REPLY_FIND   'g'
+#define REPLY_CODEC  'j'
+#define REPLY_LATENCY 'h'
+#define REPLY_MEMORY 'u'
+#define REPLY_SPELL  'v'
+#define REPLY_BENCH  'o'
+#define REPLY_MIRROR_SPAN 'F'
+#define REPLY_MIRROR_END  'E'
+#define REPLY_STALL  'X'
+
+// Latency frame flags, clear the report after the reply and send
+// a stall frame for every step over the watchdog threshold
+#define LATENCY_RESET 0x01
+#define LATENCY_WATCH 0x02
+
+/**
+ * @brief Enum values for injected key action.
+ * 
+ */
+typedef enum {
+  KEY_ACTION_PRESS, KEY_ACTION_HOLD, KEY_ACTION_RELEASE
+} KeyAction;
+
+/**
+ * @brief Enum values for text read by the host.
+ * 
+ */
+typedef enum {
+  TEXT_MESSAGE, TEXT_SENT, TEXT_RECIPIENT
+} TextSource;
+
+/**
+ * @brief Enum values for frame parser state.
+ * 
+ */
+typedef enum {
+  LINK_WAIT_STX, LINK_WAIT_CMD, LINK_WAIT_LEN, LINK_WAIT_DATA, LINK_WAIT_SUM
+} LinkState;
+
+struct Editor;
+
+/**
+ * @brief Start the serial link.
+ * 
+ */
+void initLink();
+
+/**
+ * @brief Read the available serial bytes and handle complete frames.
+ * 
+ * @param editor 
+ */
+void pollLink(Editor *editor);
+
+/**
+ * @brief Write the value in little endian.
+ * 
+ * @param dst 
+ * @param value 
+ */
+void putUint32(uint8_t *dst, uint32_t value);
+
+/**
+ * @brief Read the value in little endian.
+ * 
+ * @param src 
+ * @return uint32_t 
+ */
+uint32_t getUint32(const uint8_t *src);
+
+/**
+ * @brief Send the frame to host.
+ * 
+ * @param cmd 
+ * @param payload 
+ * @param len 
+ */
+void sendFrame(uint8_t cmd, const uint8_t *payload, uint8_t len);
+
+#endif
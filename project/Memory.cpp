@@ -0,0 +1,34 @@
+/**
+ * @file Memory.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+#include <stdint.h>
+
+#include "Memory.h"
+#include "Render.h"
+
+/**
+ * @brief Get the 8-bit heap usage and the stack high water marks of
+ * the tasks.
+ * 
+ * @return MemoryHeap 
+ */
+MemoryHeap getMemoryHeap() {
+  MemoryHeap heap;
+  heap.freeHeap = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  heap.minFreeHeap = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  heap.largestBlock = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  heap.inputStackFree = getInputStackFree();
+  heap.renderStackFree = getRenderStackFree();
+  return heap;
+}
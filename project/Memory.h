@@ -0,0 +1,75 @@
+/**
+ * @file Memory.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <stdint.h>
+
+struct Editor;
+
+/**
+ * @brief Enum values for the fixed arenas and pools, all taken at
+ * boot and never returned to the heap.
+ * 
+ */
+typedef enum {
+  ARENA_MESSAGE,
+  ARENA_UNDO,
+  ARENA_HISTORY_SLABS,
+  ARENA_HISTORY_ENTRIES,
+  ARENA_INDEX_TERMS,
+  ARENA_INDEX_BLOCKS,
+  ARENA_FLOW_FRAMES,
+  ARENAS
+} MemoryArenaId;
+
+/**
+ * @brief Structure for the usage of one arena in bytes, its size,
+ * the bytes used now and the most ever used.
+ * 
+ */
+typedef struct {
+  uint32_t size;
+  uint32_t used;
+  uint32_t peak;
+} MemoryArena;
+
+/**
+ * @brief Structure for the heap and task stack report in bytes, the
+ * free heap, its least free since boot, the largest free block and
+ * the least free stack of the input and render task.
+ * 
+ */
+typedef struct {
+  uint32_t freeHeap;
+  uint32_t minFreeHeap;
+  uint32_t largestBlock;
+  uint32_t inputStackFree;
+  uint32_t renderStackFree;
+} MemoryHeap;
+
+/**
+ * @brief Get the usage of every arena.
+ * 
+ * @param editor 
+ * @param arenas 
+ */
+void getMemoryArenas(Editor *editor, MemoryArena *arenas);
+
+/**
+ * @brief Get the heap and task stack report.
+ * 
+ * @return MemoryHeap 
+ */
+MemoryHeap getMemoryHeap();
+
+#endif
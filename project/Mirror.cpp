@@ -0,0 +1,213 @@
+/**
+ * @file Mirror.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Mirror.h"
+#include "Link.h"
+
+// Mirroring enabled flag
+bool mirrorEnabled = false;
+
+// Copy of the last mirrored frame
+uint8_t MirrorShadow[MIRROR_SIZE];
+
+// Mirrored frame sequence number
+uint16_t mirrorSeq = 0;
+
+// Frames left to the next keyframe
+uint16_t framesToKeyframe = 0;
+
+// Mirror statistics
+MirrorStats mirrorStats = {0, 0, 0, 0};
+
+/**
+ * @brief Enable or disable the mirroring, the first frame after
+ * enabling is always keyframe.
+ * 
+ * @param enabled 
+ */
+void setMirror(bool enabled) {
+  mirrorEnabled = enabled;
+  framesToKeyframe = 0;
+}
+
+/**
+ * @brief Compress the bytes by PackBits run length encoding, control
+ * byte 0-127 is followed by 1-128 literal bytes, control byte 128-255
+ * is followed by one byte repeated 2-129 times.
+ * 
+ * @param src 
+ * @param len 
+ * @param dst 
+ * @return size_t size of encoded data
+ */
+size_t encodeRle(const uint8_t *src, size_t len, uint8_t *dst) {
+  size_t in = 0;
+  size_t out = 0;
+
+  while (in < len) {
+    // Count the run of the same bytes
+    size_t run = 1;
+    while (in + run < len && run < 129 && src[in + run] == src[in]) {
+      run++;
+    }
+
+    if (run >= 3) {
+      dst[out++] = run + 126;
+      dst[out++] = src[in];
+      in += run;
+      continue;
+    }
+
+    // Copy literals until the next run of at least three bytes
+    size_t start = in;
+    while (in < len && in - start < 128) {
+      if (in + 2 < len && src[in] == src[in + 1] && src[in] == src[in + 2]) {
+        break;
+      }
+      in++;
+    }
+
+    dst[out++] = in - start - 1;
+    memcpy(&dst[out], &src[start], in - start);
+    out += in - start;
+  }
+
+  return out;
+}
+
+/**
+ * @brief Encode and send one span of columns on the page.
+ * 
+ * @param buffer 
+ * @param flags 
+ * @param page 
+ * @param col 
+ * @param width 
+ */
+void sendSpan(const uint8_t *buffer, uint8_t flags, uint8_t page, uint8_t col, uint8_t width) {
+  uint8_t payload[MIRROR_SPAN_HEADER + MIRROR_COLS + 2];
+  const uint8_t *src = &buffer[page * MIRROR_COLS + col];
+
+  payload[0] = mirrorSeq & 0xFF;
+  payload[1] = mirrorSeq >> 8;
+  payload[2] = flags;
+  payload[3] = page;
+  payload[4] = col;
+
+  size_t len = MIRROR_SPAN_HEADER + encodeRle(src, width, &payload[MIRROR_SPAN_HEADER]);
+  sendFrame(REPLY_MIRROR_SPAN, payload, len);
+
+  memcpy(&MirrorShadow[page * MIRROR_COLS + col], src, width);
+  mirrorStats.bytes += len + LINK_FRAME_OVERHEAD;
+}
+
+/**
+ * @brief Compare the framebuffer page by page with the last frame and
+ * send only changed column spans, spans closer than the span gap are
+ * merged. Whole pages are sent in the keyframe. Finally send the frame
+ * end with the span count and encode time.
+ * 
+ * @param buffer 
+ * @param keyframe 
+ */
+void sendMirrorFrame(const uint8_t *buffer, bool keyframe) {
+  uint32_t startTime = micros();
+  uint8_t flags = keyframe ? MIRROR_FLAG_KEYFRAME : 0;
+  uint8_t spans = 0;
+
+  for (uint8_t page = 0; page < MIRROR_PAGES; ++page) {
+    const uint8_t *row = &buffer[page * MIRROR_COLS];
+    const uint8_t *shadow = &MirrorShadow[page * MIRROR_COLS];
+
+    if (keyframe) {
+      sendSpan(buffer, flags, page, 0, MIRROR_COLS);
+      spans++;
+      continue;
+    }
+
+    int col = 0;
+    while (col < MIRROR_COLS) {
+      // Skip unchanged columns
+      if (row[col] == shadow[col]) {
+        col++;
+        continue;
+      }
+
+      // Extend the span over close changes
+      int last = col;
+      for (int next = col + 1; next < MIRROR_COLS && next - last <= MIRROR_SPAN_GAP; ++next) {
+        if (row[next] != shadow[next]) last = next;
+      }
+
+      sendSpan(buffer, flags, page, col, last - col + 1);
+      spans++;
+      col = last + 1;
+    }
+  }
+
+  // Send the frame end
+  uint32_t encodeTime = micros() - startTime;
+  uint8_t payload[8];
+  payload[0] = mirrorSeq & 0xFF;
+  payload[1] = mirrorSeq >> 8;
+  payload[2] = flags;
+  payload[3] = spans;
+  putUint32(&payload[4], encodeTime);
+  sendFrame(REPLY_MIRROR_END, payload, sizeof(payload));
+
+  mirrorStats.bytes += sizeof(payload) + LINK_FRAME_OVERHEAD;
+  mirrorStats.frames++;
+  mirrorStats.lastEncodeTime = encodeTime;
+  if (keyframe) mirrorStats.keyframes++;
+
+  mirrorSeq++;
+}
+
+/**
+ * @brief Send the mirror frame if mirroring enabled, every
+ * keyframe interval frames send the keyframe.
+ * 
+ * @param buffer 
+ */
+void mirrorFrame(const uint8_t *buffer) {
+  if (!mirrorEnabled) {
+    return;
+  }
+
+  bool keyframe = framesToKeyframe == 0;
+  sendMirrorFrame(buffer, keyframe);
+
+  framesToKeyframe = keyframe ? MIRROR_KEYFRAME_INTERVAL - 1 : framesToKeyframe - 1;
+}
+
+/**
+ * @brief Send the whole framebuffer as keyframe even if
+ * mirroring is disabled.
+ * 
+ * @param buffer 
+ */
+void mirrorSnapshot(const uint8_t *buffer) {
+  sendMirrorFrame(buffer, true);
+}
+
+/**
+ * @brief Get the mirror statistics.
+ * 
+ * @return MirrorStats 
+ */
+MirrorStats getMirrorStats() {
+  return mirrorStats;
+}
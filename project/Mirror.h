@@ -0,0 +1,75 @@
+/**
+ * @file Mirror.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef MIRROR_H
+#define MIRROR_H
+
+#include <stdint.h>
+
+#include "Display.h"
+
+// Mirrored framebuffer geometry, one byte is 8 vertical pixels
+#define MIRROR_COLS SCREEN_WIDTH
+#define MIRROR_PAGES ((SCREEN_HEIGHT + 7) / 8)
+#define MIRROR_SIZE (MIRROR_COLS * MIRROR_PAGES)
+
+// Send the whole frame every n frames
+#define MIRROR_KEYFRAME_INTERVAL 64
+
+// Unchanged columns gap merged into one span
+#define MIRROR_SPAN_GAP 4
+
+// Span header size in frame payload
+#define MIRROR_SPAN_HEADER 5
+
+// Mirror frame flags
+#define MIRROR_FLAG_KEYFRAME 0x01
+
+/**
+ * @brief Structure for mirror statistics.
+ * 
+ */
+typedef struct {
+  uint32_t frames;
+  uint32_t keyframes;
+  uint32_t bytes;
+  uint32_t lastEncodeTime;
+} MirrorStats;
+
+/**
+ * @brief Enable or disable the framebuffer mirroring.
+ * 
+ * @param enabled 
+ */
+void setMirror(bool enabled);
+
+/**
+ * @brief Send changes of the framebuffer since the last frame.
+ * 
+ * @param buffer 
+ */
+void mirrorFrame(const uint8_t *buffer);
+
+/**
+ * @brief Send the whole framebuffer once.
+ * 
+ * @param buffer 
+ */
+void mirrorSnapshot(const uint8_t *buffer);
+
+/**
+ * @brief Get the mirror statistics.
+ * 
+ * @return MirrorStats 
+ */
+MirrorStats getMirrorStats();
+
+#endif
@@ -0,0 +1,201 @@
+/**
+ * @file Panel.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#include <stdint.h>
+
+#include "Panel.h"
+#include "Display.h"
+
+// SPI bus settings of the panel
+SPISettings panelSettings(8000000, MSBFIRST, SPI_MODE0);
+
+// Time of one row in the host flush in us
+uint32_t hostRowTime = 0;
+
+/**
+ * @brief Set the control pins as OUTPUT and start the
+ * SPI bus with the panel frequency.
+ * 
+ * @param frequency 
+ */
+void beginPanelBus(uint32_t frequency) {
+  pinMode(SPI_CS, OUTPUT);
+  pinMode(SPI_DC, OUTPUT);
+  pinMode(SPI_RST, OUTPUT);
+  digitalWrite(SPI_CS, HIGH);
+
+  SPI.begin(SPI_CLK, -1, SPI_MOSI, SPI_CS);
+  panelSettings = SPISettings(frequency, MSBFIRST, SPI_MODE0);
+}
+
+/**
+ * @brief Pulse the reset pin LOW and wait for the panel.
+ * 
+ */
+void resetPanel() {
+  digitalWrite(SPI_RST, HIGH);
+  delay(1);
+  digitalWrite(SPI_RST, LOW);
+  delay(10);
+  digitalWrite(SPI_RST, HIGH);
+  delay(120);
+}
+
+/**
+ * @brief Send the bytes with the DC pin level in one SPI transaction.
+ * 
+ * @param level 
+ * @param bytes 
+ * @param len 
+ */
+void writePanelBytes(uint8_t level, const uint8_t *bytes, size_t len) {
+  SPI.beginTransaction(panelSettings);
+  digitalWrite(SPI_DC, level);
+  digitalWrite(SPI_CS, LOW);
+  SPI.writeBytes(bytes, len);
+  digitalWrite(SPI_CS, HIGH);
+  SPI.endTransaction();
+}
+
+/**
+ * @brief Send the command bytes, DC pin LOW.
+ * 
+ * @param cmds 
+ * @param len 
+ */
+void writePanelCommands(const uint8_t *cmds, size_t len) {
+  writePanelBytes(LOW, cmds, len);
+}
+
+/**
+ * @brief Send the data bytes, DC pin HIGH.
+ * 
+ * @param data 
+ * @param len 
+ */
+void writePanelData(const uint8_t *data, size_t len) {
+  writePanelBytes(HIGH, data, len);
+}
+
+/**
+ * @brief Send the SSD1306 init sequence for the internal
+ * charge pump and horizontal addressing mode.
+ * 
+ * @param width 
+ * @param height 
+ */
+void Ssd1306Flush::begin(int16_t /*width*/, int16_t height) {
+  beginPanelBus(SPI_FREQUENCY);
+  resetPanel();
+
+  const uint8_t cmds[] = {
+    0xAE,                            // Display off
+    0xD5, 0x80,                      // Clock divide
+    0xA8, (uint8_t)(height - 1),     // Multiplex
+    0xD3, 0x00,                      // Display offset
+    0x40,                            // Start line
+    0x8D, 0x14,                      // Charge pump on
+    0x20, 0x00,                      // Horizontal addressing
+    0xA1,                            // Segment remap
+    0xC8,                            // COM scan decrement
+    0xDA, (uint8_t)(height == 32 ? 0x02 : 0x12), // COM pins
+    0x81, CONTRAST,                  // Contrast
+    0xD9, 0xF1,                      // Precharge
+    0xDB, 0x40,                      // VCOM detect
+    0xA4,                            // Resume to RAM
+    0xA6,                            // Normal display
+    0x2E,                            // Scroll off
+    0xAF                             // Display on
+  };
+  writePanelCommands(cmds, sizeof(cmds));
+}
+
+/**
+ * @brief Send the SH1106 init sequence for the internal DC-DC.
+ * 
+ * @param width 
+ * @param height 
+ */
+void Sh1106Flush::begin(int16_t /*width*/, int16_t height) {
+  beginPanelBus(SPI_FREQUENCY);
+  resetPanel();
+
+  const uint8_t cmds[] = {
+    0xAE,                            // Display off
+    0xD5, 0x80,                      // Clock divide
+    0xA8, (uint8_t)(height - 1),     // Multiplex
+    0xD3, 0x00,                      // Display offset
+    0x40,                            // Start line
+    0xAD, 0x8B,                      // DC-DC on
+    0xA1,                            // Segment remap
+    0xC8,                            // COM scan decrement
+    0xDA, 0x12,                      // COM pins
+    0x81, CONTRAST,                  // Contrast
+    0xD9, 0x22,                      // Precharge
+    0xDB, 0x35,                      // VCOM level
+    0x32,                            // Pump voltage
+    0xA4,                            // Resume to RAM
+    0xA6,                            // Normal display
+    0xAF                             // Display on
+  };
+  writePanelCommands(cmds, sizeof(cmds));
+}
+
+/**
+ * @brief Send the ST7789 init sequence for 16 bit RGB565 pixels.
+ * 
+ */
+void beginSt7789() {
+  const uint8_t swreset[] = {0x01};
+  const uint8_t slpout[] = {0x11};
+  const uint8_t colmod[] = {0x3A};
+  const uint8_t rgb565[] = {0x55};
+  const uint8_t madctl[] = {0x36};
+  const uint8_t order[] = {0x00};
+  const uint8_t display[] = {0x21, 0x13, 0x29}; // Inversion on, normal mode, display on
+
+  writePanelCommands(swreset, 1);
+  delay(150);
+  writePanelCommands(slpout, 1);
+  delay(10);
+  writePanelCommands(colmod, 1);
+  writePanelData(rgb565, 1);
+  writePanelCommands(madctl, 1);
+  writePanelData(order, 1);
+
+  for (size_t idx = 0; idx < sizeof(display); ++idx) {
+    writePanelCommands(&display[idx], 1);
+    delay(10);
+  }
+}
+
+/**
+ * @brief Set the time one row takes in the host flush.
+ * 
+ * @param time 
+ */
+void setHostRowTime(uint32_t time) {
+  hostRowTime = time;
+}
+
+/**
+ * @brief Wait the host row time for every row.
+ * 
+ * @param rows 
+ */
+void delayHostRows(int16_t rows) {
+  if (hostRowTime > 0 && rows > 0) {
+    delayMicroseconds(hostRowTime * rows);
+  }
+}
@@ -0,0 +1,459 @@
+/**
+ * @file Panel.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef PANEL_H
+#define PANEL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "Font.h"
+
+// Panel colors, monochrome formats light every non black pixel
+#define COLOR_BLACK 0x0000
+#define COLOR_WHITE 0xFFFF
+
+/**
+ * @brief Start the SPI bus and control pins of the panel.
+ * 
+ * @param frequency 
+ */
+void beginPanelBus(uint32_t frequency);
+
+/**
+ * @brief Pulse the panel reset pin.
+ * 
+ */
+void resetPanel();
+
+/**
+ * @brief Send the command bytes to the panel.
+ * 
+ * @param cmds 
+ * @param len 
+ */
+void writePanelCommands(const uint8_t *cmds, size_t len);
+
+/**
+ * @brief Send the data bytes to the panel.
+ * 
+ * @param data 
+ * @param len 
+ */
+void writePanelData(const uint8_t *data, size_t len);
+
+/**
+ * @brief Send the ST7789 init sequence.
+ * 
+ */
+void beginSt7789();
+
+/**
+ * @brief Pixel format with 1 bit per pixel, one byte holds 8 vertical
+ * pixels of the column and pages of 8 rows follow each other, the
+ * native RAM layout of SSD1306 and SH1106.
+ * 
+ */
+struct MonoPages {
+  static const bool PAGED = true;
+
+  static constexpr size_t bufferSize(int16_t width, int16_t height) {
+    return width * ((height + 7) / 8);
+  }
+
+  static inline void setPixel(uint8_t *buffer, int16_t width, int16_t x, int16_t y, uint16_t color) {
+    uint8_t *dst = &buffer[x + (y / 8) * width];
+    uint8_t bit = 1 << (y & 7);
+
+    if (color != COLOR_BLACK) *dst |= bit;
+    else *dst &= ~bit;
+  }
+
+  static inline uint16_t getPixel(const uint8_t *buffer, int16_t width, int16_t x, int16_t y) {
+    return (buffer[x + (y / 8) * width] >> (y & 7)) & 1 ? COLOR_WHITE : COLOR_BLACK;
+  }
+};
+
+/**
+ * @brief Pixel format with 16 bit RGB565 color per pixel stored
+ * row by row in the big endian wire order of ST7789.
+ * 
+ */
+struct Rgb565 {
+  static const bool PAGED = false;
+
+  static constexpr size_t bufferSize(int16_t width, int16_t height) {
+    return 2 * width * height;
+  }
+
+  static inline void setPixel(uint8_t *buffer, int16_t width, int16_t x, int16_t y, uint16_t color) {
+    uint8_t *dst = &buffer[2 * (y * width + x)];
+    dst[0] = color >> 8;
+    dst[1] = color & 0xFF;
+  }
+
+  static inline uint16_t getPixel(const uint8_t *buffer, int16_t width, int16_t x, int16_t y) {
+    const uint8_t *src = &buffer[2 * (y * width + x)];
+    return (src[0] << 8) | src[1];
+  }
+};
+
+/**
+ * @brief SSD1306 flush, sends the pages of dirty rows in horizontal
+ * addressing mode in one transfer.
+ * 
+ */
+struct Ssd1306Flush {
+  static const uint32_t SPI_FREQUENCY = 8000000;
+  static const uint8_t CONTRAST = 0xCF;
+  static const uint8_t DIM_CONTRAST = 0x01;
+
+  static void begin(int16_t width, int16_t height);
+
+  static void dim(bool dimmed) {
+    const uint8_t cmds[] = {0x81, dimmed ? DIM_CONTRAST : CONTRAST};
+    writePanelCommands(cmds, sizeof(cmds));
+  }
+
+  template <typename P>
+  static void flush(const uint8_t *buffer, int16_t top, int16_t bottom) {
+    uint8_t firstPage = top / 8;
+    uint8_t lastPage = bottom / 8;
+    const uint8_t cmds[] = {0x21, 0, P::WIDTH - 1, 0x22, firstPage, lastPage};
+
+    writePanelCommands(cmds, sizeof(cmds));
+    writePanelData(&buffer[firstPage * P::WIDTH], (lastPage - firstPage + 1) * P::WIDTH);
+  }
+};
+
+/**
+ * @brief SH1106 flush, the controller has only page addressing so every
+ * dirty page is sent separately, the 128 pixels are centered in its
+ * 132 columns RAM.
+ * 
+ */
+struct Sh1106Flush {
+  static const uint32_t SPI_FREQUENCY = 8000000;
+  static const uint8_t COLUMN_OFFSET = 2;
+  static const uint8_t CONTRAST = 0x80;
+  static const uint8_t DIM_CONTRAST = 0x01;
+
+  static void begin(int16_t width, int16_t height);
+
+  static void dim(bool dimmed) {
+    const uint8_t cmds[] = {0x81, dimmed ? DIM_CONTRAST : CONTRAST};
+    writePanelCommands(cmds, sizeof(cmds));
+  }
+
+  template <typename P>
+  static void flush(const uint8_t *buffer, int16_t top, int16_t bottom) {
+    for (int16_t page = top / 8; page <= bottom / 8; ++page) {
+      const uint8_t cmds[] = {(uint8_t)(0xB0 | page), COLUMN_OFFSET & 0x0F, 0x10 | (COLUMN_OFFSET >> 4)};
+
+      writePanelCommands(cmds, sizeof(cmds));
+      writePanelData(&buffer[page * P::WIDTH], P::WIDTH);
+    }
+  }
+};
+
+/**
+ * @brief ST7789 flush, sends the dirty rows through the RAM window,
+ * monochrome pages are expanded to RGB565 line by line.
+ * 
+ * @tparam X_OFFSET panel column offset in controller RAM
+ * @tparam Y_OFFSET panel row offset in controller RAM
+ */
+template <int16_t X_OFFSET = 0, int16_t Y_OFFSET = 0>
+struct St7789Flush {
+  static const uint32_t SPI_FREQUENCY = 40000000;
+
+  static void begin(int16_t width, int16_t height) {
+    beginPanelBus(SPI_FREQUENCY);
+    resetPanel();
+    beginSt7789();
+  }
+
+  // No backlight control, the idle mode drops to 8 colors
+  static void dim(bool dimmed) {
+    const uint8_t cmds[] = {(uint8_t)(dimmed ? 0x39 : 0x38)};
+    writePanelCommands(cmds, sizeof(cmds));
+  }
+
+  template <typename P>
+  static void flush(const uint8_t *buffer, int16_t top, int16_t bottom) {
+    setWindow(X_OFFSET, Y_OFFSET + top, X_OFFSET + P::WIDTH - 1, Y_OFFSET + bottom);
+
+    for (int16_t y = top; y <= bottom; ++y) {
+      if (P::PixelFormat::PAGED) {
+        uint8_t line[2 * P::WIDTH];
+        for (int16_t x = 0; x < P::WIDTH; ++x) {
+          uint16_t color = P::PixelFormat::getPixel(buffer, P::WIDTH, x, y);
+          line[2 * x] = color >> 8;
+          line[2 * x + 1] = color & 0xFF;
+        }
+        writePanelData(line, sizeof(line));
+      }
+      else {
+        writePanelData(&buffer[2 * P::WIDTH * y], 2 * P::WIDTH);
+      }
+    }
+  }
+
+  static void setWindow(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1) {
+    const uint8_t caset[] = {0x2A};
+    const uint8_t columns[] = {(uint8_t)(x0 >> 8), (uint8_t)x0, (uint8_t)(x1 >> 8), (uint8_t)x1};
+    const uint8_t raset[] = {0x2B};
+    const uint8_t rows[] = {(uint8_t)(y0 >> 8), (uint8_t)y0, (uint8_t)(y1 >> 8), (uint8_t)y1};
+    const uint8_t ramwr[] = {0x2C};
+
+    writePanelCommands(caset, 1);
+    writePanelData(columns, sizeof(columns));
+    writePanelCommands(raset, 1);
+    writePanelData(rows, sizeof(rows));
+    writePanelCommands(ramwr, 1);
+  }
+
+};
+
+/**
+ * @brief Set the time one row takes in the host flush, so the render
+ * task can be loaded like by a slow panel bus.
+ * 
+ * @param time in us, 0 flushes at once
+ */
+void setHostRowTime(uint32_t time);
+
+/**
+ * @brief Wait the time the rows take in the host flush.
+ * 
+ * @param rows 
+ */
+void delayHostRows(int16_t rows);
+
+/**
+ * @brief Host framebuffer flush, the frame stays in RAM only and is
+ * read by the link snapshot and mirror, no panel has to be attached.
+ * The flush takes the host row time of every sent row.
+ * 
+ */
+struct HostFlush {
+  static void begin(int16_t /*width*/, int16_t /*height*/) {}
+
+  static void dim(bool /*dimmed*/) {}
+
+  template <typename P>
+  static void flush(const uint8_t * /*buffer*/, int16_t top, int16_t bottom) {
+    delayHostRows(bottom - top + 1);
+  }
+};
+
+/**
+ * @brief Panel driver with compile time geometry, pixel format and
+ * flush strategy, all drawing is inlined down to the framebuffer
+ * without virtual calls. Text is drawn with the 5x7 font in 6x8 cells
+ * scaled by text size and wrapped at the right edge.
+ * 
+ * @tparam W panel width in pixels
+ * @tparam H panel height in pixels
+ * @tparam Format framebuffer pixel format
+ * @tparam Flush flush strategy of the panel controller
+ */
+template <int16_t W, int16_t H, typename Format, typename Flush>
+class Panel {
+public:
+  static const int16_t WIDTH = W;
+  static const int16_t HEIGHT = H;
+  static const size_t BUFFER_SIZE = Format::bufferSize(W, H);
+  typedef Format PixelFormat;
+
+  void begin() {
+    Flush::begin(W, H);
+    clearDisplay();
+  }
+
+  void clearDisplay() {
+    memset(buffer, 0, BUFFER_SIZE);
+    dirtyTop = 0;
+    dirtyBottom = H - 1;
+  }
+
+  void display() {
+    int16_t top, bottom;
+    if (takeDirty(top, bottom)) flushBuffer(buffer, top, bottom);
+  }
+
+  bool isDirty() const {
+    return dirtyTop <= dirtyBottom;
+  }
+
+  // Get and reset the rows drawn since the last take
+  bool takeDirty(int16_t &top, int16_t &bottom) {
+    if (dirtyTop > dirtyBottom) return false;
+
+    top = dirtyTop;
+    bottom = dirtyBottom;
+    dirtyTop = H;
+    dirtyBottom = -1;
+    return true;
+  }
+
+  // Lower the panel brightness or restore it
+  void dim(bool dimmed) {
+    Flush::dim(dimmed);
+  }
+
+  // Send the rows of the frame copy to the panel
+  static void flushBuffer(const uint8_t *frame, int16_t top, int16_t bottom) {
+    Flush::template flush<Panel>(frame, top, bottom);
+  }
+
+  void setRotation(uint8_t value) {
+    rotation = value & 3;
+    width = (rotation & 1) ? H : W;
+    height = (rotation & 1) ? W : H;
+  }
+
+  inline void drawPixel(int16_t x, int16_t y, uint16_t color) {
+    if (x < 0 || y < 0 || x >= width || y >= height) return;
+
+    rotate(x, y);
+    Format::setPixel(buffer, W, x, y, color);
+    if (y < dirtyTop) dirtyTop = y;
+    if (y > dirtyBottom) dirtyBottom = y;
+  }
+
+  inline uint16_t getPixel(int16_t x, int16_t y) const {
+    if (x < 0 || y < 0 || x >= width || y >= height) return COLOR_BLACK;
+
+    rotate(x, y);
+    return Format::getPixel(buffer, W, x, y);
+  }
+
+  void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    for (int16_t row = y; row < y + h; ++row) {
+      for (int16_t col = x; col < x + w; ++col) {
+        drawPixel(col, row, color);
+      }
+    }
+  }
+
+  void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
+  }
+
+  void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+  }
+
+  void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+  }
+
+  void setCursor(int16_t x, int16_t y) {
+    cursorX = x;
+    cursorY = y;
+  }
+
+  int16_t getCursorX() const { return cursorX; }
+  int16_t getCursorY() const { return cursorY; }
+
+  void setTextSize(uint8_t size) {
+    textSize = size > 0 ? size : 1;
+  }
+
+  void setTextColor(uint16_t color) {
+    textColor = color;
+    textBackground = color;
+  }
+
+  void setTextColor(uint16_t color, uint16_t background) {
+    textColor = color;
+    textBackground = background;
+  }
+
+  size_t write(uint8_t ch) {
+    if (ch == '\n') {
+      cursorX = 0;
+      cursorY += GLYPH_CELL_HEIGHT * textSize;
+    }
+    else if (ch != '\r') {
+      if (cursorX + GLYPH_CELL_WIDTH * textSize > width) {
+        cursorX = 0;
+        cursorY += GLYPH_CELL_HEIGHT * textSize;
+      }
+
+      drawGlyph(cursorX, cursorY, ch);
+      cursorX += GLYPH_CELL_WIDTH * textSize;
+    }
+
+    return 1;
+  }
+
+  size_t print(char ch) {
+    return write(ch);
+  }
+
+  size_t print(const char *str) {
+    size_t count = 0;
+    while (*str) count += write(*str++);
+    return count;
+  }
+
+  uint8_t *getBuffer() { return buffer; }
+  const uint8_t *getBuffer() const { return buffer; }
+
+private:
+  // Map the rotated coordinates to the framebuffer ones
+  inline void rotate(int16_t &x, int16_t &y) const {
+    int16_t tmp;
+    switch (rotation) {
+      case 1: tmp = x; x = W - 1 - y; y = tmp; break;
+      case 2: x = W - 1 - x; y = H - 1 - y; break;
+      case 3: tmp = x; x = y; y = H - 1 - tmp; break;
+    }
+  }
+
+  // Draw the glyph, background only if it differs from the text color
+  void drawGlyph(int16_t x, int16_t y, uint8_t ch) {
+    const uint8_t *glyph = getGlyph(ch);
+
+    for (int16_t col = 0; col < GLYPH_CELL_WIDTH; ++col) {
+      uint8_t line = col < GLYPH_WIDTH ? glyph[col] : 0;
+
+      for (int16_t row = 0; row < GLYPH_CELL_HEIGHT; ++row, line >>= 1) {
+        if (line & 1) {
+          fillRect(x + col * textSize, y + row * textSize, textSize, textSize, textColor);
+        }
+        else if (textBackground != textColor) {
+          fillRect(x + col * textSize, y + row * textSize, textSize, textSize, textBackground);
+        }
+      }
+    }
+  }
+
+  uint8_t buffer[BUFFER_SIZE];
+  uint8_t rotation = 0;
+  int16_t width = W;
+  int16_t height = H;
+  int16_t dirtyTop = H;
+  int16_t dirtyBottom = -1;
+  int16_t cursorX = 0;
+  int16_t cursorY = 0;
+  uint8_t textSize = 1;
+  uint16_t textColor = COLOR_WHITE;
+  uint16_t textBackground = COLOR_WHITE;
+};
+
+#endif
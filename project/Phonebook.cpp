@@ -0,0 +1,366 @@
+/**
+ * @file Phonebook.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <esp_partition.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Phonebook.h"
+
+// Phonebook partition, its mapping and the end of the written blob
+const esp_partition_t *phonebookPartition = NULL;
+esp_partition_mmap_handle_t phonebookMap;
+bool phonebookMapped = false;
+uint32_t phonebookWriteEnd = 0;
+
+// Opened phonebook blob, the digit of every char and the index
+// entries, record offset in the upper 24 bits and key start in the
+// record in the lower 8 bits, sorted by the key digits
+const uint8_t *phonebookBlob = NULL;
+const uint8_t *phonebookDigits = NULL;
+const uint32_t *phonebookIndex = NULL;
+uint32_t contactCount = 0;
+uint32_t entryCount = 0;
+uint32_t phonebookSize = 0;
+
+/**
+ * @brief Read the little endian uint32_t value of the blob header.
+ * 
+ * @param src 
+ * @return uint32_t 
+ */
+uint32_t getBlobUint32(const uint8_t *src) {
+  return src[0] | (src[1] << 8) | (src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/**
+ * @brief Map the whole phonebook partition and open the blob in it.
+ * 
+ * @return true 
+ * @return false if the partition holds no valid phonebook
+ */
+bool mapPhonebook() {
+  const void *data;
+
+  if (esp_partition_mmap(phonebookPartition, 0, phonebookPartition->size,
+                         ESP_PARTITION_MMAP_DATA, &data, &phonebookMap) != ESP_OK) {
+    return false;
+  }
+
+  phonebookMapped = true;
+  return openPhonebook((const uint8_t *)data, phonebookPartition->size);
+}
+
+/**
+ * @brief Drop the opened phonebook and unmap the partition, the
+ * mapping would read stale flash cache after a write.
+ * 
+ */
+void unmapPhonebook() {
+  openPhonebook(NULL, 0);
+
+  if (phonebookMapped) {
+    esp_partition_munmap(phonebookMap);
+    phonebookMapped = false;
+  }
+}
+
+/**
+ * @brief Find the phonebook partition and open the stored phonebook,
+ * without the partition or a valid blob the phonebook is empty.
+ * 
+ */
+void initPhonebook() {
+  phonebookPartition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                (esp_partition_subtype_t)PHONEBOOK_SUBTYPE,
+                                                PHONEBOOK_PARTITION);
+  if (phonebookPartition != NULL) {
+    mapPhonebook();
+  }
+}
+
+/**
+ * @brief Check the blob header and every index entry, then use the
+ * blob for searching. The blob is the header, the digit table, the
+ * contact records of name length, name, number length and number
+ * and the 4 byte aligned index. The blob is not copied.
+ * 
+ * @param blob 
+ * @param size size of the memory with the blob
+ * @return true 
+ * @return false if the blob is malformed, the phonebook is empty
+ */
+bool openPhonebook(const uint8_t *blob, size_t size) {
+  phonebookBlob = NULL;
+  phonebookDigits = NULL;
+  phonebookIndex = NULL;
+  contactCount = 0;
+  entryCount = 0;
+  phonebookSize = 0;
+
+  if (blob == NULL || size < PHONEBOOK_HEADER + PHONEBOOK_DIGITS_SIZE ||
+      blob[0] != PHONEBOOK_MAGIC0 || blob[1] != PHONEBOOK_MAGIC1 || blob[2] != PHONEBOOK_VERSION) {
+    return false;
+  }
+
+  uint32_t contacts = getBlobUint32(&blob[4]);
+  uint32_t entries = getBlobUint32(&blob[8]);
+  uint32_t recordsOffset = getBlobUint32(&blob[12]);
+  uint32_t indexOffset = getBlobUint32(&blob[16]);
+  uint32_t total = getBlobUint32(&blob[20]);
+
+  if (recordsOffset != PHONEBOOK_HEADER + PHONEBOOK_DIGITS_SIZE || indexOffset < recordsOffset ||
+      indexOffset % 4 != 0 || total > size || entries > (total - indexOffset) / 4 ||
+      indexOffset + 4 * entries != total || indexOffset >= (1UL << 24)) {
+    return false;
+  }
+
+  // Every key has to stay inside its record and the records area
+  const uint32_t *index = (const uint32_t *)&blob[indexOffset];
+  for (uint32_t idx = 0; idx < entries; ++idx) {
+    uint32_t offset = index[idx] >> 8;
+    uint8_t start = index[idx] & 0xFF;
+
+    if (offset < recordsOffset || offset + 2 > indexOffset) {
+      return false;
+    }
+
+    const uint8_t *record = &blob[offset];
+    uint32_t numberStart = 2 + record[0];
+    if (offset + numberStart > indexOffset || offset + numberStart + record[1 + record[0]] > indexOffset ||
+        start == 0 || start == numberStart - 1 || start >= numberStart + record[numberStart - 1]) {
+      return false;
+    }
+  }
+
+  phonebookBlob = blob;
+  phonebookDigits = &blob[PHONEBOOK_HEADER];
+  phonebookIndex = index;
+  contactCount = contacts;
+  entryCount = entries;
+  phonebookSize = total;
+  return true;
+}
+
+/**
+ * @brief Write the chunk of a new phonebook blob, chunks come in
+ * order from offset zero, which drops the opened phonebook. Sectors
+ * are erased when the first chunk reaches them.
+ * 
+ * @param offset 
+ * @param data 
+ * @param len 
+ * @return true 
+ * @return false if there is no partition, the chunk is out of order
+ * or does not fit
+ */
+bool writePhonebook(uint32_t offset, const uint8_t *data, size_t len) {
+  if (phonebookPartition == NULL) {
+    return false;
+  }
+
+  if (offset == 0) {
+    unmapPhonebook();
+    phonebookWriteEnd = 0;
+  }
+
+  if (offset != phonebookWriteEnd || offset + len > phonebookPartition->size) {
+    return false;
+  }
+
+  uint32_t erasedEnd = (offset + PHONEBOOK_SECTOR_SIZE - 1) / PHONEBOOK_SECTOR_SIZE * PHONEBOOK_SECTOR_SIZE;
+  if (offset + len > erasedEnd) {
+    uint32_t eraseLen = (offset + len - erasedEnd + PHONEBOOK_SECTOR_SIZE - 1) / PHONEBOOK_SECTOR_SIZE * PHONEBOOK_SECTOR_SIZE;
+    if (esp_partition_erase_range(phonebookPartition, erasedEnd, eraseLen) != ESP_OK) {
+      return false;
+    }
+  }
+
+  if (esp_partition_write(phonebookPartition, offset, data, len) != ESP_OK) {
+    return false;
+  }
+
+  phonebookWriteEnd = offset + len;
+  return true;
+}
+
+/**
+ * @brief Map the partition again and open the written phonebook.
+ * 
+ * @return true 
+ * @return false if there is no partition or the blob is malformed
+ */
+bool commitPhonebook() {
+  if (phonebookPartition == NULL) {
+    return false;
+  }
+
+  unmapPhonebook();
+  return mapPhonebook();
+}
+
+/**
+ * @brief Get the number of contacts.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getContactCount() {
+  return contactCount;
+}
+
+/**
+ * @brief Get the number of index entries, every name word and the
+ * number of a contact.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getEntryCount() {
+  return entryCount;
+}
+
+/**
+ * @brief Get the phonebook blob size.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getPhonebookSize() {
+  return phonebookSize;
+}
+
+/**
+ * @brief Get the key digit of the index entry at the depth, the key
+ * runs from the key start to the end of the name or number.
+ * 
+ * @param idx 
+ * @param depth 
+ * @return uint8_t the digit or zero past the key end
+ */
+uint8_t getKeyDigit(uint32_t idx, uint8_t depth) {
+  uint32_t entry = phonebookIndex[idx];
+  const uint8_t *record = &phonebookBlob[entry >> 8];
+  uint32_t pos = (entry & 0xFF) + depth;
+  uint32_t end = (entry & 0xFF) <= record[0] ? 1 + record[0] : 2 + record[0] + record[1 + record[0]];
+
+  return pos < end ? phonebookDigits[record[pos]] : 0;
+}
+
+/**
+ * @brief Find the first entry of the range with the key digit at the
+ * depth not less than the digit. All keys of the range share the
+ * digits before the depth, so they are sorted by this digit.
+ * 
+ * @param first 
+ * @param last 
+ * @param depth 
+ * @param digit 
+ * @return uint32_t 
+ */
+uint32_t findKeyDigit(uint32_t first, uint32_t last, uint8_t depth, uint8_t digit) {
+  while (first < last) {
+    uint32_t middle = first + (last - first) / 2;
+
+    if (getKeyDigit(middle, depth) < digit) {
+      first = middle + 1;
+    }
+    else {
+      last = middle;
+    }
+  }
+
+  return first;
+}
+
+/**
+ * @brief Start a new search with empty query matching all entries.
+ * 
+ * @param search 
+ */
+void resetSearch(PhonebookSearch *search) {
+  search->len = 0;
+  search->first[0] = 0;
+  search->last[0] = entryCount;
+}
+
+/**
+ * @brief Add the digit to the query and narrow the range of the
+ * previous query by two binary searches on one key digit, so a key
+ * press costs O(log n) index reads.
+ * 
+ * @param search 
+ * @param digit 
+ * @return uint32_t number of matching entries
+ */
+uint32_t pushSearchDigit(PhonebookSearch *search, char digit) {
+  uint8_t depth = search->len;
+
+  if (depth == PHONEBOOK_MAX_QUERY) {
+    return getSearchCount(search);
+  }
+
+  uint32_t first = findKeyDigit(search->first[depth], search->last[depth], depth, digit);
+  uint32_t last = findKeyDigit(first, search->last[depth], depth, digit + 1);
+
+  search->digits[depth] = digit;
+  search->first[depth + 1] = first;
+  search->last[depth + 1] = last;
+  search->len++;
+
+  return last - first;
+}
+
+/**
+ * @brief Remove the last digit of the query, the range of the
+ * shorter query is kept.
+ * 
+ * @param search 
+ * @return uint32_t number of matching entries
+ */
+uint32_t popSearchDigit(PhonebookSearch *search) {
+  if (search->len > 0) {
+    search->len--;
+  }
+
+  return getSearchCount(search);
+}
+
+/**
+ * @brief Get the number of entries matching the query.
+ * 
+ * @param search 
+ * @return uint32_t 
+ */
+uint32_t getSearchCount(const PhonebookSearch *search) {
+  return search->last[search->len] - search->first[search->len];
+}
+
+/**
+ * @brief Get the contact of the matching entry, entries are ordered
+ * by their key digits.
+ * 
+ * @param search 
+ * @param idx index among the matching entries
+ * @param contact 
+ * @return true 
+ * @return false if the index is out of the matches
+ */
+bool getSearchContact(const PhonebookSearch *search, uint32_t idx, Contact *contact) {
+  if (idx >= getSearchCount(search)) {
+    return false;
+  }
+
+  const uint8_t *record = &phonebookBlob[phonebookIndex[search->first[search->len] + idx] >> 8];
+  contact->nameLen = record[0];
+  contact->name = (const char *)&record[1];
+  contact->numberLen = record[1 + record[0]];
+  contact->number = (const char *)&record[2 + record[0]];
+  return true;
+}
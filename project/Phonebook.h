@@ -0,0 +1,161 @@
+/**
+ * @file Phonebook.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef PHONEBOOK_H
+#define PHONEBOOK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Flash data partition holding the phonebook blob
+#define PHONEBOOK_PARTITION "phonebook"
+#define PHONEBOOK_SUBTYPE 0x40
+
+// Flash erase unit of the partition
+#define PHONEBOOK_SECTOR_SIZE 4096
+
+// Phonebook blob header, magic, version and the counts and offsets
+// followed by the digit of every code page char
+#define PHONEBOOK_MAGIC0 'P'
+#define PHONEBOOK_MAGIC1 'B'
+#define PHONEBOOK_VERSION 1
+#define PHONEBOOK_HEADER 24
+#define PHONEBOOK_DIGITS_SIZE 256
+
+// Longest digit query, further digits are ignored
+#define PHONEBOOK_MAX_QUERY 16
+
+/**
+ * @brief Structure for one contact, name in the internal code page
+ * and the number, both point into the phonebook and are not
+ * terminated.
+ * 
+ */
+typedef struct {
+  const char *name;
+  uint8_t nameLen;
+  const char *number;
+  uint8_t numberLen;
+} Contact;
+
+/**
+ * @brief Structure for the incremental digit search, the index range
+ * matching every query prefix, so a new digit narrows the last range
+ * and a removed digit returns to the previous one.
+ * 
+ */
+typedef struct {
+  uint8_t len;
+  char digits[PHONEBOOK_MAX_QUERY];
+  uint32_t first[PHONEBOOK_MAX_QUERY + 1];
+  uint32_t last[PHONEBOOK_MAX_QUERY + 1];
+} PhonebookSearch;
+
+/**
+ * @brief Find the phonebook partition and open the stored phonebook.
+ * 
+ */
+void initPhonebook();
+
+/**
+ * @brief Check the phonebook blob and search in it.
+ * 
+ * @param blob 
+ * @param size 
+ * @return true 
+ * @return false 
+ */
+bool openPhonebook(const uint8_t *blob, size_t size);
+
+/**
+ * @brief Write the chunk of a new phonebook blob to the partition.
+ * 
+ * @param offset 
+ * @param data 
+ * @param len 
+ * @return true 
+ * @return false 
+ */
+bool writePhonebook(uint32_t offset, const uint8_t *data, size_t len);
+
+/**
+ * @brief Open the phonebook written to the partition.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool commitPhonebook();
+
+/**
+ * @brief Get the number of contacts.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getContactCount();
+
+/**
+ * @brief Get the number of index entries.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getEntryCount();
+
+/**
+ * @brief Get the phonebook blob size.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getPhonebookSize();
+
+/**
+ * @brief Start a new search matching all entries.
+ * 
+ * @param search 
+ */
+void resetSearch(PhonebookSearch *search);
+
+/**
+ * @brief Add the digit to the query and narrow the matches.
+ * 
+ * @param search 
+ * @param digit 
+ * @return uint32_t 
+ */
+uint32_t pushSearchDigit(PhonebookSearch *search, char digit);
+
+/**
+ * @brief Remove the last digit of the query.
+ * 
+ * @param search 
+ * @return uint32_t 
+ */
+uint32_t popSearchDigit(PhonebookSearch *search);
+
+/**
+ * @brief Get the number of entries matching the query.
+ * 
+ * @param search 
+ * @return uint32_t 
+ */
+uint32_t getSearchCount(const PhonebookSearch *search);
+
+/**
+ * @brief Get the contact of the matching entry.
+ * 
+ * @param search 
+ * @param idx 
+ * @param contact 
+ * @return true 
+ * @return false 
+ */
+bool getSearchContact(const PhonebookSearch *search, uint32_t idx, Contact *contact);
+
+#endif
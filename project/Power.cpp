@@ -0,0 +1,124 @@
+/**
+ * @file Power.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+#include <esp_sleep.h>
+#include <esp_timer.h>
+#include <driver/uart.h>
+
+#include <stdint.h>
+
+#include "Power.h"
+#include "Keypad.h"
+#include "Render.h"
+#include "Editor.h"
+
+// Panel brightness lowered flag
+bool panelDimmed = false;
+
+// Total time spent in light sleep in us
+uint64_t sleepMicros = 0;
+
+// Light sleep statistics
+PowerStats powerStats = {0, 0, 0, 0, 0, 0};
+
+/**
+ * @brief Let the serial link RX line wake the device up.
+ * 
+ */
+void initPower() {
+  uart_set_wakeup_threshold(UART_NUM_0, POWER_UART_WAKE_EDGES);
+}
+
+/**
+ * @brief Light sleep until a key press, host link traffic or the
+ * next editor timer, then restore the keypad and count the wakeup.
+ * A keypad wakeup without the key still pressed means the waking
+ * press was lost.
+ * 
+ * @param idle time until the next editor timer in ms
+ */
+void sleepDevice(uint32_t idle) {
+  Serial.flush();
+  sleepKeypad();
+
+  esp_sleep_enable_gpio_wakeup();
+  esp_sleep_enable_uart_wakeup(UART_NUM_0);
+  if (idle != UINT32_MAX) {
+    esp_sleep_enable_timer_wakeup((uint64_t)idle * 1000);
+  }
+
+  int64_t startTime = esp_timer_get_time();
+  esp_light_sleep_start();
+  sleepMicros += esp_timer_get_time() - startTime;
+
+  esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
+  esp_sleep_disable_wakeup_source(ESP_SLEEP_WAKEUP_ALL);
+
+  bool pressed = wakeKeypad();
+  powerStats.sleeps++;
+
+  if (cause == ESP_SLEEP_WAKEUP_GPIO) {
+    powerStats.keyWakeups++;
+    if (!pressed) powerStats.lostWakeups++;
+  }
+  else if (cause == ESP_SLEEP_WAKEUP_UART) {
+    powerStats.linkWakeups++;
+  }
+}
+
+/**
+ * @brief Restore the panel brightness once the editor is used again,
+ * dim the panel and light sleep while the editor is idle. The panel
+ * is touched and the device sleeps only with the render task idle,
+ * otherwise it is tried again on the next step.
+ * 
+ * @param editor 
+ * @param idle time until the next editor timer in ms
+ * @return true if the device slept
+ * @return false 
+ */
+bool updatePower(Editor *editor, uint32_t idle) {
+  if (!isRenderIdle()) {
+    return false;
+  }
+
+  if (!editor->idle) {
+    if (panelDimmed) {
+      editor->display->dim(false);
+      panelDimmed = false;
+    }
+    return false;
+  }
+
+#if POWER_DIM_PANEL
+  if (!panelDimmed) {
+    editor->display->dim(true);
+    panelDimmed = true;
+  }
+#endif
+
+  sleepDevice(idle);
+  return true;
+}
+
+/**
+ * @brief Get the light sleep statistics, the active time is the
+ * uptime not spent in light sleep.
+ * 
+ * @return PowerStats 
+ */
+PowerStats getPowerStats() {
+  PowerStats stats = powerStats;
+  stats.sleepTime = sleepMicros / 1000;
+  stats.activeTime = (esp_timer_get_time() - sleepMicros) / 1000;
+  return stats;
+}
@@ -0,0 +1,63 @@
+/**
+ * @file Power.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+
+// Dim the panel while the editor is idle
+#ifndef POWER_DIM_PANEL
+#define POWER_DIM_PANEL 1
+#endif
+
+// Serial RX edges waking the device up, the waking bytes are lost
+#define POWER_UART_WAKE_EDGES 3
+
+/**
+ * @brief Structure for light sleep statistics.
+ * 
+ */
+typedef struct {
+  uint32_t sleeps;
+  uint32_t keyWakeups;
+  uint32_t linkWakeups;
+  uint32_t lostWakeups;
+  uint32_t sleepTime;
+  uint32_t activeTime;
+} PowerStats;
+
+struct Editor;
+
+/**
+ * @brief Set up the light sleep wakeup sources.
+ * 
+ */
+void initPower();
+
+/**
+ * @brief Dim the panel and light sleep while the editor is idle.
+ * 
+ * @param editor 
+ * @param idle 
+ * @return true 
+ * @return false 
+ */
+bool updatePower(Editor *editor, uint32_t idle);
+
+/**
+ * @brief Get the light sleep statistics.
+ * 
+ * @return PowerStats 
+ */
+PowerStats getPowerStats();
+
+#endif
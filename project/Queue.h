@@ -0,0 +1,64 @@
+/**
+ * @file Queue.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief Lock-free single producer single consumer ring queue, the
+ * producer owns the head and the consumer owns the tail index.
+ * 
+ * @tparam T item type
+ * @tparam N capacity, power of two
+ */
+template <typename T, uint32_t N>
+class SpscQueue {
+  static_assert((N & (N - 1)) == 0, "Queue capacity must be power of two");
+
+public:
+  bool push(const T &item) {
+    uint32_t head = headIndex.load(std::memory_order_relaxed);
+
+    if (head - tailIndex.load(std::memory_order_acquire) == N) {
+      return false;
+    }
+
+    items[head % N] = item;
+    headIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(T &item) {
+    uint32_t tail = tailIndex.load(std::memory_order_relaxed);
+
+    if (tail == headIndex.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    item = items[tail % N];
+    tailIndex.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  uint32_t size() const {
+    return headIndex.load(std::memory_order_acquire) - tailIndex.load(std::memory_order_acquire);
+  }
+
+private:
+  T items[N];
+  std::atomic<uint32_t> headIndex{0};
+  std::atomic<uint32_t> tailIndex{0};
+};
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ * @file Render.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <Arduino.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Render.h"
+#include "Display.h"
+#include "Queue.h"
+
+// Frame copies owned by the render task while queued
+uint8_t RenderSlots[RENDER_SLOTS][DisplayPanel::BUFFER_SIZE];
+
+// Frames ready for render, input task to render task
+SpscQueue<RenderFrame, RENDER_QUEUE_SIZE> readyFrames;
+
+// Slots free for next frame, render task to input task
+SpscQueue<uint8_t, RENDER_QUEUE_SIZE> freeSlots;
+
+// Task handles
+TaskHandle_t renderTaskHandle = NULL;
+TaskHandle_t inputTaskHandle = NULL;
+
+// Input step run by the input task, returns the idle time in ms
+uint32_t (*inputStepFunc)() = NULL;
+
+// Frame waiting for free slot flag
+bool framePending = false;
+
+// Render pipeline statistics
+RenderStats renderStats = {0, 0};
+
+/**
+ * @brief Put all slots to the free queue.
+ * 
+ */
+void initRender() {
+  for (uint8_t slot = 0; slot < RENDER_SLOTS; ++slot) {
+    freeSlots.push(slot);
+  }
+}
+
+/**
+ * @brief Copy the framebuffer to a free slot and queue it with the rows
+ * drawn since the last frame. If the render task still holds all slots
+ * the frame stays pending and the next publish sends all its changes.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool publishFrame() {
+  if (!Display.isDirty()) {
+    framePending = false;
+    return true;
+  }
+
+  uint8_t slot;
+  if (!freeSlots.pop(slot)) {
+    framePending = true;
+    renderStats.coalesced++;
+    return false;
+  }
+
+  RenderFrame frame;
+  frame.slot = slot;
+  Display.takeDirty(frame.top, frame.bottom);
+  memcpy(RenderSlots[slot], Display.getBuffer(), DisplayPanel::BUFFER_SIZE);
+  readyFrames.push(frame);
+
+  framePending = false;
+  renderStats.published++;
+
+  if (renderTaskHandle != NULL) {
+    xTaskNotifyGive(renderTaskHandle);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Publish the pending frame.
+ * 
+ */
+void retryFrame() {
+  if (framePending) {
+    publishFrame();
+  }
+}
+
+/**
+ * @brief Flush the queued frames to the panel and return their slots,
+ * sleep until the input task publishes next frame.
+ * 
+ * @param arg 
+ */
+void renderTask(void * /*arg*/) {
+  for (;;) {
+    RenderFrame frame;
+
+    while (readyFrames.pop(frame)) {
+      uint32_t startTime = micros();
+      DisplayPanel::flushBuffer(RenderSlots[frame.slot], frame.top, frame.bottom);
+      recordFlush(micros() - startTime);
+
+      freeSlots.push(frame.slot);
+    }
+
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+  }
+}
+
+/**
+ * @brief Run the input step forever, publish pending frame and
+ * sleep for the idle time of the step, pending frame is retried
+ * on the next tick. Due step still yields for one tick so the
+ * core idle task is not starved.
+ * 
+ * @param arg 
+ */
+void inputTask(void * /*arg*/) {
+  for (;;) {
+    uint32_t idle = inputStepFunc();
+    retryFrame();
+
+    if (framePending || idle == 0) {
+      idle = 1;
+    }
+    vTaskDelay(pdMS_TO_TICKS(idle));
+  }
+}
+
+/**
+ * @brief Start the render task pinned to the render core and input
+ * task pinned to the input core.
+ * 
+ * @param inputStep 
+ */
+void startTasks(uint32_t (*inputStep)()) {
+  inputStepFunc = inputStep;
+
+  xTaskCreatePinnedToCore(renderTask, "render", RENDER_TASK_STACK, NULL,
+                          RENDER_TASK_PRIORITY, &renderTaskHandle, RENDER_CORE);
+  xTaskCreatePinnedToCore(inputTask, "input", INPUT_TASK_STACK, NULL,
+                          INPUT_TASK_PRIORITY, &inputTaskHandle, INPUT_CORE);
+}
+
+/**
+ * @brief Check that no frame waits for a slot and the render task
+ * returned all slots, so the panel bus is free.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool isRenderIdle() {
+  return !framePending && freeSlots.size() == RENDER_SLOTS;
+}
+
+/**
+ * @brief Get the least free stack in bytes the input task ever had,
+ * without the render task the input runs in the calling loop task.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getInputStackFree() {
+  return uxTaskGetStackHighWaterMark(inputTaskHandle);
+}
+
+/**
+ * @brief Get the least free stack in bytes the render task ever had.
+ * 
+ * @return uint32_t 0 without the render task
+ */
+uint32_t getRenderStackFree() {
+  return renderTaskHandle != NULL ? uxTaskGetStackHighWaterMark(renderTaskHandle) : 0;
+}
+
+/**
+ * @brief Get the render pipeline statistics.
+ * 
+ * @return RenderStats 
+ */
+RenderStats getRenderStats() {
+  return renderStats;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file Render.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <stdint.h>
+
+// Flush the display from the render task on the other core
+#ifndef USE_RENDER_TASK
+#define USE_RENDER_TASK 1
+#endif
+
+// Frame copies shared by input and render task
+#define RENDER_SLOTS 3
+#define RENDER_QUEUE_SIZE 4
+
+// Task cores
+#define INPUT_CORE 0
+#define RENDER_CORE 1
+
+// Task stack sizes
+#define INPUT_TASK_STACK 8192
+#define RENDER_TASK_STACK 4096
+
+// Task priorities
+#define INPUT_TASK_PRIORITY 2
+#define RENDER_TASK_PRIORITY 1
+
+/**
+ * @brief Structure for frame handed to the render task.
+ * 
+ */
+typedef struct {
+  uint8_t slot;
+  int16_t top;
+  int16_t bottom;
+} RenderFrame;
+
+/**
+ * @brief Structure for render pipeline statistics.
+ * 
+ */
+typedef struct {
+  uint32_t published;
+  uint32_t coalesced;
+} RenderStats;
+
+/**
+ * @brief Initialize the frame slots.
+ * 
+ */
+void initRender();
+
+/**
+ * @brief Start the input task and render task.
+ * 
+ * @param inputStep 
+ */
+void startTasks(uint32_t (*inputStep)());
+
+/**
+ * @brief Hand the current frame to the render task.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool publishFrame();
+
+/**
+ * @brief Publish the frame left pending because of no free slot.
+ * 
+ */
+void retryFrame();
+
+/**
+ * @brief Check that no frame is pending or owned by the render task.
+ * 
+ * @return true 
+ * @return false 
+ */
+bool isRenderIdle();
+
+/**
+ * @brief Get the least free stack of the input task.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getInputStackFree();
+
+/**
+ * @brief Get the least free stack of the render task.
+ * 
+ * @return uint32_t 
+ */
+uint32_t getRenderStackFree();
+
+/**
+ * @brief Get the render pipeline statistics.
+ * 
+ * @return RenderStats 
+ */
+RenderStats getRenderStats();
+
+#endif
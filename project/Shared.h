@@ -0,0 +1,24 @@
+/**
+ * @file Shared.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef SHARED_H
+#define SHARED_H
+
+// Storage of the pools and reports shared by all editors of one
+// thread: flow frames, message history, search index, step latency
+// and the fuzz editor. On the device every editor runs on the input
+// task, so it is plain static storage, the host build runs editors
+// on many threads and defines it thread_local.
+#ifndef SHARED_STATE
+#define SHARED_STATE
+#endif
+
+#endif
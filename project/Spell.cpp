@@ -0,0 +1,231 @@
+/**
+ * @file Spell.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+
+#include "Spell.h"
+#include "Editor.h"
+#include "Layout.h"
+
+// Bloom filter of 1816 words of tools/words/english.txt for 1.0 % false
+// positives, generated by tools/spellfilter.py
+const uint8_t SpellFilter[SPELL_FILTER_BYTES] = {
+  0x36, 0x9A, 0xD5, 0x9A, 0xE4, 0xBF, 0xDC, 0xF5, 0x60, 0x8A, 0xD5, 0xB0, 0x86, 0x33, 0xB2, 0xD1,
+  0xD5, 0x37, 0x8B, 0x70, 0x23, 0x30, 0xEE, 0xD6, 0xB1, 0x37, 0xCA, 0xAD, 0x35, 0x2D, 0x3E, 0x1D,
+  0x3E, 0xBD, 0xA9, 0xD3, 0x45, 0x71, 0x09, 0xC2, 0x3E, 0x0C, 0x46, 0xEF, 0xE9, 0xCE, 0xF7, 0x92,
+  0xA2, 0x3A, 0x53, 0x72, 0xAA, 0x34, 0x34, 0x8F, 0x64, 0xBA, 0xC4, 0x94, 0x98, 0xB9, 0x44, 0x60,
+  0xF8, 0x3B, 0xCF, 0x2D, 0x32, 0xA3, 0x18, 0x4E, 0x2C, 0xFA, 0x3F, 0xBD, 0xC2, 0x8E, 0xDC, 0xCE,
+  0x57, 0x81, 0x1D, 0xC4, 0x5A, 0x0D, 0x8C, 0xF4, 0xB6, 0xF2, 0x8A, 0xEF, 0x14, 0x2B, 0xF7, 0x3B,
+  0x98, 0x1F, 0xFA, 0x12, 0xB2, 0x99, 0x6A, 0xB6, 0x76, 0xFE, 0x30, 0x46, 0xB0, 0x74, 0x79, 0x6B,
+  0xF8, 0x49, 0xB3, 0x3D, 0xF4, 0x7F, 0x18, 0xEF, 0x22, 0xB9, 0x48, 0x5D, 0xEC, 0xA4, 0xCF, 0xDF,
+  0xEA, 0xEF, 0xC5, 0x21, 0x5B, 0xBA, 0x9B, 0xC3, 0x16, 0x1B, 0x14, 0xDF, 0xA2, 0x54, 0x6D, 0x84,
+  0x2A, 0x32, 0x95, 0x47, 0x6F, 0xCD, 0xB1, 0xFD, 0xEF, 0x4D, 0x64, 0x2A, 0xDF, 0x9E, 0x4C, 0x7D,
+  0x63, 0x32, 0xFC, 0x87, 0x26, 0x98, 0x79, 0x05, 0xDD, 0x58, 0xDB, 0xB2, 0x3B, 0xB8, 0x84, 0xFD,
+  0x08, 0x9E, 0xB9, 0xFE, 0x63, 0xF2, 0xD4, 0xD9, 0x60, 0x69, 0xB7, 0xFD, 0xE4, 0xF8, 0xC3, 0xA2,
+  0x3C, 0xEE, 0xAB, 0xF4, 0xC1, 0x5E, 0x8D, 0xDA, 0xC6, 0xD9, 0xC2, 0x2C, 0x92, 0x62, 0x53, 0x80,
+  0x5C, 0xB7, 0xFA, 0x90, 0xC6, 0xD5, 0x61, 0x35, 0x54, 0x02, 0x78, 0xF2, 0x1C, 0x1C, 0x68, 0xC8,
+  0xE8, 0x7C, 0xC0, 0x00, 0x7E, 0xAF, 0x30, 0xC8, 0xEC, 0x43, 0xD6, 0xE9, 0xC4, 0x71, 0x64, 0xFB,
+  0xA5, 0x3D, 0x87, 0x71, 0xE5, 0x67, 0xC8, 0x73, 0xA3, 0xAA, 0x2D, 0x1C, 0x8F, 0x70, 0xDA, 0xFF,
+  0xA8, 0x18, 0x31, 0xDB, 0xEF, 0x72, 0x67, 0xAB, 0xD7, 0xE2, 0xA6, 0xAF, 0x82, 0x47, 0xCF, 0x43,
+  0xB9, 0x5D, 0x6A, 0xB0, 0x12, 0x92, 0xA4, 0x50, 0x95, 0x18, 0x84, 0x67, 0x59, 0x3A, 0x33, 0x03,
+  0x57, 0x59, 0xDE, 0xC1, 0x7F, 0xFA, 0x19, 0x5C, 0x7D, 0xF2, 0xFE, 0xF4, 0x7D, 0x39, 0xF2, 0x28,
+  0x5D, 0xB7, 0xB5, 0xD7, 0x2A, 0x73, 0xB2, 0x55, 0x2A, 0xB5, 0xB0, 0x62, 0xD6, 0x2C, 0x1E, 0x88,
+  0x8F, 0x3A, 0xE4, 0x59, 0x56, 0x77, 0xFA, 0x06, 0xF8, 0xB1, 0xCB, 0x4B, 0x4A, 0x4A, 0x17, 0x68,
+  0x09, 0x5E, 0x02, 0x16, 0x41, 0xC2, 0x1C, 0xBE, 0xE7, 0x3F, 0x3F, 0x0A, 0xF6, 0xFA, 0x0D, 0x4F,
+  0xA2, 0xCB, 0xFE, 0x10, 0x64, 0xD4, 0x6C, 0x70, 0xFB, 0xC1, 0xF9, 0x45, 0x87, 0xB6, 0x9F, 0x88,
+  0xA9, 0x43, 0x66, 0x62, 0x9A, 0xB5, 0x7E, 0x5E, 0x0D, 0xC1, 0x2F, 0x94, 0x28, 0xE2, 0x4F, 0x84,
+  0xA0, 0xAF, 0xFA, 0xE9, 0xEB, 0xA7, 0xCD, 0x1A, 0xA2, 0x61, 0xA7, 0x22, 0xA9, 0x6B, 0x8D, 0x89,
+  0xF3, 0x7C, 0x38, 0xB4, 0xD8, 0xBC, 0xB0, 0x12, 0xA2, 0x11, 0xFA, 0xA5, 0x7D, 0x0E, 0x63, 0x8C,
+  0x9E, 0x59, 0xC6, 0xA1, 0x23, 0x7E, 0x73, 0x16, 0x76, 0xAF, 0xDD, 0x9A, 0x84, 0x9A, 0xCA, 0xBF,
+  0x94, 0xED, 0x8A, 0xEA, 0xC1, 0xAF, 0x01, 0x3A, 0x6D, 0x2E, 0x23, 0xC1, 0x47, 0x32, 0x1D, 0x15,
+  0x18, 0x45, 0x29, 0x5C, 0x48, 0x59, 0x14, 0x86, 0x6C, 0xCC, 0x7E, 0x92, 0x83, 0x82, 0xA6, 0xAA,
+  0x4C, 0x1E, 0xA1, 0x43, 0xE6, 0x4B, 0x98, 0xE1, 0x92, 0x89, 0xC8, 0x7C, 0x8C, 0x51, 0xF9, 0x3E,
+  0x0F, 0x12, 0xEA, 0x69, 0x4E, 0x31, 0x0B, 0xF2, 0xA3, 0x37, 0x3D, 0xF9, 0xEE, 0xF7, 0x7E, 0x6F,
+  0x98, 0x5A, 0xBF, 0xDF, 0xE3, 0x89, 0xE1, 0x78, 0xF4, 0x9D, 0xA6, 0x06, 0xEB, 0x7E, 0x30, 0x9D,
+  0x49, 0xA7, 0xAC, 0x5C, 0x37, 0xFB, 0x47, 0xF5, 0x41, 0x8C, 0xAC, 0xD6, 0xA8, 0x88, 0x18, 0x39,
+  0x34, 0x98, 0x45, 0xC9, 0x4A, 0x30, 0x4D, 0x24, 0xA3, 0x4C, 0x1D, 0x9D, 0x45, 0x27, 0x19, 0x2D,
+  0xB6, 0x7E, 0x85, 0x9F, 0xD7, 0x19, 0xF5, 0x1F, 0x5E, 0x27, 0x64, 0x31, 0x27, 0x76, 0xD9, 0xC7,
+  0xFB, 0x8B, 0xAD, 0x91, 0xD7, 0x3D, 0x8F, 0x24, 0x6F, 0x7F, 0x6A, 0x3F, 0xC8, 0xBE, 0xCE, 0x58,
+  0xB0, 0xDD, 0xDD, 0x3E, 0xD8, 0x2F, 0x83, 0x9E, 0xEB, 0xE4, 0x4C, 0xE1, 0x43, 0x30, 0xB4, 0x31,
+  0x53, 0x62, 0x83, 0xB7, 0x8A, 0xB6, 0xEE, 0x67, 0xCA, 0xFF, 0x06, 0xA5, 0x52, 0xA2, 0x76, 0x3A,
+  0xBD, 0x8D, 0x38, 0x54, 0x57, 0xC1, 0x69, 0xEF, 0xD0, 0xD8, 0xB8, 0xB4, 0xCF, 0x20, 0xB5, 0xFD,
+  0xF7, 0x90, 0x21, 0x47, 0x9B, 0x28, 0xFE, 0x17, 0x2B, 0x4F, 0xA3, 0xBA, 0x61, 0xAE, 0xCE, 0x87,
+  0xA3, 0x35, 0x44, 0x2D, 0xB3, 0xF3, 0x51, 0x8F, 0x36, 0xC5, 0x3B, 0x74, 0x2C, 0x66, 0x97, 0xDE,
+  0x17, 0xC2, 0xE0, 0xF7, 0x4C, 0xB5, 0x0B, 0xB7, 0x36, 0x21, 0x54, 0xBE, 0x9F, 0x18, 0x3D, 0x3E,
+  0xC9, 0x2F, 0x18, 0xC0, 0x81, 0x65, 0xEF, 0xF6, 0x92, 0x75, 0x81, 0xF9, 0xCB, 0xD9, 0x0E, 0x75,
+  0xC5, 0x9E, 0x2D, 0x51, 0x17, 0x9B, 0x29, 0xF8, 0x83, 0x1F, 0x42, 0xFA, 0x0C, 0x5C, 0x71, 0xC5,
+  0xB7, 0x2B, 0x69, 0xA2, 0xAD, 0x24, 0x9C, 0x7B, 0x4D, 0x16, 0x1D, 0x16, 0x43, 0xBD, 0x2A, 0xBB,
+  0x3A, 0xEC, 0x71, 0x2B, 0x84, 0x2B, 0xEC, 0x58, 0x96, 0xCC, 0x08, 0x5D, 0x0A, 0x75, 0x9C, 0xFD,
+  0x43, 0x7B, 0xE3, 0x6F, 0x9B, 0xF1, 0xC7, 0x08, 0x08, 0x64, 0xF0, 0x04, 0xFD, 0x52, 0xF9, 0xD7,
+  0x0F, 0x7E, 0xD9, 0x83, 0x76, 0x5E, 0x13, 0x4E, 0xF9, 0xF3, 0xB9, 0xEA, 0x5D, 0x87, 0x4F, 0x6B,
+  0x01, 0xEE, 0x51, 0xAB, 0x7D, 0x05, 0x65, 0xB7, 0x0B, 0x35, 0x73, 0xF0, 0x4E, 0x3F, 0x82, 0x05,
+  0x47, 0xD8, 0xAB, 0x32, 0x47, 0xBD, 0xFC, 0x1F, 0x80, 0xA4, 0xBE, 0x56, 0x17, 0xB4, 0xA7, 0x9E,
+  0xE3, 0xF7, 0x3C, 0x63, 0xB0, 0xB8, 0xB2, 0x87, 0x54, 0x6F, 0xF6, 0xFC, 0x8B, 0x4B, 0xB7, 0x8A,
+  0xE1, 0x67, 0x70, 0x6F, 0x2A, 0xF2, 0x91, 0x55, 0xA9, 0xCE, 0x02, 0x75, 0xAF, 0xE7, 0xDC, 0xD2,
+  0xBF, 0xF9, 0xAB, 0xB6, 0x5B, 0x9A, 0xA1, 0xD0, 0x39, 0x0D, 0x7D, 0x52, 0x73, 0x5E, 0x57, 0xB8,
+  0x50, 0xBD, 0xA0, 0xC4, 0xD9, 0xCC, 0xF5, 0xD4, 0x0E, 0x50, 0x58, 0xA6, 0x30, 0xC4, 0xE1, 0xD5,
+  0x64, 0xAC, 0xD2, 0x22, 0x01, 0xAB, 0xB0, 0xFB, 0x2C, 0x04, 0xE7, 0x62, 0x86, 0xFF, 0xF3, 0xA9,
+  0x8E, 0x9C, 0xDD, 0x1A, 0x1C, 0x7E, 0xA2, 0xE0, 0x8C, 0xBC, 0x65, 0x5D, 0xDB, 0xFA, 0xB4, 0x53,
+  0xCF, 0xDC, 0x4D, 0x77, 0x23, 0xE9, 0xD4, 0x62, 0xDC, 0x25, 0xD7, 0x85, 0xBE, 0x66, 0x18, 0x1A,
+  0x59, 0x3C, 0xB9, 0x50, 0xD6, 0xB6, 0x2F, 0xB6, 0x69, 0xB2, 0x43, 0xE2, 0x93, 0x5B, 0xB1, 0xB7,
+  0x11, 0x4C, 0x2E, 0xFA, 0x25, 0xFA, 0x63, 0xAC, 0xC1, 0xA3, 0xC3, 0xEB, 0xF6, 0xAE, 0x07, 0x60,
+  0x61, 0x40, 0x4A, 0x31, 0xCD, 0x4D, 0x38, 0x02, 0xC9, 0x15, 0x4C, 0xEB, 0xC4, 0x76, 0xA9, 0x58,
+  0x48, 0x28, 0x78, 0xCA, 0xF7, 0xB5, 0x8C, 0xCE, 0x97, 0x29, 0x8F, 0x69, 0x7F, 0x6C, 0x06, 0x60,
+  0xCD, 0x87, 0x77, 0xB2, 0x7B, 0x9F, 0x15, 0x61, 0xB4, 0x1A, 0xBB, 0xEF, 0x00, 0xC6, 0xC6, 0xCD,
+  0xC5, 0xD7, 0x54, 0x5F, 0xFC, 0x36, 0xB1, 0xB5, 0xAB, 0x3F, 0xB2, 0x8D, 0x40, 0x00, 0x48, 0xD3,
+  0x50, 0x18, 0xBC, 0xFB, 0xC9, 0xBF, 0xA2, 0x0E, 0x0F, 0x7F, 0xBB, 0xBA, 0xC9, 0xDA, 0xE5, 0x0B,
+  0xE0, 0xF0, 0x51, 0x67, 0x13, 0x6C, 0x40, 0xB5, 0x18, 0x31, 0xC2, 0xBE, 0x42, 0xA5, 0x67, 0x67,
+  0x30, 0xAE, 0x22, 0x22, 0x99, 0xA5, 0xB9, 0x0B, 0x78, 0x32, 0xF4, 0xB3, 0x6D, 0x30, 0x2C, 0x21,
+  0x46, 0xC6, 0x1B, 0xAC, 0x4A, 0xC4, 0x70, 0x0D, 0xFB, 0xF7, 0xCC, 0x38, 0x4B, 0xB3, 0x2B, 0x04,
+  0x2C, 0x65, 0xF2, 0x9B, 0x59, 0x09, 0x08, 0xD2, 0xFD, 0x38, 0xCD, 0x1E, 0x4E, 0xDD, 0xC8, 0xE4,
+  0xDC, 0x00, 0x01, 0x06, 0xD5, 0xD5, 0xD7, 0xE1, 0xF3, 0xC8, 0x2B, 0xB3, 0x48, 0xD0, 0x0B, 0xB4,
+  0xA7, 0xE5, 0x0B, 0xCC, 0xF8, 0x58, 0x77, 0xAF, 0x0C, 0xE4, 0x18, 0x80, 0xC6, 0x85, 0xF7, 0x86,
+  0x18, 0xB8, 0x46, 0x1B, 0x9C, 0xED, 0x4E, 0xF8, 0x61, 0x7F, 0x7E, 0xC7, 0xA6, 0xD0, 0x9A, 0x92,
+  0x6D, 0x12, 0x15, 0x92, 0x7F, 0xBA, 0x56, 0xAA, 0x4C, 0x3A, 0x8F, 0x93, 0x9A, 0xF6, 0x3D, 0x86,
+  0x65, 0xA3, 0x92, 0x0C, 0xEF, 0xE5, 0x45, 0x96, 0x34, 0x51, 0xDA, 0x41, 0x2E, 0x07, 0x17, 0x0D,
+  0xA1, 0xF7, 0x8A, 0x56, 0x1B, 0x4D, 0xA2, 0x59, 0xA8, 0x28, 0x01, 0x67, 0xEC, 0xDB, 0xB2, 0x1D,
+  0x24, 0xE3, 0x21, 0x86, 0x83, 0xBE, 0xBD, 0x44, 0x77, 0x11, 0x9D, 0x8F, 0xEA, 0xA4, 0x4E, 0xAA,
+  0x77, 0x74, 0x32, 0x61, 0x39, 0x7D, 0x3E, 0xDB, 0x58, 0xF2, 0xE8, 0xD4, 0x20, 0xC0, 0x74, 0xDF,
+  0x5D, 0x68, 0x76, 0x3D, 0x27, 0x1A, 0x1C, 0xF8, 0xA6, 0x32, 0x39, 0x8D, 0x77, 0xC4, 0x5E, 0x5A,
+  0x87, 0x0D, 0x5A, 0x4B, 0x84, 0xF6, 0x9E, 0x8E, 0x3A, 0x77, 0x61, 0xD1, 0xD0, 0x66, 0x8D, 0x79,
+  0xD5, 0x07, 0x5C, 0xDF, 0x46, 0xB9, 0xDF, 0xBC, 0xF4, 0x85, 0x6F, 0x5A, 0x69, 0xCE, 0xC3, 0x40,
+  0x26, 0xDB, 0x99, 0xD6, 0x55, 0x2F, 0xF5, 0x5A, 0x9A, 0xEA, 0xD9, 0x70, 0x05, 0x13, 0xFD, 0x54,
+  0x7B, 0xDA, 0x19, 0x9F, 0x71, 0x94, 0xA9, 0x12, 0x97, 0x5D, 0x66, 0x10, 0xEC, 0x2F, 0x2F, 0xDA,
+  0x64, 0xA2, 0x3B, 0x4A, 0x4E, 0x51, 0xEE, 0x0F, 0xB0, 0x99, 0x61, 0x4D, 0x73, 0x14, 0x37, 0x4B,
+  0xCF, 0x35, 0x7A, 0x9A, 0xB0, 0x9C, 0x6E, 0x64, 0xFC, 0x96, 0x8E, 0x4C, 0x3A, 0x5C, 0xFC, 0xF8,
+  0x01, 0x2F, 0x0D, 0xB6, 0xEC, 0x06, 0xF3, 0xD3, 0x2A, 0x82, 0xC2, 0x86, 0xE3, 0xCC, 0x63, 0x1A,
+  0x44, 0xCA, 0xB3, 0x3F, 0x49, 0x17, 0x4C, 0x22, 0x46, 0xE5, 0x0C, 0xD0, 0x88, 0x97, 0x03, 0x36,
+  0xA2, 0x49, 0xB1, 0xD9, 0x1A, 0x1F, 0xB0, 0x9F, 0x13, 0xA4, 0x60, 0x3E, 0x5E, 0x67, 0x55, 0x55,
+  0x5F, 0xBC, 0xC3, 0x3F, 0x23, 0xBD, 0x28, 0xFF, 0xC7, 0xA5, 0xFB, 0xA0, 0x08, 0x23, 0x37, 0x74,
+  0x29, 0xAE, 0x52, 0x4D, 0xA4, 0x9E, 0x52, 0x5F, 0x9D, 0x86, 0x73, 0xED, 0x98, 0xE8, 0xC9, 0x35,
+  0xA8, 0xB6, 0x56, 0xC1, 0x29, 0xC5, 0xF9, 0xFB, 0xEA, 0x6C, 0xA9, 0xCF, 0xEF, 0xED, 0xBA, 0xF9,
+  0x93, 0xE4, 0xCD, 0xF0, 0x17, 0x49, 0xA5, 0x75, 0x99, 0xF1, 0x1E, 0x16, 0x02, 0x1D, 0x52, 0x73,
+  0x83, 0xA4, 0x3B, 0xD0, 0x2D, 0xED, 0xDA, 0xD5, 0x4C, 0x8F, 0x47, 0xC1, 0x82, 0xF6, 0x2F, 0x05,
+  0x5B, 0x95, 0x0B, 0x57, 0xCC, 0xBE, 0x7E, 0x56, 0xA6, 0x2C, 0x9B, 0x2D, 0xBD, 0x9B, 0xB1, 0xB7,
+  0x6D, 0x3C, 0x5D, 0x9A, 0x9D, 0xAF, 0x2B, 0xD4, 0x2F, 0xCF, 0x14, 0xB1, 0x01, 0x77, 0x18, 0xBD,
+  0x9A, 0x78, 0x71, 0x04, 0x65, 0xE5, 0x2B, 0xE1, 0xB4, 0x97, 0x02, 0x43, 0x4E, 0x08, 0xE7, 0x17,
+  0x28, 0x1A, 0xAF, 0xB7, 0x9F, 0xF1, 0x31, 0xBF, 0xF0, 0xBC, 0x5E, 0x43, 0x70, 0x62, 0x69, 0xC9,
+  0x3D, 0xDB, 0xCA, 0x84, 0x52, 0xBF, 0x7E, 0x74, 0xA5, 0x80, 0x9A, 0x39, 0x36, 0x39, 0x17, 0x81,
+  0x67, 0x13, 0x80, 0xB6, 0x41, 0xEE, 0x73, 0x93, 0x49, 0x5B, 0x5B, 0x34, 0xAB, 0x39, 0x45, 0xEE,
+  0x6D, 0x8C, 0x16, 0xDC, 0xBD, 0xA2, 0xDB, 0x14, 0x49, 0xB5, 0x73, 0xB4, 0xF3, 0x4C, 0xC3, 0x9C,
+  0xFA, 0x33, 0xE9, 0xAD, 0x77, 0x60, 0x3A, 0xDB, 0x95, 0xAD, 0xFD, 0x7F, 0x97, 0xF8, 0x9A, 0x23,
+  0x52, 0xC4, 0x12, 0xD2, 0x4C, 0xBB, 0x73, 0xD8, 0x53, 0xA9, 0x75, 0x49, 0x02, 0x39, 0x66, 0xE5,
+  0x7B, 0x7A, 0x67, 0xF0, 0x41, 0x44, 0x33, 0x07, 0xC2, 0x25, 0x4B, 0xB1, 0x54, 0xAE, 0x06, 0xED,
+  0xCB, 0x75, 0x4D, 0x93, 0x03, 0x40, 0x34, 0x3A, 0xA7, 0x63, 0xDF, 0x39, 0x93, 0xE8, 0xA3, 0x86,
+  0x81, 0x0E, 0xEF, 0xB8, 0x34, 0x81, 0xB9, 0xDC, 0x3B, 0xDD, 0x7A, 0xAD, 0x42, 0xA3, 0xF3, 0x7A,
+  0x34, 0x8B, 0x7E, 0x48, 0xD7, 0x3D, 0x9F, 0xD0, 0x2A, 0xE3, 0x45, 0x15, 0xB4, 0x79, 0xD8, 0x8D,
+  0xF8, 0xF4, 0xF6, 0x52, 0x75, 0xAB, 0xC6, 0xA4, 0x3B, 0x4C, 0x7A, 0x99, 0xEE, 0xD7, 0x47, 0x3E,
+  0x19, 0xF2, 0x05, 0xEC, 0x21, 0xD4, 0x3C, 0xE6, 0xF7, 0x7B, 0xEE, 0x65, 0xEB, 0x4B, 0x84, 0x4C,
+  0x91, 0xD3, 0xC7, 0xCC, 0xA2, 0x63, 0xA0, 0xAC, 0xFB, 0x19, 0x6D, 0x7C, 0xDC, 0xE0, 0xBF, 0x2B,
+  0xE9, 0xCE, 0x3A, 0x8A, 0x37, 0x56, 0xFF, 0xF8, 0x65, 0x28, 0x79, 0x3A, 0xF8, 0xB0, 0x94, 0x14,
+  0x8D, 0x27, 0x17, 0xF5, 0xCF, 0x94, 0xF3, 0xC1, 0x36, 0xF6, 0xF1, 0x33, 0xDC, 0xB3, 0x4E, 0xEC,
+  0x4F, 0x5E, 0xF7, 0xD5, 0x87, 0x66, 0x2C, 0xA6, 0x5E, 0xBE, 0xD8, 0xD9, 0x76, 0x17, 0x7B, 0x73,
+  0xB3, 0x3D, 0xE1, 0x55, 0xD8, 0xC2, 0x9F, 0x0E, 0x2F, 0x01, 0x3E, 0x09, 0xAF, 0x4C, 0x8C, 0x86,
+  0x74, 0xC0, 0x59, 0x90, 0x37, 0x80, 0xA3, 0x2D, 0x76, 0x61, 0x76, 0x5A, 0x33, 0x53, 0x1A, 0x9F,
+  0xBC, 0x73, 0x0F, 0x7E, 0x98, 0x77, 0xF7, 0x66, 0xFF, 0x1C, 0x04, 0x38, 0x18, 0xEF, 0xEB, 0x12,
+  0x1C, 0x76, 0xE2, 0x02, 0x01, 0x22, 0xB0, 0xE8, 0x2A, 0xB0, 0xB0, 0xB3, 0xF9, 0x9E, 0x38, 0xA2,
+  0x79, 0x46, 0x3D, 0x90, 0xE7, 0x15, 0xC6, 0xBE, 0x03, 0xD0, 0x9D, 0xA9, 0x90, 0x9B, 0x16, 0x1C,
+  0xC4, 0x22, 0x78, 0x5B, 0x34, 0x73, 0xB9, 0xBC, 0xE1, 0x0B, 0x86, 0x98, 0x14, 0x0D, 0xDA, 0x88,
+  0xA3, 0xF3, 0x02, 0xC3, 0x8A, 0x8F, 0xB6, 0x77, 0x2A, 0x60, 0x97, 0x32, 0xEA, 0x5B, 0x44, 0xAF,
+  0x8E, 0xE4, 0xD5, 0x2E, 0x47, 0x04, 0x05, 0x39, 0xE8, 0x77, 0x15, 0x70, 0x67, 0x55, 0x08, 0x57,
+  0x6E, 0xEC, 0x28, 0xC5, 0x73, 0xD6, 0xB6, 0xA3, 0x23, 0x24, 0xD3, 0xFC, 0x4C, 0x08, 0x48, 0xC6,
+  0x2F, 0x52, 0x1F, 0xAA, 0x61, 0x05, 0xE9, 0xCB, 0x52, 0xD3, 0x17, 0x98, 0xEA, 0x59, 0x9B, 0x38,
+  0xBF, 0x3C, 0xCF, 0x21, 0x98, 0x2D, 0x6B, 0x94, 0x57, 0x9E, 0x5F, 0xFF, 0xE1, 0xEF, 0x10, 0x47,
+  0x96, 0xC4, 0x91, 0xD9, 0x73, 0x0A, 0x2F, 0xE6, 0x97, 0x9D, 0xF8, 0x19, 0x9D, 0x6C, 0x30, 0x7C,
+  0xE5, 0x97, 0xBE, 0x73, 0x9D, 0xA7, 0x41, 0x3E, 0xA0, 0xE6, 0x09, 0xF5, 0xB5, 0xCA, 0x8F, 0x91,
+  0x71, 0x1E, 0xA8, 0xFE, 0x59, 0xAF, 0xB3, 0xE9, 0xB7, 0x25, 0xA8, 0xAD, 0xD1, 0x3F, 0xE3, 0x75,
+  0xDA, 0x7A, 0xBB, 0x1F, 0x31, 0x33, 0xD1, 0xEF, 0x28, 0x0D, 0xE2, 0x68, 0xFB, 0xF3, 0xB6, 0x65,
+  0x76, 0x4D, 0x92, 0xE4, 0x42, 0xC0, 0x6C, 0x4F, 0xF2, 0x76, 0x52, 0x9F, 0x42, 0xDC, 0x09, 0xEC,
+  0xCA, 0x33, 0x93, 0xB6, 0x3C, 0x29, 0x8E, 0x8C, 0x37, 0xE7, 0x61, 0x2B, 0xE4, 0x6F, 0x68, 0xF9,
+  0xFA, 0x34, 0x29, 0x9B, 0x76, 0x40, 0x26, 0x53, 0xED, 0x30, 0x7B, 0x42, 0x53, 0xF5, 0x0B, 0x6B,
+  0xDB, 0x15, 0x07, 0x32, 0xF4, 0x70, 0xFD, 0x93, 0x90, 0x49, 0x31, 0xE6, 0x6F, 0x2E, 0xA4, 0xCC,
+  0xC5, 0x99, 0x01, 0x8F, 0xD6, 0x4E, 0x7F, 0x4B, 0x00, 0x79, 0x99, 0x6C, 0x6D, 0xD9, 0xED, 0x47,
+  0xDF, 0x8E, 0x47, 0x25, 0xA7, 0x26, 0x6F, 0x7E, 0xC8, 0x14, 0x6E, 0x08, 0x96, 0x64, 0x99, 0x97,
+  0xAC, 0x2F, 0xBD, 0xDB, 0xC8, 0xB0, 0x90, 0x42, 0x83, 0x1A, 0x62, 0x22, 0x54, 0xCA, 0x31, 0x78,
+  0x2C, 0x67, 0x0B, 0x03, 0xDB, 0xE1, 0x15, 0x6F, 0xD6, 0x8B, 0xDC, 0xE9, 0x90, 0xFA, 0xDD, 0x63,
+  0xEE, 0xC2, 0xC5, 0xD5, 0x98, 0x03, 0x09, 0xC0, 0x85, 0x33, 0x9D, 0x39, 0xF2, 0xDE, 0xBB, 0xFF,
+  0xB6, 0xFA, 0x0F, 0xEF, 0xC1, 0x57, 0xDA, 0xEB, 0x37, 0x87, 0xCA, 0x38, 0xD9, 0xE1, 0xFB, 0x4E,
+  0xCF, 0x95, 0xE0, 0x89, 0xB8, 0x02, 0x13, 0x47, 0x83, 0x3B, 0xA9, 0xF7, 0xDD, 0x1B, 0x04, 0x40
+};
+
+static_assert(sizeof(SpellFilter) == SPELL_FILTER_BYTES, "SPELL_FILTER_BITS must match the generated filter");
+
+/**
+ * @brief Look the word up in the flash filter, one hash pass over the
+ * folded chars and SPELL_HASHES bit reads, the probes are the low half
+ * of the hash stepped by its high half. Words with digits or other
+ * chars than letters and apostrophes are not checked.
+ * 
+ * @param word 
+ * @param len 
+ * @return true if the word is known or not checked
+ * @return false 
+ */
+bool isSpellWord(const char *word, uint8_t len) {
+  uint64_t hash = SPELL_HASH_BASIS;
+
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    if (word[idx] == '\'') continue;
+
+    uint8_t key = foldChar(word[idx]);
+    if (key == 0 || (key >= '0' && key <= '9')) {
+      return true;
+    }
+
+    hash = (hash ^ key) * SPELL_HASH_PRIME;
+  }
+
+  hash ^= hash >> 32;
+  hash *= SPELL_HASH_MIX;
+  hash ^= hash >> 32;
+
+  uint32_t probe = (uint32_t)hash;
+  uint32_t step = (uint32_t)(hash >> 32) | 1;
+  for (uint8_t idx = 0; idx < SPELL_HASHES; ++idx) {
+    uint32_t bit = ((uint64_t)probe * SPELL_FILTER_BITS) >> 32;
+    if ((SpellFilter[bit >> 3] & (1 << (bit & 7))) == 0) {
+      return false;
+    }
+    probe += step;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Check the word ending before the index when it was finished
+ * by a separator, an unknown word gets its chars marked. The English
+ * dictionary only checks text typed in the English layout.
+ * 
+ * @param editor 
+ * @param end index after the word
+ * @return uint8_t start of the marked word or end if not marked
+ */
+uint8_t checkSpelling(Editor *editor, uint8_t end) {
+  if (editor->layoutIndex != LAYOUT_ENGLISH) {
+    return end;
+  }
+
+  uint8_t start = end;
+  while (start > 0 && isSpellChar(editor->buffer[start - 1])) {
+    start--;
+  }
+
+  uint8_t len = end - start;
+  if (len == 0 || len > SPELL_WORD_SIZE || isSpellWord(&editor->buffer[start], len)) {
+    return end;
+  }
+
+  for (uint8_t idx = start; idx < end; ++idx) {
+    editor->spellMarks[idx / 32] |= 1UL << (idx % 32);
+  }
+  return start;
+}
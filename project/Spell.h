@@ -0,0 +1,69 @@
+/**
+ * @file Spell.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef SPELL_H
+#define SPELL_H
+
+#include <stdint.h>
+
+#include "CodePage.h"
+
+// Bloom filter size and hash count of the dictionary, generated by
+// tools/spellfilter.py for the chosen false positive rate
+#define SPELL_FILTER_BITS 17408
+#define SPELL_HASHES 7
+#define SPELL_FILTER_BYTES ((SPELL_FILTER_BITS + 7) / 8)
+
+// Word hash, 64-bit FNV-1a and the multiplier of its mix round
+#define SPELL_HASH_BASIS 0xCBF29CE484222325ULL
+#define SPELL_HASH_PRIME 0x100000001B3ULL
+#define SPELL_HASH_MIX 0xFF51AFD7ED558CCDULL
+
+// Longest word checked, longer words are never marked
+#define SPELL_WORD_SIZE 24
+
+// Lookup rounds of the link spell benchmark
+#define SPELL_BENCH_ROUNDS 16
+
+struct Editor;
+
+/**
+ * @brief Check whether the char belongs to a checked word, letters,
+ * digits and the apostrophe.
+ * 
+ * @param ch 
+ * @return true 
+ * @return false 
+ */
+inline bool isSpellChar(char ch) {
+  return foldChar(ch) != 0 || ch == '\'';
+}
+
+/**
+ * @brief Look the word up in the dictionary.
+ * 
+ * @param word 
+ * @param len 
+ * @return true 
+ * @return false 
+ */
+bool isSpellWord(const char *word, uint8_t len);
+
+/**
+ * @brief Check the word ending before the index and mark it.
+ * 
+ * @param editor 
+ * @param end 
+ * @return uint8_t 
+ */
+uint8_t checkSpelling(Editor *editor, uint8_t end);
+
+#endif
@@ -0,0 +1,274 @@
+/**
+ * @file Timer.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Timer.h"
+
+/**
+ * @brief Get the slot index of the tick on the level.
+ * 
+ * @param tick 
+ * @param level 
+ * @return uint8_t 
+ */
+uint8_t getTimerSlot(uint64_t tick, uint8_t level) {
+  return (tick >> (level * TIMER_SLOT_BITS)) & TIMER_SLOT_MASK;
+}
+
+/**
+ * @brief Link the timer into the slot of its deadline, the level is
+ * chosen by the distance to the deadline, timers past the top level
+ * range wait in its last slot and are placed again on cascade.
+ * 
+ * @param wheel 
+ * @param timer 
+ */
+void linkTimer(TimerWheel *wheel, Timer *timer) {
+  uint64_t delta = timer->deadline - wheel->now;
+  uint8_t level = 0;
+
+  while (level < TIMER_LEVELS - 1 && delta >> ((level + 1) * TIMER_SLOT_BITS) != 0) {
+    level++;
+  }
+
+  uint64_t tick = timer->deadline;
+  if (delta >> (TIMER_LEVELS * TIMER_SLOT_BITS) != 0) {
+    tick = wheel->now + ((uint64_t)TIMER_SLOT_MASK << (level * TIMER_SLOT_BITS));
+  }
+
+  uint8_t slot = getTimerSlot(tick, level);
+  Timer **head = &wheel->slots[level][slot];
+
+  timer->next = *head;
+  timer->prev = head;
+  if (*head != NULL) {
+    (*head)->prev = &timer->next;
+  }
+  *head = timer;
+
+  wheel->occupied[level] |= 1ULL << slot;
+}
+
+/**
+ * @brief Unlink the timer from its slot.
+ * 
+ * @param timer 
+ */
+void unlinkTimer(Timer *timer) {
+  *timer->prev = timer->next;
+  if (timer->next != NULL) {
+    timer->next->prev = timer->prev;
+  }
+
+  timer->next = NULL;
+  timer->prev = NULL;
+}
+
+/**
+ * @brief Unlink the armed timer, the slot bit is cleared when the
+ * timer was the last one of its slot, so the slot no longer counts
+ * for the next deadline. Timers taken out of the wheel for firing
+ * are not in any slot.
+ * 
+ * @param wheel 
+ * @param timer 
+ */
+void releaseTimer(TimerWheel *wheel, Timer *timer) {
+  Timer **head = timer->prev;
+  unlinkTimer(timer);
+
+  uintptr_t offset = (uintptr_t)head - (uintptr_t)&wheel->slots[0][0];
+  if (offset < sizeof(wheel->slots) && *head == NULL) {
+    uint16_t idx = offset / sizeof(Timer *);
+    wheel->occupied[idx / TIMER_SLOTS] &= ~(1ULL << (idx % TIMER_SLOTS));
+  }
+}
+
+/**
+ * @brief Detach the whole slot list and clear the slot.
+ * 
+ * @param wheel 
+ * @param level 
+ * @param slot 
+ * @return Timer* 
+ */
+Timer *takeSlot(TimerWheel *wheel, uint8_t level, uint8_t slot) {
+  Timer *list = wheel->slots[level][slot];
+  wheel->slots[level][slot] = NULL;
+  wheel->occupied[level] &= ~(1ULL << slot);
+  return list;
+}
+
+/**
+ * @brief Move the timers of the level slot for current tick into
+ * lower levels.
+ * 
+ * @param wheel 
+ * @param level 
+ */
+void cascadeTimers(TimerWheel *wheel, uint8_t level) {
+  Timer *timer = takeSlot(wheel, level, getTimerSlot(wheel->now, level));
+
+  while (timer != NULL) {
+    Timer *next = timer->next;
+    linkTimer(wheel, timer);
+    timer = next;
+  }
+}
+
+/**
+ * @brief Clear all slots and set the wheel time.
+ * 
+ * @param wheel 
+ * @param now 
+ */
+void initTimerWheel(TimerWheel *wheel, uint64_t now) {
+  memset(wheel->slots, 0, sizeof(wheel->slots));
+  memset(wheel->occupied, 0, sizeof(wheel->occupied));
+  wheel->now = now;
+}
+
+/**
+ * @brief Set the timer handler, callback may be NULL for timers
+ * which are only checked if armed.
+ * 
+ * @param timer 
+ * @param callback 
+ * @param context 
+ */
+void initTimer(Timer *timer, TimerCallback callback, void *context) {
+  timer->next = NULL;
+  timer->prev = NULL;
+  timer->deadline = 0;
+  timer->callback = callback;
+  timer->context = context;
+}
+
+/**
+ * @brief Unlink the armed timer and link it on the new deadline,
+ * deadline already passed fires on the next advance.
+ * 
+ * @param wheel 
+ * @param timer 
+ * @param deadline 
+ */
+void armTimer(TimerWheel *wheel, Timer *timer, uint64_t deadline) {
+  if (isTimerArmed(timer)) {
+    releaseTimer(wheel, timer);
+  }
+
+  timer->deadline = deadline < wheel->now ? wheel->now : deadline;
+  linkTimer(wheel, timer);
+}
+
+/**
+ * @brief Unlink the timer if armed, the slot bit is cleared with the
+ * last timer of the slot.
+ * 
+ * @param wheel 
+ * @param timer 
+ */
+void cancelTimer(TimerWheel *wheel, Timer *timer) {
+  if (isTimerArmed(timer)) {
+    releaseTimer(wheel, timer);
+  }
+}
+
+/**
+ * @brief Check if the timer is linked in the wheel.
+ * 
+ * @param timer 
+ * @return true 
+ * @return false 
+ */
+bool isTimerArmed(const Timer *timer) {
+  return timer->prev != NULL;
+}
+
+/**
+ * @brief Process the ticks up to now, on level boundaries the upper
+ * slots are cascaded down, then the expired timers of the tick slot
+ * are fired. Ticks without any lower level timer are skipped up to
+ * the next boundary. The callbacks may arm and cancel timers, flows
+ * resumed by their timers redraw and restart the blink.
+ * 
+ * @param wheel 
+ * @param now 
+ */
+void advanceTimers(TimerWheel *wheel, uint64_t now) {
+  while (wheel->now <= now) {
+    for (uint8_t level = TIMER_LEVELS - 1; level > 0; --level) {
+      if ((wheel->now & (((uint64_t)1 << (level * TIMER_SLOT_BITS)) - 1)) == 0) {
+        cascadeTimers(wheel, level);
+      }
+    }
+
+    if (wheel->occupied[0] == 0) {
+      uint64_t boundary = (wheel->now | TIMER_SLOT_MASK) + 1;
+      wheel->now = boundary <= now ? boundary : now + 1;
+      continue;
+    }
+
+    // The expired timers stay linked from the local list head, so a
+    // callback may cancel or re-arm any of the timers not fired yet
+    Timer *pending = takeSlot(wheel, 0, getTimerSlot(wheel->now, 0));
+    if (pending != NULL) pending->prev = &pending;
+    wheel->now++;
+
+    while (pending != NULL) {
+      Timer *timer = pending;
+      unlinkTimer(timer);
+
+      if (timer->callback != NULL) {
+        timer->callback(timer);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Get the deadline of the nearest lowest level timer or the
+ * start of the nearest upper level slot, where the timers cascade
+ * down, so waiting until the returned time never misses a timer.
+ * 
+ * @param wheel 
+ * @return uint64_t 
+ */
+uint64_t getNextDeadline(const TimerWheel *wheel) {
+  uint64_t deadline = TIMER_NEVER;
+
+  for (uint8_t level = 0; level < TIMER_LEVELS; ++level) {
+    uint64_t occupied = wheel->occupied[level];
+    if (occupied == 0) {
+      continue;
+    }
+
+    uint8_t shift = level * TIMER_SLOT_BITS;
+    uint8_t current = getTimerSlot(wheel->now, level);
+
+    // Upper level timers are at least one slot ahead, unless the
+    // current slot waits for cascade on the boundary tick
+    uint8_t ahead = level == 0 || (wheel->now & ((1ULL << shift) - 1)) == 0 ? 0 : 1;
+    uint8_t first = (current + ahead) & TIMER_SLOT_MASK;
+    uint64_t rotated = (occupied >> first) | (first != 0 ? occupied << (TIMER_SLOTS - first) : 0);
+    uint64_t distance = __builtin_ctzll(rotated) + ahead;
+
+    uint64_t tick = level == 0 ? wheel->now + distance : ((wheel->now >> shift) + distance) << shift;
+
+    if (tick < deadline) {
+      deadline = tick;
+    }
+  }
+
+  return deadline;
+}
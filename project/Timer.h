@@ -0,0 +1,117 @@
+/**
+ * @file Timer.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+// Slots of one wheel level, tick is 1 ms
+#define TIMER_SLOT_BITS 6
+#define TIMER_SLOTS (1 << TIMER_SLOT_BITS)
+#define TIMER_SLOT_MASK (TIMER_SLOTS - 1)
+
+// Wheel levels, 64 ms, 4.1 s and 262 s range
+#define TIMER_LEVELS 3
+
+// Deadline of empty wheel
+#define TIMER_NEVER UINT64_MAX
+
+struct Timer;
+
+// Handler of the expired timer
+typedef void (*TimerCallback)(Timer *timer);
+
+/**
+ * @brief Structure for one timer, linked into the wheel slot
+ * while armed, prev points to the link pointing at the timer.
+ * 
+ */
+struct Timer {
+  Timer *next;
+  Timer **prev;
+  uint64_t deadline;
+  TimerCallback callback;
+  void *context;
+};
+
+/**
+ * @brief Structure for hierarchical timer wheel, each level keeps
+ * the slot lists and bitmap of slots with timers, now is the next
+ * tick to be processed.
+ * 
+ */
+typedef struct {
+  Timer *slots[TIMER_LEVELS][TIMER_SLOTS];
+  uint64_t occupied[TIMER_LEVELS];
+  uint64_t now;
+} TimerWheel;
+
+/**
+ * @brief Initialize the empty wheel.
+ * 
+ * @param wheel 
+ * @param now 
+ */
+void initTimerWheel(TimerWheel *wheel, uint64_t now);
+
+/**
+ * @brief Initialize the disarmed timer.
+ * 
+ * @param timer 
+ * @param callback 
+ * @param context 
+ */
+void initTimer(Timer *timer, TimerCallback callback, void *context);
+
+/**
+ * @brief Arm or re-arm the timer on the deadline.
+ * 
+ * @param wheel 
+ * @param timer 
+ * @param deadline 
+ */
+void armTimer(TimerWheel *wheel, Timer *timer, uint64_t deadline);
+
+/**
+ * @brief Disarm the timer.
+ * 
+ * @param wheel 
+ * @param timer 
+ */
+void cancelTimer(TimerWheel *wheel, Timer *timer);
+
+/**
+ * @brief Check if the timer is armed.
+ * 
+ * @param timer 
+ * @return true 
+ * @return false 
+ */
+bool isTimerArmed(const Timer *timer);
+
+/**
+ * @brief Fire all timers with deadline up to now.
+ * 
+ * @param wheel 
+ * @param now 
+ */
+void advanceTimers(TimerWheel *wheel, uint64_t now);
+
+/**
+ * @brief Get the time the wheel has to be advanced to next.
+ * 
+ * @param wheel 
+ * @return uint64_t 
+ */
+uint64_t getNextDeadline(const TimerWheel *wheel);
+
+#endif
@@ -0,0 +1,422 @@
+/**
+ * @file Undo.cpp
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Undo.h"
+#include "Buffer.h"
+#include "Editor.h"
+
+static_assert(UNDO_ARENA_SIZE >= 2 * MESSAGE_SIZE, "Undo arena must fit the longest operation");
+
+/**
+ * @brief Get the operation on the position from the oldest one.
+ * 
+ * @param log 
+ * @param pos 
+ * @return UndoOp* 
+ */
+UndoOp *getUndoOp(UndoLog *log, uint8_t pos) {
+  return &log->ops[(log->first + pos) % UNDO_MAX_OPS];
+}
+
+/**
+ * @brief Get the payload size of the operation, write stores
+ * old and new char pair, insert and delete store the chars.
+ * 
+ * @param op 
+ * @return size_t 
+ */
+size_t getOpSize(const UndoOp *op) {
+  return op->type == OP_WRITE ? 2 * op->len : op->len;
+}
+
+/**
+ * @brief Get the payload byte of the operation.
+ * 
+ * @param log 
+ * @param op 
+ * @param pos 
+ * @return uint8_t 
+ */
+uint8_t getOpByte(UndoLog *log, const UndoOp *op, size_t pos) {
+  return log->arena[(op->data + pos) % UNDO_ARENA_SIZE];
+}
+
+/**
+ * @brief Set the payload byte of the operation.
+ * 
+ * @param log 
+ * @param op 
+ * @param pos 
+ * @param value 
+ */
+void setOpByte(UndoLog *log, const UndoOp *op, size_t pos, uint8_t value) {
+  log->arena[(op->data + pos) % UNDO_ARENA_SIZE] = value;
+}
+
+/**
+ * @brief Drop the oldest operation from the log.
+ * 
+ * @param log 
+ */
+void dropOldestOp(UndoLog *log) {
+  log->arenaUsed -= getOpSize(getUndoOp(log, 0));
+  log->first = (log->first + 1) % UNDO_MAX_OPS;
+  log->count--;
+  if (log->applied > 0) log->applied--;
+}
+
+/**
+ * @brief Drop the oldest operations until there is space for
+ * size bytes in the arena, the newest operation is kept.
+ * 
+ * @param log 
+ * @param size 
+ */
+void reserveArena(UndoLog *log, size_t size) {
+  while (log->arenaUsed + size > UNDO_ARENA_SIZE && log->count > 1) {
+    dropOldestOp(log);
+  }
+}
+
+/**
+ * @brief Append the bytes at the end of arena.
+ * 
+ * @param log 
+ * @param value 
+ */
+void pushArenaByte(UndoLog *log, uint8_t value) {
+  log->arena[log->arenaEnd] = value;
+  log->arenaEnd = (log->arenaEnd + 1) % UNDO_ARENA_SIZE;
+  log->arenaUsed++;
+
+  if (log->arenaUsed > log->arenaPeak) {
+    log->arenaPeak = log->arenaUsed;
+  }
+}
+
+/**
+ * @brief Drop the operations which can be redone, they are
+ * always at the end of arena.
+ * 
+ * @param log 
+ */
+void dropRedoOps(UndoLog *log) {
+  if (log->applied == log->count) {
+    return;
+  }
+
+  log->arenaEnd = getUndoOp(log, log->applied)->data;
+
+  while (log->count > log->applied) {
+    log->arenaUsed -= getOpSize(getUndoOp(log, log->count - 1));
+    log->count--;
+  }
+}
+
+/**
+ * @brief Start new operation at the end of the log.
+ * 
+ * @param log 
+ * @param type 
+ * @param index 
+ * @param cursor 
+ * @return UndoOp* 
+ */
+UndoOp *pushOp(UndoLog *log, OpType type, uint8_t index, uint8_t cursor) {
+  if (log->count == UNDO_MAX_OPS) {
+    dropOldestOp(log);
+  }
+
+  UndoOp *op = getUndoOp(log, log->count);
+  op->type = type;
+  op->index = index;
+  op->len = 0;
+  op->cursor = cursor;
+  op->data = log->arenaEnd;
+
+  log->count++;
+  log->applied = log->count;
+  log->sealed = false;
+
+  return op;
+}
+
+/**
+ * @brief Get the last operation if it can be extended.
+ * 
+ * @param log 
+ * @param type 
+ * @return UndoOp* 
+ */
+UndoOp *getOpenOp(UndoLog *log, OpType type) {
+  if (log->sealed || log->count == 0) {
+    return NULL;
+  }
+
+  UndoOp *op = getUndoOp(log, log->count - 1);
+  return op->type == type ? op : NULL;
+}
+
+/**
+ * @brief Record the write of char on the index, multitap cycle
+ * only replaces the new char of the last write so the whole
+ * cycle is undone at once.
+ * 
+ * @param editor 
+ * @param index 
+ * @param ch 
+ * @param isCycle 
+ */
+void recordWrite(Editor *editor, uint8_t index, char ch, bool isCycle) {
+  UndoLog *log = &editor->undo;
+
+  dropRedoOps(log);
+
+  UndoOp *op = getOpenOp(log, OP_WRITE);
+  if (isCycle && op != NULL && op->index + op->len - 1 == index) {
+    setOpByte(log, op, 2 * (op->len - 1) + 1, ch);
+    return;
+  }
+
+  reserveArena(log, 2);
+  op = pushOp(log, OP_WRITE, index, editor->bufferIndex);
+  op->len = 1;
+  pushArenaByte(log, getBufferCharByIndex(editor, index));
+  pushArenaByte(log, ch);
+}
+
+/**
+ * @brief Record the string already inserted into buffer on the
+ * index as one operation.
+ * 
+ * @param editor 
+ * @param index 
+ * @param len 
+ */
+void recordInsert(Editor *editor, uint8_t index, uint8_t len) {
+  UndoLog *log = &editor->undo;
+
+  dropRedoOps(log);
+  reserveArena(log, len);
+
+  UndoOp *op = pushOp(log, OP_INSERT, index, editor->bufferIndex);
+  op->len = len;
+
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    pushArenaByte(log, getBufferCharByIndex(editor, index + idx));
+  }
+
+  log->sealed = true;
+}
+
+/**
+ * @brief Record the delete of char on the index, deletes in short
+ * time in a row are grouped into one burst operation.
+ * 
+ * @param editor 
+ * @param index 
+ * @param backward 
+ * @param time 
+ */
+void recordDelete(Editor *editor, uint8_t index, bool backward, uint64_t time) {
+  UndoLog *log = &editor->undo;
+
+  dropRedoOps(log);
+
+  OpType type = backward ? OP_DELETE_BACK : OP_DELETE;
+  UndoOp *op = getOpenOp(log, type);
+
+  // Check if delete continues the burst
+  bool isBurst = op != NULL && op->len < MESSAGE_SIZE &&
+                 time - log->lastRecordTime <= UNDO_GROUP_DELAY &&
+                 (backward ? op->index == index + 1 : op->index == index);
+
+  reserveArena(log, 1);
+
+  if (isBurst) {
+    op->index = index;
+    op->len++;
+  }
+  else {
+    op = pushOp(log, type, index, editor->bufferIndex);
+    op->len = 1;
+  }
+
+  pushArenaByte(log, getBufferCharByIndex(editor, index));
+  log->lastRecordTime = time;
+}
+
+/**
+ * @brief Record the clear of the whole buffer as one delete.
+ * 
+ * @param editor 
+ */
+void recordClear(Editor *editor) {
+  UndoLog *log = &editor->undo;
+
+  dropRedoOps(log);
+
+  uint8_t len = getBufferLen(editor);
+  reserveArena(log, len);
+
+  UndoOp *op = pushOp(log, OP_DELETE, 0, editor->bufferIndex);
+  op->len = len;
+
+  for (uint8_t idx = 0; idx < len; ++idx) {
+    pushArenaByte(log, getBufferCharByIndex(editor, idx));
+  }
+
+  log->sealed = true;
+}
+
+/**
+ * @brief Revert the last applied operation and set the bufferIndex
+ * to its position before the operation.
+ * 
+ * @param editor 
+ * @return true 
+ * @return false 
+ */
+bool undoEdit(Editor *editor) {
+  UndoLog *log = &editor->undo;
+
+  if (log->applied == 0) {
+    return false;
+  }
+
+  UndoOp *op = getUndoOp(log, log->applied - 1);
+  char text[MESSAGE_SIZE];
+
+  switch (op->type) {
+    // Restore the old chars
+    case OP_WRITE:
+      for (uint8_t idx = 0; idx < op->len; ++idx) {
+        setBufferCharOnIndex(editor, op->index + idx, getOpByte(log, op, 2 * idx));
+      }
+      break;
+
+    // Remove the inserted chars
+    case OP_INSERT:
+      removeBufferRange(editor, op->index, op->len);
+      break;
+
+    // Insert back the removed chars
+    case OP_DELETE:
+      for (uint8_t idx = 0; idx < op->len; ++idx) {
+        text[idx] = getOpByte(log, op, idx);
+      }
+      insertBufferString(editor, op->index, text, op->len);
+      break;
+
+    // Insert back the removed chars in reversed order
+    case OP_DELETE_BACK:
+      for (uint8_t idx = 0; idx < op->len; ++idx) {
+        text[op->len - 1 - idx] = getOpByte(log, op, idx);
+      }
+      insertBufferString(editor, op->index, text, op->len);
+      break;
+  }
+
+  editor->bufferIndex = op->cursor;
+  log->applied--;
+  log->sealed = true;
+
+  return true;
+}
+
+/**
+ * @brief Apply again the last undone operation and set the bufferIndex
+ * to its position after the operation.
+ * 
+ * @param editor 
+ * @return true 
+ * @return false 
+ */
+bool redoEdit(Editor *editor) {
+  UndoLog *log = &editor->undo;
+
+  if (log->applied == log->count) {
+    return false;
+  }
+
+  UndoOp *op = getUndoOp(log, log->applied);
+  char text[MESSAGE_SIZE];
+
+  switch (op->type) {
+    // Write the new chars
+    case OP_WRITE:
+      for (uint8_t idx = 0; idx < op->len; ++idx) {
+        setBufferCharOnIndex(editor, op->index + idx, getOpByte(log, op, 2 * idx + 1));
+      }
+      editor->bufferIndex = op->index + op->len;
+      break;
+
+    // Insert the chars again
+    case OP_INSERT:
+      for (uint8_t idx = 0; idx < op->len; ++idx) {
+        text[idx] = getOpByte(log, op, idx);
+      }
+      insertBufferString(editor, op->index, text, op->len);
+      editor->bufferIndex = op->index + op->len;
+      break;
+
+    // Remove the chars again
+    case OP_DELETE:
+    case OP_DELETE_BACK:
+      removeBufferRange(editor, op->index, op->len);
+      editor->bufferIndex = op->index;
+      break;
+  }
+
+  log->applied++;
+  log->sealed = true;
+
+  return true;
+}
+
+/**
+ * @brief Drop all operations from the log.
+ * 
+ * @param editor 
+ */
+void resetUndo(Editor *editor) {
+  UndoLog *log = &editor->undo;
+
+  log->first = 0;
+  log->count = 0;
+  log->applied = 0;
+  log->arenaEnd = 0;
+  log->arenaUsed = 0;
+  log->sealed = true;
+}
+
+/**
+ * @brief Get the undo log memory usage, the memory is statically
+ * allocated so the memory size is the upper bound.
+ * 
+ * @param editor 
+ * @return UndoStats 
+ */
+UndoStats getUndoStats(Editor *editor) {
+  UndoLog *log = &editor->undo;
+
+  UndoStats stats;
+  stats.memorySize = sizeof(UndoLog);
+  stats.arenaSize = UNDO_ARENA_SIZE;
+  stats.arenaUsed = log->arenaUsed;
+  stats.arenaPeak = log->arenaPeak;
+  stats.undoOps = log->applied;
+  stats.redoOps = log->count - log->applied;
+  return stats;
+}
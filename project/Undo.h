@@ -0,0 +1,153 @@
+/**
+ * @file Undo.h
+ * @author Patrik Prochazka (xprochp00@stud.fit.vutbr.cz)
+ * @brief 
+ * @version 0.1
+ * @date 2026-10-19
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#ifndef UNDO_H
+#define UNDO_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Size of the undo log payload arena in bytes
+#define UNDO_ARENA_SIZE 512
+
+// Maximal number of operations kept in the undo log
+#define UNDO_MAX_OPS 64
+
+// Max delay between deletes grouped into one burst
+#define UNDO_GROUP_DELAY 500
+
+// Delay for undo and redo long press
+#define UNDO_SPEED_DELAY 300
+
+/**
+ * @brief Enum values for undo log operation types.
+ * 
+ */
+typedef enum {
+  OP_WRITE, OP_INSERT, OP_DELETE, OP_DELETE_BACK
+} OpType;
+
+/**
+ * @brief Structure for one undo log operation, the operation
+ * payload is stored in the arena starting at data offset.
+ * 
+ */
+typedef struct {
+  uint8_t type;
+  uint8_t index;
+  uint8_t len;
+  uint8_t cursor;
+  uint16_t data;
+} UndoOp;
+
+/**
+ * @brief Structure for undo log memory usage report.
+ * 
+ */
+typedef struct {
+  size_t memorySize;
+  size_t arenaSize;
+  size_t arenaUsed;
+  size_t arenaPeak;
+  uint8_t undoOps;
+  uint8_t redoOps;
+} UndoStats;
+
+/**
+ * @brief Structure for the undo log of one editor, operations
+ * are kept in a ring and their payload in the arena ring.
+ * 
+ */
+typedef struct {
+  uint8_t arena[UNDO_ARENA_SIZE];
+  UndoOp ops[UNDO_MAX_OPS];
+  uint8_t first;
+  uint8_t count;
+  uint8_t applied;
+  uint16_t arenaEnd;
+  size_t arenaUsed;
+  size_t arenaPeak;
+  bool sealed;
+  uint64_t lastRecordTime;
+} UndoLog;
+
+struct Editor;
+
+/**
+ * @brief Record char write on the buffer index.
+ * 
+ * @param editor 
+ * @param index 
+ * @param ch 
+ * @param isCycle 
+ */
+void recordWrite(Editor *editor, uint8_t index, char ch, bool isCycle);
+
+/**
+ * @brief Record inserted string on the buffer index.
+ * 
+ * @param editor 
+ * @param index 
+ * @param len 
+ */
+void recordInsert(Editor *editor, uint8_t index, uint8_t len);
+
+/**
+ * @brief Record char delete on the buffer index.
+ * 
+ * @param editor 
+ * @param index 
+ * @param backward 
+ * @param time 
+ */
+void recordDelete(Editor *editor, uint8_t index, bool backward, uint64_t time);
+
+/**
+ * @brief Record clear of the whole buffer.
+ * 
+ * @param editor 
+ */
+void recordClear(Editor *editor);
+
+/**
+ * @brief Undo the last operation.
+ * 
+ * @param editor 
+ * @return true 
+ * @return false 
+ */
+bool undoEdit(Editor *editor);
+
+/**
+ * @brief Redo the last undone operation.
+ * 
+ * @param editor 
+ * @return true 
+ * @return false 
+ */
+bool redoEdit(Editor *editor);
+
+/**
+ * @brief Drop the whole undo log.
+ * 
+ * @param editor 
+ */
+void resetUndo(Editor *editor);
+
+/**
+ * @brief Get the undo log memory usage.
+ * 
+ * @param editor 
+ * @return UndoStats 
+ */
+UndoStats getUndoStats(Editor *editor);
+
+#endif
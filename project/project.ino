@@ -13,57 +13,84 @@
 
 #include "Display.h"
 #include "Keypad.h"
+#include "Link.h"
+#include "Render.h"
+#include "Editor.h"
+#include "Power.h"
+#include "Phonebook.h"
+#include "History.h"
+#include "Latency.h"
 
-// Current time
-uint64_t now = 0;
+// Editor shown on the device display
+Editor DeviceEditor;
+
+uint32_t inputStep();
 
 /**
- * @brief Start serial communication, itialize 
- * display, keypad, and draw initial header
+ * @brief Start serial link, initialize render slots, device editor,
+ * display, keypad, sleep wakeup, phonebook and message history, draw
+ * initial header and start the input and render tasks.
  * 
  */
 void setup() {
-  Serial.begin(921600);
-  initDisplay();
+  initLink();
+  initRender();
+  initEditor(&DeviceEditor, &Display, flushDevice);
+  initDisplay(&DeviceEditor);
   initKeypad();
-  drawHeader();
+  initPower();
+  initPhonebook();
+  initHistory();
+  drawHeader(&DeviceEditor);
+
+#if USE_RENDER_TASK
+  startTasks(inputStep);
+#endif
 }
 
 /**
- * @brief Get current time, scan the keypad and 
- * handles the pressed key by calling the handle
- * functions, redraw the header and cursor.
+ * @brief The work runs in the input and render task,
+ * so the Arduino loop task is removed, without the render task
+ * the loop sleeps until the next editor deadline.
  * 
  */
 void loop() {
-  now = millis();
+#if USE_RENDER_TASK
+  vTaskDelete(NULL);
+#else
+  delay(inputStep());
+#endif
+}
 
-  Key key = scanKeypad();
-  
-  if (key != KEY_NONE) {
-    switch (key) {
-      // Numerical key
-      case KEY_0: case KEY_1: 
-      case KEY_2: case KEY_3: 
-      case KEY_4: case KEY_5: 
-      case KEY_6: case KEY_7: 
-      case KEY_8: case KEY_9:
-        handleKey(key);
-        break;
+/**
+ * @brief Advance the editor timers to current time, scan the keypad
+ * and handle the pressed key, then handle frames received from the
+ * host link. The step is timed up to here, the idle editor light
+ * sleeps until the next wakeup, then the step is run again right away
+ * to read the waking key.
+ * 
+ * @return uint32_t time in ms the input may sleep, until the next
+ * editor deadline but at most one keypad scan period of the current
+ * scan rate
+ */
+uint32_t inputStep() {
+  startLoopStep();
+  setEditorTime(&DeviceEditor, millis());
 
-      // Star key
-      case KEY_S:
-        switchCaseMode();
-        break;
+  enterLoopPhase(LOOP_SCAN);
+  Key key = scanKeypad(&DeviceEditor);
+  enterLoopPhase(LOOP_EDIT);
+  handlePress(&DeviceEditor, key);
 
-      // Hashtag key
-      case KEY_H:
-        handleDelete(now);
-        break;
-    }
+  enterLoopPhase(LOOP_LINK);
+  pollLink(&DeviceEditor);
+  endLoopStep();
 
-    drawHeader();
+  uint32_t idle = getEditorIdle(&DeviceEditor, millis());
+  if (updatePower(&DeviceEditor, idle)) {
+    return 0;
   }
 
-  updateCursor();
+  uint32_t scanDelay = getScanDelay(&DeviceEditor);
+  return idle < scanDelay ? idle : scanDelay;
 }
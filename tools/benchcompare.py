@@ -0,0 +1,96 @@
+#!/usr/bin/env python3
+"""Compare Google Benchmark JSON reports with a stored baseline.
+
+Reads the reports of `build/microbench --benchmark_out=FILE` or
+`tools/link.py PORT microbench --save FILE`, matches the benchmarks by
+name and prints the change of every time against the baseline.
+`--max-regression PCT` fails the run when one is slower by more,
+`--max-mean-regression PCT` when their geometric mean is, which stays
+steady on a noisy host where single nanosecond timings do not.
+"""
+
+import argparse
+import json
+import math
+import sys
+
+# Nanoseconds in one time unit of the report
+TIME_UNITS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(path):
+    """Time per iteration in ns of every benchmark of the report,
+    aggregates other than the median are skipped."""
+    with open(path) as f:
+        report = json.load(f)
+
+    times = {}
+    for bench in report["benchmarks"]:
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        times[name] = bench["real_time"] * TIME_UNITS[bench.get("time_unit", "ns")]
+    return times
+
+
+def change(base, ns):
+    """Change of the time against the baseline in percent."""
+    return (ns - base) * 100.0 / max(base, 1e-9)
+
+
+def mean_change(baseline, report):
+    """Change of the geometric mean time of the benchmarks in both
+    reports against the baseline in percent."""
+    logs = [math.log(ns / baseline[name]) for name, ns in report.items()
+            if baseline.get(name, 0) > 0 and ns > 0]
+    return (math.exp(sum(logs) / len(logs)) - 1) * 100.0 if logs else 0.0
+
+
+def compare(baseline, report, max_regression=None):
+    """Print the change of every benchmark of the report, return the
+    names slower by more than the allowed percent."""
+    failed = []
+    print("%-36s %12s %12s %9s" % ("Benchmark", "Baseline", "Time", "Change"))
+    print("-" * 72)
+    for name, ns in report.items():
+        if name not in baseline:
+            print("%-36s %12s %9.1f ns %9s" % (name, "-", ns, "new"))
+            continue
+        diff = change(baseline[name], ns)
+        line = "%-36s %9.1f ns %9.1f ns %+8.1f%%" % (name, baseline[name], ns, diff)
+        if max_regression is not None and diff > max_regression:
+            line += "  FAIL"
+            failed.append(name)
+        print(line)
+
+    for name in baseline:
+        if name not in report:
+            print("%-36s %9.1f ns %12s %9s" % (name, baseline[name], "-", "gone"))
+    return failed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="stored report")
+    parser.add_argument("report", help="new report")
+    parser.add_argument("--max-regression", type=float, help="fail when a benchmark is slower by more percent")
+    parser.add_argument("--max-mean-regression", type=float,
+                        help="fail when the geometric mean is slower by more percent")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    report = load(args.report)
+    failed = compare(baseline, report, args.max_regression)
+    if failed:
+        print("%d benchmarks slower by more than %.1f%%" % (len(failed), args.max_regression))
+
+    mean = mean_change(baseline, report)
+    print("geometric mean %+.1f%%" % mean)
+    if args.max_mean_regression is not None and mean > args.max_mean_regression:
+        print("geometric mean slower by more than %.1f%%" % args.max_mean_regression)
+        failed.append("mean")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
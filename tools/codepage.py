@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Internal one byte code page of the terminal.
+
+Codes 0x20-0x7E are ASCII, 0x80-0x9B the GSM 03.38 chars missing in
+ISO 8859-2, 0xA0-0xFF ISO 8859-2 with the Central European letters.
+The firmware keeps one byte per char so buffer indexing stays O(1),
+UTF-8 and UCS-2 are converted only on the link and on send.
+Run with --c to print the code page tables of CodePage.cpp, the fold
+table gives the search key of every char for the message index.
+"""
+
+import argparse
+import sys
+import unicodedata
+
+UNKNOWN = "?"
+
+# GSM 03.38 chars without ISO 8859-2 code, from 0x80
+GSM_EXTRA = "£¥èùìòØøÅåΔΦΓΛΩΠΨΣΘΞÆæÑñ¡¿à€"
+
+
+def build():
+    """Unicode char of every code, None for codes without char."""
+    table = [None] * 256
+    for code in range(0x20, 0x7F):
+        table[code] = chr(code)
+    for offset, ch in enumerate(GSM_EXTRA):
+        table[0x80 + offset] = ch
+    for code in range(0xA0, 0x100):
+        table[code] = bytes([code]).decode("iso8859_2")
+    return table
+
+
+TABLE = build()
+CODES = {ch: code for code, ch in enumerate(TABLE) if ch is not None}
+
+
+def encode(text, strict=True):
+    """Internal bytes of the text, unknown chars fail or become '?'."""
+    out = bytearray()
+    for ch in text:
+        if ch in CODES:
+            out.append(CODES[ch])
+        elif strict:
+            raise UnicodeEncodeError("codepage", text, text.index(ch), text.index(ch) + 1,
+                                     "char not in the code page")
+        else:
+            out.append(CODES[UNKNOWN])
+    return bytes(out)
+
+
+def decode(data):
+    return "".join(TABLE[code] or UNKNOWN for code in data)
+
+
+def fold(code):
+    """Search key of the code, letters lower case without diacritics
+    when the base letter is ASCII, digits themselves and zero for word
+    separators."""
+    ch = TABLE[code]
+    if ch is None or unicodedata.category(ch) not in ("Lu", "Ll", "Nd"):
+        return 0
+    base = unicodedata.normalize("NFD", ch)[0].lower()
+    if base.isascii():
+        return ord(base)
+    return CODES.get(ch.lower(), code)
+
+
+def c_tables():
+    lines = ["// Unicode of every code, zero for codes without char",
+             "const uint16_t CodePageUnicode[256] = {"]
+    for row in range(0, 256, 8):
+        values = ", ".join("0x%04X" % ord(TABLE[code]) if TABLE[code] else "0x0000"
+                           for code in range(row, row + 8))
+        lines.append("  %s,%s // 0x%02X" % (values, "" if row < 248 else "", row))
+    lines[-1] = lines[-1].replace(", //", "  //")
+    lines.append("};")
+    lines.append("")
+    pairs = sorted((ord(TABLE[code]), code) for code in range(0x80, 0x100) if TABLE[code])
+    lines.append("// Codes of the non-ASCII chars sorted by Unicode")
+    lines.append("const CodePageEntry CodePageCodes[CODEPAGE_EXTRA] = {")
+    for start in range(0, len(pairs), 6):
+        chunk = pairs[start:start + 6]
+        text = ", ".join("{0x%04X, 0x%02X}" % pair for pair in chunk)
+        lines.append("  %s%s" % (text, "," if start + 6 < len(pairs) else ""))
+    lines.append("};")
+    lines.append("")
+    lines.append("// Search key of every code, zero for word separators")
+    lines.append("const uint8_t CodePageFold[256] = {")
+    for row in range(0, 256, 16):
+        values = ", ".join("0x%02X" % fold(code) for code in range(row, row + 16))
+        lines.append("  %s%s // 0x%02X" % (values, "," if row < 240 else " ", row))
+    lines.append("};")
+    return "\n".join(lines), len(pairs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--c", action="store_true", help="print the C tables")
+    args = parser.parse_args()
+    if args.c:
+        text, count = c_tables()
+        print("// CODEPAGE_EXTRA %d" % count)
+        print(text)
+        return 0
+    for row in range(0x20, 0x100, 16):
+        print("%02X %s" % (row, "".join(TABLE[code] or "." for code in range(row, row + 16))
+                           .replace("\xa0", "_").replace("\xad", "-")))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,197 @@
+#!/usr/bin/env python3
+"""Debouncer bench with synthetic bounce waveforms.
+
+Generates key matrix sample sequences with contact bounce, glitches,
+rollover of overlapping keys, star chords and ghost rectangles, runs
+them through the device debouncer (`B` link command) or its model
+here on the host with --offline, and checks every key toggles exactly
+once per press and release and no ghost key is ever reported pressed.
+Requires pyserial unless --offline.
+"""
+
+import argparse
+import random
+import struct
+import sys
+
+COLS = 3
+ROWS = 4
+KEYS = "123456789*0#"
+MAX_SAMPLES = 127
+DEBOUNCE_SCANS = 4
+CHORD_BIT = KEYS.index("*")
+
+
+def ghost_keys(sample):
+    """Keys of rectangles two rows share in two or more columns."""
+    ghosts = 0
+    for r1 in range(ROWS - 1):
+        row1 = (sample >> (r1 * COLS)) & ((1 << COLS) - 1)
+        for r2 in range(r1 + 1, ROWS):
+            common = row1 & (sample >> (r2 * COLS))
+            if common & (common - 1):
+                ghosts |= (common << (r1 * COLS)) | (common << (r2 * COLS))
+    return ghosts
+
+
+class Debouncer:
+    """Model of the firmware 2 bit vertical counter debouncer."""
+
+    def __init__(self):
+        self.state = self.count0 = self.count1 = 0
+
+    def feed(self, sample):
+        ghosts = ghost_keys(sample)
+        sample = (sample & ~ghosts) | (self.state & ghosts)
+        delta = sample ^ self.state
+        self.count1 = (self.count1 ^ self.count0) & delta
+        self.count0 = ~self.count0 & delta & 0xFFFF
+        toggled = delta & ~(self.count0 | self.count1)
+        self.state ^= toggled
+        return self.state
+
+
+def run_model(samples):
+    debouncer = Debouncer()
+    return [debouncer.feed(sample) for sample in samples]
+
+
+def key_wave(rng, start, hold, max_bounce):
+    """Levels of one key press, bounce on both edges, by sample index."""
+    wave = {}
+    t = start
+    for _ in range(rng.randint(0, max_bounce)):
+        wave[t] = rng.random() < 0.5
+        t += 1
+    for _ in range(hold):
+        wave[t] = True
+        t += 1
+    for _ in range(rng.randint(0, max_bounce)):
+        wave[t] = rng.random() < 0.5
+        t += 1
+    return wave, t
+
+
+def build(rng, presses, length, glitches=0):
+    """Matrix samples of the key presses, each press is (bit, wave)."""
+    samples = [0] * length
+    for bit, wave in presses:
+        for t, level in wave.items():
+            if level:
+                samples[t] |= 1 << bit
+    for _ in range(glitches):
+        t = rng.randrange(length)
+        samples[t] ^= 1 << rng.randrange(COLS * ROWS)
+    return samples
+
+
+def case_bounce(rng, args):
+    bit = rng.randrange(COLS * ROWS)
+    wave, end = key_wave(rng, 4, rng.randint(DEBOUNCE_SCANS + 2, 40), args.max_bounce)
+    return "bounce", build(rng, [(bit, wave)], end + 10), {bit: 1}, 0
+
+
+def case_rollover(rng, args):
+    bits = rng.sample([b for b in range(COLS * ROWS) if b != CHORD_BIT], 2)
+    first, end1 = key_wave(rng, 4, rng.randint(12, 30), args.max_bounce)
+    second, end2 = key_wave(rng, 4 + rng.randint(3, 8), rng.randint(12, 30), args.max_bounce)
+    samples = build(rng, [(bits[0], first), (bits[1], second)], max(end1, end2) + 10)
+    # Two keys in different rows and columns with no third key never ghost
+    return "rollover", samples, {bits[0]: 1, bits[1]: 1}, 0
+
+
+def case_chord(rng, args):
+    digit = rng.choice([b for b in range(COLS * ROWS) if KEYS[b].isdigit()])
+    star, end1 = key_wave(rng, 4, 60, args.max_bounce)
+    key, end2 = key_wave(rng, 20, rng.randint(10, 20), args.max_bounce)
+    samples = build(rng, [(CHORD_BIT, star), (digit, key)], max(end1, end2) + 10)
+    return "chord", samples, {CHORD_BIT: 1, digit: 1}, 1 << CHORD_BIT | 1 << digit
+
+
+def case_ghost(rng, args):
+    r1, r2 = rng.sample(range(ROWS), 2)
+    c1, c2 = rng.sample(range(COLS), 2)
+    corners = [r1 * COLS + c1, r1 * COLS + c2, r2 * COLS + c1]
+    phantom = r2 * COLS + c2
+    samples = [0] * 100
+    for order, bit in enumerate(corners):
+        for t in range(10 + 15 * order, 80):
+            samples[t] |= 1 << bit
+    for t in range(40, 80):
+        samples[t] |= 1 << phantom
+    # The third corner closes the rectangle together with the phantom
+    return "ghost", samples, {corners[0]: 1, corners[1]: 1}, 0
+
+
+def case_glitch(rng, args):
+    return "glitch", build(rng, [], 60, rng.randint(1, 6)), {}, 0
+
+
+CASES = (case_bounce, case_rollover, case_chord, case_ghost, case_glitch)
+
+
+def check(samples, states, presses, together):
+    """Count the press edges of the keys, all other keys stay released."""
+    edges = {}
+    previous = 0
+    seen_together = together == 0
+    for state in states:
+        for bit in range(COLS * ROWS):
+            if (state & ~previous) >> bit & 1:
+                edges[bit] = edges.get(bit, 0) + 1
+        if state & together == together:
+            seen_together = True
+        previous = state
+    if states[-1] != 0 or not seen_together:
+        return False
+    for bit in range(COLS * ROWS):
+        if edges.get(bit, 0) != presses.get(bit, 0):
+            return False
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port", nargs="?")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--offline", action="store_true", help="run the host model only")
+    parser.add_argument("--cases", type=int, default=200)
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--max-bounce", type=int, default=3,
+                        help="bounce samples per edge, below %d to be filtered" % DEBOUNCE_SCANS)
+    args = parser.parse_args()
+    if not args.offline and not args.port:
+        parser.error("PORT is required without --offline")
+
+    link = None
+    if not args.offline:
+        from link import Link
+        link = Link(args.port, args.baud)
+
+    rng = random.Random(args.seed)
+    results = {}
+    for number in range(args.cases):
+        name, samples, presses, together = CASES[number % len(CASES)](rng, args)
+        samples = samples[:MAX_SAMPLES]
+        states = run_model(samples)
+        if link is not None:
+            _, data = link.request("B", struct.pack("<%dH" % len(samples), *samples))
+            device = list(struct.unpack("<%dH" % len(samples), data))
+            if device != states:
+                print("%s case %d: device differs from the model" % (name, number))
+                states = device
+        passed, total = results.get(name, (0, 0))
+        ok = check(samples, states, presses, together)
+        results[name] = (passed + ok, total + 1)
+        if not ok:
+            print("%s case %d failed: %s" % (name, number, " ".join("%03x" % s for s in samples)))
+
+    failed = 0
+    for name, (passed, total) in results.items():
+        print("%-9s %4d / %d passed" % (name, passed, total))
+        failed += total - passed
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+"""Static RAM and flash footprint of every sketch module.
+
+Reads the section sizes of the compiled sketch objects with the
+toolchain `size` and sums them per module: code (.text, .literal),
+constants (.rodata), initialized data (.data, kept in flash and copied
+to RAM), zeroed data (.bss) and code placed in IRAM. Build with
+`arduino-cli compile --build-path BUILD` first, or pass the CMake host
+build with `--size size`, its thread-local pools count as data. With `--save` the
+report is stored as a baseline, with `--baseline` the growth of every
+module is shown and `--max-growth` fails the run on a regression.
+"""
+
+import argparse
+import glob
+import json
+import os
+import subprocess
+import sys
+
+KINDS = ("text", "rodata", "data", "bss", "iram")
+# Section name prefixes of every kind, other sections are not loaded
+SECTIONS = (
+    (".iram", "iram"),
+    (".text", "text"),
+    (".literal", "text"),
+    (".rodata", "rodata"),
+    (".dram", "data"),
+    (".data", "data"),
+    (".sdata", "data"),
+    (".tdata", "data"),
+    (".bss", "bss"),
+    (".sbss", "bss"),
+    (".tbss", "bss"),
+)
+
+# Object files of the arduino-cli build and of the CMake host build
+OBJECTS = (os.path.join("sketch", "*.o"), os.path.join("CMakeFiles", "editor.dir", "project", "*.o"))
+
+
+def module_name(path):
+    """Module of the object file, Buffer for sketch/Buffer.cpp.o."""
+    return os.path.basename(path).split(".")[0]
+
+
+def read_sections(size_tool, path):
+    """Get the bytes of every kind in the object file."""
+    out = subprocess.run([size_tool, "-A", path], capture_output=True, text=True, check=True).stdout
+    sizes = dict.fromkeys(KINDS, 0)
+    for line in out.splitlines()[2:]:
+        words = line.split()
+        if len(words) < 2 or not words[1].isdigit():
+            continue
+        for prefix, kind in SECTIONS:
+            if words[0].startswith(prefix):
+                sizes[kind] += int(words[1])
+                break
+    return sizes
+
+
+def measure(build, size_tool, modules):
+    """Get the footprint of the modules, all sketch modules if none."""
+    objects = sorted(path for pattern in OBJECTS for path in glob.glob(os.path.join(build, pattern)))
+    if not objects:
+        raise SystemExit("%s: no sketch objects, build with --build-path first" % build)
+    report = {}
+    for path in objects:
+        name = module_name(path)
+        if modules and name not in modules:
+            continue
+        sizes = read_sections(size_tool, path)
+        sizes["flash"] = sizes["text"] + sizes["rodata"] + sizes["data"] + sizes["iram"]
+        sizes["ram"] = sizes["data"] + sizes["bss"] + sizes["iram"]
+        report[name] = sizes
+    return report
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("build", help="arduino-cli build path or CMake host build")
+    parser.add_argument("--size", default="xtensa-esp32-elf-size", help="toolchain size command")
+    parser.add_argument("--modules", nargs="+", help="only these modules, e.g. Buffer Keypad Display")
+    parser.add_argument("--save", help="store the report as a JSON baseline")
+    parser.add_argument("--baseline", help="JSON baseline to compare with")
+    parser.add_argument("--max-growth", type=int, help="fail when a module RAM or flash grows more bytes")
+    args = parser.parse_args()
+
+    report = measure(args.build, args.size, args.modules)
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    print("%-12s %8s %8s %8s %8s %8s %9s %9s" % (("module",) + KINDS + ("flash", "RAM")))
+    failed = False
+    total = dict.fromkeys(KINDS + ("flash", "ram"), 0)
+    for name, sizes in sorted(report.items()):
+        for kind in total:
+            total[kind] += sizes[kind]
+        line = "%-12s %8d %8d %8d %8d %8d %9d %9d" % ((name,) + tuple(sizes[kind] for kind in KINDS + ("flash", "ram")))
+        if name in baseline:
+            flash = sizes["flash"] - baseline[name]["flash"]
+            ram = sizes["ram"] - baseline[name]["ram"]
+            line += "  flash %+d RAM %+d" % (flash, ram)
+            if args.max_growth is not None and max(flash, ram) > args.max_growth:
+                line += "  FAIL"
+                failed = True
+        print(line)
+    print("%-12s %8d %8d %8d %8d %8d %9d %9d" % (("total",) + tuple(total[kind] for kind in KINDS + ("flash", "ram"))))
+
+    if args.save:
+        with open(args.save, "w") as f:
+            json.dump(report, f, indent=1, sort_keys=True)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
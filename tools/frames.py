@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""PBM frame helpers and pixel diff of terminal display frames."""
+
+import argparse
+import sys
+
+WIDTH = 128
+HEIGHT = 64
+
+
+def write_pbm(path, pixels, width=WIDTH, height=HEIGHT):
+    """Write rows of 0/1 pixels as binary PBM (P4)."""
+    data = bytearray()
+    for row in pixels:
+        for x in range(0, width, 8):
+            byte = 0
+            for bit in range(8):
+                if x + bit < width and row[x + bit]:
+                    byte |= 0x80 >> bit
+            data.append(byte)
+    with open(path, "wb") as f:
+        f.write(b"P4\n%d %d\n" % (width, height) + bytes(data))
+
+
+def read_pbm(path):
+    """Read binary (P4) or plain (P1) PBM as rows of 0/1 pixels."""
+    with open(path, "rb") as f:
+        data = f.read()
+    tokens = []
+    pos = 0
+    while len(tokens) < 3:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        end = pos
+        while not data[end:end + 1].isspace():
+            end += 1
+        tokens.append(data[pos:end])
+        pos = end
+    magic, width, height = tokens[0], int(tokens[1]), int(tokens[2])
+    pos += 1
+    if magic == b"P4":
+        stride = (width + 7) // 8
+        return [[(data[pos + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)]
+                for y in range(height)]
+    if magic == b"P1":
+        bits = [int(c) for c in data[pos:].decode() if c in "01"]
+        return [bits[y * width:(y + 1) * width] for y in range(height)]
+    raise ValueError("%s: not a PBM file" % path)
+
+
+def diff(a, b):
+    """Return count of differing pixels and the diff mask."""
+    if len(a) != len(b) or len(a[0]) != len(b[0]):
+        raise ValueError("frame sizes differ")
+    mask = [[pa ^ pb for pa, pb in zip(ra, rb)] for ra, rb in zip(a, b)]
+    return sum(map(sum, mask)), mask
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("expected")
+    parser.add_argument("actual")
+    parser.add_argument("--out", help="write the diff mask as PBM")
+    args = parser.parse_args()
+
+    count, mask = diff(read_pbm(args.expected), read_pbm(args.actual))
+    if args.out:
+        write_pbm(args.out, mask, len(mask[0]), len(mask))
+    print("%d pixels differ" % count)
+    return 1 if count else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+"""Fuzzing farm for the editor core over one or more devices.
+
+Every device runs seeded random timed key sequences on its own fuzz
+editor and checks the editor invariants and the text area against a
+reference rendering after every step. Seeds from the corpus directory
+are replayed first, then fresh seeds are handed to whichever device is
+idle. Failing seeds are stored in the corpus directory.
+Requires pyserial.
+"""
+
+import argparse
+import os
+import queue
+import sys
+import threading
+import time
+
+from link import Link
+
+CHECKS = ["ok", "terminator", "tail", "index", "scroll", "cursor", "frame", "words"]
+ACTIONS = ["press", "hold", "text", "chord"]
+KEYS = "0123456789*#"
+
+
+def load_corpus(path):
+    seeds = []
+    for name in sorted(os.listdir(path)):
+        if name.endswith(".seed"):
+            with open(os.path.join(path, name)) as f:
+                seeds.append(int(f.readline().split()[0], 0))
+    return seeds
+
+
+def save_seed(path, seed, result):
+    steps, fail_step, check, key, action, _ = result
+    with open(os.path.join(path, "%08x.seed" % seed), "w") as f:
+        f.write("0x%08x %d\n" % (seed, steps))
+        f.write("step %d check %s key %s action %s\n"
+                % (fail_step, CHECKS[check], KEYS[key], ACTIONS[action]))
+
+
+def worker(port, args, seeds, stats, lock):
+    link = Link(port, args.baud, timeout=60.0)
+    while True:
+        try:
+            seed = seeds.get_nowait()
+        except queue.Empty:
+            return
+        result = link.fuzz(seed, args.steps)
+        steps, fail_step, check, key, action, run_us = result
+        with lock:
+            stats[port]["runs"] += 1
+            stats[port]["steps"] += steps
+            stats[port]["us"] += run_us
+            if check:
+                stats[port]["failures"] += 1
+                save_seed(args.corpus, seed, result)
+                print("%s seed 0x%08x step %d: %s after %s %s"
+                      % (port, seed, fail_step, CHECKS[check], ACTIONS[action], KEYS[key]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("ports", nargs="+")
+    parser.add_argument("--baud", type=int, default=921600)
+    parser.add_argument("--seeds", type=int, default=100, help="fresh seeds to run")
+    parser.add_argument("--first-seed", type=lambda v: int(v, 0), default=1)
+    parser.add_argument("--steps", type=int, default=1024, help="steps per seed")
+    parser.add_argument("--corpus", default=os.path.join(os.path.dirname(__file__), "corpus"))
+    args = parser.parse_args()
+
+    os.makedirs(args.corpus, exist_ok=True)
+    seeds = queue.Queue()
+    for seed in load_corpus(args.corpus) + list(range(args.first_seed, args.first_seed + args.seeds)):
+        seeds.put(seed)
+
+    lock = threading.Lock()
+    stats = {port: {"runs": 0, "steps": 0, "us": 0, "failures": 0} for port in args.ports}
+    threads = [threading.Thread(target=worker, args=(port, args, seeds, stats, lock)) for port in args.ports]
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    wall = time.perf_counter() - start
+
+    total = {"runs": 0, "steps": 0, "failures": 0}
+    print("%-16s %8s %10s %12s %9s" % ("device", "runs", "steps", "steps/s dev", "failures"))
+    for port, item in stats.items():
+        rate = item["steps"] / (item["us"] / 1e6) if item["us"] else 0
+        print("%-16s %8d %10d %12.0f %9d" % (port, item["runs"], item["steps"], rate, item["failures"]))
+        for name in total:
+            total[name] += item[name]
+    print("farm             %8d %10d %12.0f %9d" % (total["runs"], total["steps"], total["steps"] / wall, total["failures"]))
+    return 1 if total["failures"] else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Generate the font glyphs of the code page chars above ASCII.
+
+Letters with diacritics are composed from the ASCII glyph of the base
+letter in Font.cpp and a mark, accents above lowercase letters take the
+two free top rows, capitals are squeezed to six rows under the accent.
+Other chars are drawn here. Prints the glyph rows of codes 0x7F-0xFF
+for Font.cpp, `--show CHARS` draws the glyphs as text.
+"""
+
+import argparse
+import os
+import re
+import sys
+import unicodedata
+
+import codepage
+
+FONT = os.path.join(os.path.dirname(__file__), "..", "project", "Font.cpp")
+
+# Marks above, column bytes of the two top rows
+ABOVE = {
+    "\u0301": [0x00, 0x00, 0x02, 0x01, 0x00],  # acute
+    "\u0300": [0x00, 0x01, 0x02, 0x00, 0x00],  # grave
+    "\u030c": [0x00, 0x01, 0x02, 0x01, 0x00],  # caron
+    "\u0302": [0x00, 0x02, 0x01, 0x02, 0x00],  # circumflex
+    "\u0306": [0x00, 0x01, 0x02, 0x01, 0x00],  # breve, drawn as caron
+    "\u0308": [0x00, 0x01, 0x00, 0x01, 0x00],  # diaeresis
+    "\u030a": [0x00, 0x03, 0x01, 0x03, 0x00],  # ring
+    "\u030b": [0x00, 0x02, 0x01, 0x02, 0x01],  # double acute
+    "\u0303": [0x02, 0x01, 0x01, 0x02, 0x01],  # tilde
+    "\u0307": [0x00, 0x00, 0x01, 0x00, 0x00],  # dot
+}
+
+# Marks below, column bytes of the bottom row
+BELOW = {
+    "\u0328": [0x00, 0x00, 0x00, 0x80, 0x80],  # ogonek
+    "\u0327": [0x00, 0x00, 0x80, 0x80, 0x00],  # cedilla
+}
+
+# Chars without a base letter and mark, 5x8 columns
+DRAWN = {
+    "\x7f": [0x02, 0x01, 0x51, 0x09, 0x06],
+    "£": [0x48, 0x7E, 0x49, 0x41, 0x42],
+    "¥": [0x2B, 0x2C, 0x78, 0x2C, 0x2B],
+    "Ø": [0x5E, 0x31, 0x49, 0x46, 0x3D],
+    "ø": [0x58, 0x64, 0x54, 0x4C, 0x34],
+    "Δ": [0x70, 0x4C, 0x43, 0x4C, 0x70],
+    "Φ": [0x0C, 0x12, 0x7F, 0x12, 0x0C],
+    "Γ": [0x7F, 0x01, 0x01, 0x01, 0x03],
+    "Λ": [0x70, 0x0C, 0x03, 0x0C, 0x70],
+    "Ω": [0x5E, 0x61, 0x01, 0x61, 0x5E],
+    "Π": [0x7F, 0x01, 0x01, 0x01, 0x7F],
+    "Ψ": [0x07, 0x08, 0x7F, 0x08, 0x07],
+    "Σ": [0x63, 0x55, 0x49, 0x41, 0x63],
+    "Θ": [0x3E, 0x49, 0x49, 0x49, 0x3E],
+    "Ξ": [0x41, 0x49, 0x49, 0x49, 0x41],
+    "Æ": [0x7E, 0x09, 0x7F, 0x49, 0x41],
+    "æ": [0x20, 0x54, 0x78, 0x54, 0x58],
+    "¡": [0x00, 0x00, 0x7D, 0x00, 0x00],
+    "¿": [0x30, 0x48, 0x45, 0x40, 0x20],
+    "€": [0x14, 0x3E, 0x55, 0x41, 0x22],
+    "\xa0": [0x00, 0x00, 0x00, 0x00, 0x00],
+    "\xad": [0x08, 0x08, 0x08, 0x08, 0x00],
+    "˘": [0x00, 0x01, 0x02, 0x01, 0x00],
+    "˛": [0x00, 0x00, 0x80, 0x40, 0x00],
+    "ˇ": [0x00, 0x01, 0x02, 0x01, 0x00],
+    "¸": [0x00, 0x00, 0x80, 0x40, 0x00],
+    "˝": [0x00, 0x02, 0x01, 0x02, 0x01],
+    "¨": [0x00, 0x01, 0x00, 0x01, 0x00],
+    "´": [0x00, 0x00, 0x02, 0x01, 0x00],
+    "˙": [0x00, 0x00, 0x01, 0x00, 0x00],
+    "°": [0x00, 0x06, 0x09, 0x09, 0x06],
+    "¤": [0x22, 0x1C, 0x14, 0x1C, 0x22],
+    "§": [0x00, 0x4A, 0x55, 0x29, 0x00],
+    "×": [0x22, 0x14, 0x08, 0x14, 0x22],
+    "÷": [0x08, 0x08, 0x2A, 0x08, 0x08],
+    "ß": [0x7E, 0x01, 0x49, 0x56, 0x20],
+    "Ł": [0x7F, 0x48, 0x44, 0x40, 0x40],
+    "ł": [0x00, 0x49, 0x7F, 0x44, 0x00],
+    "Đ": [0x08, 0x7F, 0x49, 0x41, 0x3E],
+    "đ": [0x38, 0x44, 0x44, 0x4A, 0x7F],
+    # Caron as an apostrophe beside ascenders
+    "ď": [0x38, 0x44, 0x44, 0x7F, 0x03],
+    "ľ": [0x00, 0x41, 0x7F, 0x40, 0x03],
+    "Ľ": [0x7F, 0x40, 0x43, 0x40, 0x40],
+    "ť": [0x04, 0x04, 0x3F, 0x44, 0x27],
+}
+
+
+def load_ascii():
+    glyphs = {}
+    with open(FONT) as f:
+        text = f.read()
+    for values, ch in re.findall(r"\{([0-9A-Fx, ]+)\},? *// '(.)'", text):
+        glyphs[ch] = [int(v, 16) for v in values.split(",")]
+    if len(glyphs) < 95:
+        raise SystemExit("%s: ASCII glyphs not found" % FONT)
+    return glyphs
+
+
+def squeeze(columns):
+    """Drop the second row of a capital and move it down to rows 2-7."""
+    out = []
+    for column in columns:
+        rows = [(column >> row) & 1 for row in range(7)]
+        rows = rows[:1] + rows[2:]
+        out.append(sum(bit << (row + 2) for row, bit in enumerate(rows)))
+    return out
+
+
+def compose(ch, ascii_glyphs):
+    if ch in DRAWN:
+        return DRAWN[ch]
+    base, *marks = unicodedata.normalize("NFD", ch)
+    if base not in ascii_glyphs or len(marks) != 1:
+        raise SystemExit("no glyph for %r" % ch)
+    mark = marks[0]
+    columns = list(ascii_glyphs[base])
+    if mark in BELOW:
+        return [column | below for column, below in zip(columns, BELOW[mark])]
+    if mark not in ABOVE:
+        raise SystemExit("no mark %r of %r" % (mark, ch))
+    if base == "i":
+        columns = [column & ~0x01 for column in columns]
+    elif base.isupper():
+        columns = squeeze(columns)
+    return [column | above for column, above in zip(columns, ABOVE[mark])]
+
+
+def glyph_rows():
+    ascii_glyphs = load_ascii()
+    rows = []
+    for code in range(0x7F, 0x100):
+        ch = codepage.TABLE[code] or "\x7f"
+        columns = compose(ch, ascii_glyphs)
+        label = "0x%02X" % code if not ch.isprintable() or ch in "\xa0\xad" else "'%s'" % ch
+        rows.append("  {%s}, // %s" % (", ".join("0x%02X" % c for c in columns), label))
+    rows[-1] = rows[-1].replace("}, //", "}  //")
+    return rows
+
+
+def show(text):
+    ascii_glyphs = load_ascii()
+    glyphs = [compose(ch, ascii_glyphs) if ord(ch) > 0x7E else ascii_glyphs[ch] for ch in text]
+    for row in range(8):
+        print(" ".join("".join("#" if column >> row & 1 else "." for column in glyph) for glyph in glyphs))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--show", help="draw the glyphs of the chars")
+    args = parser.parse_args()
+    if args.show:
+        show(args.show)
+    else:
+        print("\n".join(glyph_rows()))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Compile keypad layout files into layout blobs.
+
+A layout file holds the layout name (up to 4 chars) on the first line
+and the symbol cycle of the digit keys 0 to 9 on the next ten lines,
+in UTF-8, lines starting with `#` are comments. Symbols are stored in
+the internal code page (codepage.py) with their upper case variants, the blob is loaded on the
+device with `link.py PORT layout FILE` (`L` command).
+"""
+
+import argparse
+import struct
+import sys
+
+import codepage
+
+LAYOUT_KEYS = 10
+LAYOUT_MAX_CYCLE = 8
+LAYOUT_NAME_SIZE = 4
+MAGIC = b"KL"
+VERSION = 1
+
+
+def upper(ch):
+    """Upper case variant of one symbol, kept when it has none."""
+    up = ch.upper()
+    return up if len(up) == 1 and up in codepage.CODES else ch
+
+
+def parse(path):
+    with open(path, encoding="utf-8") as f:
+        lines = [line.rstrip("\n") for line in f if not line.startswith("#")]
+    if len(lines) < LAYOUT_KEYS + 1:
+        raise SystemExit("%s: needs a name and %d key lines" % (path, LAYOUT_KEYS))
+    name = lines[0].strip()
+    if not name or len(name) > LAYOUT_NAME_SIZE:
+        raise SystemExit("%s: name must have 1 to %d chars" % (path, LAYOUT_NAME_SIZE))
+    return name, lines[1:LAYOUT_KEYS + 1]
+
+
+def compile_layout(name, keys):
+    """Blob of the layout, magic, version, name, then every key cycle."""
+    blob = bytearray(MAGIC + struct.pack("<B", VERSION))
+    blob += name.encode("ascii").ljust(LAYOUT_NAME_SIZE, b"\0")
+    for key, symbols in enumerate(keys):
+        if not 0 < len(symbols) <= LAYOUT_MAX_CYCLE:
+            raise SystemExit("key %d: cycle must have 1 to %d symbols" % (key, LAYOUT_MAX_CYCLE))
+        try:
+            lower = codepage.encode(symbols)
+            upper_symbols = codepage.encode("".join(upper(ch) for ch in symbols))
+        except UnicodeEncodeError as e:
+            raise SystemExit("key %d: %s" % (key, e))
+        blob += struct.pack("<B", len(lower)) + lower + upper_symbols
+    return bytes(blob)
+
+
+def load(path):
+    return compile_layout(*parse(path))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("layout", help="layout file")
+    parser.add_argument("--out", help="write the blob to the file")
+    args = parser.parse_args()
+
+    blob = load(args.layout)
+    if args.out:
+        with open(args.out, "wb") as f:
+            f.write(blob)
+    print("%s: %d B" % (parse(args.layout)[0], len(blob)))
+    print(blob.hex())
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
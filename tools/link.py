@@ -0,0 +1,1044 @@
+#!/usr/bin/env python3
+"""Host side of the terminal serial link.
+
+Frame: STX(0x02) cmd len payload[len] sum, sum = XOR of cmd, len and payload.
+Requires pyserial.
+"""
+
+import argparse
+import json
+import os
+import random
+import re
+import statistics
+import struct
+import sys
+import time
+
+import serial
+
+import benchcompare
+import frames
+import layout
+import phonebook
+import spellfilter
+
+STX = 0x02
+COLS = 128
+PAGES = 8
+MIRROR_FRAMES = ("F", "E")
+STALL_FRAME = "X"
+# Input step parts, LoopPhase of Latency.h
+LOOP_PHASES = ("scan", "edit", "render", "flush", "link")
+LATENCY_RESET = 0x01
+LATENCY_WATCH = 0x02
+# Fixed arenas and pools, MemoryArenaId of Memory.h
+ARENAS = ("message", "undo", "history slabs", "history entries", "index terms", "index blocks", "flow frames")
+# Benchmarked primitives, BenchCase of Bench.h, and whether the cursor
+# index matters
+BENCHES = (("setBufferChar", True), ("removeBufferCharOnIndex", True), ("getBufferLen", False),
+           ("getKeyChar", True), ("isSentenceStart", True), ("getTargetCursorPos", True),
+           ("drawMessage", True), ("drawHeader", False))
+# Calls of one O frame, BENCH_MAX_ITERATIONS of Bench.h
+BENCH_MAX_ITERATIONS = 4096
+MESSAGE_SIZE = 160
+KEYS = "0123456789*#"
+KEY_ACTIONS = {"press": 0, "hold": 1, "release": 2}
+TEXT_SOURCES = ("message", "sent", "recipient")
+HISTORY_SENT = 0x01
+HISTORY_UNREAD = 0x02
+# Most messages kept in the history, same as History.h
+HISTORY_ENTRIES = 512
+# Encodes and decodes per codec frame, CODEC_BENCH_ROUNDS of Codec.h
+CODEC_ROUNDS = 16
+# Lookups of every word per spell frame, SPELL_BENCH_ROUNDS of Spell.h
+SPELL_ROUNDS = 16
+# Text bytes of one spell frame
+SPELL_CHUNK = 250
+# Phonebook blob bytes of one D frame, the offset takes 4
+PHONEBOOK_CHUNK = 248
+# Idle device light sleeps and loses the bytes waking it up over RX
+WAKE_PREAMBLE = b"\x55" * 4
+WAKE_AFTER_S = 1.0
+WAKE_DELAY_S = 0.005
+
+
+def decode_rle(data):
+    """Decode PackBits data of the mirror span."""
+    out = bytearray()
+    pos = 0
+    while pos < len(data):
+        ctrl = data[pos]
+        pos += 1
+        if ctrl < 128:
+            out += data[pos:pos + ctrl + 1]
+            pos += ctrl + 1
+        else:
+            out += bytes([data[pos]]) * (ctrl - 126)
+            pos += 1
+    return bytes(out)
+
+
+class MirrorDecoder:
+    """Rebuilds the SSD1306 page framebuffer from mirror frames."""
+
+    def __init__(self):
+        self.buffer = bytearray(COLS * PAGES)
+        self.synced = False
+        self.bytes = 0
+        self.frames = 0
+
+    def feed(self, cmd, payload):
+        """Apply one mirror frame, returns the frame end info or None."""
+        self.bytes += len(payload) + 4
+        seq, flags = struct.unpack_from("<HB", payload)
+        if flags & 1:
+            self.synced = True
+        if cmd == "F":
+            page, col = payload[3], payload[4]
+            data = decode_rle(payload[5:])
+            start = page * COLS + col
+            self.buffer[start:start + len(data)] = data
+            return None
+        self.frames += 1
+        spans, encode_us = struct.unpack_from("<BI", payload, 3)
+        return seq, spans, encode_us
+
+    def pixel(self, x, y):
+        # Panel is mounted rotated by 180 degrees
+        x, y = COLS - 1 - x, PAGES * 8 - 1 - y
+        return (self.buffer[(y // 8) * COLS + x] >> (y % 8)) & 1
+
+    def pixels(self):
+        return [[self.pixel(x, y) for x in range(COLS)] for y in range(PAGES * 8)]
+
+    def render(self):
+        rows = []
+        for y in range(0, PAGES * 8, 2):
+            rows.append("".join(" \u2580\u2584\u2588"[self.pixel(x, y) | self.pixel(x, y + 1) << 1]
+                                for x in range(COLS)))
+        return "\n".join(rows)
+
+
+class Link:
+    def __init__(self, port, baud=921600, timeout=5.0):
+        self.port = serial.Serial(port, baud, timeout=timeout)
+        self.mirror = None
+        self.stalls = []
+        self.last_send = 0.0
+
+    def send(self, cmd, payload=b""):
+        if time.monotonic() - self.last_send > WAKE_AFTER_S:
+            self.port.write(WAKE_PREAMBLE)
+            time.sleep(WAKE_DELAY_S)
+        self.last_send = time.monotonic()
+        sum_ = ord(cmd) ^ len(payload)
+        for b in payload:
+            sum_ ^= b
+        self.port.write(bytes([STX, ord(cmd), len(payload)]) + payload + bytes([sum_]))
+
+    def recv(self):
+        while True:
+            b = self.port.read(1)
+            if not b:
+                raise TimeoutError("no reply from device")
+            if b[0] == STX:
+                break
+        cmd, length = self.port.read(2)
+        payload = self.port.read(length)
+        sum_ = self.port.read(1)[0]
+        check = cmd ^ length
+        for b in payload:
+            check ^= b
+        if check != sum_:
+            raise IOError("bad reply checksum")
+        return chr(cmd), payload
+
+    def recv_reply(self):
+        """Receive the next reply, mirror frames on the way are decoded
+        and stall frames collected."""
+        while True:
+            reply, data = self.recv()
+            if reply == STALL_FRAME:
+                time_us, cause, *phases = struct.unpack("<IB5I", data)
+                self.stalls.append((time_us, LOOP_PHASES[cause], phases))
+                continue
+            if reply not in MIRROR_FRAMES:
+                return reply, data
+            if self.mirror is not None:
+                self.mirror.feed(reply, data)
+
+    def request(self, cmd, payload=b""):
+        self.send(cmd, payload)
+        reply, data = self.recv_reply()
+        if reply == "N":
+            raise IOError("device rejected command %r" % cmd)
+        return reply, data
+
+    def insert(self, text, batched=True):
+        _, data = self.request("I" if batched else "K", text.encode("utf-8"))
+        return struct.unpack("<BI", data)
+
+    def clear(self):
+        self.request("C")
+
+    def key(self, key, action="press"):
+        """Inject key, returns handling time, flushes, flush time and cursor index."""
+        _, data = self.request("Y", bytes([KEYS.index(key), KEY_ACTIONS[action]]))
+        return struct.unpack("<IHIB", data)
+
+    def snapshot(self):
+        """Capture the current framebuffer as rows of pixels."""
+        decoder = MirrorDecoder()
+        self.send("P")
+        while True:
+            cmd, data = self.recv()
+            if cmd in MIRROR_FRAMES:
+                if decoder.feed(cmd, data) is not None and decoder.synced:
+                    break
+        self.recv_reply()
+        return decoder.pixels()
+
+    def fuzz(self, seed, steps):
+        """Run fuzz sequence of the seed on the device fuzz editor.
+
+        Returns steps, failing step, check, key, action and run time in us.
+        """
+        _, data = self.request("Z", struct.pack("<IH", seed, steps))
+        return struct.unpack("<HHBBBI", data)
+
+    def power(self):
+        """Light sleep statistics of the device.
+
+        Returns sleeps, key wakeups, link wakeups, lost key wakeups,
+        sleep time and active time in ms.
+        """
+        _, data = self.request("W")
+        return struct.unpack("<IIIIII", data)
+
+    def scan(self):
+        """Keypad scan statistics of the fast and slow scan rate.
+
+        Returns per rate scans, scan time in ms, presses, average and
+        max input latency in us.
+        """
+        _, data = self.request("S")
+        return [struct.unpack_from("<IIIII", data, offset) for offset in (0, 20)]
+
+    def text(self, source="message"):
+        """Read the message, the last sent message or its recipient
+        number as a string."""
+        data = b""
+        offset = total = 0
+        while True:
+            payload = struct.pack("<BH", TEXT_SOURCES.index(source), offset)
+            _, reply = self.request("T", payload)
+            total, offset = struct.unpack_from("<HH", reply)
+            data += reply[4:]
+            if offset >= total:
+                break
+        return data.decode({"message": "utf-8", "sent": "utf-16-be", "recipient": "ascii"}[source])
+
+    def message(self, text, peer="", sent=False):
+        """Store a message in the history, received messages are unread.
+
+        Returns the message id, history count, free slabs, evictions
+        and store time in us.
+        """
+        flags = HISTORY_SENT if sent else HISTORY_UNREAD
+        payload = bytes([flags, len(peer)]) + peer.encode("ascii") + text.encode("utf-8")
+        _, data = self.request("R", payload)
+        return struct.unpack("<HHHII", data)
+
+    def find(self, query):
+        """Search the history for the query words.
+
+        Returns the match count, search time in us, newest match id,
+        index words, free posting blocks, postings and messages
+        searched by text.
+        """
+        _, data = self.request("G", query.encode("utf-8"))
+        return struct.unpack("<HIHHHIH", data)
+
+    def codec(self, text):
+        """Pack the text by the message codec and decode it back.
+
+        Returns the chars, packed bytes (zero when it does not pack),
+        whether the round trip matched, the time of CODEC_ROUNDS
+        encodes and decodes in us and the history text chars with
+        their stored bytes.
+        """
+        _, data = self.request("J", text.encode("utf-8"))
+        return struct.unpack("<BB?IIII", data)
+
+    def latency(self, flags=None, threshold_us=None):
+        """Input step latency report, the flags and watchdog threshold
+        are set when given.
+
+        Returns budget and threshold in us, steps, violations, max step
+        time in us, violations by part and the log2 us histogram.
+        """
+        payload = b""
+        if flags is not None:
+            payload = bytes([flags])
+            if threshold_us is not None:
+                payload += struct.pack("<I", threshold_us)
+        _, data = self.request("H", payload)
+        values = struct.unpack("<%dI" % (len(data) // 4), data)
+        causes = dict(zip(LOOP_PHASES, values[5:5 + len(LOOP_PHASES)]))
+        return values[:5] + (causes, list(values[5 + len(LOOP_PHASES):]))
+
+    def memory(self):
+        """Heap, task stack and arena usage in bytes.
+
+        Returns free heap, least free heap, largest free block, least
+        free stack of the input and render task and the size, used and
+        peak bytes of every arena.
+        """
+        _, data = self.request("U")
+        values = struct.unpack("<%dI" % (len(data) // 4), data)
+        arenas = [values[5 + idx * 3:8 + idx * 3] for idx in range(len(ARENAS))]
+        return values[:5] + (dict(zip(ARENAS, arenas)),)
+
+    def spell(self, text):
+        """Look up the words of the text in the spell dictionary.
+
+        Returns the word count, unknown word count, the time of
+        SPELL_ROUNDS lookups of all words in us, the filter bytes, hash
+        count and the unknown flag of every word.
+        """
+        _, data = self.request("V", text.encode("utf-8"))
+        words, unknown, lookup_us, size, hashes = struct.unpack("<BBIIB", data[:11])
+        flags = [bool(data[11 + idx // 8] >> (idx % 8) & 1) for idx in range(words)]
+        return words, unknown, lookup_us, size, hashes, flags
+
+    def bench(self, case, length, index, iterations):
+        """Time the primitive on the message of the length with the
+        cursor on the index.
+
+        Returns the iterations and the time of all of them in us.
+        """
+        _, data = self.request("O", struct.pack("<BBBH", case, length, index, iterations))
+        return struct.unpack("<HI", data)
+
+    def phonebook(self, blob):
+        """Write the phonebook blob and open it.
+
+        Returns the contact count, index entry count and blob size.
+        """
+        for offset in range(0, len(blob), PHONEBOOK_CHUNK):
+            self.request("D", struct.pack("<I", offset) + blob[offset:offset + PHONEBOOK_CHUNK])
+        _, data = self.request("D")
+        return struct.unpack("<III", data)
+
+    def query(self, digits):
+        """Search the phonebook digit by digit.
+
+        Returns the match count, search time and slowest digit time in
+        us and the first match as (name, number) or None.
+        """
+        _, data = self.request("Q", digits.encode("ascii"))
+        count, total_us, max_us = struct.unpack_from("<III", data)
+        first = None
+        if len(data) > 12:
+            name_len, number_len = data[12], data[13]
+            name = phonebook.codepage.decode(data[14:14 + name_len])
+            first = (name, data[14 + name_len:14 + name_len + number_len].decode("ascii"))
+        return count, total_us, max_us, first
+
+    def layout(self, payload=b""):
+        """Select the layout index or load a layout blob.
+
+        Returns the selected index and the names of all layouts.
+        """
+        _, data = self.request("L", payload)
+        names = [data[offset:offset + 4].rstrip(b"\0").decode("ascii")
+                 for offset in range(2, 2 + data[1] * 4, 4)]
+        return data[0], names
+
+    def set_mirror(self, enabled):
+        self.mirror = MirrorDecoder() if enabled else None
+        self.request("M", bytes([1 if enabled else 0]))
+
+    def next_mirror_frame(self):
+        """Receive frames until the next mirror frame end."""
+        while True:
+            cmd, data = self.recv()
+            if cmd in MIRROR_FRAMES:
+                end = self.mirror.feed(cmd, data)
+                if end is not None:
+                    return end
+
+
+def cmd_insert(link, args):
+    inserted, elapsed = link.insert(args.text, not args.per_key)
+    print("inserted %d chars in %d us" % (inserted, elapsed))
+
+
+def cmd_bench(link, args):
+    text = ("the quick brown fox jumps over the lazy dog " * 4)[: args.length]
+    for name, batched in (("per-key", False), ("batched", True)):
+        device_us = 0
+        chars = 0
+        start = time.perf_counter()
+        for _ in range(args.rounds):
+            link.clear()
+            inserted, elapsed = link.insert(text, batched)
+            chars += inserted
+            device_us += elapsed
+        wall = time.perf_counter() - start
+        print("%-8s %6d chars  device %10.0f chars/s  end-to-end %8.0f chars/s"
+              % (name, chars, chars * 1e6 / max(device_us, 1), chars / wall))
+    link.clear()
+
+
+def cmd_mirror(link, args):
+    link.set_mirror(True)
+    try:
+        while True:
+            seq, spans, encode_us = link.next_mirror_frame()
+            sys.stdout.write("\x1b[H\x1b[2J%s\nframe %d  spans %d  encode %d us  total %d B\n"
+                             % (link.mirror.render(), seq, spans, encode_us, link.mirror.bytes))
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        link.set_mirror(False)
+
+
+def cmd_mirror_bench(link, args):
+    text = ("the quick brown fox jumps over the lazy dog " * 4)[: args.length]
+    link.clear()
+    link.set_mirror(True)
+    link.next_mirror_frame()
+    mirror = link.mirror
+    mirror.bytes = 0
+    latencies = []
+    for ch in text:
+        start = time.perf_counter()
+        first = None
+        link.send("K", ch.encode("utf-8"))
+        while True:
+            cmd, data = link.recv()
+            if cmd not in MIRROR_FRAMES:
+                break
+            if mirror.feed(cmd, data) is not None and first is None:
+                first = time.perf_counter() - start
+        latencies.append(first)
+    link.set_mirror(False)
+    link.clear()
+    latencies.sort()
+    print("bandwidth  %.1f B/char over %d chars (%d frames)"
+          % (mirror.bytes / len(text), len(text), mirror.frames))
+    print("latency    median %.2f ms  p95 %.2f ms  max %.2f ms"
+          % (latencies[len(latencies) // 2] * 1e3,
+             latencies[int(len(latencies) * 0.95)] * 1e3, latencies[-1] * 1e3))
+    print("keyframe   %d B" % (COLS * PAGES))
+
+
+def cmd_key_bench(link, args):
+    """Type and delete as fast as the link allows, every key redraws."""
+    link.clear()
+    handling = []
+    flushes = 0
+    start = time.perf_counter()
+    for number in range(args.keys):
+        elapsed, count, _, _ = link.key("2" if number % 2 == 0 else "#")
+        handling.append(elapsed)
+        flushes += count
+    wall = time.perf_counter() - start
+    link.clear()
+    handling.sort()
+    print("throughput %.0f keys/s over %d keys" % (args.keys / wall, args.keys))
+    print("handling   median %d us  p95 %d us  max %d us"
+          % (handling[len(handling) // 2], handling[int(len(handling) * 0.95)], handling[-1]))
+    print("flushes    %.2f per key completed while handling" % (flushes / args.keys))
+
+
+def cmd_power(link, args):
+    sleeps, keys, links, lost, sleep_ms, active_ms = link.power()
+    total = max(sleep_ms + active_ms, 1)
+    print("sleeps     %d (key %d, link %d, lost key %d)" % (sleeps, keys, links, lost))
+    print("asleep     %.1f s (%.1f %%)" % (sleep_ms / 1e3, sleep_ms * 100 / total))
+    print("active     %.1f s" % (active_ms / 1e3))
+
+
+def cmd_scan(link, args):
+    print("%-6s %10s %10s %8s %14s %14s" % ("rate", "scans", "scans/s", "presses", "avg latency", "max latency"))
+    for name, (scans, time_ms, presses, avg_us, max_us) in zip(("fast", "slow"), link.scan()):
+        print("%-6s %10d %10.0f %8d %11.2f ms %11.2f ms"
+              % (name, scans, scans * 1e3 / max(time_ms, 1), presses, avg_us / 1e3, max_us / 1e3))
+
+
+def cmd_nav_bench(link, args):
+    """Hold left from the message end until the cursor reaches the start."""
+    link.clear()
+    link.insert(("lorem ipsum dolor sit amet " * (args.length // 27 + 1))[:args.length])
+    _, _, _, index = link.key("6", "release")
+    length = index
+    moves = []
+    start = time.perf_counter()
+    deadline = start
+    while index > 0 and time.perf_counter() - start < args.timeout:
+        _, _, _, now = link.key("4", "hold")
+        if now != index:
+            moves.append((time.perf_counter() - start, index - now))
+            index = now
+        deadline += args.repeat_ms / 1000
+        time.sleep(max(deadline - time.perf_counter(), 0))
+    link.key("4", "release")
+    wall = time.perf_counter() - start
+    link.clear()
+    fixed = length * args.fixed_ms / 1000
+    words = sum(1 for _, step in moves if step > 1)
+    print("cursor     %d chars in %d moves (%d word jumps)" % (length - index, len(moves), words))
+    print("held       %.2f s, fixed %d ms rate %.2f s (%.1fx)"
+          % (wall, args.fixed_ms, fixed, fixed / max(wall, 1e-3)))
+    return 0 if index == 0 else 1
+
+
+def cmd_message(link, args):
+    mid, count, free, evictions, store_us = link.message(args.text, args.peer, args.sent)
+    print("message %d stored in %d us, %d messages, %d free slabs, %d dropped"
+          % (mid, store_us, count, free, evictions))
+
+
+def cmd_history_bench(link, args):
+    """Time history store, list open, scroll, message open and delete
+    at growing history sizes, the times should not grow with it. The
+    stores run the slices of the index compaction, so their worst case
+    is reported next to the average, as is the worst delete. Messages
+    are stored until the history keeps the size, or until the slabs
+    run out and a store drops a message."""
+    rng = random.Random(args.seed)
+    words = "ok see you at noon the meeting moved call me back soon home late".split()
+    print("%8s %8s %8s %8s %8s %8s %8s %8s %8s %8s %8s" % ("stored", "kept", "free", "dropped", "store", "max",
+                                                           "list", "scroll", "open", "delete", "max"))
+    count = stored = free = evictions = 0
+    for size in args.sizes:
+        store_us = []
+        full = False
+        while count < size and not full:
+            kept = count
+            text = " ".join(rng.choice(words) for _ in range(rng.randint(2, 12)))
+            peer = "+420%09d" % rng.randrange(10 ** 9)
+            _, count, free, evictions, elapsed = link.message(text, peer, rng.random() < 0.5)
+            store_us.append(elapsed)
+            stored += 1
+            full = count <= kept
+        list_us = link.key("9", "hold")[0]
+        link.key("9", "release")
+        scroll_us = [link.key("8")[0] for _ in range(min(args.scrolls, count - 1))]
+        open_us = link.key("5")[0]
+        link.key("#")
+        delete_us = []
+        for _ in range(min(args.deletes, count)):
+            time.sleep(0.25)
+            delete_us.append(link.key("0", "hold")[0])
+            link.key("0", "release")
+        link.key("#")
+        kept, count = count, count - len(delete_us)
+        print("%8d %8d %8d %8d %8.0f %8d %8d %8.0f %8d %8.0f %8d"
+              % (stored, kept, free, evictions, sum(store_us) / max(len(store_us), 1), max(store_us or [0]), list_us,
+                 sum(scroll_us) / max(len(scroll_us), 1), open_us,
+                 sum(delete_us) / max(len(delete_us), 1), max(delete_us or [0])))
+    print("times in us, scroll is the average of %d moves, delete of %d deletes" % (args.scrolls, args.deletes))
+    return 0
+
+
+def cmd_find(link, args):
+    count, find_us, newest, terms, free, postings, unindexed = link.find(args.query)
+    print("%d messages in %d us, newest %s" % (count, find_us, newest if count else "-"))
+    print("index: %d words, %d postings, %d free blocks, %d messages searched by text"
+          % (terms, postings, free, unindexed))
+
+
+def search_words(count, seed):
+    """Word list of the search bench, common words first, the rest
+    are picked with Zipf frequencies like words of real messages."""
+    rng = random.Random(seed)
+    words = ("ok see you at noon the meeting moved call me back soon home late "
+             "práce doma zítra ahoj díky jo kde jsi").split()
+    while len(words) < count:
+        words.append("".join(rng.choice("abcdeghijklmnoprstuvyz") for _ in range(rng.randint(2, 9))))
+    return words
+
+
+def cmd_search_bench(link, args):
+    """Store messages of Zipf distributed words and time searches of
+    one and two words at growing history sizes, up to the history size
+    by default. Long messages fill the slabs first, the kept column
+    shows the messages the index covers."""
+    rng = random.Random(args.seed)
+    words = search_words(args.words, args.seed)
+    weights = [1.0 / (rank + 1) for rank in range(len(words))]
+    print("%8s %8s %8s %8s %8s %8s %8s %8s %8s"
+          % ("stored", "kept", "words", "postings", "free", "by text", "store", "find", "max"))
+    stored = kept = 0
+    for size in args.sizes:
+        store_us = []
+        while stored < size:
+            text = " ".join(rng.choices(words, weights, k=rng.randint(3, 25)))[:160]
+            _, kept, _, _, elapsed = link.message(text, "+420%09d" % rng.randrange(10 ** 9))
+            store_us.append(elapsed)
+            stored += 1
+        find_us = []
+        for _ in range(args.queries):
+            query = " ".join(rng.choices(words, weights, k=rng.randint(1, 2)))
+            count, elapsed, _, terms, free, postings, unindexed = link.find(query)
+            find_us.append(elapsed)
+        print("%8d %8d %8d %8d %8d %8d %8.0f %8.0f %8d"
+              % (size, kept, terms, postings, free, unindexed,
+                 sum(store_us) / max(len(store_us), 1), sum(find_us) / len(find_us), max(find_us)))
+    print("times in us, find is the average of %d queries" % args.queries)
+    return 0
+
+
+def cmd_codec_bench(link, args):
+    """Pack every corpus message on the device and report the
+    compression ratio with the encode and decode throughput."""
+    with open(args.corpus, encoding="utf-8") as f:
+        messages = [line.strip() for line in f if line.strip() and not line.startswith("#")]
+    chars = stored = encode_us = decode_us = failed = 0
+    for text in messages:
+        count, size, ok, enc, dec, history_chars, history_bytes = link.codec(text)
+        chars += count
+        stored += size if 0 < size < count else count
+        encode_us += enc
+        decode_us += dec
+        if size > 0 and not ok:
+            failed += 1
+            print("round trip failed: %s" % text)
+    rounds = CODEC_ROUNDS * 1e6 / 1024
+    print("messages %d, %d chars packed to %d B (%.1f%%)"
+          % (len(messages), chars, stored, 100.0 * stored / max(chars, 1)))
+    print("encode %.0f KB/s, decode %.0f KB/s"
+          % (chars * rounds / max(encode_us, 1), chars * rounds / max(decode_us, 1)))
+    print("history %d chars stored in %d B" % (history_chars, history_bytes))
+    return 1 if failed else 0
+
+
+def bucket_limit(bucket):
+    """Upper bound in us of the latency histogram bucket."""
+    return 1 << bucket
+
+
+def histogram_percentile(buckets, fraction):
+    """Upper bound in us of the bucket holding the fraction of steps."""
+    total = sum(buckets)
+    seen = 0
+    for bucket, count in enumerate(buckets):
+        seen += count
+        if count and seen >= fraction * total:
+            return bucket_limit(bucket)
+    return 0
+
+
+def cmd_latency(link, args):
+    """Print the input step histogram, optionally watch for stalls,
+    fail when a gate is exceeded."""
+    if args.watch:
+        link.latency(LATENCY_WATCH, args.threshold_us)
+        time.sleep(args.watch)
+        link.latency(0)
+        for time_us, cause, phases in link.stalls:
+            print("stall %8.2f ms, %s (%s)" % (time_us / 1e3, cause, ", ".join(
+                "%s %.2f" % (name, us / 1e3) for name, us in zip(LOOP_PHASES, phases) if us)))
+    flags = LATENCY_RESET if args.reset else 0
+    budget, threshold, steps, violations, max_us, causes, buckets = link.latency(flags, args.threshold_us)
+
+    print("steps %d, budget %.2f ms, watchdog %.2f ms" % (steps, budget / 1e3, threshold / 1e3))
+    used = [bucket for bucket, count in enumerate(buckets) if count] or [0]
+    for bucket in range(used[0], used[-1] + 1):
+        count = buckets[bucket]
+        low = bucket_limit(bucket - 1) if bucket else 0
+        bar = "#" * (count * 40 // max(max(buckets), 1))
+        print("%8d us %10d %s" % (low, count, bar))
+    p50, p99 = histogram_percentile(buckets, 0.5), histogram_percentile(buckets, 0.99)
+    print("p50 < %d us, p99 < %d us, max %d us" % (p50, p99, max_us))
+    print("violations %d (%s)" % (violations, ", ".join("%s %d" % item for item in causes.items() if item[1])))
+
+    failed = False
+    if args.max_p99_us is not None and p99 > args.max_p99_us:
+        print("FAIL p99 over %d us" % args.max_p99_us)
+        failed = True
+    if args.max_violations is not None and violations > args.max_violations:
+        print("FAIL over %d violations" % args.max_violations)
+        failed = True
+    return 1 if failed else 0
+
+
+def cmd_memory(link, args):
+    free, min_free, largest, input_stack, render_stack, arenas = link.memory()
+    print("heap       %d B free, %d B least free, %d B largest block" % (free, min_free, largest))
+    print("stack      input %d B, render %d B least free" % (input_stack, render_stack))
+    print("%-16s %8s %8s %8s %7s" % ("arena", "size", "used", "peak", "peak %"))
+    for name, (size, used, peak) in arenas.items():
+        print("%-16s %8d %8d %8d %6.1f%%" % (name, size, used, peak, peak * 100.0 / max(size, 1)))
+
+
+def spell_chunks(words):
+    """Texts of the words fitting one spell frame."""
+    text = ""
+    for word in words:
+        if text and len((text + " " + word).encode("utf-8")) > SPELL_CHUNK:
+            yield text
+            text = ""
+        text = (text + " " + word) if text else word
+    if text:
+        yield text
+
+
+def spell_words(text):
+    """Words of the text split like the device does, runs of letters,
+    digits and apostrophes."""
+    words, word = [], ""
+    for ch in text:
+        if ch.isalnum() or ch == "'":
+            word += ch
+        elif word:
+            words.append(word)
+            word = ""
+    return words + [word] if word else words
+
+
+def cmd_spell(link, args):
+    text = " ".join(args.text)
+    _, unknown, _, _, _, flags = link.spell(text)
+    marked = [word for word, flag in zip(spell_words(text), flags) if flag]
+    print("%d words, %d misspelled%s" % (len(flags), unknown, ": " + " ".join(marked) if marked else ""))
+
+
+def cmd_spell_bench(link, args):
+    """Look up the dictionary words and random non-words on the device,
+    report the lookup time per word, the filter size, missing words
+    and the measured false positive rate."""
+    keys = spellfilter.load(args.words)
+    words = [key.decode("latin-1") for key in keys]
+    rng = random.Random(args.seed)
+    known = set(keys)
+    unknown = set()
+    while len(unknown) < args.samples:
+        key = spellfilter.random_key(rng)
+        if key not in known:
+            unknown.add(key.decode("latin-1"))
+
+    lookups = lookup_us = missing = 0
+    size = hashes = 0
+    for text in spell_chunks(words):
+        count, marked, elapsed, size, hashes, _ = link.spell(text)
+        lookups += count
+        lookup_us += elapsed
+        missing += marked
+    false = 0
+    for text in spell_chunks(sorted(unknown)):
+        count, marked, elapsed, size, hashes, _ = link.spell(text)
+        lookups += count
+        lookup_us += elapsed
+        false += count - marked
+
+    print("filter %d B, %d hashes, %.1f bits per word" % (size, hashes, size * 8.0 / max(len(words), 1)))
+    print("lookup %.2f us per word" % (lookup_us / max(lookups * SPELL_ROUNDS, 1)))
+    print("dictionary %d words, %d missing" % (len(words), missing))
+    print("non-words %d, %d passed, %.2f%% false positives" % (len(unknown), false, false * 100.0 / len(unknown)))
+    return 1 if missing else 0
+
+
+def microbench_cases(lengths, pattern):
+    """Benchmark names with their case, message length and cursor
+    index, the cursor is at the start, middle and end of the message,
+    the written and removed char is the last one at the end of a full
+    message."""
+    cases = []
+    for case, (name, indexed) in enumerate(BENCHES):
+        for length in lengths:
+            indexes = (0, length // 2, length) if indexed else (0,)
+            if name == "setBufferChar" and length == MESSAGE_SIZE:
+                indexes = (0, length // 2, length - 1)
+            if name == "removeBufferCharOnIndex":
+                indexes = (0, length // 2, length - 1) if length else ()
+            for index in sorted(set(indexes)):
+                label = "%s/%d/%d" % (name, length, index) if indexed else "%s/%d" % (name, length)
+                if not pattern or re.search(pattern, label):
+                    cases.append((label, case, length, index))
+    return cases
+
+
+def run_microbench(link, case, length, index, min_time_us):
+    """Time per call in ns, the iterations grow until the run takes
+    the minimal time like a Google Benchmark run."""
+    iterations = 16
+    while True:
+        done, elapsed = link.bench(case, length, index, iterations)
+        if elapsed >= min_time_us or iterations >= BENCH_MAX_ITERATIONS:
+            return done, elapsed * 1000.0 / done
+        iterations = min(BENCH_MAX_ITERATIONS, iterations * max(2, min(10, int(min_time_us * 1.4 / max(elapsed, 1)))))
+
+
+def cmd_microbench(link, args):
+    """Run the primitive benchmarks on the device, print the median of
+    the repetitions, store them as a Google Benchmark JSON report and
+    compare them with a stored report, a case slower by more than the
+    allowed percent fails the run."""
+    baseline = benchcompare.load(args.baseline) if args.baseline else {}
+
+    print("%-36s %12s %12s" % ("Benchmark", "Time", "Iterations"))
+    print("-" * 62)
+    report = []
+    failed = False
+    for label, case, length, index in microbench_cases(args.lengths, args.filter):
+        runs = [run_microbench(link, case, length, index, args.min_time_us) for _ in range(args.repetitions)]
+        iterations = runs[0][0]
+        ns = statistics.median(time_ns for _, time_ns in runs)
+        report.append({"name": label, "run_name": label, "run_type": "iteration", "iterations": iterations,
+                       "real_time": ns, "cpu_time": ns, "time_unit": "ns"})
+        line = "%-36s %9.0f ns %12d" % (label, ns, iterations)
+        if label in baseline:
+            change = benchcompare.change(baseline[label], ns)
+            line += "  %+6.1f%%" % change
+            if args.max_regression is not None and change > args.max_regression:
+                line += "  FAIL"
+                failed = True
+        print(line)
+
+    if args.save:
+        context = {"date": time.strftime("%Y-%m-%dT%H:%M:%S"), "executable": "device", "port": args.port,
+                   "repetitions": args.repetitions}
+        with open(args.save, "w") as f:
+            json.dump({"context": context, "benchmarks": report}, f, indent=1)
+    return 1 if failed else 0
+
+
+def cmd_text(link, args):
+    print(link.text("recipient" if args.recipient else "sent" if args.sent else "message"))
+
+
+def cmd_phonebook(link, args):
+    start = time.perf_counter()
+    contacts, entries, size = link.phonebook(phonebook.load(args.file))
+    print("%d contacts, %d entries, %d B written in %.1f s"
+          % (contacts, entries, size, time.perf_counter() - start))
+    return 0 if contacts > 0 else 1
+
+
+def cmd_phonebook_bench(link, args):
+    """Load synthetic contacts and time typed name queries on the device."""
+    contacts = phonebook.generate(args.contacts, args.seed)
+    start = time.perf_counter()
+    blob = phonebook.build(contacts)
+    build_ms = (time.perf_counter() - start) * 1000
+    count, entries, size = link.phonebook(blob)
+    print("contacts %d, entries %d, blob %d B, build %.0f ms" % (count, entries, size, build_ms))
+
+    digit_us = []
+    for digits in phonebook.queries(contacts, args.queries, args.seed):
+        matches, total_us, max_us, first = link.query(digits)
+        digit_us.append(max_us)
+        if matches == 0:
+            print("no match for %s" % digits)
+            return 1
+    digit_us.sort()
+    print("slowest digit per query: median %d us, p99 %d us, max %d us"
+          % (digit_us[len(digit_us) // 2], digit_us[len(digit_us) * 99 // 100], digit_us[-1]))
+    return 0 if digit_us[-1] < 1000 else 1
+
+
+def cmd_layout(link, args):
+    if args.layout is None:
+        index, names = link.layout()
+    elif os.path.exists(args.layout):
+        index, names = link.layout(layout.load(args.layout))
+    else:
+        names = link.layout()[1]
+        if args.layout not in names:
+            raise SystemExit("no layout %r, layouts: %s" % (args.layout, " ".join(names)))
+        index, names = link.layout(bytes([names.index(args.layout)]))
+    for number, name in enumerate(names):
+        print("%s %d %s" % ("*" if number == index else " ", number, name))
+
+
+def cmd_session(link, args):
+    """Run the session script, capture and compare frames at snap steps.
+
+    Script lines: press|hold|release KEY, wait MS, text TEXT, clear, snap NAME.
+    """
+    failed = 0
+    render_us = flushes = flush_us = 0
+    previous = None
+    print("%-16s %10s %8s %10s %8s %8s" % ("frame", "render us", "flushes", "flush us", "changed", "diff"))
+    with open(args.script) as f:
+        for number, line in enumerate(f, 1):
+            words = line.split(None, 1)
+            if not words or words[0].startswith("#"):
+                continue
+            step = words[0]
+            arg = line.rstrip("\n")[len(step) + 1:] if step == "text" else line[len(step):].strip()
+            if step in KEY_ACTIONS:
+                elapsed, count, flush_time, _ = link.key(arg, step)
+                render_us += elapsed
+                flushes += count
+                flush_us += flush_time
+            elif step == "wait":
+                time.sleep(int(arg) / 1000)
+            elif step == "text":
+                render_us += link.insert(arg, False)[1]
+            elif step == "clear":
+                link.clear()
+            elif step == "snap":
+                pixels = link.snapshot()
+                changed = 0 if previous is None else frames.diff(previous, pixels)[0]
+                golden = os.path.join(args.golden, arg + ".pbm")
+                status = "-"
+                if args.record:
+                    frames.write_pbm(golden, pixels)
+                    status = "recorded"
+                elif os.path.exists(golden):
+                    count, _ = frames.diff(frames.read_pbm(golden), pixels)
+                    status = "ok" if count == 0 else "%d px" % count
+                    failed += count != 0
+                if args.out:
+                    frames.write_pbm(os.path.join(args.out, arg + ".pbm"), pixels)
+                if args.budget_us and render_us > args.budget_us:
+                    status += " slow"
+                    failed += 1
+                print("%-16s %10d %8d %10d %8d %8s" % (arg, render_us, flushes, flush_us, changed, status))
+                previous = pixels
+                render_us = flushes = flush_us = 0
+            else:
+                raise SystemExit("%s:%d: unknown step %r" % (args.script, number, step))
+    return 1 if failed else 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("--baud", type=int, default=921600)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    p = sub.add_parser("insert", help="insert text at the cursor")
+    p.add_argument("text")
+    p.add_argument("--per-key", action="store_true", help="insert char by char")
+    p.set_defaults(func=cmd_insert)
+
+    p = sub.add_parser("bench", help="compare batched and per-key insertion")
+    p.add_argument("--length", type=int, default=160)
+    p.add_argument("--rounds", type=int, default=20)
+    p.set_defaults(func=cmd_bench)
+
+    p = sub.add_parser("mirror", help="show the mirrored display")
+    p.set_defaults(func=cmd_mirror)
+
+    p = sub.add_parser("mirror-bench", help="mirror bandwidth and latency per typed char")
+    p.add_argument("--length", type=int, default=80)
+    p.set_defaults(func=cmd_mirror_bench)
+
+    p = sub.add_parser("key-bench", help="keystroke throughput while every key redraws")
+    p.add_argument("--keys", type=int, default=1000)
+    p.set_defaults(func=cmd_key_bench)
+
+    p = sub.add_parser("nav-bench", help="time to cross a message holding the cursor key")
+    p.add_argument("--length", type=int, default=160)
+    p.add_argument("--repeat-ms", type=float, default=20, help="LONG_PRESS_REPEAT_DELAY")
+    p.add_argument("--fixed-ms", type=int, default=200, help="fixed move delay to compare")
+    p.add_argument("--timeout", type=float, default=60)
+    p.set_defaults(func=cmd_nav_bench)
+
+    p = sub.add_parser("power", help="light sleep statistics")
+    p.set_defaults(func=cmd_power)
+
+    p = sub.add_parser("scan", help="keypad scan rate and input latency")
+    p.set_defaults(func=cmd_scan)
+
+    p = sub.add_parser("text", help="print the message text")
+    p.add_argument("--sent", action="store_true", help="the last sent message")
+    p.add_argument("--recipient", action="store_true", help="number of the last sent message recipient")
+    p.set_defaults(func=cmd_text)
+
+    p = sub.add_parser("message", help="store a message in the history")
+    p.add_argument("text")
+    p.add_argument("--peer", default="", help="number of the other side")
+    p.add_argument("--sent", action="store_true", help="store as sent, default received")
+    p.set_defaults(func=cmd_message)
+
+    p = sub.add_parser("history-bench", help="history operation times at growing sizes")
+    p.add_argument("--sizes", type=int, nargs="+", default=[10, 100, HISTORY_ENTRIES],
+                   help="kept messages, at most HISTORY_ENTRIES")
+    p.add_argument("--scrolls", type=int, default=50)
+    p.add_argument("--deletes", type=int, default=10)
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_history_bench)
+
+    p = sub.add_parser("find", help="search the message history")
+    p.add_argument("query")
+    p.set_defaults(func=cmd_find)
+
+    p = sub.add_parser("search-bench", help="history search times at growing sizes")
+    p.add_argument("--sizes", type=int, nargs="+", default=[100, 250, HISTORY_ENTRIES])
+    p.add_argument("--words", type=int, default=5000, help="vocabulary size")
+    p.add_argument("--queries", type=int, default=100)
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_search_bench)
+
+    p = sub.add_parser("codec-bench", help="message codec ratio and throughput on the device")
+    p.add_argument("--corpus", default=os.path.join(os.path.dirname(__file__), "messages", "sms.txt"))
+    p.set_defaults(func=cmd_codec_bench)
+
+    p = sub.add_parser("latency", help="input step latency histogram and budget gate")
+    p.add_argument("--reset", action="store_true", help="clear the report after reading")
+    p.add_argument("--watch", type=float, help="report stalls for this many seconds first")
+    p.add_argument("--threshold-us", type=int, help="watchdog threshold of stall reports")
+    p.add_argument("--max-p99-us", type=int, help="fail when p99 step time is over")
+    p.add_argument("--max-violations", type=int, help="fail when more steps are over budget")
+    p.set_defaults(func=cmd_latency)
+
+    p = sub.add_parser("memory", help="heap, task stack and arena usage")
+    p.set_defaults(func=cmd_memory)
+
+    p = sub.add_parser("spell", help="mark the misspelled words of the text")
+    p.add_argument("text", nargs="+")
+    p.set_defaults(func=cmd_spell)
+
+    p = sub.add_parser("spell-bench", help="dictionary lookup time and false positives on the device")
+    p.add_argument("--words", nargs="+", default=[spellfilter.WORDS], help="word lists of the flashed filter")
+    p.add_argument("--samples", type=int, default=5000, help="random non-words looked up")
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_spell_bench)
+
+    p = sub.add_parser("microbench", help="buffer, keypad and render primitive times with a baseline gate")
+    p.add_argument("--filter", help="only benchmarks matching the regex, e.g. ^draw")
+    p.add_argument("--lengths", type=int, nargs="+", default=[0, 16, 80, MESSAGE_SIZE], help="message lengths")
+    p.add_argument("--repetitions", type=int, default=3, help="runs of every benchmark, the median is kept")
+    p.add_argument("--min-time-us", type=int, default=2000, help="least time of one run")
+    p.add_argument("--save", help="store the report as a Google Benchmark JSON file")
+    p.add_argument("--baseline", help="report to compare with")
+    p.add_argument("--max-regression", type=float, help="fail when a benchmark is slower by more percent")
+    p.set_defaults(func=cmd_microbench)
+
+    p = sub.add_parser("phonebook", help="write a phonebook CSV or blob")
+    p.add_argument("file")
+    p.set_defaults(func=cmd_phonebook)
+
+    p = sub.add_parser("phonebook-bench", help="digit search latency of synthetic contacts")
+    p.add_argument("--contacts", type=int, default=10000)
+    p.add_argument("--queries", type=int, default=200)
+    p.add_argument("--seed", type=int, default=1)
+    p.set_defaults(func=cmd_phonebook_bench)
+
+    p = sub.add_parser("layout", help="list, select or load keypad layouts")
+    p.add_argument("layout", nargs="?", help="layout name or layout file to load")
+    p.set_defaults(func=cmd_layout)
+
+    p = sub.add_parser("session", help="run a scripted session against golden frames")
+    p.add_argument("script")
+    p.add_argument("--golden", default=os.path.join(os.path.dirname(__file__), "golden"))
+    p.add_argument("--record", action="store_true", help="store the frames as new golden frames")
+    p.add_argument("--out", help="directory for the captured frames")
+    p.add_argument("--budget-us", type=int, help="fail frames rendered slower than this")
+    p.set_defaults(func=cmd_session)
+
+    args = parser.parse_args()
+    return args.func(Link(args.port, args.baud), args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
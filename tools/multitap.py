@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""Multitap timeout bench on key press traces.
+
+Replays key press traces through a model of the firmware multitap
+cycle with the fixed delay and with the delay learned from the tapping
+cadence, and reports effective chars per minute, unwanted commits (a
+tap of a cycle arriving after the delay expired) and waits (a letter
+on the key of the previous letter held back until the cycle commits).
+
+Trace lines are `GAP KEY [+]`: the natural gap in ms since the previous
+press, the key (`0`-`9`) and `+` when the press continues the cycle of
+the previous letter. Gaps before a letter on the same key are the gaps
+with an instant commit, the replay adds the wait for the delay.
+`--generate PROFILE` writes a synthetic trace of a typist profile.
+"""
+
+import argparse
+import random
+import sys
+
+KEY_SYMBOLS = [" 0", ".,?!1", "abc2", "def3", "ghi4", "jkl5", "mno6", "pqrs7", "tuv8", "wxyz9"]
+
+# Keypad.h
+MULTITAP_DELAY = 500
+MULTITAP_MIN_DELAY = 250
+MULTITAP_MAX_DELAY = 1000
+MULTITAP_AVERAGE_SHIFT = 3
+MULTITAP_DEVIATION_SHIFT = 2
+MULTITAP_LATE_WINDOW = 150
+MULTITAP_MAX_GAP = 2000
+
+# Typist profiles, mean and deviation of tap interval and letter gap
+PROFILES = {
+    "fast": (110, 25, 260, 80),
+    "average": (200, 50, 420, 120),
+    "slow": (340, 90, 750, 220),
+}
+
+TEXT = ("hello see you at noon. the meeting moved to room six, bring the "
+        "old keys too. call me back soon if it rains we stay home")
+
+
+class Cadence:
+    """Model of the firmware tapping cadence, same integer math."""
+
+    def __init__(self, adaptive):
+        self.adaptive = adaptive
+        self.tap = (MULTITAP_DELAY * 3 // 5) << MULTITAP_AVERAGE_SHIFT
+        self.deviation = MULTITAP_DELAY * 2 // 5
+        self.letter = MULTITAP_MAX_GAP << MULTITAP_DEVIATION_SHIFT
+        self.delay = MULTITAP_DELAY
+
+    def update(self, is_cycle, is_late, interval):
+        if not self.adaptive or interval > MULTITAP_MAX_GAP:
+            return
+        if is_cycle or is_late:
+            error = interval - (self.tap >> MULTITAP_AVERAGE_SHIFT)
+            self.tap += error
+            self.deviation += abs(error) - (self.deviation >> MULTITAP_DEVIATION_SHIFT)
+        else:
+            self.letter += interval - (self.letter >> MULTITAP_DEVIATION_SHIFT)
+
+        tap = self.tap >> MULTITAP_AVERAGE_SHIFT
+        letter = self.letter >> MULTITAP_DEVIATION_SHIFT
+        delay = tap + self.deviation
+        if delay > letter:
+            delay = max(letter, tap + tap // 4)
+        self.delay = min(max(delay, MULTITAP_MIN_DELAY), MULTITAP_MAX_DELAY)
+
+
+def load_trace(path):
+    events = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            words = line.split()
+            if not words or words[0].startswith("#"):
+                continue
+            if len(words) > 3 or not words[1].isdigit() or words[2:] not in ([], ["+"]):
+                raise SystemExit("%s:%d: bad trace line %r" % (path, number, line.strip()))
+            events.append((int(words[0]), int(words[1]), len(words) == 3))
+    return events
+
+
+def generate(profile, text, seed):
+    """Key presses of the text with the profile gaps, one line each."""
+    tap_mean, tap_dev, letter_mean, letter_dev = PROFILES[profile]
+    rng = random.Random(seed)
+    lines = ["# %s typist, seed %d" % (profile, seed)]
+    for ch in text:
+        key = next(k for k, symbols in enumerate(KEY_SYMBOLS) if ch in symbols)
+        gap = max(int(rng.gauss(letter_mean, letter_dev)), 80)
+        lines.append("%d %d" % (gap, key))
+        for _ in range(KEY_SYMBOLS[key].index(ch)):
+            lines.append("%d %d +" % (max(int(rng.gauss(tap_mean, tap_dev)), 50), key))
+    return "\n".join(lines) + "\n"
+
+
+def replay(events, adaptive, args):
+    """Time the trace with the fixed or learned delay."""
+    cadence = Cadence(adaptive)
+    now = last = 0
+    deadline = -1
+    previous = None
+    chars = commits = waits = taps = 0
+    for gap, key, is_tap in events:
+        if is_tap:
+            now += gap
+            taps += 1
+            if now < deadline:
+                cadence.update(True, False, now - last)
+            else:
+                # The cycle committed too early, delete the two wrong
+                # letters and tap the cycle again
+                commits += 1
+                is_late = now - last < cadence.delay + MULTITAP_LATE_WINDOW
+                cadence.update(False, is_late, now - last)
+                now += args.react_ms + 2 * args.delete_ms + taps * gap
+        else:
+            now += gap
+            if key == previous and now < deadline + args.react_ms:
+                waits += 1
+                now = deadline + args.react_ms
+            is_late = key == previous and now - last < cadence.delay + MULTITAP_LATE_WINDOW
+            cadence.update(False, is_late, now - last)
+            chars += 1
+            taps = 0
+        last = now
+        previous = key
+        deadline = now + cadence.delay
+    return {
+        "cpm": chars * 60000 / max(now, 1),
+        "commits": commits,
+        "waits": waits,
+        "delay": cadence.delay,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("traces", nargs="*", help="key press traces")
+    parser.add_argument("--generate", choices=sorted(PROFILES), help="print a synthetic trace")
+    parser.add_argument("--text", default=TEXT, help="text of the generated trace")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--react-ms", type=float, default=250, help="reaction to the commit")
+    parser.add_argument("--delete-ms", type=float, default=300, help="time of one delete press")
+    args = parser.parse_args()
+
+    if args.generate:
+        sys.stdout.write(generate(args.generate, args.text.lower(), args.seed))
+        return 0
+    if not args.traces:
+        parser.error("no traces given")
+
+    print("%-24s %-9s %8s %8s %6s %9s" % ("trace", "delay", "cpm", "commits", "waits", "final ms"))
+    for path in args.traces:
+        events = load_trace(path)
+        for name, adaptive in (("fixed", False), ("adaptive", True)):
+            r = replay(events, adaptive, args)
+            print("%-24s %-9s %8.1f %8d %6d %9d"
+                  % (path.rsplit("/", 1)[-1], name, r["cpm"], r["commits"], r["waits"], r["delay"]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
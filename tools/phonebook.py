@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+"""Build phonebook blobs with the T9 digit index.
+
+Contacts come from a CSV file of `name,number` rows in UTF-8, names are
+stored in the internal code page (codepage.py). Every word of a name and
+the number get an index entry sorted by the keypad digits of the key, so
+the device narrows the matches of a typed digit query by two binary
+searches per digit (Phonebook.cpp). The blob is written to the phonebook
+flash partition with `link.py PORT phonebook FILE` (`D` command).
+
+`--generate N` writes a synthetic CSV, `--bench N` reports build time,
+blob and index size and the index reads per key press of a model of the
+device search.
+"""
+
+import argparse
+import bisect
+import csv
+import io
+import random
+import struct
+import sys
+import time
+import unicodedata
+
+import codepage
+
+MAGIC = b"PB"
+VERSION = 1
+HEADER = 24
+DIGITS_SIZE = 256
+MAX_NAME = 32
+MAX_NUMBER = 20
+MAX_QUERY = 16
+# Phonebook partition size, partitions.csv
+PARTITION_SIZE = 0xF0000
+
+KEY_LETTERS = ["", "", "abc", "def", "ghi", "jkl", "mno", "pqrs", "tuv", "wxyz"]
+
+FIRST_NAMES = ["Adam", "Alena", "Anna", "Barbora", "David", "Eva", "Filip", "Hana", "Jakub",
+               "Jan", "Jana", "Jiří", "Kateřina", "Lucie", "Lukáš", "Marek", "Martin",
+               "Michaela", "Ondřej", "Pavel", "Petr", "Petra", "Radek", "Šárka", "Tomáš",
+               "Veronika", "Vojtěch", "Zdeněk", "Zuzana", "Štěpán"]
+LAST_NAMES = ["Beneš", "Černý", "Doležal", "Dvořák", "Fiala", "Hájek", "Horák", "Jelínek",
+              "Král", "Krejčí", "Kučera", "Marek", "Němec", "Novák", "Pokorný", "Pospíšil",
+              "Procházka", "Růžička", "Sedláček", "Svoboda", "Šimek", "Urban", "Veselý",
+              "Vlček", "Zeman", "Žák"]
+
+
+def digit_table():
+    """Keypad digit of every code page char, letters with diacritics
+    take the digit of the base letter, other chars the 1 key."""
+    table = bytearray(b"1" * DIGITS_SIZE)
+    for code, ch in enumerate(codepage.TABLE):
+        if ch is None:
+            continue
+        base = unicodedata.normalize("NFD", ch)[0].lower()
+        if base.isdigit() and base.isascii():
+            table[code] = ord(base)
+        elif base == " ":
+            table[code] = ord("0")
+        for key, letters in enumerate(KEY_LETTERS):
+            if base in letters:
+                table[code] = ord("0") + key
+    return bytes(table)
+
+
+DIGITS = digit_table()
+
+
+def load_csv(path):
+    contacts = []
+    with open(path, encoding="utf-8", newline="") as f:
+        for number, row in enumerate(csv.reader(f), 1):
+            if not row or row[0].startswith("#"):
+                continue
+            if len(row) != 2:
+                raise SystemExit("%s:%d: needs name,number" % (path, number))
+            contacts.append((row[0].strip(), row[1].strip()))
+    return contacts
+
+
+def generate(count, seed):
+    rng = random.Random(seed)
+    contacts = []
+    for _ in range(count):
+        name = "%s %s" % (rng.choice(FIRST_NAMES), rng.choice(LAST_NAMES))
+        if rng.random() < 0.2:
+            name += " %s" % rng.choice(["práce", "doma", "mobil", "servis"])
+        contacts.append((name, "+420%09d" % rng.randrange(10 ** 9)))
+    return contacts
+
+
+def key_starts(name, number):
+    """Record offsets of every name word start and of the number
+    digits after a leading plus."""
+    starts = [1 + pos for pos, ch in enumerate(name)
+              if ch != 0x20 and (pos == 0 or name[pos - 1] == 0x20)]
+    starts.append(2 + len(name) + (1 if number.startswith(b"+") else 0))
+    return starts
+
+
+def build(contacts):
+    """Blob of the contacts, header, digit table, records and index."""
+    records = bytearray()
+    entries = []
+    for text, number in sorted(contacts, key=lambda c: c[0].lower()):
+        try:
+            name = codepage.encode(text)
+            number = number.encode("ascii")
+        except UnicodeError as e:
+            raise SystemExit("%s: %s" % (text, e))
+        if not 0 < len(name) <= MAX_NAME or not 0 < len(number) <= MAX_NUMBER:
+            raise SystemExit("%s: name or number too long" % text)
+        offset = HEADER + DIGITS_SIZE + len(records)
+        record = bytes([len(name)]) + name + bytes([len(number)]) + number
+        end_name = 1 + len(name)
+        for start in key_starts(name, number):
+            end = end_name if start < end_name else len(record)
+            if start < end:
+                entries.append((record[start:end].translate(DIGITS), offset, start))
+        records += record
+
+    index_offset = (HEADER + DIGITS_SIZE + len(records) + 3) & ~3
+    if index_offset >= 1 << 24:
+        raise SystemExit("records do not fit the 24 bit entry offset")
+    entries.sort()
+    total = index_offset + 4 * len(entries)
+    header = MAGIC + struct.pack("<BBIIIII", VERSION, 0, len(contacts), len(entries),
+                                 HEADER + DIGITS_SIZE, index_offset, total)
+    blob = bytearray(header + DIGITS + records)
+    blob += bytes(index_offset - len(blob))
+    for _, offset, start in entries:
+        blob += struct.pack("<I", offset << 8 | start)
+    if len(blob) > PARTITION_SIZE:
+        raise SystemExit("blob of %d B does not fit the partition" % len(blob))
+    return bytes(blob)
+
+
+def load(path):
+    """Blob of the CSV file or the blob file itself."""
+    with open(path, "rb") as f:
+        data = f.read()
+    return data if data.startswith(MAGIC) else build(load_csv(path))
+
+
+class Search:
+    """Model of the device search counting the index reads."""
+
+    def __init__(self, blob):
+        count, entries, _, index_offset, _ = struct.unpack_from("<IIIII", blob, 4)
+        self.blob = blob
+        self.index = struct.unpack_from("<%dI" % entries, blob, index_offset)
+        self.reads = 0
+        self.ranges = [(0, entries)]
+
+    def key_digit(self, idx, depth):
+        self.reads += 1
+        offset, start = self.index[idx] >> 8, self.index[idx] & 0xFF
+        name_len = self.blob[offset]
+        end = 1 + name_len if start <= name_len else 2 + name_len + self.blob[offset + 1 + name_len]
+        pos = start + depth
+        return self.blob[HEADER + self.blob[offset + pos]] if pos < end else 0
+
+    def push(self, digit):
+        depth = len(self.ranges) - 1
+        lo, hi = self.ranges[-1]
+        if depth < MAX_QUERY:
+            first = bisect.bisect_left(range(lo, hi), digit, key=lambda i: self.key_digit(i, depth)) + lo
+            last = bisect.bisect_left(range(first, hi), digit + 1, key=lambda i: self.key_digit(i, depth)) + first
+            self.ranges.append((first, last))
+        return self.ranges[-1][1] - self.ranges[-1][0]
+
+    def contact(self, idx):
+        offset = self.index[self.ranges[-1][0] + idx] >> 8
+        name_len = self.blob[offset]
+        name = codepage.decode(self.blob[offset + 1:offset + 1 + name_len])
+        number_len = self.blob[offset + 1 + name_len]
+        return name, self.blob[offset + 2 + name_len:offset + 2 + name_len + number_len].decode("ascii")
+
+
+def queries(contacts, count, seed):
+    """Digit queries of typed name prefixes of random contacts."""
+    rng = random.Random(seed)
+    out = []
+    for _ in range(count):
+        name = rng.choice(contacts)[0]
+        word = rng.choice(name.split())
+        out.append(codepage.encode(word).translate(DIGITS)[:rng.randint(1, len(word))].decode("ascii"))
+    return out
+
+
+def bench(count, seed):
+    contacts = generate(count, seed)
+    start = time.perf_counter()
+    blob = build(contacts)
+    build_s = time.perf_counter() - start
+
+    _, entries, records_offset, index_offset, total = struct.unpack_from("<IIIII", blob, 4)
+    print("contacts      %d" % count)
+    print("build         %.0f ms" % (build_s * 1000))
+    print("blob          %d B (%.1f%% of the partition)" % (total, 100.0 * total / PARTITION_SIZE))
+    print("records       %d B" % (index_offset - records_offset))
+    print("index         %d B, %d entries, %.1f B per contact" % (total - index_offset, entries,
+                                                                   (total - index_offset) / count))
+
+    reads = []
+    misses = 0
+    for query in queries(contacts, 1000, seed):
+        search = Search(blob)
+        for digit in query.encode("ascii"):
+            search.reads = 0
+            matches = search.push(digit)
+            reads.append(search.reads)
+        misses += matches == 0
+    print("reads per key avg %.1f, max %d (%d key presses, %d queries without match)"
+          % (sum(reads) / len(reads), max(reads), len(reads), misses))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("csv", nargs="?", help="contacts as name,number rows")
+    parser.add_argument("-o", "--out", help="blob file, default prints the index summary")
+    parser.add_argument("--generate", type=int, metavar="N", help="print a synthetic CSV of N contacts")
+    parser.add_argument("--bench", type=int, metavar="N", help="benchmark N synthetic contacts")
+    parser.add_argument("--seed", type=int, default=1)
+    parser.add_argument("--query", help="digits searched in the built blob")
+    args = parser.parse_args()
+
+    if args.generate:
+        out = io.StringIO()
+        csv.writer(out, lineterminator="\n").writerows(generate(args.generate, args.seed))
+        sys.stdout.write(out.getvalue())
+        return 0
+    if args.bench:
+        return bench(args.bench, args.seed)
+    if not args.csv:
+        parser.error("no contacts given")
+
+    blob = load(args.csv)
+    if args.out:
+        with open(args.out, "wb") as f:
+            f.write(blob)
+    count, entries = struct.unpack_from("<II", blob, 4)
+    print("%d contacts, %d entries, %d B" % (count, entries, len(blob)))
+    if args.query:
+        search = Search(blob)
+        for digit in args.query.encode("ascii"):
+            matches = search.push(digit)
+        for idx in range(min(matches, 10)):
+            print("  %s %s" % search.contact(idx))
+        print("%d matches" % matches)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
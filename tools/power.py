@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""Energy model of the idle light sleep over scripted sessions.
+
+Replays the timing of a session script (the steps of `link.py session`)
+through a model of the firmware power states and reports wakeups, awake
+and sleep time and energy per typed message, once for a device that
+stays awake and once with light sleep after the editor idle delay.
+Compare the sleep and active time with `link.py PORT power` on a board.
+"""
+
+import argparse
+import sys
+
+
+def load_activity(path, args):
+    """Get the activity times in ms, length and typed chars of the script."""
+    activity = []
+    now = 0.0
+    chars = 0
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            words = line.split(None, 1)
+            if not words or words[0].startswith("#"):
+                continue
+            step = words[0]
+            arg = line.rstrip("\n")[len(step) + 1:] if step == "text" else line[len(step):].strip()
+            if step == "press":
+                activity.append(now)
+                now += args.key_ms
+                chars += 1
+            elif step == "hold":
+                activity.append(now)
+                now += args.hold_ms
+            elif step == "release":
+                activity.append(now)
+            elif step == "text":
+                for _ in arg:
+                    activity.append(now)
+                    now += args.char_ms
+                chars += len(arg)
+            elif step == "wait":
+                now += int(arg)
+            elif step in ("clear", "snap"):
+                activity.append(now)
+            else:
+                raise SystemExit("%s:%d: unknown step %r" % (path, number, step))
+    return activity, now, chars
+
+
+def awake_spans(activity, end, idle_ms):
+    """Merge the idle delay after every activity into awake spans."""
+    spans = []
+    for start in activity:
+        stop = min(start + idle_ms, end)
+        if spans and start <= spans[-1][1]:
+            spans[-1][1] = max(spans[-1][1], stop)
+        else:
+            spans.append([start, stop])
+    return spans
+
+
+def simulate(args, activity, length, sleep):
+    """Run the model over all messages, returns the totals."""
+    period = length + args.gap_s * 1000
+    total = period * args.messages
+    events = [m * period + t for m in range(args.messages) for t in activity]
+    spans = awake_spans(events, total, args.idle_ms) if sleep else [[0.0, total]]
+
+    awake = sum(stop - start for start, stop in spans)
+    scans = awake / args.scan_ms
+    blinks = awake / args.blink_ms
+    wakeups = len(spans) if sleep else 0
+    run = (len(events) * args.handle_ms + scans * args.scan_us / 1000
+           + blinks * args.blink_us / 1000 + wakeups * args.wake_us / 1000)
+    # mA times ms times V gives uJ
+    charge = (run * args.run_ma + (awake - run) * args.wait_ma
+              + (total - awake) * args.sleep_ma)
+    return {
+        "awake": awake / 1000,
+        "sleep": (total - awake) / 1000,
+        "wakeups": wakeups,
+        "scans": scans,
+        "run": run,
+        "energy": charge * args.volts / 1000,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("script", help="session script")
+    parser.add_argument("--messages", type=int, default=20, help="script runs, one message each")
+    parser.add_argument("--gap-s", type=float, default=300, help="pause between messages")
+    parser.add_argument("--idle-ms", type=float, default=30000, help="EDITOR_IDLE_DELAY")
+    parser.add_argument("--scan-ms", type=float, default=20, help="KEYPAD_SLOW_SCAN_DELAY")
+    parser.add_argument("--blink-ms", type=float, default=700, help="CURSOR_BLINK_DELAY")
+    parser.add_argument("--key-ms", type=float, default=150, help="short press duration")
+    parser.add_argument("--hold-ms", type=float, default=1000, help="long press duration")
+    parser.add_argument("--char-ms", type=float, default=300, help="typing time per text char")
+    parser.add_argument("--handle-ms", type=float, default=2, help="CPU time per key or frame")
+    parser.add_argument("--scan-us", type=float, default=30, help="CPU time per keypad scan")
+    parser.add_argument("--blink-us", type=float, default=400, help="CPU time per cursor blink")
+    parser.add_argument("--wake-us", type=float, default=1000, help="light sleep exit time")
+    parser.add_argument("--run-ma", type=float, default=40, help="current with CPU running")
+    parser.add_argument("--wait-ma", type=float, default=20, help="current awake between scans")
+    parser.add_argument("--sleep-ma", type=float, default=0.8, help="light sleep current")
+    parser.add_argument("--volts", type=float, default=3.3)
+    args = parser.parse_args()
+
+    activity, length, chars = load_activity(args.script, args)
+    chars = max(chars * args.messages, 1)
+    print("%d messages of %.1f s, %.0f s apart, %d typed chars"
+          % (args.messages, length / 1000, args.gap_s, chars))
+    print("%-10s %10s %10s %8s %10s %10s %12s %10s"
+          % ("policy", "awake s", "sleep s", "wakeups", "scans", "energy mJ", "mJ/message", "mJ/char"))
+    for name, sleep in (("awake", False), ("idle-sleep", True)):
+        r = simulate(args, activity, length, sleep)
+        print("%-10s %10.1f %10.1f %8d %10.0f %10.1f %12.2f %10.3f"
+              % (name, r["awake"], r["sleep"], r["wakeups"], r["scans"], r["energy"],
+                 r["energy"] / args.messages, r["energy"] / chars))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
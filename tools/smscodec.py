@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+"""Message codec of the history store, GSM 7-bit packing with a
+static dictionary of common message fragments.
+
+Every char becomes a GSM 03.38 septet, chars of the extension table
+ESC and their septet, the packed septets take 7 bits per char like an
+SMS. ESC followed by a septet that is not in the extension table
+stands for one dictionary word (SMAZ style), a word of n GSM chars
+takes 14 bits instead of 7n. Code page chars outside GSM are ESC ESC
+and the low 7 bits of their code (the backtick is ESC ESC 0).
+
+The dictionary is trained on a message corpus, one message per line:
+words are picked greedily by the bits they save on the corpus not yet
+covered by the picked words. `--c` prints the tables of Codec.cpp,
+`--bench MESSAGES` reports the compression ratio against 8-bit text,
+plain GSM packing and zlib, `TEXT` shows its encoding.
+"""
+
+import argparse
+import collections
+import sys
+import time
+import zlib
+
+import codepage
+
+# GSM 03.38 default alphabet by septet, ESC at 0x1B
+GSM = ("@£$¥èéùìòÇ\nØø\rÅåΔ_ΦΓΛΩΠΨΣΘΞ\x1bÆæßÉ !\"#¤%&'()*+,-./0123456789:;<=>?"
+       "¡ABCDEFGHIJKLMNOPQRSTUVWXYZÄÖÑÜ§¿abcdefghijklmnopqrstuvwxyzäöñüà")
+ESC = 0x1B
+# GSM 03.38 extension table, ESC and the septet
+EXTENSION = {0x0A: "\f", 0x14: "^", 0x28: "{", 0x29: "}", 0x2F: "\\", 0x3C: "[",
+             0x3D: "~", 0x3E: "]", 0x40: "|", 0x65: "€"}
+# Septets after ESC free for dictionary words
+WORD_CODES = [code for code in range(128) if code not in EXTENSION and code != ESC]
+WORDS = len(WORD_CODES)
+MAX_WORD = 8
+# Fewest occurrences of a dictionary word in the corpus
+MIN_USES = 3
+# Code page char of the verbatim septet zero
+VERBATIM_ZERO = ord("`")
+
+assert len(GSM) == 128
+
+
+def septet_table():
+    """Septets of every code page char, one for the default alphabet,
+    ESC and the septet for the extension table, else verbatim."""
+    table = {}
+    for code, ch in enumerate(codepage.TABLE):
+        if ch is None:
+            continue
+        if ch in GSM and GSM.index(ch) != ESC:
+            table[code] = [GSM.index(ch)]
+        elif ch in EXTENSION.values():
+            table[code] = [ESC] + [k for k, v in EXTENSION.items() if v == ch]
+        else:
+            table[code] = [ESC, ESC, 0 if code == VERBATIM_ZERO else code & 0x7F]
+    return table
+
+
+SEPTETS = septet_table()
+
+
+def char_bits(code):
+    return 7 * len(SEPTETS[code])
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        return [codepage.encode(line.strip(), strict=False) for line in f
+                if line.strip() and not line.startswith("#")]
+
+
+def train(messages, count=WORDS):
+    """Dictionary words picked by the bits they save, the covered
+    parts of the messages are cut out before the next pick. Words used
+    less than MIN_USES times would only fit the corpus."""
+    segments = list(messages)
+    words = []
+    while len(words) < count:
+        gain = collections.Counter()
+        uses = collections.Counter()
+        for seg in segments:
+            for start in range(len(seg)):
+                bits = 0
+                for end in range(start + 1, min(start + MAX_WORD, len(seg)) + 1):
+                    bits += char_bits(seg[end - 1])
+                    if bits > 14:
+                        gain[seg[start:end]] += bits - 14
+                        uses[seg[start:end]] += 1
+        for word in list(gain):
+            if uses[word] < MIN_USES or word in words:
+                del gain[word]
+        if not gain:
+            break
+        word, _ = max(gain.items(), key=lambda item: (item[1], item[0]))
+        words.append(word)
+        cut = []
+        for seg in segments:
+            cut.extend(part for part in seg.split(word) if part)
+        segments = cut
+    return sort_words(words)
+
+
+def sort_words(words):
+    """Words by first char and longest first, the encoder takes the
+    first matching word of the char."""
+    return sorted(words, key=lambda w: (w[0], -len(w), w))
+
+
+def encode_septets(text, words):
+    by_first = collections.defaultdict(list)
+    for idx, word in enumerate(words):
+        by_first[word[0]].append(idx)
+    out = []
+    pos = 0
+    while pos < len(text):
+        for idx in by_first.get(text[pos], ()):
+            if text.startswith(words[idx], pos):
+                out += [ESC, WORD_CODES[idx]]
+                pos += len(words[idx])
+                break
+        else:
+            out += SEPTETS[text[pos]]
+            pos += 1
+    return out
+
+
+def pack(septets):
+    acc = count = 0
+    out = bytearray()
+    for septet in septets:
+        acc |= septet << count
+        count += 7
+        while count >= 8:
+            out.append(acc & 0xFF)
+            acc >>= 8
+            count -= 8
+    if count:
+        out.append(acc)
+    return bytes(out)
+
+
+def unpack(data):
+    acc = count = 0
+    for byte in data:
+        acc |= byte << count
+        count += 8
+        while count >= 7:
+            yield acc & 0x7F
+            acc >>= 7
+            count -= 7
+
+
+def encode(text, words):
+    return pack(encode_septets(text, words))
+
+
+def decode(data, length, words):
+    out = bytearray()
+    septets = unpack(data)
+    codes = {code: idx for idx, code in enumerate(WORD_CODES)}
+    while len(out) < length:
+        septet = next(septets)
+        if septet != ESC:
+            out.append(codepage.CODES[GSM[septet]])
+            continue
+        septet = next(septets)
+        if septet == ESC:
+            septet = next(septets)
+            out.append(VERBATIM_ZERO if septet == 0 else 0x80 | septet)
+        elif septet in EXTENSION:
+            out.append(codepage.CODES[EXTENSION[septet]])
+        else:
+            out += words[codes[septet]]
+    return bytes(out[:length])
+
+
+def c_string(word):
+    """C literal of the code page bytes, hex escapes end the literal
+    part when a hex digit follows."""
+    out = ""
+    for pos, byte in enumerate(word):
+        if 0x20 <= byte < 0x7F and chr(byte) not in "\\\"":
+            out += chr(byte)
+        else:
+            out += "\\x%02X" % byte
+            if pos + 1 < len(word) and chr(word[pos + 1]) in "0123456789abcdefABCDEF":
+                out += "\" \""
+    return "\"%s\"" % out
+
+
+def c_rows(values, width=16):
+    rows = []
+    for row in range(0, len(values), width):
+        text = ", ".join(values[row:row + width])
+        rows.append("  %s%s // 0x%02X" % (text, "," if row + width < len(values) else " ", row))
+    return rows
+
+
+def c_tables(words):
+    encode = []
+    for code in range(256):
+        septets = SEPTETS.get(code, [ESC, ESC, 0])
+        encode.append("0x%02X" % (septets[0] if len(septets) == 1 else
+                                  0x80 | septets[1] if len(septets) == 2 else 0xFF))
+    escapes = ["CODEC_NONE"] * 128
+    for septet in EXTENSION:
+        escapes[septet] = "CODEC_EXTENSION"
+    for idx in range(len(words)):
+        escapes[WORD_CODES[idx]] = "0x%02X" % idx
+    extensions = ", ".join("{0x%02X, 0x%02X}" % (septet, codepage.CODES[ch])
+                           for septet, ch in sorted(EXTENSION.items()) if ch in codepage.CODES)
+
+    first = ["CODEC_NONE"] * 256
+    for idx in reversed(range(len(words))):
+        first[words[idx][0]] = "0x%02X" % idx
+
+    lines = ["// Septets of every code page char, the GSM 03.38 septet, the",
+             "// extension septet with CODEC_ESCAPE set or CODEC_VERBATIM,",
+             "// generated by tools/smscodec.py",
+             "const uint8_t CodecSeptets[256] = {"]
+    lines += c_rows(encode)
+    lines += ["};", "", "// Code page char of every GSM 03.38 septet",
+              "const uint8_t CodecChars[128] = {"]
+    lines += c_rows(["0x%02X" % codepage.CODES.get(ch, 0) for ch in GSM])
+    lines += ["};", "", "// Meaning of the septet after ESC, a dictionary word index,",
+              "// CODEC_EXTENSION for an extension table char or CODEC_NONE",
+              "const uint8_t CodecEscapes[128] = {"]
+    lines += c_rows(escapes, 8)
+    lines += ["};", "", "// Extension table septets and their code page chars",
+              "const CodecExtension CodecExtensions[CODEC_EXTENSIONS] = {",
+              "  %s" % extensions, "};", "",
+              "// Septet after ESC of every dictionary word",
+              "const uint8_t CodecWordSeptets[] = {"]
+    lines += c_rows(["0x%02X" % WORD_CODES[idx] for idx in range(len(words))])
+    lines += ["};", "",
+              "// Dictionary words by first char and longest first, trained on",
+              "// tools/messages/sms.txt",
+              "const char *const CodecWords[] = {"]
+    for start in range(0, len(words), 6):
+        chunk = ", ".join(c_string(word) for word in words[start:start + 6])
+        lines.append("  %s%s" % (chunk, "," if start + 6 < len(words) else ""))
+    lines += ["};", "", "// First dictionary word of every code page char or CODEC_NONE",
+              "const uint8_t CodecFirst[256] = {"]
+    lines += c_rows(first, 8)
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def bench(messages, words):
+    raw = sum(len(m) for m in messages)
+    gsm = sum(len(pack(sum((SEPTETS[c] for c in m), []))) for m in messages)
+    deflate = sum(min(len(zlib.compress(bytes(m), 9)), len(m)) for m in messages)
+    start = time.perf_counter()
+    packed = [encode(m, words) for m in messages]
+    encode_s = time.perf_counter() - start
+    start = time.perf_counter()
+    for m, data in zip(messages, packed):
+        if decode(data, len(m), words) != m:
+            raise SystemExit("round trip failed: %s" % codepage.decode(m))
+    decode_s = time.perf_counter() - start
+    coded = sum(min(len(p), len(m)) for m, p in zip(messages, packed))
+    print("messages      %d, %d chars, %d dictionary words" % (len(messages), raw, len(words)))
+    print("8-bit text    %6d B  100.0%%" % raw)
+    print("GSM 7-bit     %6d B  %5.1f%%" % (gsm, 100.0 * gsm / raw))
+    print("zlib -9       %6d B  %5.1f%% (per message, raw when larger)" % (deflate, 100.0 * deflate / raw))
+    print("codec         %6d B  %5.1f%% (raw when larger)" % (coded, 100.0 * coded / raw))
+    held = train(messages[::2])
+    unseen = messages[1::2]
+    heldout = sum(min(len(encode(m, held)), len(m)) for m in unseen)
+    print("held out      %5.1f%% (trained on every other message, packed the rest)" %
+          (100.0 * heldout / sum(len(m) for m in unseen)))
+    print("host model    encode %.0f KB/s, decode %.0f KB/s" % (raw / encode_s / 1024, raw / decode_s / 1024))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("text", nargs="?", help="text to encode")
+    parser.add_argument("--corpus", default="tools/messages/sms.txt", help="training messages")
+    parser.add_argument("--c", action="store_true", help="print the C tables")
+    parser.add_argument("--bench", metavar="MESSAGES", help="compression ratio of the messages")
+    args = parser.parse_args()
+
+    words = train(load(args.corpus))
+    if args.c:
+        print(c_tables(words))
+        return 0
+    if args.bench:
+        return bench(load(args.bench), words)
+    if args.text:
+        text = codepage.encode(args.text, strict=False)
+        data = encode(text, words)
+        print("%d chars, %d B: %s" % (len(text), len(data), data.hex()))
+        print(codepage.decode(decode(data, len(text), words)))
+        return 0
+    for word in words:
+        print(repr(codepage.decode(word)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
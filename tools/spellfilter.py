@@ -0,0 +1,183 @@
+#!/usr/bin/env python3
+"""Spell check dictionary of the terminal, a Bloom filter in flash.
+
+Every word of the word lists is folded like the message index keys
+(lower case, no diacritics, apostrophes left out) and hashed once with
+64-bit FNV-1a and one xorshift multiply round, FNV alone leaves the
+high half of short words poorly mixed. The low half is the first probe
+and the high half the probe step, so a lookup costs one pass over the
+word and the given number of bit reads. The filter size and hash count follow from the
+word count and the wanted false positive rate.
+
+`--c` prints the constants of Spell.h and the filter of Spell.cpp,
+`--bench` reports the filter size, measured false positive rate and
+host lookup rate at several rates, `--synthetic N` benchmarks N random
+words instead of the lists, `WORD ...` shows the lookup of words.
+"""
+
+import argparse
+import math
+import os
+import random
+import sys
+import time
+
+import codepage
+
+WORDS = os.path.join(os.path.dirname(__file__), "words", "english.txt")
+# Longest word checked, SPELL_WORD_SIZE of Spell.h
+WORD_SIZE = 24
+FNV_BASIS = 0xCBF29CE484222325
+FNV_PRIME = 0x100000001B3
+MASK = (1 << 64) - 1
+MIX = 0xFF51AFD7ED558CCD
+# English letter frequencies in percent for the synthetic words
+LETTERS = b"etaoinshrdlcumwfgypbvkjxqz"
+LETTER_WEIGHTS = (12.7, 9.1, 8.2, 7.5, 7.0, 6.7, 6.3, 6.1, 6.0, 4.3, 4.0, 2.8, 2.8,
+                  2.4, 2.4, 2.2, 2.0, 2.0, 1.9, 1.5, 1.0, 0.8, 0.2, 0.2, 0.1, 0.1)
+
+
+def word_key(word):
+    """Folded bytes of the word or None if the word is not checked,
+    words with digits or separators and too long words."""
+    key = bytearray()
+    for code in codepage.encode(word, strict=False):
+        if code == ord("'"):
+            continue
+        value = codepage.fold(code)
+        if value == 0 or ord("0") <= value <= ord("9"):
+            return None
+        key.append(value)
+    return bytes(key) if 0 < len(key) <= WORD_SIZE else None
+
+
+def load(paths):
+    """Distinct keys of the words in the lists."""
+    keys = set()
+    for path in paths:
+        with open(path, encoding="utf-8") as f:
+            for line in f:
+                if line.startswith("#"):
+                    continue
+                for word in line.split():
+                    key = word_key(word)
+                    if key:
+                        keys.add(key)
+    return sorted(keys)
+
+
+def probes(key, bits, hashes):
+    """Filter bits of the key."""
+    value = FNV_BASIS
+    for byte in key:
+        value = ((value ^ byte) * FNV_PRIME) & MASK
+    value ^= value >> 32
+    value = (value * MIX) & MASK
+    value ^= value >> 32
+    probe = value & 0xFFFFFFFF
+    step = (value >> 32) | 1
+    for _ in range(hashes):
+        yield (probe * bits) >> 32
+        probe = (probe + step) & 0xFFFFFFFF
+
+
+def size(count, rate):
+    """Filter bits and hash count for the word count and rate."""
+    bits = max(64, math.ceil(-count * math.log(rate) / math.log(2) ** 2))
+    bits = (bits + 7) // 8 * 8
+    hashes = max(1, round(bits / count * math.log(2)))
+    return bits, hashes
+
+
+def build(keys, bits, hashes):
+    filter_ = bytearray(bits // 8)
+    for key in keys:
+        for bit in probes(key, bits, hashes):
+            filter_[bit >> 3] |= 1 << (bit & 7)
+    return filter_
+
+
+def contains(filter_, key, bits, hashes):
+    return all(filter_[bit >> 3] & (1 << (bit & 7)) for bit in probes(key, bits, hashes))
+
+
+def c_tables(keys, bits, hashes, rate, source):
+    filter_ = build(keys, bits, hashes)
+    lines = ["// Spell.h", "#define SPELL_FILTER_BITS %d" % bits, "#define SPELL_HASHES %d" % hashes, "",
+             "// Spell.cpp",
+             "// Bloom filter of %d words of %s for %.1f %% false" % (len(keys), source, rate * 100),
+             "// positives, generated by tools/spellfilter.py",
+             "const uint8_t SpellFilter[SPELL_FILTER_BYTES] = {"]
+    for start in range(0, len(filter_), 16):
+        row = ", ".join("0x%02X" % value for value in filter_[start:start + 16])
+        lines.append("  %s%s" % (row, "," if start + 16 < len(filter_) else ""))
+    lines.append("};")
+    return "\n".join(lines)
+
+
+def random_key(rng):
+    """Random lower case key of an English-like length."""
+    length = min(max(int(rng.gauss(7, 2.5)), 2), WORD_SIZE)
+    return bytes(rng.choices(LETTERS, LETTER_WEIGHTS, k=length))
+
+
+def bench(keys, samples, seed):
+    rng = random.Random(seed)
+    known = set(keys)
+    unknown = set()
+    while len(unknown) < samples:
+        key = random_key(rng)
+        if key not in known:
+            unknown.add(key)
+    print("words %d, %d unknown samples" % (len(keys), samples))
+    print("%8s %10s %8s %7s %10s %12s" % ("rate", "flash", "bits/w", "hashes", "measured", "host lookup"))
+    for rate in (0.1, 0.05, 0.01, 0.001):
+        bits, hashes = size(len(keys), rate)
+        filter_ = build(keys, bits, hashes)
+        if not all(contains(filter_, key, bits, hashes) for key in keys[:samples]):
+            raise SystemExit("a dictionary word is missing")
+        start = time.perf_counter()
+        false = sum(contains(filter_, key, bits, hashes) for key in unknown)
+        lookup = (time.perf_counter() - start) / samples
+        print("%7.1f%% %8d B %8.1f %7d %9.2f%% %9.1f us"
+              % (rate * 100, bits // 8, bits / len(keys), hashes, false * 100.0 / samples, lookup * 1e6))
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("word", nargs="*", help="words to look up")
+    parser.add_argument("--words", nargs="+", default=[WORDS], help="word lists, one or more words per line")
+    parser.add_argument("--rate", type=float, default=0.01, help="false positive rate of the filter")
+    parser.add_argument("--c", action="store_true", help="print the constants and the C filter")
+    parser.add_argument("--bench", action="store_true", help="filter size and false positives by rate")
+    parser.add_argument("--synthetic", type=int, help="benchmark this many random words instead")
+    parser.add_argument("--samples", type=int, default=100000, help="unknown words of the benchmark")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    if args.synthetic:
+        rng = random.Random(args.seed + 1)
+        keys = set()
+        while len(keys) < args.synthetic:
+            keys.add(random_key(rng))
+        return bench(sorted(keys), args.samples, args.seed)
+
+    keys = load(args.words)
+    bits, hashes = size(len(keys), args.rate)
+    if args.c:
+        print(c_tables(keys, bits, hashes, args.rate, ", ".join(os.path.relpath(path) for path in args.words)))
+        return 0
+    if args.bench:
+        return bench(keys, args.samples, args.seed)
+    filter_ = build(keys, bits, hashes)
+    print("%d words, %d B, %d hashes" % (len(keys), bits // 8, hashes))
+    for word in args.word:
+        key = word_key(word)
+        print("%-20s %s" % (word, "not checked" if key is None else
+                            "known" if contains(filter_, key, bits, hashes) else "misspelled"))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())